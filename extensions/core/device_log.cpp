@@ -0,0 +1,270 @@
+#include "device_log.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Single-producer/single-consumer ring owned by one producing thread.
+// The producer only writes `head`, the drainer only writes `tail`.
+struct LogRing {
+    static constexpr uint32_t kCapacity = 512; // Must be a power of two
+    static constexpr uint32_t kMask = kCapacity - 1;
+
+    alignas(64) std::atomic<uint32_t> head{0};
+    alignas(64) std::atomic<uint32_t> tail{0};
+    std::atomic<bool> retired{false};
+    LogRecord slots[kCapacity];
+
+    bool push(const LogRecord& record, uint32_t& pending) {
+        uint32_t currentHead = head.load(std::memory_order_relaxed);
+        uint32_t currentTail = tail.load(std::memory_order_acquire);
+        if (currentHead - currentTail >= kCapacity) {
+            return false;
+        }
+        slots[currentHead & kMask] = record;
+        head.store(currentHead + 1, std::memory_order_release);
+        pending = currentHead + 1 - currentTail;
+        return true;
+    }
+
+    template <typename Consumer>
+    void drain(Consumer&& consume) {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        uint32_t currentHead = head.load(std::memory_order_acquire);
+        while (currentTail != currentHead) {
+            consume(slots[currentTail & kMask]);
+            ++currentTail;
+        }
+        tail.store(currentTail, std::memory_order_release);
+    }
+
+    bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
+
+// Shared state between producers, the drainer and the control API
+struct LogState {
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<LogRing>> rings;
+
+    std::mutex sinkMutex;
+    DeviceLog::Sink sink;
+
+    std::mutex drainerMutex;
+    std::condition_variable drainerWake;
+    std::thread drainer;
+    std::chrono::milliseconds flushInterval{16};
+    bool stopRequested = false;
+    std::atomic<bool> running{false};
+
+    // Scratch buffers reused between flushes, guarded by drainMutex
+    std::mutex drainMutex;
+    std::vector<LogRecord> batch;
+    std::string text;
+};
+
+LogState& state() {
+    static LogState instance;
+    return instance;
+}
+
+// Retires the thread's ring on thread exit; the drainer frees it once empty
+struct RingOwner {
+    std::shared_ptr<LogRing> ring;
+
+    ~RingOwner() {
+        if (ring) {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local RingOwner threadRing;
+
+LogRing& localRing() {
+    if (!threadRing.ring) {
+        threadRing.ring = std::make_shared<LogRing>();
+        LogState& s = state();
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        s.rings.push_back(threadRing.ring);
+    }
+    return *threadRing.ring;
+}
+
+void emit(const std::string& text) {
+    LogState& s = state();
+    std::lock_guard<std::mutex> lock(s.sinkMutex);
+    if (s.sink) {
+        s.sink(text);
+    } else {
+        std::fputs(text.c_str(), stdout);
+        std::fputc('\n', stdout);
+    }
+}
+
+void drainAll() {
+    LogState& s = state();
+    std::lock_guard<std::mutex> drainLock(s.drainMutex);
+
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        rings = s.rings;
+    }
+
+    s.batch.clear();
+    for (auto& ring : rings) {
+        ring->drain([&](const LogRecord& record) { s.batch.push_back(record); });
+    }
+
+    // Rings of exited threads can go once they have been emptied
+    {
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        s.rings.erase(
+            std::remove_if(s.rings.begin(), s.rings.end(), [](const std::shared_ptr<LogRing>& ring) {
+                return ring->retired.load(std::memory_order_acquire) && ring->isEmpty();
+            }),
+            s.rings.end()
+        );
+    }
+
+    if (s.batch.empty()) {
+        return;
+    }
+
+    // Interleave records from different threads in the order they happened
+    std::stable_sort(s.batch.begin(), s.batch.end(), [](const LogRecord& a, const LogRecord& b) {
+        return a.timestampNs < b.timestampNs;
+    });
+
+    s.text.clear();
+    for (size_t i = 0; i < s.batch.size(); ++i) {
+        if (i > 0) {
+            s.text.push_back('\n');
+        }
+        DeviceLog::formatRecord(s.batch[i], s.text);
+    }
+    emit(s.text);
+}
+
+void drainerLoop() {
+    LogState& s = state();
+    std::unique_lock<std::mutex> lock(s.drainerMutex);
+    while (!s.stopRequested) {
+        s.drainerWake.wait_for(lock, s.flushInterval);
+        lock.unlock();
+        drainAll();
+        lock.lock();
+    }
+}
+
+void appendArg(const LogArg& arg, std::string& out) {
+    char buffer[32];
+    switch (arg.kind) {
+        case LogArg::Kind::INTEGER:
+            std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(arg.integer));
+            out += buffer;
+            break;
+        case LogArg::Kind::REAL:
+            std::snprintf(buffer, sizeof(buffer), "%g", arg.real);
+            out += buffer;
+            break;
+        case LogArg::Kind::TEXT:
+            out += arg.text;
+            break;
+    }
+}
+
+} // namespace
+
+void DeviceLog::start(Sink sink, std::chrono::milliseconds flushInterval) {
+    LogState& s = state();
+    if (s.running.load()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s.sinkMutex);
+        s.sink = std::move(sink);
+    }
+    {
+        std::lock_guard<std::mutex> lock(s.drainerMutex);
+        s.flushInterval = flushInterval;
+        s.stopRequested = false;
+    }
+    s.running.store(true);
+    s.drainer = std::thread(drainerLoop);
+}
+
+void DeviceLog::stop() {
+    LogState& s = state();
+    if (!s.running.load()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s.drainerMutex);
+        s.stopRequested = true;
+    }
+    s.drainerWake.notify_one();
+    s.drainer.join();
+    s.running.store(false);
+
+    // Anything written while the drainer was shutting down
+    drainAll();
+
+    std::lock_guard<std::mutex> lock(s.sinkMutex);
+    s.sink = nullptr;
+}
+
+void DeviceLog::flush() {
+    drainAll();
+}
+
+void DeviceLog::submit(const LogRecord& record) {
+    LogState& s = state();
+
+    // Without a drainer the record is formatted and written immediately
+    if (!s.running.load(std::memory_order_acquire)) {
+        std::string text;
+        formatRecord(record, text);
+        emit(text);
+        return;
+    }
+
+    uint32_t pending = 0;
+    if (!localRing().push(record, pending)) {
+        if (record.level == LogLevel::ALERT) {
+            // Safety-critical messages are never dropped
+            std::string text;
+            formatRecord(record, text);
+            emit(text);
+        } else {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    // Wake the drainer early once a ring is half full
+    if (pending == LogRing::kCapacity / 2) {
+        s.drainerWake.notify_one();
+    }
+}
+
+void DeviceLog::formatRecord(const LogRecord& record, std::string& out) {
+    size_t argIndex = 0;
+    for (const char* cursor = record.format; *cursor; ++cursor) {
+        if (cursor[0] == '{' && cursor[1] == '}' && argIndex < record.argCount) {
+            appendArg(record.args[argIndex++], out);
+            ++cursor;
+        } else {
+            out.push_back(*cursor);
+        }
+    }
+}
@@ -0,0 +1,172 @@
+#ifndef DEVICE_LOG_H
+#define DEVICE_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+// Severity levels for device logging. Hot paths compare against the
+// runtime level with a single relaxed load and skip everything else.
+enum class LogLevel : uint8_t {
+    TRACE = 0,  // Per-tick chatter (scan progress, vital samples)
+    DEBUG = 1,  // Per-operation detail (brightness, colour, height changes)
+    INFO = 2,   // Lifecycle events (power, procedures, scans) and device storage I/O errors
+    ALERT = 3   // Safety-critical messages, never filtered at runtime
+};
+
+// Lowest tier compiled into the binary (0 = TRACE ... 3 = ALERT). The build
+// raises it for release targets so lower tiers disappear together with
+// their argument formatting; ALERT is always compiled in.
+#ifndef DEVICE_LOG_MIN_TIER
+#define DEVICE_LOG_MIN_TIER 0
+#endif
+
+template <LogLevel Level>
+struct LogTier {
+    static constexpr bool compiled =
+        Level == LogLevel::ALERT || static_cast<int>(Level) >= DEVICE_LOG_MIN_TIER;
+};
+
+// One formatting argument, captured by value so the record can outlive
+// the caller's stack frame. Text is truncated to fit the fixed slot.
+struct LogArg {
+    static constexpr size_t kTextCapacity = 32;
+
+    enum class Kind : uint8_t { INTEGER, REAL, TEXT };
+
+    Kind kind;
+    union {
+        int64_t integer;
+        double real;
+        char text[kTextCapacity];
+    };
+
+    LogArg() : kind(Kind::INTEGER), integer(0) {}
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+    LogArg(T value) : kind(Kind::INTEGER), integer(static_cast<int64_t>(value)) {}
+
+    template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    LogArg(T value) : kind(Kind::REAL), real(static_cast<double>(value)) {}
+
+    LogArg(bool value) : LogArg(value ? "true" : "false") {}
+    LogArg(const std::string& value) : LogArg(value.c_str()) {}
+
+    LogArg(const char* value) : kind(Kind::TEXT) {
+        size_t length = value ? std::strlen(value) : 0;
+        if (length >= kTextCapacity) {
+            length = kTextCapacity - 1;
+        }
+        if (length > 0) {
+            std::memcpy(text, value, length);
+        }
+        text[length] = '\0';
+    }
+};
+
+// Fixed-size record written by producers. The format string must be a
+// string literal: only its pointer is stored and "{}" placeholders are
+// expanded later on the drainer thread.
+struct LogRecord {
+    static constexpr size_t kMaxArgs = 4;
+
+    uint64_t timestampNs;
+    const char* format;
+    LogLevel level;
+    uint8_t argCount;
+    LogArg args[kMaxArgs];
+};
+
+/**
+ * @class DeviceLog
+ * @brief Asynchronous logging backend for device hot paths
+ *
+ * Each producing thread owns a lock-free single-producer ring of LogRecords.
+ * A background drainer collects pending records from every ring, formats
+ * them in timestamp order and hands one batch per flush to the sink, so the
+ * Godot console is hit once per interval instead of once per message.
+ */
+class DeviceLog {
+public:
+    using Sink = std::function<void(const std::string& batch)>;
+
+    /**
+     * Starts the background drainer
+     * @param sink Receives formatted batches, one line per record
+     * @param flushInterval Maximum time a record waits before being flushed
+     */
+    static void start(Sink sink, std::chrono::milliseconds flushInterval = std::chrono::milliseconds(16));
+
+    /**
+     * Stops the drainer after flushing every pending record
+     */
+    static void stop();
+
+    /**
+     * Synchronously drains and formats all pending records
+     */
+    static void flush();
+
+    static void setLevel(LogLevel level) { currentLevel.store(level, std::memory_order_relaxed); }
+    static LogLevel getLevel() { return currentLevel.load(std::memory_order_relaxed); }
+
+    static bool isEnabled(LogLevel level) {
+        return level >= currentLevel.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Number of records discarded because a producer ring was full
+     */
+    static uint64_t getDroppedCount() { return droppedCount.load(std::memory_order_relaxed); }
+
+    template <typename... Args>
+    static void write(LogLevel level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= LogRecord::kMaxArgs, "Too many arguments for a device log record");
+
+        LogRecord record;
+        record.timestampNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        record.format = format;
+        record.level = level;
+        record.argCount = static_cast<uint8_t>(sizeof...(Args));
+        size_t index = 0;
+        ((record.args[index++] = LogArg(args)), ...);
+        (void)index;
+
+        submit(record);
+    }
+
+    /**
+     * Expands the "{}" placeholders of a record into text
+     */
+    static void formatRecord(const LogRecord& record, std::string& out);
+
+private:
+    static void submit(const LogRecord& record);
+
+    inline static std::atomic<LogLevel> currentLevel{LogLevel::INFO};
+    inline static std::atomic<uint64_t> droppedCount{0};
+};
+
+// Logging macros - tiers below DEVICE_LOG_MIN_TIER compile to nothing, the
+// others only evaluate their arguments when the level is enabled at runtime
+#define DEVICE_LOG(level, ...) \
+    do { \
+        if constexpr (LogTier<level>::compiled) { \
+            if (DeviceLog::isEnabled(level)) { \
+                DeviceLog::write(level, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define DEVICE_LOG_TRACE(...) DEVICE_LOG(LogLevel::TRACE, __VA_ARGS__)
+#define DEVICE_LOG_DEBUG(...) DEVICE_LOG(LogLevel::DEBUG, __VA_ARGS__)
+#define DEVICE_LOG_INFO(...) DEVICE_LOG(LogLevel::INFO, __VA_ARGS__)
+#define DEVICE_LOG_ALERT(...) DEVICE_LOG(LogLevel::ALERT, __VA_ARGS__)
+
+#endif // DEVICE_LOG_H
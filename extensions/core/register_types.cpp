@@ -6,6 +6,15 @@
 #include "../medical_equipment/patient_bed.h"
 #include "../medical_equipment/surgical_bed.h"
 #include "../medical_equipment/godot_bed_factory.h"
+#include "../medical_equipment/vitals_fleet.h"
+#include "../medical_equipment/ward_lights.h"
+#include "../medical_equipment/emergency_network.h"
+#include "../medical_equipment/light_animation.h"
+#include "../medical_equipment/bed_fleet.h"
+#include "../medical_equipment/bed_ward.h"
+#include "../medical_equipment/bed_maintenance.h"
+#include "../medical_equipment/bed_change_notifier.h"
+#include "device_log.h"
 
 using namespace godot;
 
@@ -16,15 +25,30 @@ void initialize_window_module(ModuleInitializationLevel p_level) {
     
     UtilityFunctions::print("🔧 Medical Equipment Extension Loading...");
     
+    // Device hot paths log through the asynchronous backend; batches reach
+    // the Godot console from the drainer thread
+    DeviceLog::start([](const std::string& batch) {
+        UtilityFunctions::print(String::utf8(batch.c_str()));
+    });
+    
     // Register window controls classes
     ClassDB::register_class<CustomWindow>();
     UtilityFunctions::print("✅ CustomWindow registered");
     
     // Register medical equipment classes
+    ClassDB::register_class<LightAnimation>();  // before Bed, whose methods take it
     ClassDB::register_abstract_class<Bed>();
     ClassDB::register_class<PatientBed>();
     ClassDB::register_class<SurgicalBed>();
     ClassDB::register_class<BedFactory>();
+    ClassDB::register_class<VitalsFleet>();
+    ClassDB::register_class<WardLights>();
+    ClassDB::register_class<EmergencyNetwork>();
+    ClassDB::register_class<BedFleet>();
+    ClassDB::register_class<BedView>();  // before BedWard, whose get_bed returns it
+    ClassDB::register_class<BedWard>();
+    ClassDB::register_class<BedMaintenance>();
+    ClassDB::register_class<BedChangeNotifier>();
     UtilityFunctions::print("✅ Medical equipment classes registered");
 }
 
@@ -32,6 +56,9 @@ void uninitialize_window_module(ModuleInitializationLevel p_level) {
     if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
         return;
     }
+    
+    // Flush pending device log records before Godot tears down
+    DeviceLog::stop();
 }
 
 extern "C" {
@@ -0,0 +1,121 @@
+#include "worker_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+
+// Shared between the caller of parallelFor and the helper jobs, which may
+// start after the caller has already finished every chunk
+struct ParallelRange {
+    WorkerPool::RangeFunction fn;
+    size_t count;
+    size_t chunkSize;
+    size_t chunkCount;
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<size_t> finishedChunks{0};
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    void runChunks() {
+        size_t chunk;
+        while ((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunkCount) {
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(count, begin + chunkSize);
+            fn(begin, end);
+            if (finishedChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == chunkCount) {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                done.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace
+
+WorkerPool::WorkerPool(size_t threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        size_t hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        stopping = true;
+    }
+    jobsAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+WorkerPool& WorkerPool::shared() {
+    static WorkerPool instance;
+    return instance;
+}
+
+void WorkerPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        jobs.push_back(std::move(job));
+    }
+    jobsAvailable.notify_one();
+}
+
+void WorkerPool::parallelFor(size_t count, size_t grainSize, const RangeFunction& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    grainSize = std::max<size_t>(1, grainSize);
+    size_t maxChunks = (count + grainSize - 1) / grainSize;
+    size_t chunkCount = std::min(maxChunks, (workers.size() + 1) * 4);
+
+    // Small ranges are not worth a hand-off
+    if (chunkCount <= 1) {
+        fn(0, count);
+        return;
+    }
+
+    auto range = std::make_shared<ParallelRange>();
+    range->fn = fn;
+    range->count = count;
+    range->chunkSize = (count + chunkCount - 1) / chunkCount;
+    range->chunkCount = (count + range->chunkSize - 1) / range->chunkSize;
+
+    size_t helpers = std::min(workers.size(), range->chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        submit([range]() { range->runChunks(); });
+    }
+
+    // The caller works too, so progress never depends on a free worker
+    range->runChunks();
+
+    std::unique_lock<std::mutex> lock(range->doneMutex);
+    range->done.wait(lock, [&range]() {
+        return range->finishedChunks.load(std::memory_order_acquire) == range->chunkCount;
+    });
+}
+
+void WorkerPool::workerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(jobsMutex);
+            jobsAvailable.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (stopping && jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkerPool
+ * @brief Fixed set of worker threads shared by the batch engines
+ *
+ * Jobs submitted with submit() run asynchronously. parallelFor() splits an
+ * index range into chunks that the workers and the calling thread pull
+ * from, and returns once every chunk has run.
+ */
+class WorkerPool {
+public:
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    /**
+     * Creates a pool
+     * @param threadCount Number of workers; 0 uses hardware concurrency - 1
+     */
+    explicit WorkerPool(size_t threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Process-wide pool used by the device engines
+     */
+    static WorkerPool& shared();
+
+    /**
+     * Queues a job for asynchronous execution
+     */
+    void submit(std::function<void()> job);
+
+    /**
+     * Runs fn over [0, count) in chunks of at least grainSize indices
+     * @param count Number of indices
+     * @param grainSize Minimum chunk size, keeps tiny ranges on one thread
+     * @param fn Called with [begin, end) for every chunk, possibly concurrently
+     */
+    void parallelFor(size_t count, size_t grainSize, const RangeFunction& fn);
+
+    size_t getThreadCount() const { return workers.size(); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex jobsMutex;
+    std::condition_variable jobsAvailable;
+    bool stopping;
+};
+
+#endif // WORKER_POOL_H
@@ -1,10 +1,14 @@
 #include "bed.h"
+#include "worker_pool.h"
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 
 using namespace godot;
 
-Bed::Bed() : currentHeight(50.0f), minHeight(30.0f), maxHeight(100.0f), isPoweredOn(false) {
+Bed::Bed() : heightActuator(50.0f, 30.0f, 100.0f), minHeight(30.0f), maxHeight(100.0f), isPoweredOn(false) {
     initializeComponents();
 }
 
@@ -21,11 +25,14 @@ void Bed::initializeComponents() {
 void Bed::powerOn() {
     if (!isPoweredOn) {
         isPoweredOn = true;
-        UtilityFunctions::print(getClassName().c_str(), " powered ON");
+        DEVICE_LOG_INFO("{} powered ON", getClassName());
         
         // Initialize default settings
         temperatureControl->setTemperature(TemperatureControl::Mode::NEUTRAL);
         lightStrip->activate();
+        markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_POWER | MaintenanceRecord::SUBSYSTEM_LIGHTS |
+                             MaintenanceRecord::SUBSYSTEM_TEMPERATURE);
+        markChanged(BedChange::POWER | BedChange::LIGHTS | BedChange::TEMPERATURE);
         
         onPowerOn(); // Hook for subclasses
     }
@@ -34,11 +41,13 @@ void Bed::powerOn() {
 void Bed::powerOff() {
     if (isPoweredOn) {
         isPoweredOn = false;
-        UtilityFunctions::print(getClassName().c_str(), " powered OFF");
+        DEVICE_LOG_INFO("{} powered OFF", getClassName());
         
         if (lightStrip) {
             lightStrip->deactivate();
         }
+        markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_POWER | MaintenanceRecord::SUBSYSTEM_LIGHTS);
+        markChanged(BedChange::POWER | BedChange::LIGHTS);
         
         onPowerOff(); // Hook for subclasses
     }
@@ -46,45 +55,95 @@ void Bed::powerOff() {
 
 void Bed::raiseHeight(float amount) {
     if (!isPoweredOn) {
-        UtilityFunctions::print("Cannot adjust height - bed is powered off");
+        DEVICE_LOG_DEBUG("Cannot adjust height - bed is powered off");
         return;
     }
     
-    float newHeight = currentHeight + amount;
+    // Relative to where the lift is already headed, so repeated presses add up
+    float newHeight = heightActuator.getFinalTarget() + amount;
     if (validateHeightRange(newHeight)) {
-        currentHeight = newHeight;
-        UtilityFunctions::print("Height raised to ", currentHeight, " cm");
+        heightActuator.moveTo(newHeight);
+        startHeightMotion();
+        DEVICE_LOG_DEBUG("Height raising to {} cm", newHeight);
     } else {
-        UtilityFunctions::print("Cannot raise height - would exceed maximum (", maxHeight, " cm)");
+        DEVICE_LOG_DEBUG("Cannot raise height - would exceed maximum ({} cm)", maxHeight);
     }
 }
 
 void Bed::lowerHeight(float amount) {
     if (!isPoweredOn) {
-        UtilityFunctions::print("Cannot adjust height - bed is powered off");
+        DEVICE_LOG_DEBUG("Cannot adjust height - bed is powered off");
         return;
     }
     
-    float newHeight = currentHeight - amount;
+    float newHeight = heightActuator.getFinalTarget() - amount;
     if (validateHeightRange(newHeight)) {
-        currentHeight = newHeight;
-        UtilityFunctions::print("Height lowered to ", currentHeight, " cm");
+        heightActuator.moveTo(newHeight);
+        startHeightMotion();
+        DEVICE_LOG_DEBUG("Height lowering to {} cm", newHeight);
     } else {
-        UtilityFunctions::print("Cannot lower height - would go below minimum (", minHeight, " cm)");
+        DEVICE_LOG_DEBUG("Cannot lower height - would go below minimum ({} cm)", minHeight);
     }
 }
 
 void Bed::setHeight(float height) {
     if (!isPoweredOn) {
-        UtilityFunctions::print("Cannot set height - bed is powered off");
+        DEVICE_LOG_DEBUG("Cannot set height - bed is powered off");
         return;
     }
     
     if (validateHeightRange(height)) {
-        currentHeight = height;
-        UtilityFunctions::print("Height set to ", currentHeight, " cm");
+        heightActuator.moveTo(height);
+        startHeightMotion();
+        DEVICE_LOG_DEBUG("Height moving to {} cm", height);
     } else {
-        UtilityFunctions::print("Invalid height. Range: ", minHeight, " - ", maxHeight, " cm");
+        DEVICE_LOG_DEBUG("Invalid height. Range: {} - {} cm", minHeight, maxHeight);
+    }
+}
+
+bool Bed::queueHeight(float height) {
+    if (!isPoweredOn) {
+        DEVICE_LOG_DEBUG("Cannot queue height - bed is powered off");
+        return false;
+    }
+    
+    if (!validateHeightRange(height) || !heightActuator.enqueue(height)) {
+        DEVICE_LOG_INFO("❌ Cannot queue height {} cm", height);
+        return false;
+    }
+    startHeightMotion();
+    return true;
+}
+
+void Bed::stopHeight() {
+    heightActuator.stop();
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_HEIGHT);
+    markChanged(BedChange::HEIGHT | BedChange::TARGET_HEIGHT);
+}
+
+void Bed::setMotionProfile(int profile, float maxVelocity, float maxAcceleration, float maxJerk) {
+    if (profile < MOTION_PROFILE_TRAPEZOIDAL || profile > MOTION_PROFILE_S_CURVE) {
+        DEVICE_LOG_INFO("❌ Unknown motion profile: {}", profile);
+        return;
+    }
+    
+    MotionLimits limits;
+    limits.profile = static_cast<MotionLimits::Profile>(profile);
+    limits.maxVelocity = maxVelocity;
+    limits.maxAcceleration = maxAcceleration;
+    limits.maxJerk = maxJerk;
+    if (!heightActuator.setLimits(limits)) {
+        DEVICE_LOG_INFO("❌ Motion limits must be finite");
+    }
+}
+
+void Bed::startHeightMotion() {
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_HEIGHT);
+    markChanged(BedChange::HEIGHT | BedChange::TARGET_HEIGHT);
+    
+    // A fleet steps managed lifts; otherwise the bed steps its own
+    if (heightActuator.isMoving() && !heightActuator.isManaged()) {
+        set_process(true);
     }
 }
 
@@ -92,48 +151,205 @@ void Bed::activateLights() {
     if (lightStrip) {
         lightStrip->activate();
     }
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_LIGHTS);
+    markChanged(BedChange::LIGHTS);
 }
 
 void Bed::deactivateLights() {
     if (lightStrip) {
         lightStrip->deactivate();
     }
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_LIGHTS);
+    markChanged(BedChange::LIGHTS);
 }
 
 void Bed::setLightBrightness(float intensity) {
     if (lightStrip) {
         lightStrip->setBrightness(intensity);
     }
+    markChanged(BedChange::LIGHTS);
 }
 
 void Bed::setLightColor(const LightColor& color) {
     if (lightStrip) {
         lightStrip->setColor(color);
     }
+    markChanged(BedChange::LIGHTS);
+}
+
+// GDScript wrapper: Godot colors are sRGB-encoded, like LightColor
+void Bed::setLightColor(const Color& color) {
+    setLightColor(PackedColor::fromFloat(color.r, color.g, color.b, color.a));
 }
 
 void Bed::triggerEmergency() {
-    UtilityFunctions::print("🚨 EMERGENCY TRIGGERED on ", getClassName().c_str());
+    DEVICE_LOG_ALERT("🚨 EMERGENCY TRIGGERED on {}", getClassName());
     if (lightStrip) {
         lightStrip->activateEmergencyMode();
     }
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_LIGHTS);
 }
 
 void Bed::clearEmergency() {
-    UtilityFunctions::print("Emergency cleared on ", getClassName().c_str());
+    DEVICE_LOG_ALERT("Emergency cleared on {}", getClassName());
     if (lightStrip) {
         lightStrip->deactivateEmergencyMode();
     }
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_LIGHTS);
+}
+
+bool Bed::setEmergencyDomain(int domain) {
+    EmergencyDomainTree& tree = EmergencyDomainTree::shared();
+    if (domain != EmergencyDomainTree::kNoDomain && !tree.isValid(domain)) {
+        DEVICE_LOG_INFO("❌ Unknown emergency domain: {}", domain);
+        return false;
+    }
+    
+    // A fresh subscription re-reads the whole path on the next poll
+    bool wasActive = emergencyDomain.active;
+    emergencyDomain = tree.subscribe(domain);
+    emergencyDomain.active = wasActive;
+    
+    // Only ever switched on here: scans or a moving lift may still need _process, which switches itself off
+    pollEmergencyDomain();
+    if (needsBedProcessing()) {
+        set_process(true);
+    }
+    markChanged(BedChange::EMERGENCY);
+    return true;
+}
+
+void Bed::pollEmergencyDomain() {
+    EmergencyDomainTree::Update update;
+    if (!EmergencyDomainTree::shared().poll(emergencyDomain, update)) {
+        return;
+    }
+    
+    if (emergencyDomain.active) {
+        triggerEmergency();
+    } else {
+        clearEmergency();
+    }
+}
+
+void Bed::processBedSystems(double delta) {
+    pollEmergencyDomain();
+    if (!heightActuator.isManaged() && heightActuator.isMoving()) {
+        heightActuator.advance(delta);
+        markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_HEIGHT);
+        markChanged(BedChange::HEIGHT);
+    }
+}
+
+bool Bed::needsBedProcessing() const {
+    return isInEmergencyDomain() || (heightActuator.isMoving() && !heightActuator.isManaged());
+}
+
+void Bed::_process(double delta) {
+    processBedSystems(delta);
+    if (!needsBedProcessing()) {
+        set_process(false);
+    }
+}
+
+void Bed::setLightLedCount(int count) {
+    if (lightStrip) {
+        lightStrip->setLedCount(static_cast<size_t>(std::max(0, count)));
+    }
+    markChanged(BedChange::LIGHTS);
+}
+
+int Bed::getLightLedCount() const {
+    return lightStrip ? static_cast<int>(lightStrip->getLedCount()) : 0;
+}
+
+void Bed::setLightEffect(int effect, float rateHz, float width, const Color& secondary) {
+    if (effect < LIGHT_EFFECT_SOLID || effect > LIGHT_EFFECT_STROBE) {
+        DEVICE_LOG_INFO("❌ Unknown light effect: {}", effect);
+        return;
+    }
+    if (!std::isfinite(rateHz) || !std::isfinite(width)) {
+        DEVICE_LOG_INFO("❌ Light effect rate and width must be finite");
+        return;
+    }
+    
+    if (lightStrip) {
+        LedEffect led;
+        led.type = static_cast<LedEffect::Type>(effect);
+        led.secondary = PackedColor::fromFloat(secondary.r, secondary.g, secondary.b).toLinear();
+        led.rateHz = rateHz;
+        led.width = width;
+        lightStrip->setEffect(led);
+    }
+    markChanged(BedChange::LIGHTS);
+}
+
+// One RGB8 texture row: get_light_led_count() pixels
+PackedByteArray Bed::renderLightFrame(double timeSeconds) {
+    PackedByteArray frame;
+    if (!lightStrip) {
+        return frame;
+    }
+    if (!std::isfinite(timeSeconds)) {
+        DEVICE_LOG_INFO("❌ Light frame time must be finite");
+        return frame;
+    }
+    
+    frame.resize(static_cast<int64_t>(lightStrip->getLedCount() * 3));
+    lightStrip->renderFrame(timeSeconds);
+    lightStrip->encodeFrame(frame.ptrw());
+    return frame;
+}
+
+bool Bed::playLightAnimation(const Ref<LightAnimation>& animation, double phaseOffset) {
+    if (animation.is_null()) {
+        DEVICE_LOG_INFO("❌ No light animation to play");
+        return false;
+    }
+    if (!animation->isCompiled() && !animation->compile()) {
+        return false;
+    }
+    
+    if (lightStrip) {
+        lightStrip->playTimeline(animation->getTimeline(), phaseOffset);
+    }
+    markChanged(BedChange::LIGHTS);
+    return true;
+}
+
+void Bed::stopLightAnimation() {
+    if (lightStrip) {
+        lightStrip->stopTimeline();
+    }
+    markChanged(BedChange::LIGHTS);
+}
+
+bool Bed::isLightAnimationPlaying() const {
+    return lightStrip && lightStrip->isTimelinePlaying();
+}
+
+PackedColorArray Bed::getLightColors() const {
+    PackedColorArray colors;
+    if (!lightStrip) {
+        return colors;
+    }
+    
+    const LedFramebuffer& framebuffer = lightStrip->getFramebuffer();
+    colors.resize(static_cast<int64_t>(framebuffer.size()));
+    ColorSpace::unpackFloats(framebuffer.data(), framebuffer.size(), reinterpret_cast<float*>(colors.ptrw()));
+    return colors;
 }
 
 void Bed::setTemperature(TemperatureControl::Mode mode) {
     if (!isPoweredOn) {
-        UtilityFunctions::print("Cannot set temperature - bed is powered off");
+        DEVICE_LOG_DEBUG("Cannot set temperature - bed is powered off");
         return;
     }
     
     if (temperatureControl) {
         temperatureControl->setTemperature(mode);
+        markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_TEMPERATURE);
+        markChanged(BedChange::TEMPERATURE);
     }
 }
 
@@ -163,34 +379,356 @@ float Bed::getTemperatureValue() const {
     return temperatureControl ? temperatureControl->getTemperatureValue() : 22.0f;
 }
 
+BedSnapshot Bed::makeSnapshot() const {
+    BedSnapshot snapshot;
+    snapshot.kind = getSnapshotKind();
+    snapshot.set(BedSnapshot::POWERED, isPoweredOn);
+    snapshot.temperatureMode = static_cast<uint8_t>(getCurrentTemperature());
+    
+    const MotionLimits& limits = heightActuator.getLimits();
+    snapshot.minHeight = minHeight;
+    snapshot.maxHeight = maxHeight;
+    snapshot.height = heightActuator.getPosition();
+    snapshot.targetHeight = heightActuator.getFinalTarget();
+    snapshot.motionProfile = static_cast<uint8_t>(limits.profile);
+    snapshot.maxVelocity = limits.maxVelocity;
+    snapshot.maxAcceleration = limits.maxAcceleration;
+    snapshot.maxJerk = limits.maxJerk;
+    
+    if (lightStrip) {
+        const NormalLightBehavior& lights = lightStrip->getNormalBehavior();
+        LedEffect effect = lights.getEffect();
+        snapshot.set(BedSnapshot::LIGHTS_ON, lights.isActivated());
+        snapshot.set(BedSnapshot::EMERGENCY, lightStrip->getMode() == LightStrip::Mode::EMERGENCY);
+        snapshot.lightColor = lights.getColor();
+        snapshot.lightBrightness = lights.getBrightnessSetting();
+        snapshot.lightEffect = static_cast<uint8_t>(effect.type);
+        snapshot.lightSecondary = ColorSpace::fromLinear(effect.secondary);
+        snapshot.lightRateHz = effect.rateHz;
+        snapshot.lightWidth = effect.width;
+        snapshot.ledCount = static_cast<uint32_t>(lightStrip->getLedCount());
+    }
+    snapshot.emergencyDomain = emergencyDomain.domain;
+    
+    captureSnapshot(snapshot); // Hook for subclasses
+    return snapshot;
+}
+
+bool Bed::restoreSnapshot(const BedSnapshot& snapshot) {
+    if (snapshot.kind != getSnapshotKind()) {
+        DEVICE_LOG_INFO("❌ Snapshot is of another bed kind ({}), not {}", static_cast<int>(snapshot.kind), getClassName());
+        return false;
+    }
+    if (!snapshot.isValid()) {
+        DEVICE_LOG_INFO("❌ Invalid snapshot for {}", getClassName());
+        return false;
+    }
+    
+    // Written directly: powerOn() and friends would re-apply their defaults over the saved state
+    isPoweredOn = snapshot.has(BedSnapshot::POWERED);
+    minHeight = snapshot.minHeight;
+    maxHeight = snapshot.maxHeight;
+    
+    MotionLimits limits;
+    limits.profile = static_cast<MotionLimits::Profile>(snapshot.motionProfile);
+    limits.maxVelocity = snapshot.maxVelocity;
+    limits.maxAcceleration = snapshot.maxAcceleration;
+    limits.maxJerk = snapshot.maxJerk;
+    heightActuator.setRange(minHeight, maxHeight);
+    heightActuator.setLimits(limits);
+    heightActuator.reset(snapshot.height);
+    if (isPoweredOn && snapshot.targetHeight != heightActuator.getPosition()) {
+        heightActuator.moveTo(snapshot.targetHeight);
+    }
+    
+    if (temperatureControl) {
+        temperatureControl->setTemperature(static_cast<TemperatureControl::Mode>(snapshot.temperatureMode));
+    }
+    
+    if (lightStrip) {
+        NormalLightBehavior& lights = lightStrip->getNormalBehavior();
+        LedEffect effect;
+        effect.type = static_cast<LedEffect::Type>(snapshot.lightEffect);
+        effect.secondary = snapshot.lightSecondary.toLinear();
+        effect.rateHz = snapshot.lightRateHz;
+        effect.width = snapshot.lightWidth;
+        lights.setColor(snapshot.lightColor);
+        lights.setBrightness(snapshot.lightBrightness);
+        lights.setEffect(effect);
+        if (snapshot.has(BedSnapshot::LIGHTS_ON)) {
+            lights.activate();
+        } else {
+            lights.deactivate();
+        }
+        lightStrip->setLedCount(snapshot.ledCount);
+        
+        bool emergency = snapshot.has(BedSnapshot::EMERGENCY);
+        if (emergency != (lightStrip->getMode() == LightStrip::Mode::EMERGENCY)) {
+            if (emergency) {
+                lightStrip->activateEmergencyMode();
+            } else {
+                lightStrip->deactivateEmergencyMode();
+            }
+        }
+    }
+    
+    if (snapshot.emergencyDomain != emergencyDomain.domain) {
+        setEmergencyDomain(snapshot.emergencyDomain);
+    }
+    
+    applySnapshot(snapshot); // Hook for subclasses
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_ALL);
+    markChanged(BedChange::ALL);
+    startHeightMotion();
+    return true;
+}
+
+PackedByteArray Bed::saveSnapshot() const {
+    BedSnapshot snapshot = makeSnapshot();
+    std::vector<uint8_t> encoded = BedSnapshotFormat::encodeRecords(&snapshot, 1);
+    PackedByteArray bytes;
+    bytes.resize(static_cast<int64_t>(encoded.size()));
+    std::memcpy(bytes.ptrw(), encoded.data(), encoded.size());
+    return bytes;
+}
+
+bool Bed::loadSnapshot(const PackedByteArray& bytes) {
+    size_t count = 0;
+    const BedSnapshot* records = BedSnapshotFormat::decodeRecords(bytes.ptr(), static_cast<size_t>(bytes.size()), count);
+    if (!records || count != 1) {
+        DEVICE_LOG_INFO("❌ Not a single-bed snapshot ({} bytes)", bytes.size());
+        return false;
+    }
+    
+    // Byte arrays carry no alignment promise, so the record is copied out
+    BedSnapshot snapshot;
+    std::memcpy(&snapshot, records, sizeof(snapshot));
+    return restoreSnapshot(snapshot);
+}
+
+bool Bed::saveSnapshots(const Array& beds, const String& path) {
+    std::vector<BedSnapshot> records;
+    records.reserve(static_cast<size_t>(beds.size()));
+    for (int64_t i = 0; i < beds.size(); ++i) {
+        const Bed* bed = Object::cast_to<Bed>(static_cast<Object*>(beds[i]));
+        if (!bed) {
+            DEVICE_LOG_INFO("❌ Snapshot entry {} is not a Bed", i);
+            return false;
+        }
+        records.push_back(bed->makeSnapshot());
+    }
+    
+    String filePath = ProjectSettings::get_singleton()->globalize_path(path);
+    return BedSnapshotFormat::writeRecords(filePath.utf8().get_data(), records.data(), records.size());
+}
+
+int Bed::loadSnapshots(const Array& beds, const String& path) {
+    String filePath = ProjectSettings::get_singleton()->globalize_path(path);
+    BedSnapshotMapping mapping;
+    if (!mapping.open(filePath.utf8().get_data(), BedSnapshotFormat::Payload::BED_RECORDS)) {
+        return -1;
+    }
+    
+    // Records are used in place; entry i of the file restores beds[i]
+    const BedSnapshot* records = mapping.getRecords();
+    size_t count = std::min(mapping.getCount(), static_cast<size_t>(beds.size()));
+    int restored = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Bed* bed = Object::cast_to<Bed>(static_cast<Object*>(beds[static_cast<int64_t>(i)]));
+        if (bed && bed->restoreSnapshot(records[i])) {
+            ++restored;
+        }
+    }
+    if (mapping.getCount() != static_cast<size_t>(beds.size())) {
+        DEVICE_LOG_INFO("❌ Snapshot holds {} beds, {} given", mapping.getCount(), beds.size());
+    }
+    return restored;
+}
+
+PackedByteArray Bed::executeCommands(const PackedByteArray& commands) {
+    // A command is at least one byte, so the stream's size bounds the statuses
+    PackedByteArray statuses;
+    statuses.resize(commands.size());
+    size_t count = runBedCommands(commands.ptr(), static_cast<size_t>(commands.size()), statuses.ptrw(),
+                                  [this](const BedCommand& command) { return applyCommand(command); });
+    statuses.resize(static_cast<int64_t>(count));
+    return statuses;
+}
+
+BedCommand::Status Bed::applyCommand(const BedCommand& command) {
+    switch (command.opcode) {
+        case BedCommand::POWER_ON:
+            powerOn();
+            return BedCommand::OK;
+        case BedCommand::POWER_OFF:
+            powerOff();
+            return BedCommand::OK;
+        case BedCommand::SET_HEIGHT:
+        case BedCommand::RAISE_HEIGHT:
+        case BedCommand::LOWER_HEIGHT:
+        case BedCommand::QUEUE_HEIGHT: {
+            if (!isPoweredOn) {
+                return BedCommand::REJECTED;
+            }
+            
+            float target = command.value;
+            if (command.opcode == BedCommand::RAISE_HEIGHT) {
+                target = heightActuator.getFinalTarget() + command.value;
+            } else if (command.opcode == BedCommand::LOWER_HEIGHT) {
+                target = heightActuator.getFinalTarget() - command.value;
+            }
+            if (!validateHeightRange(target)) {
+                return BedCommand::INVALID_ARGUMENT;
+            }
+            
+            bool queued = command.opcode == BedCommand::QUEUE_HEIGHT;
+            if (queued ? !heightActuator.enqueue(target) : !heightActuator.moveTo(target)) {
+                return BedCommand::REJECTED;
+            }
+            startHeightMotion();
+            return BedCommand::OK;
+        }
+        case BedCommand::STOP_HEIGHT:
+            stopHeight();
+            return BedCommand::OK;
+        case BedCommand::SET_TEMPERATURE:
+            if (command.mode > TEMPERATURE_WARM) {
+                return BedCommand::INVALID_ARGUMENT;
+            }
+            if (!isPoweredOn) {
+                return BedCommand::REJECTED;
+            }
+            setTemperature(static_cast<int>(command.mode));
+            return BedCommand::OK;
+        case BedCommand::ACTIVATE_LIGHTS:
+            activateLights();
+            return BedCommand::OK;
+        case BedCommand::DEACTIVATE_LIGHTS:
+            deactivateLights();
+            return BedCommand::OK;
+        case BedCommand::SET_LIGHT_BRIGHTNESS:
+            if (std::isnan(command.value)) {
+                return BedCommand::INVALID_ARGUMENT;
+            }
+            setLightBrightness(command.value);
+            return BedCommand::OK;
+        case BedCommand::SET_LIGHT_COLOR:
+            setLightColor(command.color);
+            return BedCommand::OK;
+        case BedCommand::TRIGGER_EMERGENCY:
+            triggerEmergency();
+            return BedCommand::OK;
+        case BedCommand::CLEAR_EMERGENCY:
+            clearEmergency();
+            return BedCommand::OK;
+        default:
+            // Selecting beds means nothing to a single bed
+            return BedCommand::UNSUPPORTED;
+    }
+}
+
+void Bed::setLogLevel(int level) {
+    DeviceLog::setLevel(static_cast<LogLevel>(std::max(LOG_LEVEL_TRACE, std::min(LOG_LEVEL_ALERT, level))));
+}
+
+int Bed::getLogLevel() {
+    return static_cast<int>(DeviceLog::getLevel());
+}
+
 // Observer pattern implementation
 void Bed::onEmergencyActivated() {
-    UtilityFunctions::print("🚨 ", getClassName().c_str(), " responding to emergency activation");
+    DEVICE_LOG_ALERT("🚨 {} responding to emergency activation", getClassName());
+    markChanged(BedChange::EMERGENCY);
     // Additional emergency response can be added here
 }
 
 void Bed::onEmergencyDeactivated() {
-    UtilityFunctions::print("✅ ", getClassName().c_str(), " emergency response deactivated");
+    DEVICE_LOG_ALERT("✅ {} emergency response deactivated", getClassName());
+    markChanged(BedChange::EMERGENCY);
+}
+
+void Bed::performMaintenanceCheck() {
+    DEVICE_LOG_INFO("Starting maintenance check for {}", getClassName());
+    MaintenanceRecord record = inspectMaintenance();
+    DEVICE_LOG_INFO("Checking power system... {}", (record.status & MaintenanceRecord::STATUS_POWERED) ? "OK" : "OFF");
+    DEVICE_LOG_INFO("Checking height mechanism... {}", (record.faults & MaintenanceRecord::FAULT_HEIGHT) ? "ERROR" : "OK");
+    DEVICE_LOG_INFO("Checking light system... {}", (record.faults & MaintenanceRecord::FAULT_LIGHTS) ? "ERROR" : "OK");
+    DEVICE_LOG_INFO("Checking temperature system... {}",
+                    (record.faults & MaintenanceRecord::FAULT_TEMPERATURE) ? "ERROR" : "OK");
+    
+    // Subclass checks are reported by name
+    for (int bit = MaintenanceRecord::kFirstSensorFault; bit < MaintenanceRecord::kFaultCount; ++bit) {
+        if (record.faults & (1u << bit)) {
+            DEVICE_LOG_INFO("Checking {}... ERROR", MaintenanceSweep::getFaultName(bit));
+        }
+    }
+    DEVICE_LOG_INFO("Maintenance check completed for {}: {}", getClassName(), record.isHealthy() ? "OK" : "FAULTS");
+}
+
+Dictionary Bed::runMaintenanceSweep(const Array& beds) {
+    // Resolved on the main thread; the workers only read
+    std::vector<const Bed*> targets;
+    targets.reserve(static_cast<size_t>(beds.size()));
+    for (int64_t i = 0; i < beds.size(); ++i) {
+        const Bed* bed = Object::cast_to<Bed>(static_cast<Object*>(beds[i]));
+        if (!bed) {
+            // Skipping it would shift every later record onto the wrong bed
+            DEVICE_LOG_INFO("❌ Maintenance sweep entry {} is not a Bed", i);
+            return Dictionary();
+        }
+        targets.push_back(bed);
+    }
+    
+    std::vector<MaintenanceRecord> records;
+    MaintenanceSweep::Summary summary = MaintenanceSweep::run(
+        targets.size(), [&targets](size_t i) { return targets[i]->inspectMaintenance(); }, records,
+        &WorkerPool::shared());
+    DEVICE_LOG_INFO("🔧 Maintenance sweep: {} beds, {} with faults, {} us", summary.checked, summary.faulty(),
+                    summary.durationUs);
+    return makeMaintenanceReport(records, summary);
+}
+
+Dictionary Bed::makeMaintenanceReport(const std::vector<MaintenanceRecord>& records,
+                                      const MaintenanceSweep::Summary& summary) {
+    PackedInt64Array packed;
+    packed.resize(static_cast<int64_t>(records.size()));
+    int64_t* out = packed.ptrw();
+    for (size_t i = 0; i < records.size(); ++i) {
+        out[i] = static_cast<int64_t>(records[i].pack());
+    }
+    
+    Dictionary faultCounts;
+    for (int bit = 0; bit < MaintenanceRecord::kFaultCount; ++bit) {
+        faultCounts[MaintenanceSweep::getFaultName(bit)] = static_cast<int64_t>(summary.faultCounts[bit]);
+    }
+    
+    Dictionary report;
+    report["records"] = packed;
+    report["checked"] = static_cast<int64_t>(summary.checked);
+    report["healthy"] = static_cast<int64_t>(summary.healthy);
+    report["faulty"] = static_cast<int64_t>(summary.faulty());
+    report["fault_counts"] = faultCounts;
+    report["duration_us"] = static_cast<int64_t>(summary.durationUs);
+    return report;
 }
 
 // Template method implementation
-void Bed::checkPowerSystem() {
-    UtilityFunctions::print("Checking power system... ", isPoweredOn ? "OK" : "OFF");
+void Bed::checkPowerSystem(MaintenanceRecord& record) const {
+    record.recordPower(isPoweredOn);
 }
 
-void Bed::checkHeightMechanism() {
-    bool heightOK = currentHeight >= minHeight && currentHeight <= maxHeight;
-    UtilityFunctions::print("Checking height mechanism... ", heightOK ? "OK" : "ERROR");
+void Bed::checkHeightMechanism(MaintenanceRecord& record) const {
+    record.recordLift(getHeight(), minHeight, maxHeight, heightActuator.isMoving());
 }
 
-void Bed::checkLightSystem() {
-    bool lightOK = lightStrip != nullptr;
-    UtilityFunctions::print("Checking light system... ", lightOK ? "OK" : "ERROR");
+void Bed::checkLightSystem(MaintenanceRecord& record) const {
+    record.recordLights(lightStrip != nullptr, lightStrip && lightStrip->isEmergencyMode());
 }
 
-void Bed::checkTemperatureSystem() {
-    bool tempOK = temperatureControl != nullptr;
-    UtilityFunctions::print("Checking temperature system... ", tempOK ? "OK" : "ERROR");
+void Bed::checkTemperatureSystem(MaintenanceRecord& record) const {
+    record.recordTemperature(temperatureControl != nullptr,
+                             temperatureControl ? static_cast<uint8_t>(temperatureControl->getCurrentTemperature())
+                                                : MaintenanceRecord::kNoTemperature);
 }
 
 bool Bed::validateHeightRange(float height) const {
@@ -205,17 +743,122 @@ void Bed::_bind_methods() {
     ClassDB::bind_method(D_METHOD("lower_height", "amount"), &Bed::lowerHeight);
     ClassDB::bind_method(D_METHOD("set_height", "height"), &Bed::setHeight);
     ClassDB::bind_method(D_METHOD("get_height"), &Bed::getHeight);
+    ClassDB::bind_method(D_METHOD("queue_height", "height"), &Bed::queueHeight);
+    ClassDB::bind_method(D_METHOD("stop_height"), &Bed::stopHeight);
+    ClassDB::bind_method(D_METHOD("get_target_height"), &Bed::getTargetHeight);
+    ClassDB::bind_method(D_METHOD("get_height_velocity"), &Bed::getHeightVelocity);
+    ClassDB::bind_method(D_METHOD("is_height_moving"), &Bed::isHeightMoving);
+    ClassDB::bind_method(D_METHOD("set_motion_profile", "profile", "max_velocity", "max_acceleration", "max_jerk"),
+                         &Bed::setMotionProfile, DEFVAL(4.0f), DEFVAL(8.0f), DEFVAL(40.0f));
     ClassDB::bind_method(D_METHOD("activate_lights"), &Bed::activateLights);
     ClassDB::bind_method(D_METHOD("deactivate_lights"), &Bed::deactivateLights);
     ClassDB::bind_method(D_METHOD("set_light_brightness", "intensity"), &Bed::setLightBrightness);
+    ClassDB::bind_method(D_METHOD("set_light_color", "color"), static_cast<void (Bed::*)(const Color&)>(&Bed::setLightColor));
     ClassDB::bind_method(D_METHOD("set_temperature", "mode"), static_cast<void (Bed::*)(int)>(&Bed::setTemperature));
     ClassDB::bind_method(D_METHOD("trigger_emergency"), &Bed::triggerEmergency);
     ClassDB::bind_method(D_METHOD("clear_emergency"), &Bed::clearEmergency);
+    ClassDB::bind_method(D_METHOD("set_emergency_domain", "domain"), &Bed::setEmergencyDomain);
+    ClassDB::bind_method(D_METHOD("get_emergency_domain"), &Bed::getEmergencyDomain);
+    ClassDB::bind_method(D_METHOD("set_light_led_count", "count"), &Bed::setLightLedCount);
+    ClassDB::bind_method(D_METHOD("get_light_led_count"), &Bed::getLightLedCount);
+    ClassDB::bind_method(D_METHOD("set_light_effect", "effect", "rate_hz", "width", "secondary"), &Bed::setLightEffect,
+                         DEFVAL(1.0f), DEFVAL(0.0f), DEFVAL(Color(0, 0, 0)));
+    ClassDB::bind_method(D_METHOD("render_light_frame", "time_sec"), &Bed::renderLightFrame);
+    ClassDB::bind_method(D_METHOD("get_light_colors"), &Bed::getLightColors);
+    ClassDB::bind_method(D_METHOD("play_light_animation", "animation", "phase_offset"), &Bed::playLightAnimation, DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("stop_light_animation"), &Bed::stopLightAnimation);
+    ClassDB::bind_method(D_METHOD("is_light_animation_playing"), &Bed::isLightAnimationPlaying);
     ClassDB::bind_method(D_METHOD("perform_maintenance_check"), &Bed::performMaintenanceCheck);
+    ClassDB::bind_method(D_METHOD("get_maintenance_record"), &Bed::getMaintenanceRecord);
+    ClassDB::bind_method(D_METHOD("execute_commands", "commands"), &Bed::executeCommands);
+    ClassDB::bind_method(D_METHOD("save_snapshot"), &Bed::saveSnapshot);
+    ClassDB::bind_method(D_METHOD("load_snapshot", "bytes"), &Bed::loadSnapshot);
+    ClassDB::bind_method(D_METHOD("get_changed_properties"), &Bed::getChangedProperties);
     ClassDB::bind_method(D_METHOD("get_temperature_value"), &Bed::getTemperatureValue);
+    ClassDB::bind_static_method("Bed", D_METHOD("set_log_level", "level"), &Bed::setLogLevel);
+    ClassDB::bind_static_method("Bed", D_METHOD("get_log_level"), &Bed::getLogLevel);
+    ClassDB::bind_static_method("Bed", D_METHOD("run_maintenance_sweep", "beds"), &Bed::runMaintenanceSweep);
+    ClassDB::bind_static_method("Bed", D_METHOD("save_snapshots", "beds", "path"), &Bed::saveSnapshots);
+    ClassDB::bind_static_method("Bed", D_METHOD("load_snapshots", "beds", "path"), &Bed::loadSnapshots);
     
     // Temperature control constants
     BIND_CONSTANT(TEMPERATURE_COLD);
     BIND_CONSTANT(TEMPERATURE_NEUTRAL);
     BIND_CONSTANT(TEMPERATURE_WARM);
+    
+    // Device log level constants
+    BIND_CONSTANT(LOG_LEVEL_TRACE);
+    BIND_CONSTANT(LOG_LEVEL_DEBUG);
+    BIND_CONSTANT(LOG_LEVEL_INFO);
+    BIND_CONSTANT(LOG_LEVEL_ALERT);
+    
+    // LED effect constants
+    BIND_CONSTANT(LIGHT_EFFECT_SOLID);
+    BIND_CONSTANT(LIGHT_EFFECT_GRADIENT);
+    BIND_CONSTANT(LIGHT_EFFECT_PULSE);
+    BIND_CONSTANT(LIGHT_EFFECT_CHASE);
+    BIND_CONSTANT(LIGHT_EFFECT_STROBE);
+    
+    // Motion profile constants
+    BIND_CONSTANT(MOTION_PROFILE_TRAPEZOIDAL);
+    BIND_CONSTANT(MOTION_PROFILE_S_CURVE);
+    
+    // Maintenance record bits
+    BIND_CONSTANT(MAINTENANCE_FAULT_HEIGHT);
+    BIND_CONSTANT(MAINTENANCE_FAULT_LIGHTS);
+    BIND_CONSTANT(MAINTENANCE_FAULT_TEMPERATURE);
+    BIND_CONSTANT(MAINTENANCE_FAULT_OCCUPANCY_SENSOR);
+    BIND_CONSTANT(MAINTENANCE_FAULT_MEDICAL_DEVICE);
+    BIND_CONSTANT(MAINTENANCE_FAULT_POSITIONING);
+    BIND_CONSTANT(MAINTENANCE_STATUS_POWERED);
+    BIND_CONSTANT(MAINTENANCE_STATUS_HEIGHT_MOVING);
+    BIND_CONSTANT(MAINTENANCE_STATUS_EMERGENCY);
+    BIND_CONSTANT(MAINTENANCE_STATUS_OCCUPIED);
+    BIND_CONSTANT(MAINTENANCE_STATUS_COMFORT_MODE);
+    BIND_CONSTANT(MAINTENANCE_STATUS_STERILE);
+    BIND_CONSTANT(MAINTENANCE_STATUS_PROCEDURE);
+
+    // Command stream constants
+    BIND_CONSTANT(COMMAND_POWER_ON);
+    BIND_CONSTANT(COMMAND_POWER_OFF);
+    BIND_CONSTANT(COMMAND_SET_HEIGHT);
+    BIND_CONSTANT(COMMAND_RAISE_HEIGHT);
+    BIND_CONSTANT(COMMAND_LOWER_HEIGHT);
+    BIND_CONSTANT(COMMAND_QUEUE_HEIGHT);
+    BIND_CONSTANT(COMMAND_STOP_HEIGHT);
+    BIND_CONSTANT(COMMAND_SET_TEMPERATURE);
+    BIND_CONSTANT(COMMAND_ACTIVATE_LIGHTS);
+    BIND_CONSTANT(COMMAND_DEACTIVATE_LIGHTS);
+    BIND_CONSTANT(COMMAND_SET_LIGHT_BRIGHTNESS);
+    BIND_CONSTANT(COMMAND_SET_LIGHT_COLOR);
+    BIND_CONSTANT(COMMAND_TRIGGER_EMERGENCY);
+    BIND_CONSTANT(COMMAND_CLEAR_EMERGENCY);
+    BIND_CONSTANT(COMMAND_SELECT_BED);
+    BIND_CONSTANT(COMMAND_SELECT_ALL);
+    BIND_CONSTANT(COMMAND_STATUS_OK);
+    BIND_CONSTANT(COMMAND_STATUS_REJECTED);
+    BIND_CONSTANT(COMMAND_STATUS_INVALID_ARGUMENT);
+    BIND_CONSTANT(COMMAND_STATUS_UNSUPPORTED);
+    BIND_CONSTANT(COMMAND_STATUS_NO_TARGET);
+    BIND_CONSTANT(COMMAND_STATUS_UNKNOWN_OPCODE);
+    BIND_CONSTANT(COMMAND_STATUS_TRUNCATED);
+    
+    // Property change bits
+    BIND_CONSTANT(CHANGE_POWER);
+    BIND_CONSTANT(CHANGE_HEIGHT);
+    BIND_CONSTANT(CHANGE_TARGET_HEIGHT);
+    BIND_CONSTANT(CHANGE_TEMPERATURE);
+    BIND_CONSTANT(CHANGE_LIGHTS);
+    BIND_CONSTANT(CHANGE_EMERGENCY);
+    BIND_CONSTANT(CHANGE_OCCUPANCY);
+    BIND_CONSTANT(CHANGE_COMFORT_MODE);
+    BIND_CONSTANT(CHANGE_STERILE_MODE);
+    BIND_CONSTANT(CHANGE_PROCEDURE);
+    BIND_CONSTANT(CHANGE_VITALS);
+    BIND_CONSTANT(CHANGE_SCANNER);
+    BIND_CONSTANT(CHANGE_DEVICE_POSITION);
+    BIND_CONSTANT(CHANGE_ALL);
+    
+    // Emitted by a BedChangeNotifier at most once per frame, with every CHANGE_* bit since the last one
+    ADD_SIGNAL(MethodInfo("state_changed", PropertyInfo(Variant::INT, "changes")));
 }
\ No newline at end of file
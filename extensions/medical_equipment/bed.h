@@ -2,8 +2,23 @@
 #define BED_H
 
 #include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include "light_strip.h"
+#include "light_animation.h"
+#include "emergency_domain.h"
+#include "bed_commands.h"
+#include "bed_snapshot.h"
+#include "height_actuator.h"
+#include "maintenance_scheduler.h"
+#include "change_batcher.h"
+#include "device_log.h"
 #include <memory>
 
 using namespace godot;
@@ -32,15 +47,15 @@ public:
         switch (mode) {
             case Mode::COLD:
                 temperature = 18.0f;
-                UtilityFunctions::print("Temperature set to COLD (18°C)");
+                DEVICE_LOG_DEBUG("Temperature set to COLD (18°C)");
                 break;
             case Mode::NEUTRAL:
                 temperature = 22.0f;
-                UtilityFunctions::print("Temperature set to NEUTRAL (22°C)");
+                DEVICE_LOG_DEBUG("Temperature set to NEUTRAL (22°C)");
                 break;
             case Mode::WARM:
                 temperature = 26.0f;
-                UtilityFunctions::print("Temperature set to WARM (26°C)");
+                DEVICE_LOG_DEBUG("Temperature set to WARM (26°C)");
                 break;
         }
     }
@@ -50,7 +65,7 @@ public:
 };
 
 // Template Method Pattern - Base Bed Class
-class Bed : public Node, public EmergencyObserver {
+class Bed : public Node, public EmergencyObserver, public MaintenanceTarget, public ChangeTracker {
     GDCLASS(Bed, Node)
 
 public:
@@ -59,53 +74,189 @@ public:
     static const int TEMPERATURE_NEUTRAL = 1;
     static const int TEMPERATURE_WARM = 2;
 
+    // Device log level constants for GDScript binding
+    static const int LOG_LEVEL_TRACE = 0;
+    static const int LOG_LEVEL_DEBUG = 1;
+    static const int LOG_LEVEL_INFO = 2;
+    static const int LOG_LEVEL_ALERT = 3;
+
+    // LED effect constants for GDScript binding
+    static const int LIGHT_EFFECT_SOLID = static_cast<int>(LedEffect::Type::SOLID);
+    static const int LIGHT_EFFECT_GRADIENT = static_cast<int>(LedEffect::Type::GRADIENT);
+    static const int LIGHT_EFFECT_PULSE = static_cast<int>(LedEffect::Type::PULSE);
+    static const int LIGHT_EFFECT_CHASE = static_cast<int>(LedEffect::Type::CHASE);
+    static const int LIGHT_EFFECT_STROBE = static_cast<int>(LedEffect::Type::STROBE);
+
+    // Motion profile constants for GDScript binding
+    static const int MOTION_PROFILE_TRAPEZOIDAL = static_cast<int>(MotionLimits::Profile::TRAPEZOIDAL);
+    static const int MOTION_PROFILE_S_CURVE = static_cast<int>(MotionLimits::Profile::S_CURVE);
+
+    // Maintenance record bits for GDScript binding (see MaintenanceRecord::pack)
+    static const int MAINTENANCE_FAULT_HEIGHT = MaintenanceRecord::FAULT_HEIGHT;
+    static const int MAINTENANCE_FAULT_LIGHTS = MaintenanceRecord::FAULT_LIGHTS;
+    static const int MAINTENANCE_FAULT_TEMPERATURE = MaintenanceRecord::FAULT_TEMPERATURE;
+    static const int MAINTENANCE_FAULT_OCCUPANCY_SENSOR = MaintenanceRecord::FAULT_OCCUPANCY_SENSOR;
+    static const int MAINTENANCE_FAULT_MEDICAL_DEVICE = MaintenanceRecord::FAULT_MEDICAL_DEVICE;
+    static const int MAINTENANCE_FAULT_POSITIONING = MaintenanceRecord::FAULT_POSITIONING;
+    static const int MAINTENANCE_STATUS_POWERED = MaintenanceRecord::STATUS_POWERED;
+    static const int MAINTENANCE_STATUS_HEIGHT_MOVING = MaintenanceRecord::STATUS_HEIGHT_MOVING;
+    static const int MAINTENANCE_STATUS_EMERGENCY = MaintenanceRecord::STATUS_EMERGENCY;
+    static const int MAINTENANCE_STATUS_OCCUPIED = MaintenanceRecord::STATUS_OCCUPIED;
+    static const int MAINTENANCE_STATUS_COMFORT_MODE = MaintenanceRecord::STATUS_COMFORT_MODE;
+    static const int MAINTENANCE_STATUS_STERILE = MaintenanceRecord::STATUS_STERILE;
+    static const int MAINTENANCE_STATUS_PROCEDURE = MaintenanceRecord::STATUS_PROCEDURE;
+
+    // Command stream opcodes and statuses for GDScript binding (see BedCommand)
+    static const int COMMAND_POWER_ON = BedCommand::POWER_ON;
+    static const int COMMAND_POWER_OFF = BedCommand::POWER_OFF;
+    static const int COMMAND_SET_HEIGHT = BedCommand::SET_HEIGHT;
+    static const int COMMAND_RAISE_HEIGHT = BedCommand::RAISE_HEIGHT;
+    static const int COMMAND_LOWER_HEIGHT = BedCommand::LOWER_HEIGHT;
+    static const int COMMAND_QUEUE_HEIGHT = BedCommand::QUEUE_HEIGHT;
+    static const int COMMAND_STOP_HEIGHT = BedCommand::STOP_HEIGHT;
+    static const int COMMAND_SET_TEMPERATURE = BedCommand::SET_TEMPERATURE;
+    static const int COMMAND_ACTIVATE_LIGHTS = BedCommand::ACTIVATE_LIGHTS;
+    static const int COMMAND_DEACTIVATE_LIGHTS = BedCommand::DEACTIVATE_LIGHTS;
+    static const int COMMAND_SET_LIGHT_BRIGHTNESS = BedCommand::SET_LIGHT_BRIGHTNESS;
+    static const int COMMAND_SET_LIGHT_COLOR = BedCommand::SET_LIGHT_COLOR;
+    static const int COMMAND_TRIGGER_EMERGENCY = BedCommand::TRIGGER_EMERGENCY;
+    static const int COMMAND_CLEAR_EMERGENCY = BedCommand::CLEAR_EMERGENCY;
+    static const int COMMAND_SELECT_BED = BedCommand::SELECT_BED;
+    static const int COMMAND_SELECT_ALL = BedCommand::SELECT_ALL;
+    static const int COMMAND_STATUS_OK = BedCommand::OK;
+    static const int COMMAND_STATUS_REJECTED = BedCommand::REJECTED;
+    static const int COMMAND_STATUS_INVALID_ARGUMENT = BedCommand::INVALID_ARGUMENT;
+    static const int COMMAND_STATUS_UNSUPPORTED = BedCommand::UNSUPPORTED;
+    static const int COMMAND_STATUS_NO_TARGET = BedCommand::NO_TARGET;
+    static const int COMMAND_STATUS_UNKNOWN_OPCODE = BedCommand::UNKNOWN_OPCODE;
+    static const int COMMAND_STATUS_TRUNCATED = BedCommand::TRUNCATED;
+
+    // Property change bits for GDScript binding (see BedChange and BedChangeNotifier)
+    static const int CHANGE_POWER = BedChange::POWER;
+    static const int CHANGE_HEIGHT = BedChange::HEIGHT;
+    static const int CHANGE_TARGET_HEIGHT = BedChange::TARGET_HEIGHT;
+    static const int CHANGE_TEMPERATURE = BedChange::TEMPERATURE;
+    static const int CHANGE_LIGHTS = BedChange::LIGHTS;
+    static const int CHANGE_EMERGENCY = BedChange::EMERGENCY;
+    static const int CHANGE_OCCUPANCY = BedChange::OCCUPANCY;
+    static const int CHANGE_COMFORT_MODE = BedChange::COMFORT_MODE;
+    static const int CHANGE_STERILE_MODE = BedChange::STERILE_MODE;
+    static const int CHANGE_PROCEDURE = BedChange::PROCEDURE;
+    static const int CHANGE_VITALS = BedChange::VITALS;
+    static const int CHANGE_SCANNER = BedChange::SCANNER;
+    static const int CHANGE_DEVICE_POSITION = BedChange::DEVICE_POSITION;
+    static const int CHANGE_ALL = BedChange::ALL;
+
 protected:
     std::unique_ptr<LightStrip> lightStrip;
     std::unique_ptr<TemperatureControl> temperatureControl;
-    float currentHeight; // in cm
+    HeightActuator heightActuator; // position in cm
     float minHeight;
     float maxHeight;
     bool isPoweredOn;
+    EmergencyDomainTree::Subscription emergencyDomain;
 
 public:
     Bed();
     virtual ~Bed() = default;
 
-    // Template Method - defines the algorithm structure
-    void performMaintenanceCheck() {
-        UtilityFunctions::print("Starting maintenance check for ", getClassName().c_str());
-        checkPowerSystem();
-        checkHeightMechanism();
-        checkLightSystem();
-        checkTemperatureSystem();
-        performSpecificChecks(); // Hook method for subclasses
-        UtilityFunctions::print("Maintenance check completed for ", getClassName().c_str());
+    // Template Method - defines the algorithm structure; read-only, so sweeps run it on worker threads.
+    // Only the given subsystems are checked; the rest of record is kept.
+    MaintenanceRecord inspectMaintenance(uint8_t subsystems = MaintenanceRecord::SUBSYSTEM_ALL,
+                                         MaintenanceRecord record = MaintenanceRecord()) const {
+        record.clearSubsystems(subsystems);
+        if (subsystems & MaintenanceRecord::SUBSYSTEM_POWER) checkPowerSystem(record);
+        if (subsystems & MaintenanceRecord::SUBSYSTEM_HEIGHT) checkHeightMechanism(record);
+        if (subsystems & MaintenanceRecord::SUBSYSTEM_LIGHTS) checkLightSystem(record);
+        if (subsystems & MaintenanceRecord::SUBSYSTEM_TEMPERATURE) checkTemperatureSystem(record);
+        if (subsystems & MaintenanceRecord::SUBSYSTEM_DEVICE) performSpecificChecks(record); // Hook method for subclasses
+        return record;
     }
+    
+    // Inspects this bed and logs the outcome
+    void performMaintenanceCheck();
+    int64_t getMaintenanceRecord() const { return static_cast<int64_t>(inspectMaintenance().pack()); }
+    
+    // Checks every Bed in the array on the worker pool; records[i] is beds[i], plus a summary, nothing
+    // logged per bed. Empty if any entry is not a Bed
+    static Dictionary runMaintenanceSweep(const Array& beds);
+    static Dictionary makeMaintenanceReport(const std::vector<MaintenanceRecord>& records,
+                                            const MaintenanceSweep::Summary& summary);
 
     // Common operations for all beds
     virtual void powerOn();
     virtual void powerOff();
     
-    // Height control
+    // Height control: the lift moves there along its motion profile
     void raiseHeight(float amount);
     void lowerHeight(float amount);
     void setHeight(float height);
-    float getHeight() const { return currentHeight; }
+    bool queueHeight(float height);
+    void stopHeight();
+    float getHeight() const { return heightActuator.getPosition(); }
+    float getTargetHeight() const { return heightActuator.getFinalTarget(); }
+    float getHeightVelocity() const { return heightActuator.getVelocity(); }
+    bool isHeightMoving() const { return heightActuator.isMoving(); }
+    void setMotionProfile(int profile, float maxVelocity, float maxAcceleration, float maxJerk);
+    HeightActuator& getHeightActuator() { return heightActuator; }
     
     // Light control
     void activateLights();
     void deactivateLights();
     void setLightBrightness(float intensity);
     void setLightColor(const LightColor& color);
+    void setLightColor(const Color& color); // GDScript wrapper
     void triggerEmergency();
     void clearEmergency();
     
+    // Hierarchical emergencies: broadcasts to the domain or any ancestor reach this bed on its next tick
+    bool setEmergencyDomain(int domain);
+    int getEmergencyDomain() const { return emergencyDomain.domain; }
+    bool isInEmergencyDomain() const { return emergencyDomain.domain != EmergencyDomainTree::kNoDomain; }
+    
+    void _process(double delta) override;
+    
+    // Per-LED output of the light strip
+    void setLightLedCount(int count);
+    int getLightLedCount() const;
+    void setLightEffect(int effect, float rateHz, float width, const Color& secondary);
+    PackedByteArray renderLightFrame(double timeSeconds);
+    PackedColorArray getLightColors() const; // last rendered frame, before brightness
+    
+    // Keyframed animation shared with other beds; phaseOffset shifts this bed's copy in time
+    bool playLightAnimation(const Ref<LightAnimation>& animation, double phaseOffset);
+    void stopLightAnimation();
+    bool isLightAnimationPlaying() const;
+    LightStrip* getLightStrip() { return lightStrip.get(); }
+    
     // Temperature control
     void setTemperature(TemperatureControl::Mode mode);
     void setTemperature(int mode); // GDScript wrapper
     TemperatureControl::Mode getCurrentTemperature() const;
     float getTemperatureValue() const;
     
+    // Complete device state as a BedSnapshot record; restoring writes state
+    // directly, without the defaults that power and mode changes apply
+    BedSnapshot makeSnapshot() const;
+    bool restoreSnapshot(const BedSnapshot& snapshot);
+    PackedByteArray saveSnapshot() const;
+    bool loadSnapshot(const PackedByteArray& bytes);
+    
+    // Fleet snapshots: records for every bed in one contiguous file, restored
+    // from a read-only mapping in array order; returns beds restored, or -1
+    static bool saveSnapshots(const Array& beds, const String& path);
+    static int loadSnapshots(const Array& beds, const String& path);
+    
+    // CHANGE_* bits changed since a BedChangeNotifier last reported this bed
+    int64_t getChangedProperties() const { return static_cast<int64_t>(getPendingChanges()); }
+    
+    // Runs a whole BedCommand stream in one call; returns one status byte per command
+    PackedByteArray executeCommands(const PackedByteArray& commands);
+    
+    // Device logging verbosity, shared by all beds
+    static void setLogLevel(int level);
+    static int getLogLevel();
+    
     // Observer pattern implementation
     void onEmergencyActivated() override;
     void onEmergencyDeactivated() override;
@@ -115,21 +266,39 @@ public:
 
 protected:
     // Hook methods for subclasses to override
-    virtual void performSpecificChecks() {} // Empty default implementation
+    virtual void performSpecificChecks(MaintenanceRecord& record) const {} // Empty default implementation
     virtual void onPowerOn() {} // Called when powered on
     virtual void onPowerOff() {} // Called when powered off
     
+    // Snapshot hooks: subclasses add their own state to the record
+    virtual BedSnapshot::Kind getSnapshotKind() const { return BedSnapshot::GENERIC; }
+    virtual void captureSnapshot(BedSnapshot& snapshot) const {}
+    virtual void applySnapshot(const BedSnapshot& snapshot) {}
+    
     // Template method steps
-    virtual void checkPowerSystem();
-    virtual void checkHeightMechanism();
-    virtual void checkLightSystem();
-    virtual void checkTemperatureSystem();
+    virtual void checkPowerSystem(MaintenanceRecord& record) const;
+    virtual void checkHeightMechanism(MaintenanceRecord& record) const;
+    virtual void checkLightSystem(MaintenanceRecord& record) const;
+    virtual void checkTemperatureSystem(MaintenanceRecord& record) const;
+    
+    // Applies any domain broadcast or clear since the last tick
+    void pollEmergencyDomain();
+    
+    MaintenanceRecord inspectSubsystems(uint8_t subsystems, MaintenanceRecord previous) const override {
+        return inspectMaintenance(subsystems, previous);
+    }
+    
+    // Per-frame work of the base bed: domain emergencies and, unless a fleet steps it, the lift
+    void processBedSystems(double delta);
+    bool needsBedProcessing() const;
     
     static void _bind_methods();
 
 private:
     void initializeComponents();
     bool validateHeightRange(float height) const;
+    void startHeightMotion();
+    BedCommand::Status applyCommand(const BedCommand& command);
 };
 
 #endif // BED_H
\ No newline at end of file
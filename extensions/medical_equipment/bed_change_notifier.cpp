@@ -0,0 +1,89 @@
+#include "bed_change_notifier.h"
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+BedChangeNotifier::BedChangeNotifier() {
+    set_process_priority(PROCESS_PRIORITY);
+    DEVICE_LOG_INFO("📣 BedChangeNotifier created");
+}
+
+bool BedChangeNotifier::addBed(Node* bed) {
+    Bed* target = Object::cast_to<Bed>(bed);
+    if (!target) {
+        DEVICE_LOG_INFO("❌ BedChangeNotifier only accepts Bed nodes");
+        return false;
+    }
+    if (!batcher.add(target)) {
+        DEVICE_LOG_INFO("❌ Bed already reports to a BedChangeNotifier");
+        return false;
+    }
+    return true;
+}
+
+bool BedChangeNotifier::removeBed(Node* bed) {
+    Bed* target = Object::cast_to<Bed>(bed);
+    return target && batcher.remove(target);
+}
+
+void BedChangeNotifier::clearBeds() {
+    batcher.clear();
+}
+
+int BedChangeNotifier::flush() {
+    const std::vector<ChangeBatcher::Change>& changes = batcher.flush();
+    if (changes.empty()) {
+        return 0;
+    }
+
+    // Copied out before anything is emitted: handlers may change beds or remove them
+    Array beds;
+    PackedInt32Array properties;
+    beds.resize(static_cast<int64_t>(changes.size()));
+    properties.resize(static_cast<int64_t>(changes.size()));
+    int32_t* out = properties.ptrw();
+    for (size_t i = 0; i < changes.size(); ++i) {
+        beds[static_cast<int64_t>(i)] = dynamic_cast<Bed*>(changes[i].tracker);
+        out[i] = static_cast<int32_t>(changes[i].properties);
+    }
+
+    const int32_t* bits = properties.ptr();
+    for (int64_t i = 0; i < beds.size(); ++i) {
+        Bed* bed = Object::cast_to<Bed>(static_cast<Object*>(beds[i]));
+        if (bed) {
+            bed->emit_signal("state_changed", static_cast<int64_t>(bits[i]));
+        }
+    }
+    emit_signal("beds_changed", beds, properties);
+    return static_cast<int>(beds.size());
+}
+
+Dictionary BedChangeNotifier::getStats() const {
+    const ChangeBatcher::Stats& stats = batcher.getStats();
+    Dictionary result;
+    result["beds"] = static_cast<int64_t>(stats.trackers);
+    result["pending"] = static_cast<int64_t>(stats.pending);
+    result["last_frame_changes"] = static_cast<int64_t>(stats.lastFlushChanges);
+    result["total_changes"] = static_cast<int64_t>(stats.totalChanges);
+    result["total_marks"] = static_cast<int64_t>(stats.totalMarks);
+    result["frames"] = static_cast<int64_t>(stats.flushes);
+    return result;
+}
+
+void BedChangeNotifier::_process(double delta) {
+    flush();
+}
+
+void BedChangeNotifier::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_bed", "bed"), &BedChangeNotifier::addBed);
+    ClassDB::bind_method(D_METHOD("remove_bed", "bed"), &BedChangeNotifier::removeBed);
+    ClassDB::bind_method(D_METHOD("clear_beds"), &BedChangeNotifier::clearBeds);
+    ClassDB::bind_method(D_METHOD("get_bed_count"), &BedChangeNotifier::getBedCount);
+    ClassDB::bind_method(D_METHOD("flush"), &BedChangeNotifier::flush);
+    ClassDB::bind_method(D_METHOD("get_stats"), &BedChangeNotifier::getStats);
+
+    BIND_CONSTANT(PROCESS_PRIORITY);
+
+    ADD_SIGNAL(MethodInfo("beds_changed", PropertyInfo(Variant::ARRAY, "beds"),
+                          PropertyInfo(Variant::PACKED_INT32_ARRAY, "changes")));
+}
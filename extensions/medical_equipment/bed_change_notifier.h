@@ -0,0 +1,52 @@
+#ifndef BED_CHANGE_NOTIFIER_H
+#define BED_CHANGE_NOTIFIER_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include "bed.h"
+#include "change_batcher.h"
+
+using namespace godot;
+
+/**
+ * @class BedChangeNotifier
+ * @brief Godot node reporting its beds' property changes once per frame
+ *
+ * Beds flag the Bed.CHANGE_* properties they change; at the end of each
+ * frame the node emits state_changed(changes) on every changed bed and
+ * then one beds_changed(beds, changes) for the whole batch, so UI work
+ * follows the number of changed beds rather than beds times properties.
+ * Nothing is emitted for a frame without changes.
+ */
+class BedChangeNotifier : public Node {
+    GDCLASS(BedChangeNotifier, Node)
+
+public:
+    // After nodes at the default priority, so their changes make this frame's batch
+    static const int PROCESS_PRIORITY = 1000000;
+
+private:
+    ChangeBatcher batcher;
+
+public:
+    BedChangeNotifier();
+    ~BedChangeNotifier() = default;
+
+    bool addBed(Node* bed);
+    bool removeBed(Node* bed);
+    void clearBeds();
+    int getBedCount() const { return static_cast<int>(batcher.size()); }
+
+    // Emits the pending batch now; returns the number of changed beds
+    int flush();
+    Dictionary getStats() const;
+
+    void _process(double delta) override;
+
+protected:
+    static void _bind_methods();
+};
+
+#endif // BED_CHANGE_NOTIFIER_H
@@ -0,0 +1,127 @@
+#include "bed_commands.h"
+#include <cstring>
+
+namespace {
+
+uint32_t readU32(const uint8_t* bytes) {
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+float readF32(const uint8_t* bytes) {
+    uint32_t bits = readU32(bytes);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+int BedCommand::getArgumentSize(uint8_t opcode) {
+    switch (opcode) {
+        case POWER_ON:
+        case POWER_OFF:
+        case STOP_HEIGHT:
+        case ACTIVATE_LIGHTS:
+        case DEACTIVATE_LIGHTS:
+        case TRIGGER_EMERGENCY:
+        case CLEAR_EMERGENCY:
+        case SELECT_ALL:
+            return 0;
+        case SET_TEMPERATURE:
+            return 1;
+        case SET_HEIGHT:
+        case RAISE_HEIGHT:
+        case LOWER_HEIGHT:
+        case QUEUE_HEIGHT:
+        case SET_LIGHT_BRIGHTNESS:
+        case SET_LIGHT_COLOR:
+        case SELECT_BED:
+            return 4;
+        default:
+            return -1;
+    }
+}
+
+bool BedCommandReader::next(BedCommand& command, BedCommand::Status& status) {
+    if (failed || offset >= size) {
+        return false;
+    }
+
+    uint8_t opcode = data[offset];
+    int arguments = BedCommand::getArgumentSize(opcode);
+    if (arguments < 0) {
+        status = BedCommand::UNKNOWN_OPCODE;
+        failed = true;
+        return true;
+    }
+    if (size - offset - 1 < static_cast<size_t>(arguments)) {
+        status = BedCommand::TRUNCATED;
+        failed = true;
+        return true;
+    }
+
+    const uint8_t* args = data + offset + 1;
+    command.opcode = static_cast<BedCommand::Opcode>(opcode);
+    switch (command.opcode) {
+        case BedCommand::SET_HEIGHT:
+        case BedCommand::RAISE_HEIGHT:
+        case BedCommand::LOWER_HEIGHT:
+        case BedCommand::QUEUE_HEIGHT:
+        case BedCommand::SET_LIGHT_BRIGHTNESS:
+            command.value = readF32(args);
+            break;
+        case BedCommand::SET_TEMPERATURE:
+            command.mode = args[0];
+            break;
+        case BedCommand::SET_LIGHT_COLOR:
+            command.color = PackedColor(args[0], args[1], args[2], args[3]);
+            break;
+        case BedCommand::SELECT_BED:
+            command.slot = readU32(args);
+            break;
+        default:
+            break;
+    }
+
+    offset += 1 + static_cast<size_t>(arguments);
+    status = BedCommand::OK;
+    return true;
+}
+
+BedCommandWriter& BedCommandWriter::opcode(BedCommand::Opcode code) {
+    bytes.push_back(code);
+    return *this;
+}
+
+BedCommandWriter& BedCommandWriter::withFloat(BedCommand::Opcode code, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bytes.push_back(code);
+    putU32(bits);
+    return *this;
+}
+
+BedCommandWriter& BedCommandWriter::setTemperature(uint8_t mode) {
+    bytes.push_back(BedCommand::SET_TEMPERATURE);
+    bytes.push_back(mode);
+    return *this;
+}
+
+BedCommandWriter& BedCommandWriter::setLightColor(PackedColor color) {
+    bytes.insert(bytes.end(), {BedCommand::SET_LIGHT_COLOR, color.r, color.g, color.b, color.a});
+    return *this;
+}
+
+BedCommandWriter& BedCommandWriter::selectBed(uint32_t slot) {
+    bytes.push_back(BedCommand::SELECT_BED);
+    putU32(slot);
+    return *this;
+}
+
+void BedCommandWriter::putU32(uint32_t value) {
+    bytes.push_back(static_cast<uint8_t>(value));
+    bytes.push_back(static_cast<uint8_t>(value >> 8));
+    bytes.push_back(static_cast<uint8_t>(value >> 16));
+    bytes.push_back(static_cast<uint8_t>(value >> 24));
+}
@@ -0,0 +1,146 @@
+#ifndef BED_COMMANDS_H
+#define BED_COMMANDS_H
+
+#include "packed_color.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct BedCommand
+ * @brief One decoded entry of a bed command stream
+ *
+ * A stream is a flat byte buffer: a one-byte opcode followed by its
+ * arguments, little-endian, with no padding. Floats are IEEE 754 binary32,
+ * as PackedByteArray.encode_float() writes them.
+ *
+ *   POWER_ON, POWER_OFF, STOP_HEIGHT, ACTIVATE_LIGHTS, DEACTIVATE_LIGHTS,
+ *   TRIGGER_EMERGENCY, CLEAR_EMERGENCY, SELECT_ALL      no arguments
+ *   SET_HEIGHT, RAISE_HEIGHT, LOWER_HEIGHT, QUEUE_HEIGHT,
+ *   SET_LIGHT_BRIGHTNESS                                 f32
+ *   SET_TEMPERATURE                                      u8 mode
+ *   SET_LIGHT_COLOR                                      u8 r, g, b, a (sRGB)
+ *   SELECT_BED                                           u32 slot
+ *
+ * The select opcodes pick the beds that later commands apply to, and only
+ * mean something to a container of beds.
+ */
+struct BedCommand {
+    enum Opcode : uint8_t {
+        POWER_ON = 1,
+        POWER_OFF,
+        SET_HEIGHT,
+        RAISE_HEIGHT,
+        LOWER_HEIGHT,
+        QUEUE_HEIGHT,
+        STOP_HEIGHT,
+        SET_TEMPERATURE,
+        ACTIVATE_LIGHTS,
+        DEACTIVATE_LIGHTS,
+        SET_LIGHT_BRIGHTNESS,
+        SET_LIGHT_COLOR,
+        TRIGGER_EMERGENCY,
+        CLEAR_EMERGENCY,
+        SELECT_BED,
+        SELECT_ALL
+    };
+
+    // One status byte per command, in stream order
+    enum Status : uint8_t {
+        OK = 0,
+        REJECTED,          // well-formed, but the bed's state refused it (powered off, queue full)
+        INVALID_ARGUMENT,  // out of range or not a number
+        UNSUPPORTED,       // valid opcode this receiver does not handle
+        NO_TARGET,         // nothing selected, or the ward is empty
+        UNKNOWN_OPCODE,    // ends the stream
+        TRUNCATED          // arguments run past the end; ends the stream
+    };
+
+    Opcode opcode = POWER_ON;
+    float value = 0.0f;
+    uint32_t slot = 0;
+    uint8_t mode = 0;
+    PackedColor color;
+
+    // Argument bytes after the opcode, or -1 for an unknown opcode
+    static int getArgumentSize(uint8_t opcode);
+};
+
+/**
+ * @class BedCommandReader
+ * @brief Decodes a command stream one command at a time, without copying it
+ */
+class BedCommandReader {
+public:
+    BedCommandReader(const uint8_t* data, size_t size) : data(data), size(size), offset(0), failed(false) {}
+
+    /**
+     * Decodes the next command into command
+     * @return false at the end of the stream; otherwise status is OK, or
+     *         UNKNOWN_OPCODE / TRUNCATED for a malformed command, after
+     *         which the stream ends
+     */
+    bool next(BedCommand& command, BedCommand::Status& status);
+
+    size_t getOffset() const { return offset; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+    bool failed;
+};
+
+/**
+ * Runs every command through apply(const BedCommand&) -> BedCommand::Status
+ * and writes one status per command, malformed ones included.
+ * statuses needs room for size entries, the most size bytes can encode.
+ * @return the number of statuses written
+ */
+template <typename Apply>
+size_t runBedCommands(const uint8_t* data, size_t size, uint8_t* statuses, Apply&& apply) {
+    BedCommandReader reader(data, size);
+    BedCommand command;
+    BedCommand::Status status;
+    size_t count = 0;
+    while (reader.next(command, status)) {
+        statuses[count++] = status == BedCommand::OK ? apply(command) : status;
+    }
+    return count;
+}
+
+/**
+ * @class BedCommandWriter
+ * @brief Builds a command stream; used by native callers, tests and benchmarks
+ */
+class BedCommandWriter {
+public:
+    BedCommandWriter& powerOn() { return opcode(BedCommand::POWER_ON); }
+    BedCommandWriter& powerOff() { return opcode(BedCommand::POWER_OFF); }
+    BedCommandWriter& setHeight(float height) { return withFloat(BedCommand::SET_HEIGHT, height); }
+    BedCommandWriter& raiseHeight(float amount) { return withFloat(BedCommand::RAISE_HEIGHT, amount); }
+    BedCommandWriter& lowerHeight(float amount) { return withFloat(BedCommand::LOWER_HEIGHT, amount); }
+    BedCommandWriter& queueHeight(float height) { return withFloat(BedCommand::QUEUE_HEIGHT, height); }
+    BedCommandWriter& stopHeight() { return opcode(BedCommand::STOP_HEIGHT); }
+    BedCommandWriter& setTemperature(uint8_t mode);
+    BedCommandWriter& activateLights() { return opcode(BedCommand::ACTIVATE_LIGHTS); }
+    BedCommandWriter& deactivateLights() { return opcode(BedCommand::DEACTIVATE_LIGHTS); }
+    BedCommandWriter& setLightBrightness(float value) { return withFloat(BedCommand::SET_LIGHT_BRIGHTNESS, value); }
+    BedCommandWriter& setLightColor(PackedColor color);
+    BedCommandWriter& triggerEmergency() { return opcode(BedCommand::TRIGGER_EMERGENCY); }
+    BedCommandWriter& clearEmergency() { return opcode(BedCommand::CLEAR_EMERGENCY); }
+    BedCommandWriter& selectBed(uint32_t slot);
+    BedCommandWriter& selectAll() { return opcode(BedCommand::SELECT_ALL); }
+
+    void clear() { bytes.clear(); }
+    const std::vector<uint8_t>& getBytes() const { return bytes; }
+
+private:
+    BedCommandWriter& opcode(BedCommand::Opcode code);
+    BedCommandWriter& withFloat(BedCommand::Opcode code, float value);
+    void putU32(uint32_t value);
+
+    std::vector<uint8_t> bytes;
+};
+
+#endif // BED_COMMANDS_H
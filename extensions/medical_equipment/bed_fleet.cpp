@@ -0,0 +1,119 @@
+#include "bed_fleet.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+
+using namespace godot;
+
+BedFleet::BedFleet() {
+    DEVICE_LOG_INFO("🛏️ BedFleet created");
+}
+
+BedFleet::~BedFleet() {
+    // Beds that outlive the fleet go back to stepping their own lift
+    clearBeds();
+}
+
+bool BedFleet::addBed(Node* bed) {
+    Bed* target = Object::cast_to<Bed>(bed);
+    if (!target) {
+        DEVICE_LOG_INFO("❌ BedFleet only accepts Bed nodes");
+        return false;
+    }
+    
+    uint64_t id = target->get_instance_id();
+    if (std::find(bedIds.begin(), bedIds.end(), id) != bedIds.end()) {
+        return false;
+    }
+    bedIds.push_back(id);
+    target->getHeightActuator().setManaged(true);
+    return true;
+}
+
+bool BedFleet::removeBed(Node* bed) {
+    if (!bed) {
+        return false;
+    }
+    
+    auto it = std::find(bedIds.begin(), bedIds.end(), bed->get_instance_id());
+    if (it == bedIds.end()) {
+        return false;
+    }
+    release(*it);
+    bedIds.erase(it);
+    return true;
+}
+
+void BedFleet::clearBeds() {
+    for (uint64_t id : bedIds) {
+        release(id);
+    }
+    bedIds.clear();
+    movingBeds.clear();
+    fleet.setActuators({});
+}
+
+int BedFleet::getBedCount() const {
+    return static_cast<int>(bedIds.size());
+}
+
+void BedFleet::setTimestep(double timestep) {
+    if (timestep <= 0.0) {
+        DEVICE_LOG_INFO("❌ Fleet timestep must be positive");
+        return;
+    }
+    fleet.setTimestep(timestep);
+}
+
+void BedFleet::_physics_process(double delta) {
+    collectActuators();
+    if (fleet.advance(delta) == 0) {
+        return;
+    }
+    for (Bed* bed : movingBeds) {
+        bed->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_HEIGHT);
+        bed->markChanged(BedChange::HEIGHT);
+    }
+}
+
+void BedFleet::collectActuators() {
+    // Beds freed since the last frame drop out of the fleet
+    std::vector<HeightActuator*> actuators;
+    actuators.reserve(bedIds.size());
+    movingBeds.clear();
+    auto live = bedIds.begin();
+    for (uint64_t id : bedIds) {
+        Bed* bed = Object::cast_to<Bed>(ObjectDB::get_instance(id));
+        if (!bed) {
+            continue;
+        }
+        *live++ = id;
+        actuators.push_back(&bed->getHeightActuator());
+        if (bed->isHeightMoving()) {
+            movingBeds.push_back(bed);
+        }
+    }
+    bedIds.erase(live, bedIds.end());
+    fleet.setActuators(std::move(actuators));
+}
+
+void BedFleet::release(uint64_t id) {
+    Bed* bed = Object::cast_to<Bed>(ObjectDB::get_instance(id));
+    if (!bed) {
+        return;
+    }
+    
+    HeightActuator& actuator = bed->getHeightActuator();
+    actuator.setManaged(false);
+    if (actuator.isMoving()) {
+        bed->set_process(true);
+    }
+}
+
+void BedFleet::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_bed", "bed"), &BedFleet::addBed);
+    ClassDB::bind_method(D_METHOD("remove_bed", "bed"), &BedFleet::removeBed);
+    ClassDB::bind_method(D_METHOD("clear_beds"), &BedFleet::clearBeds);
+    ClassDB::bind_method(D_METHOD("get_bed_count"), &BedFleet::getBedCount);
+    ClassDB::bind_method(D_METHOD("set_timestep", "timestep"), &BedFleet::setTimestep);
+    ClassDB::bind_method(D_METHOD("get_timestep"), &BedFleet::getTimestep);
+}
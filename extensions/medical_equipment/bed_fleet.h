@@ -0,0 +1,52 @@
+#ifndef BED_FLEET_H
+#define BED_FLEET_H
+
+#include <godot_cpp/classes/node.hpp>
+#include "bed.h"
+#include "height_actuator.h"
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+/**
+ * @class BedFleet
+ * @brief Godot node stepping the height lifts of many beds together
+ *
+ * Member beds stop stepping their own lift; the fleet advances all of them
+ * from _physics_process() at one fixed timestep, in a single pass split
+ * across the worker pool, so a ward of moving beds costs one loop per
+ * substep instead of one _process() call per bed.
+ */
+class BedFleet : public Node {
+    GDCLASS(BedFleet, Node)
+
+private:
+    std::vector<uint64_t> bedIds;  // instance ids, so freed beds are skipped rather than dangling
+    std::vector<Bed*> movingBeds;  // live beds whose lift moves this frame
+    ActuatorFleet fleet;
+
+public:
+    BedFleet();
+    ~BedFleet();
+
+    // Fleet membership
+    bool addBed(Node* bed);
+    bool removeBed(Node* bed);
+    void clearBeds();
+    int getBedCount() const;
+
+    void setTimestep(double timestep);
+    double getTimestep() const { return fleet.getTimestep(); }
+
+    void _physics_process(double delta) override;
+
+protected:
+    static void _bind_methods();
+
+private:
+    void collectActuators();
+    void release(uint64_t id);
+};
+
+#endif // BED_FLEET_H
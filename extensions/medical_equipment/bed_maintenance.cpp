@@ -0,0 +1,110 @@
+#include "bed_maintenance.h"
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+BedMaintenance::BedMaintenance() {
+    DEVICE_LOG_INFO("🔧 BedMaintenance created");
+}
+
+bool BedMaintenance::addBed(Node* bed) {
+    Bed* target = Object::cast_to<Bed>(bed);
+    if (!target) {
+        DEVICE_LOG_INFO("❌ BedMaintenance only accepts Bed nodes");
+        return false;
+    }
+    
+    // New members start with a full check
+    if (!scheduler.add(target)) {
+        return false;
+    }
+    target->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_ALL);
+    return true;
+}
+
+bool BedMaintenance::removeBed(Node* bed) {
+    Bed* target = Object::cast_to<Bed>(bed);
+    return target && scheduler.remove(target);
+}
+
+void BedMaintenance::clearBeds() {
+    scheduler.clear();
+}
+
+void BedMaintenance::setBudgetUs(int64_t budgetUs) {
+    if (budgetUs <= 0) {
+        DEVICE_LOG_INFO("❌ Maintenance budget must be positive");
+        return;
+    }
+    scheduler.setBudgetUs(budgetUs);
+}
+
+void BedMaintenance::requestFullCheck() {
+    for (MaintenanceTarget* target : scheduler.getTargets()) {
+        target->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_ALL);
+    }
+}
+
+PackedInt64Array BedMaintenance::getRecords() const {
+    const std::vector<MaintenanceTarget*>& targets = scheduler.getTargets();
+    PackedInt64Array records;
+    records.resize(static_cast<int64_t>(targets.size()));
+    int64_t* out = records.ptrw();
+    for (size_t i = 0; i < targets.size(); ++i) {
+        out[i] = static_cast<int64_t>(targets[i]->getLastMaintenance().pack());
+    }
+    return records;
+}
+
+Dictionary BedMaintenance::getStats() const {
+    const MaintenanceScheduler::Stats& stats = scheduler.getStats();
+    Dictionary result;
+    result["beds"] = static_cast<int64_t>(stats.targets);
+    result["backlog"] = static_cast<int64_t>(stats.backlog);
+    result["budget_us"] = scheduler.getBudgetUs();
+    result["last_frame_checks"] = static_cast<int64_t>(stats.lastFrameChecks);
+    result["last_frame_us"] = stats.lastFrameUs;
+    result["total_checks"] = static_cast<int64_t>(stats.totalChecks);
+    result["subsystems_checked"] = static_cast<int64_t>(stats.subsystemsChecked);
+    result["subsystems_skipped"] = static_cast<int64_t>(stats.subsystemsSkipped);
+    result["checks_per_second"] = stats.checksPerSecond;
+    result["coverage_per_second"] = stats.coveragePerSecond;
+    return result;
+}
+
+void BedMaintenance::_process(double delta) {
+    scheduler.runFrame(delta);
+    const std::vector<MaintenanceTarget*>& changes = scheduler.getFaultChanges();
+    if (changes.empty()) {
+        return;
+    }
+
+    // Copied out before anything is emitted: handlers may remove beds or clear the schedule
+    Array beds;
+    PackedInt64Array records;
+    for (MaintenanceTarget* target : changes) {
+        Bed* bed = dynamic_cast<Bed*>(target);
+        if (bed) {
+            beds.push_back(bed);
+            records.push_back(static_cast<int64_t>(bed->getLastMaintenance().pack()));
+        }
+    }
+
+    for (int64_t i = 0; i < beds.size(); ++i) {
+        emit_signal("faults_changed", beds[i], records[i]);
+    }
+}
+
+void BedMaintenance::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_bed", "bed"), &BedMaintenance::addBed);
+    ClassDB::bind_method(D_METHOD("remove_bed", "bed"), &BedMaintenance::removeBed);
+    ClassDB::bind_method(D_METHOD("clear_beds"), &BedMaintenance::clearBeds);
+    ClassDB::bind_method(D_METHOD("get_bed_count"), &BedMaintenance::getBedCount);
+    ClassDB::bind_method(D_METHOD("set_budget_us", "budget_us"), &BedMaintenance::setBudgetUs);
+    ClassDB::bind_method(D_METHOD("get_budget_us"), &BedMaintenance::getBudgetUs);
+    ClassDB::bind_method(D_METHOD("request_full_check"), &BedMaintenance::requestFullCheck);
+    ClassDB::bind_method(D_METHOD("get_records"), &BedMaintenance::getRecords);
+    ClassDB::bind_method(D_METHOD("get_stats"), &BedMaintenance::getStats);
+    
+    ADD_SIGNAL(MethodInfo("faults_changed", PropertyInfo(Variant::OBJECT, "bed"), PropertyInfo(Variant::INT, "record")));
+}
@@ -0,0 +1,53 @@
+#ifndef BED_MAINTENANCE_H
+#define BED_MAINTENANCE_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include "bed.h"
+#include "maintenance_scheduler.h"
+
+using namespace godot;
+
+/**
+ * @class BedMaintenance
+ * @brief Godot node keeping maintenance records of its beds current, a little each frame
+ *
+ * Beds flag the subsystems they change; from _process() the node rechecks
+ * only those, spending at most the configured microseconds per frame, and
+ * emits faults_changed for beds whose faults appeared or cleared.
+ * get_stats() reports the backlog and the coverage achieved per second.
+ */
+class BedMaintenance : public Node {
+    GDCLASS(BedMaintenance, Node)
+
+private:
+    MaintenanceScheduler scheduler;
+
+public:
+    BedMaintenance();
+    ~BedMaintenance() = default;
+
+    bool addBed(Node* bed);
+    bool removeBed(Node* bed);
+    void clearBeds();
+    int getBedCount() const { return static_cast<int>(scheduler.size()); }
+
+    void setBudgetUs(int64_t budgetUs);
+    int64_t getBudgetUs() const { return scheduler.getBudgetUs(); }
+
+    // Marks every subsystem of every bed for a recheck
+    void requestFullCheck();
+
+    // Last record of each bed, in the order they were added (see Bed.get_maintenance_record)
+    PackedInt64Array getRecords() const;
+    Dictionary getStats() const;
+
+    void _process(double delta) override;
+
+protected:
+    static void _bind_methods();
+};
+
+#endif // BED_MAINTENANCE_H
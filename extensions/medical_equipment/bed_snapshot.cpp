@@ -0,0 +1,308 @@
+#include "bed_snapshot.h"
+#include "device_log.h"
+#include "height_actuator.h"
+#include "led_framebuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Format = BedSnapshotFormat;
+
+namespace {
+
+struct FileCloser {
+    void operator()(std::FILE* file) const { std::fclose(file); }
+};
+
+using FileHandle = std::unique_ptr<std::FILE, FileCloser>;
+
+inline size_t alignUp(size_t value) {
+    return (value + Format::kAlignment - 1) & ~(Format::kAlignment - 1);
+}
+
+} // namespace
+
+// BedSnapshot
+
+BedSnapshot::BedSnapshot()
+    : kind(GENERIC), temperatureMode(0), flags(0), minHeight(0.0f), maxHeight(0.0f), height(0.0f),
+      targetHeight(0.0f), motionProfile(0), lightEffect(0), scanType(0), reserved0(0), maxVelocity(0.0f),
+      maxAcceleration(0.0f), maxJerk(0.0f), lightColor(0, 0, 0, 0), lightBrightness(0.0f),
+      lightSecondary(0, 0, 0, 0), lightRateHz(0.0f), lightWidth(0.0f), ledCount(0), emergencyDomain(-1),
+      swivelAngle(0.0f), reserved1(0), procedure{}, patientId{} {}
+
+bool BedSnapshot::isValid() const {
+    auto finite = [](float value) { return std::isfinite(value); };
+    auto within = [](float value, float low, float high) { return value >= low && value <= high; };
+
+    if (kind > SURGICAL || temperatureMode >= kTemperatureModeCount ||
+        motionProfile > static_cast<uint8_t>(MotionLimits::Profile::S_CURVE) ||
+        lightEffect > static_cast<uint8_t>(LedEffect::Type::STROBE) || ledCount > LedFramebuffer::kMaxLedCount) {
+        return false;
+    }
+
+    // Comparisons fail for NaN, so within() also rejects it
+    if (!finite(minHeight) || !finite(maxHeight) || minHeight > maxHeight ||
+        !within(height, minHeight, maxHeight) || !within(targetHeight, minHeight, maxHeight)) {
+        return false;
+    }
+    if (!finite(maxVelocity) || !finite(maxAcceleration) || !finite(maxJerk) ||
+        maxVelocity <= 0.0f || maxAcceleration <= 0.0f || maxJerk <= 0.0f) {
+        return false;
+    }
+    return within(lightBrightness, 0.0f, 1.0f) && finite(lightRateHz) && finite(lightWidth) &&
+           within(swivelAngle, -kMaxSwivelAngle, kMaxSwivelAngle);
+}
+
+void BedSnapshot::setText(char* field, size_t size, const std::string& text) {
+    std::memset(field, 0, size);
+    std::memcpy(field, text.data(), std::min(text.size(), size - 1));
+}
+
+std::string BedSnapshot::getText(const char* field, size_t size) {
+    return std::string(field, std::find(field, field + size, '\0'));
+}
+
+// BedSnapshotFormat
+
+namespace BedSnapshotFormat {
+
+size_t getColumnElementBytes(Column column) {
+    switch (column) {
+        case Column::HEIGHT:
+        case Column::TARGET_HEIGHT:
+        case Column::BRIGHTNESS:
+            return sizeof(float);
+        case Column::COLOR:
+            return sizeof(PackedColor);
+        default:
+            return sizeof(uint8_t);
+    }
+}
+
+size_t getColumnOffset(Column column, size_t count) {
+    size_t offset = sizeof(FileHeader);
+    for (uint32_t c = 0; c < static_cast<uint32_t>(column); ++c) {
+        offset = alignUp(offset + count * getColumnElementBytes(static_cast<Column>(c)));
+    }
+    return offset;
+}
+
+size_t getWardPayloadBytes(size_t count) {
+    return getColumnOffset(Column::COUNT, count) - sizeof(FileHeader);
+}
+
+FileHeader makeHeader(Payload payload, size_t count) {
+    FileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.payload = static_cast<uint32_t>(payload);
+    header.count = count;
+    if (payload == Payload::BED_RECORDS) {
+        header.recordBytes = sizeof(BedSnapshot);
+        header.payloadBytes = count * sizeof(BedSnapshot);
+    } else {
+        header.payloadBytes = getWardPayloadBytes(count);
+    }
+    return header;
+}
+
+bool validate(const uint8_t* data, size_t size, Payload payload, FileHeader& header) {
+    if (!data || size < sizeof(FileHeader)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0 || header.version != kVersion ||
+        header.payload != static_cast<uint32_t>(payload)) {
+        return false;
+    }
+
+    // Sizes are recomputed rather than trusted, so a bad count cannot read past the end;
+    // every bed takes at least a byte, which also keeps the arithmetic from overflowing
+    if (header.count > size) {
+        return false;
+    }
+    FileHeader expected = makeHeader(payload, static_cast<size_t>(header.count));
+    return header.recordBytes == expected.recordBytes && header.payloadBytes == expected.payloadBytes &&
+           expected.payloadBytes <= size - sizeof(FileHeader);
+}
+
+std::vector<uint8_t> encodeRecords(const BedSnapshot* records, size_t count) {
+    FileHeader header = makeHeader(Payload::BED_RECORDS, count);
+    std::vector<uint8_t> bytes(sizeof(header) + count * sizeof(BedSnapshot));
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    if (count > 0) {
+        std::memcpy(bytes.data() + sizeof(header), records, count * sizeof(BedSnapshot));
+    }
+    return bytes;
+}
+
+const BedSnapshot* decodeRecords(const uint8_t* data, size_t size, size_t& count) {
+    FileHeader header;
+    if (!validate(data, size, Payload::BED_RECORDS, header)) {
+        return nullptr;
+    }
+    count = static_cast<size_t>(header.count);
+    return reinterpret_cast<const BedSnapshot*>(data + sizeof(FileHeader));
+}
+
+bool writeRecords(const std::string& path, const BedSnapshot* records, size_t count) {
+    FileHandle file(std::fopen(path.c_str(), "wb"));
+    if (!file) {
+        DEVICE_LOG_INFO("❌ Cannot create bed snapshot {}", path);
+        return false;
+    }
+
+    // One contiguous block after the header
+    FileHeader header = makeHeader(Payload::BED_RECORDS, count);
+    bool written = std::fwrite(&header, sizeof(header), 1, file.get()) == 1 &&
+                   (count == 0 || std::fwrite(records, sizeof(BedSnapshot), count, file.get()) == count);
+    // A truncated snapshot must not be left behind for a later load to map
+    if (std::fclose(file.release()) != 0 || !written) {
+        DEVICE_LOG_INFO("❌ Cannot write bed snapshot {}", path);
+        std::remove(path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool writeWardColumns(const std::string& path, size_t count, const void* const* columns) {
+    FileHandle file(std::fopen(path.c_str(), "wb"));
+    if (!file) {
+        DEVICE_LOG_INFO("❌ Cannot create ward snapshot {}", path);
+        return false;
+    }
+
+    FileHeader header = makeHeader(Payload::WARD_COLUMNS, count);
+    bool written = std::fwrite(&header, sizeof(header), 1, file.get()) == 1;
+    static const uint8_t padding[kAlignment] = {};
+    for (uint32_t c = 0; written && c < static_cast<uint32_t>(Column::COUNT); ++c) {
+        Column column = static_cast<Column>(c);
+        size_t bytes = count * getColumnElementBytes(column);
+        size_t end = getColumnOffset(static_cast<Column>(c + 1), count);
+        size_t gap = end - getColumnOffset(column, count) - bytes;
+        written = (bytes == 0 || std::fwrite(columns[c], 1, bytes, file.get()) == bytes) &&
+                  (gap == 0 || std::fwrite(padding, 1, gap, file.get()) == gap);
+    }
+    if (std::fclose(file.release()) != 0 || !written) {
+        DEVICE_LOG_INFO("❌ Cannot write ward snapshot {}", path);
+        std::remove(path.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace BedSnapshotFormat
+
+// BedSnapshotMapping
+
+BedSnapshotMapping::BedSnapshotMapping() : header(), data(nullptr), size(0), fd(-1) {}
+
+BedSnapshotMapping::~BedSnapshotMapping() {
+    close();
+}
+
+#if defined(_WIN32)
+
+bool BedSnapshotMapping::open(const std::string& path, Format::Payload payload) {
+    close();
+
+    // Without mmap the file is read in one go; restoring is still a plain copy
+    FileHandle file(std::fopen(path.c_str(), "rb"));
+    if (!file) {
+        DEVICE_LOG_INFO("❌ Cannot open bed snapshot {}", path);
+        return false;
+    }
+    std::fseek(file.get(), 0, SEEK_END);
+    long length = std::ftell(file.get());
+    std::fseek(file.get(), 0, SEEK_SET);
+    buffer.resize(length > 0 ? static_cast<size_t>(length) : 0);
+    if (buffer.empty() || std::fread(buffer.data(), 1, buffer.size(), file.get()) != buffer.size() ||
+        !Format::validate(buffer.data(), buffer.size(), payload, header)) {
+        DEVICE_LOG_INFO("❌ Not a bed snapshot: {}", path);
+        close();
+        return false;
+    }
+    data = buffer.data();
+    size = buffer.size();
+    return true;
+}
+
+void BedSnapshotMapping::close() {
+    buffer.clear();
+    data = nullptr;
+    size = 0;
+}
+
+#else
+
+bool BedSnapshotMapping::open(const std::string& path, Format::Payload payload) {
+    close();
+
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        DEVICE_LOG_INFO("❌ Cannot open bed snapshot {}", path);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Format::FileHeader)) {
+        DEVICE_LOG_INFO("❌ Not a bed snapshot: {}", path);
+        close();
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        DEVICE_LOG_INFO("❌ Cannot map bed snapshot {}", path);
+        close();
+        return false;
+    }
+    data = static_cast<const uint8_t*>(mapped);
+    size = length;
+
+    if (!Format::validate(data, size, payload, header)) {
+        DEVICE_LOG_INFO("❌ Not a bed snapshot: {}", path);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void BedSnapshotMapping::close() {
+    if (data) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    fd = -1;
+    data = nullptr;
+    size = 0;
+}
+
+#endif
+
+const BedSnapshot* BedSnapshotMapping::getRecords() const {
+    if (!data || header.payload != static_cast<uint32_t>(Format::Payload::BED_RECORDS)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const BedSnapshot*>(data + sizeof(Format::FileHeader));
+}
+
+const uint8_t* BedSnapshotMapping::getColumn(Format::Column column) const {
+    if (!data || header.payload != static_cast<uint32_t>(Format::Payload::WARD_COLUMNS)) {
+        return nullptr;
+    }
+    return data + Format::getColumnOffset(column, getCount());
+}
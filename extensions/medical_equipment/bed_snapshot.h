@@ -0,0 +1,193 @@
+#ifndef BED_SNAPSHOT_H
+#define BED_SNAPSHOT_H
+
+#include "packed_color.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct BedSnapshot
+ * @brief Complete state of one bed as a fixed 128-byte record
+ *
+ * Plain data, written and read as is, so a file of records is usable
+ * straight from a mapping. Fields a bed kind does not have stay zero.
+ * Text fields are NUL-padded and cut to fit. A lift in motion is saved as
+ * its position and final target, and on restore moves there again from
+ * rest; a scan in flight is saved as its type and requested again.
+ */
+struct BedSnapshot {
+    enum Kind : uint8_t { GENERIC = 0, PATIENT, SURGICAL };
+
+    enum Flags : uint16_t {
+        POWERED = 1 << 0,
+        LIGHTS_ON = 1 << 1,
+        EMERGENCY = 1 << 2,
+        OCCUPIED = 1 << 3,
+        COMFORT_MODE = 1 << 4,
+        STERILE = 1 << 5,
+        PROCEDURE = 1 << 6,
+        MONITORING_VITALS = 1 << 7,
+        SCANNING = 1 << 8
+    };
+
+    static constexpr size_t kProcedureBytes = 24;
+    static constexpr size_t kPatientIdBytes = 32;
+    static constexpr uint8_t kTemperatureModeCount = 3;  // cold, neutral, warm
+    static constexpr float kMaxSwivelAngle = 90.0f;
+
+    uint8_t kind;
+    uint8_t temperatureMode;
+    uint16_t flags;
+
+    // Lift, in cm
+    float minHeight;
+    float maxHeight;
+    float height;
+    float targetHeight;
+    uint8_t motionProfile;
+    uint8_t lightEffect;
+    uint8_t scanType;
+    uint8_t reserved0;
+    float maxVelocity;
+    float maxAcceleration;
+    float maxJerk;
+
+    // Normal light behavior, kept while an emergency overrides it
+    PackedColor lightColor;
+    float lightBrightness;
+    PackedColor lightSecondary;
+    float lightRateHz;
+    float lightWidth;
+    uint32_t ledCount;
+    int32_t emergencyDomain;
+
+    // Scanner
+    float swivelAngle;
+    uint32_t reserved1;
+    char procedure[kProcedureBytes];
+    char patientId[kPatientIdBytes];
+
+    BedSnapshot();
+
+    bool has(Flags flag) const { return (flags & flag) != 0; }
+    void set(Flags flag, bool value) { flags = static_cast<uint16_t>(value ? (flags | flag) : (flags & ~flag)); }
+
+    /**
+     * Checks every enum and numeric field: finite, and within the range a bed
+     * could have saved, so a damaged or edited file cannot reach the devices
+     * @return false for a record that must not be restored
+     */
+    bool isValid() const;
+
+    static void setText(char* field, size_t size, const std::string& text);
+    static std::string getText(const char* field, size_t size);
+};
+
+static_assert(sizeof(BedSnapshot) == 128, "BedSnapshot must stay 128 bytes");
+
+// On-disk layout of bed snapshots: a 64-byte header and one payload. A
+// BED_RECORDS payload is count BedSnapshot records back to back; a
+// WARD_COLUMNS payload is one column per field of a BedWardState, each
+// starting on a 64-byte boundary. Values are stored in host byte order,
+// which is little-endian on every platform Godot ships on.
+namespace BedSnapshotFormat {
+
+constexpr char kMagic[4] = {'B', 'E', 'D', 'S'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kAlignment = 64;
+
+enum class Payload : uint32_t { BED_RECORDS = 1, WARD_COLUMNS = 2 };
+
+enum class Column : uint32_t {
+    HEIGHT,          // float
+    TARGET_HEIGHT,   // float
+    POWERED,         // uint8
+    TEMPERATURE,     // uint8
+    LIGHTS_ON,       // uint8
+    BRIGHTNESS,      // float
+    COLOR,           // PackedColor
+    EMERGENCY,       // uint8
+    KIND,            // uint8
+    COUNT
+};
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t payload;
+    uint32_t recordBytes;   // sizeof(BedSnapshot) for BED_RECORDS, 0 otherwise
+    uint64_t count;         // beds
+    uint64_t payloadBytes;  // after the header
+    uint64_t reserved[4];
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader must stay 64 bytes");
+
+size_t getColumnElementBytes(Column column);
+
+// Offset of a column from the start of the file, and the payload size, for count beds
+size_t getColumnOffset(Column column, size_t count);
+size_t getWardPayloadBytes(size_t count);
+
+FileHeader makeHeader(Payload payload, size_t count);
+
+/**
+ * Checks magic, version, payload kind and that the sizes fit in size bytes
+ * @return false for anything this build cannot read
+ */
+bool validate(const uint8_t* data, size_t size, Payload payload, FileHeader& header);
+
+// Header and records as one buffer, for Godot byte arrays
+std::vector<uint8_t> encodeRecords(const BedSnapshot* records, size_t count);
+
+/**
+ * Records inside an encoded buffer; they are not copied
+ * @return nullptr if the buffer is not a BED_RECORDS snapshot
+ */
+const BedSnapshot* decodeRecords(const uint8_t* data, size_t size, size_t& count);
+
+bool writeRecords(const std::string& path, const BedSnapshot* records, size_t count);
+
+// columns[c] holds count elements of Column c, for every column
+bool writeWardColumns(const std::string& path, size_t count, const void* const* columns);
+
+} // namespace BedSnapshotFormat
+
+/**
+ * @class BedSnapshotMapping
+ * @brief Read-only mapping of a snapshot file
+ *
+ * open() maps the file and checks its header; records and columns then
+ * point straight into the mapping, with nothing parsed or copied.
+ */
+class BedSnapshotMapping {
+public:
+    BedSnapshotMapping();
+    ~BedSnapshotMapping();
+
+    BedSnapshotMapping(const BedSnapshotMapping&) = delete;
+    BedSnapshotMapping& operator=(const BedSnapshotMapping&) = delete;
+
+    bool open(const std::string& path, BedSnapshotFormat::Payload payload);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    size_t getCount() const { return static_cast<size_t>(header.count); }
+
+    // BED_RECORDS files
+    const BedSnapshot* getRecords() const;
+
+    // WARD_COLUMNS files; getCount() elements of the column's type
+    const uint8_t* getColumn(BedSnapshotFormat::Column column) const;
+
+private:
+    BedSnapshotFormat::FileHeader header;
+    const uint8_t* data;
+    size_t size;
+    int fd;
+    std::vector<uint8_t> buffer;  // the file's bytes where mapping is unavailable
+};
+
+#endif // BED_SNAPSHOT_H
@@ -0,0 +1,401 @@
+#include "bed_ward.h"
+#include "bed.h"
+#include "device_log.h"
+#include "worker_pool.h"
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <chrono>
+
+using namespace godot;
+
+namespace {
+
+using TemperatureMode = BedWardState::TemperatureMode;
+
+// Copies a byte column into a fresh packed array
+PackedByteArray copyColumn(const uint8_t* column, size_t count) {
+    PackedByteArray values;
+    values.resize(static_cast<int64_t>(count));
+    if (count > 0) {
+        std::copy(column, column + count, values.ptrw());
+    }
+    return values;
+}
+
+} // namespace
+
+BedWard::BedWard() {
+    DEVICE_LOG_INFO("🏥 BedWard created");
+}
+
+int BedWard::addBeds(int count, int kind) {
+    if (count <= 0) {
+        return -1;
+    }
+    if (kind != BED_PATIENT && kind != BED_SURGICAL) {
+        DEVICE_LOG_INFO("❌ Unknown bed kind: {}", kind);
+        return -1;
+    }
+    
+    size_t first = state.addBeds(static_cast<size_t>(count), static_cast<BedWardState::BedKind>(kind));
+    DEVICE_LOG_INFO("🏥 BedWard now holds {} beds", state.size());
+    return static_cast<int>(first);
+}
+
+void BedWard::clearBeds() {
+    state.clear();
+}
+
+int BedWard::powerOn(const PackedByteArray& mask) {
+    const uint8_t* bytes = nullptr;
+    return resolveMask(mask, bytes) ? static_cast<int>(state.powerOnMasked(bytes)) : 0;
+}
+
+int BedWard::powerOff(const PackedByteArray& mask) {
+    const uint8_t* bytes = nullptr;
+    return resolveMask(mask, bytes) ? static_cast<int>(state.powerOffMasked(bytes)) : 0;
+}
+
+int BedWard::setHeights(const PackedFloat32Array& heights) {
+    if (static_cast<size_t>(heights.size()) != state.size()) {
+        DEVICE_LOG_INFO("❌ Expected {} heights, got {}", state.size(), heights.size());
+        return 0;
+    }
+    return static_cast<int>(state.setHeights(heights.ptr(), static_cast<size_t>(heights.size())));
+}
+
+int BedWard::setHeightMasked(const PackedByteArray& mask, float height) {
+    const uint8_t* bytes = nullptr;
+    return resolveMask(mask, bytes) ? static_cast<int>(state.setHeightMasked(bytes, height)) : 0;
+}
+
+int BedWard::setTemperature(const PackedByteArray& mask, int mode) {
+    const uint8_t* bytes = nullptr;
+    if (!isValidTemperature(mode) || !resolveMask(mask, bytes)) {
+        return 0;
+    }
+    return static_cast<int>(state.setTemperatureMasked(bytes, static_cast<TemperatureMode>(mode)));
+}
+
+int BedWard::setLights(const PackedByteArray& mask, bool on) {
+    const uint8_t* bytes = nullptr;
+    return resolveMask(mask, bytes) ? static_cast<int>(state.setLightsMasked(bytes, on)) : 0;
+}
+
+int BedWard::setLightBrightness(const PackedByteArray& mask, float brightness) {
+    const uint8_t* bytes = nullptr;
+    return resolveMask(mask, bytes) ? static_cast<int>(state.setBrightnessMasked(bytes, brightness)) : 0;
+}
+
+// Godot colors are sRGB-encoded, like the ward's color column
+int BedWard::setLightColor(const PackedByteArray& mask, const Color& color) {
+    const uint8_t* bytes = nullptr;
+    if (!resolveMask(mask, bytes)) {
+        return 0;
+    }
+    return static_cast<int>(state.setColorMasked(bytes, PackedColor::fromFloat(color.r, color.g, color.b, color.a)));
+}
+
+int BedWard::triggerEmergency(const PackedByteArray& mask) {
+    const uint8_t* bytes = nullptr;
+    if (!resolveMask(mask, bytes)) {
+        return 0;
+    }
+    
+    size_t changed = state.setEmergencyMasked(bytes, true);
+    if (changed > 0) {
+        DEVICE_LOG_ALERT("🚨 EMERGENCY TRIGGERED on {} ward beds", changed);
+    }
+    return static_cast<int>(changed);
+}
+
+int BedWard::clearEmergency(const PackedByteArray& mask) {
+    const uint8_t* bytes = nullptr;
+    if (!resolveMask(mask, bytes)) {
+        return 0;
+    }
+    
+    size_t changed = state.setEmergencyMasked(bytes, false);
+    if (changed > 0) {
+        DEVICE_LOG_ALERT("Emergency cleared on {} ward beds", changed);
+    }
+    return static_cast<int>(changed);
+}
+
+PackedFloat32Array BedWard::getHeights() const {
+    PackedFloat32Array values;
+    values.resize(static_cast<int64_t>(state.size()));
+    if (state.size() > 0) {
+        std::copy(state.getHeights(), state.getHeights() + state.size(), values.ptrw());
+    }
+    return values;
+}
+
+PackedByteArray BedWard::getPowerStates() const {
+    return copyColumn(state.getPowered(), state.size());
+}
+
+PackedByteArray BedWard::getTemperatureModes() const {
+    return copyColumn(state.getTemperatureModes(), state.size());
+}
+
+PackedByteArray BedWard::getLightStates() const {
+    return copyColumn(state.getLightsOn(), state.size());
+}
+
+PackedByteArray BedWard::getEmergencyFlags() const {
+    return copyColumn(state.getEmergency(), state.size());
+}
+
+PackedByteArray BedWard::executeCommands(const PackedByteArray& commands) {
+    PackedByteArray statuses;
+    statuses.resize(commands.size());
+    size_t count = state.executeCommands(commands.ptr(), static_cast<size_t>(commands.size()), statuses.ptrw());
+    statuses.resize(static_cast<int64_t>(count));
+    return statuses;
+}
+
+bool BedWard::saveSnapshot(const String& path) const {
+    String filePath = ProjectSettings::get_singleton()->globalize_path(path);
+    return state.saveSnapshot(filePath.utf8().get_data());
+}
+
+bool BedWard::loadSnapshot(const String& path) {
+    String filePath = ProjectSettings::get_singleton()->globalize_path(path);
+    auto start = std::chrono::steady_clock::now();
+    if (!state.loadSnapshot(filePath.utf8().get_data())) {
+        DEVICE_LOG_INFO("❌ Cannot restore ward from {}", filePath.utf8().get_data());
+        return false;
+    }
+    
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    DEVICE_LOG_INFO("Ward restored: {} beds in {} us", state.size(), us);
+    return true;
+}
+
+Dictionary BedWard::runMaintenance() const {
+    std::vector<MaintenanceRecord> records;
+    MaintenanceSweep::Summary summary = MaintenanceSweep::run(
+        state.size(), [this](size_t slot) { return state.inspect(slot); }, records, &WorkerPool::shared());
+    DEVICE_LOG_INFO("🔧 Ward maintenance: {} beds, {} with faults, {} us", summary.checked, summary.faulty(),
+                    summary.durationUs);
+    return Bed::makeMaintenanceReport(records, summary);
+}
+
+Ref<BedView> BedWard::getBed(int slot) {
+    if (slot < 0 || static_cast<size_t>(slot) >= state.size()) {
+        DEVICE_LOG_INFO("❌ No bed in ward slot {}", slot);
+        return Ref<BedView>();
+    }
+    
+    Ref<BedView> view;
+    view.instantiate();
+    view->attach(this, slot);
+    return view;
+}
+
+void BedWard::_physics_process(double delta) {
+    state.step(delta);
+}
+
+bool BedWard::resolveMask(const PackedByteArray& mask, const uint8_t*& bytes) const {
+    if (mask.is_empty()) {
+        bytes = nullptr;
+        return true;
+    }
+    if (static_cast<size_t>(mask.size()) != state.size()) {
+        DEVICE_LOG_INFO("❌ Mask covers {} beds, ward has {}", mask.size(), state.size());
+        return false;
+    }
+    bytes = mask.ptr();
+    return true;
+}
+
+bool BedWard::isValidTemperature(int mode) const {
+    if (mode < static_cast<int>(TemperatureMode::COLD) || mode > static_cast<int>(TemperatureMode::WARM)) {
+        DEVICE_LOG_INFO("❌ Unknown temperature mode: {}", mode);
+        return false;
+    }
+    return true;
+}
+
+void BedWard::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_beds", "count", "kind"), &BedWard::addBeds, DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("clear_beds"), &BedWard::clearBeds);
+    ClassDB::bind_method(D_METHOD("get_bed_count"), &BedWard::getBedCount);
+    ClassDB::bind_method(D_METHOD("power_on", "mask"), &BedWard::powerOn, DEFVAL(PackedByteArray()));
+    ClassDB::bind_method(D_METHOD("power_off", "mask"), &BedWard::powerOff, DEFVAL(PackedByteArray()));
+    ClassDB::bind_method(D_METHOD("set_heights", "heights"), &BedWard::setHeights);
+    ClassDB::bind_method(D_METHOD("set_height_masked", "mask", "height"), &BedWard::setHeightMasked);
+    ClassDB::bind_method(D_METHOD("set_temperature", "mask", "mode"), &BedWard::setTemperature);
+    ClassDB::bind_method(D_METHOD("set_lights", "mask", "on"), &BedWard::setLights);
+    ClassDB::bind_method(D_METHOD("set_light_brightness", "mask", "brightness"), &BedWard::setLightBrightness);
+    ClassDB::bind_method(D_METHOD("set_light_color", "mask", "color"), &BedWard::setLightColor);
+    ClassDB::bind_method(D_METHOD("trigger_emergency", "mask"), &BedWard::triggerEmergency, DEFVAL(PackedByteArray()));
+    ClassDB::bind_method(D_METHOD("clear_emergency", "mask"), &BedWard::clearEmergency, DEFVAL(PackedByteArray()));
+    ClassDB::bind_method(D_METHOD("get_heights"), &BedWard::getHeights);
+    ClassDB::bind_method(D_METHOD("get_power_states"), &BedWard::getPowerStates);
+    ClassDB::bind_method(D_METHOD("get_temperature_modes"), &BedWard::getTemperatureModes);
+    ClassDB::bind_method(D_METHOD("get_light_states"), &BedWard::getLightStates);
+    ClassDB::bind_method(D_METHOD("get_emergency_flags"), &BedWard::getEmergencyFlags);
+    ClassDB::bind_method(D_METHOD("get_powered_count"), &BedWard::getPoweredCount);
+    ClassDB::bind_method(D_METHOD("get_emergency_count"), &BedWard::getEmergencyCount);
+    ClassDB::bind_method(D_METHOD("execute_commands", "commands"), &BedWard::executeCommands);
+    ClassDB::bind_method(D_METHOD("save_snapshot", "path"), &BedWard::saveSnapshot);
+    ClassDB::bind_method(D_METHOD("load_snapshot", "path"), &BedWard::loadSnapshot);
+    ClassDB::bind_method(D_METHOD("run_maintenance"), &BedWard::runMaintenance);
+    ClassDB::bind_method(D_METHOD("get_bed", "slot"), &BedWard::getBed);
+    
+    // Bed kind constants
+    BIND_CONSTANT(BED_PATIENT);
+    BIND_CONSTANT(BED_SURGICAL);
+}
+
+BedView::BedView() : wardId(0), slot(-1) {}
+
+void BedView::attach(const BedWard* ward, int wardSlot) {
+    wardId = ward ? ward->get_instance_id() : 0;
+    slot = wardSlot;
+}
+
+BedWardState* BedView::resolve() const {
+    BedWard* ward = Object::cast_to<BedWard>(ObjectDB::get_instance(wardId));
+    if (!ward || slot < 0 || static_cast<size_t>(slot) >= ward->getState().size()) {
+        return nullptr;
+    }
+    return &ward->getState();
+}
+
+void BedView::powerOn() {
+    if (BedWardState* state = resolve()) {
+        state->powerOn(static_cast<size_t>(slot));
+    }
+}
+
+void BedView::powerOff() {
+    if (BedWardState* state = resolve()) {
+        state->powerOff(static_cast<size_t>(slot));
+    }
+}
+
+bool BedView::isPoweredOn() const {
+    const BedWardState* state = resolve();
+    return state && state->getPowered()[slot];
+}
+
+bool BedView::setHeight(float height) {
+    BedWardState* state = resolve();
+    if (!state || !state->setHeight(static_cast<size_t>(slot), height)) {
+        DEVICE_LOG_DEBUG("Ward bed {} cannot move to {} cm", slot, height);
+        return false;
+    }
+    return true;
+}
+
+float BedView::getHeight() const {
+    const BedWardState* state = resolve();
+    return state ? state->getHeights()[slot] : 0.0f;
+}
+
+float BedView::getTargetHeight() const {
+    const BedWardState* state = resolve();
+    return state ? state->getTargetHeight(static_cast<size_t>(slot)) : 0.0f;
+}
+
+bool BedView::isHeightMoving() const {
+    const BedWardState* state = resolve();
+    return state && state->isHeightMoving(static_cast<size_t>(slot));
+}
+
+void BedView::setTemperature(int mode) {
+    BedWardState* state = resolve();
+    if (!state) {
+        return;
+    }
+    if (mode < static_cast<int>(TemperatureMode::COLD) || mode > static_cast<int>(TemperatureMode::WARM)) {
+        DEVICE_LOG_INFO("❌ Unknown temperature mode: {}", mode);
+        return;
+    }
+    state->setTemperature(static_cast<size_t>(slot), static_cast<TemperatureMode>(mode));
+}
+
+int BedView::getCurrentTemperature() const {
+    const BedWardState* state = resolve();
+    return state ? state->getTemperatureModes()[slot] : static_cast<int>(TemperatureMode::NEUTRAL);
+}
+
+float BedView::getTemperatureValue() const {
+    return BedWardState::getTemperatureValue(static_cast<TemperatureMode>(getCurrentTemperature()));
+}
+
+void BedView::activateLights() {
+    if (BedWardState* state = resolve()) {
+        state->setLights(static_cast<size_t>(slot), true);
+    }
+}
+
+void BedView::deactivateLights() {
+    if (BedWardState* state = resolve()) {
+        state->setLights(static_cast<size_t>(slot), false);
+    }
+}
+
+bool BedView::areLightsOn() const {
+    const BedWardState* state = resolve();
+    return state && state->getLightsOn()[slot];
+}
+
+void BedView::setLightBrightness(float brightness) {
+    if (BedWardState* state = resolve()) {
+        state->setBrightness(static_cast<size_t>(slot), brightness);
+    }
+}
+
+void BedView::setLightColor(const Color& color) {
+    if (BedWardState* state = resolve()) {
+        state->setColor(static_cast<size_t>(slot), PackedColor::fromFloat(color.r, color.g, color.b, color.a));
+    }
+}
+
+void BedView::triggerEmergency() {
+    BedWardState* state = resolve();
+    if (state && state->setEmergency(static_cast<size_t>(slot), true)) {
+        DEVICE_LOG_ALERT("🚨 EMERGENCY TRIGGERED on ward bed {}", slot);
+    }
+}
+
+void BedView::clearEmergency() {
+    BedWardState* state = resolve();
+    if (state && state->setEmergency(static_cast<size_t>(slot), false)) {
+        DEVICE_LOG_ALERT("Emergency cleared on ward bed {}", slot);
+    }
+}
+
+bool BedView::isEmergencyActive() const {
+    const BedWardState* state = resolve();
+    return state && state->getEmergency()[slot];
+}
+
+void BedView::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("is_valid"), &BedView::isValid);
+    ClassDB::bind_method(D_METHOD("get_slot"), &BedView::getSlot);
+    ClassDB::bind_method(D_METHOD("power_on"), &BedView::powerOn);
+    ClassDB::bind_method(D_METHOD("power_off"), &BedView::powerOff);
+    ClassDB::bind_method(D_METHOD("is_powered_on"), &BedView::isPoweredOn);
+    ClassDB::bind_method(D_METHOD("set_height", "height"), &BedView::setHeight);
+    ClassDB::bind_method(D_METHOD("get_height"), &BedView::getHeight);
+    ClassDB::bind_method(D_METHOD("get_target_height"), &BedView::getTargetHeight);
+    ClassDB::bind_method(D_METHOD("is_height_moving"), &BedView::isHeightMoving);
+    ClassDB::bind_method(D_METHOD("set_temperature", "mode"), &BedView::setTemperature);
+    ClassDB::bind_method(D_METHOD("get_current_temperature"), &BedView::getCurrentTemperature);
+    ClassDB::bind_method(D_METHOD("get_temperature_value"), &BedView::getTemperatureValue);
+    ClassDB::bind_method(D_METHOD("activate_lights"), &BedView::activateLights);
+    ClassDB::bind_method(D_METHOD("deactivate_lights"), &BedView::deactivateLights);
+    ClassDB::bind_method(D_METHOD("are_lights_on"), &BedView::areLightsOn);
+    ClassDB::bind_method(D_METHOD("set_light_brightness", "intensity"), &BedView::setLightBrightness);
+    ClassDB::bind_method(D_METHOD("set_light_color", "color"), &BedView::setLightColor);
+    ClassDB::bind_method(D_METHOD("trigger_emergency"), &BedView::triggerEmergency);
+    ClassDB::bind_method(D_METHOD("clear_emergency"), &BedView::clearEmergency);
+    ClassDB::bind_method(D_METHOD("is_emergency_active"), &BedView::isEmergencyActive);
+}
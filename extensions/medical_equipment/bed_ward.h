@@ -0,0 +1,146 @@
+#ifndef BED_WARD_H
+#define BED_WARD_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "bed_ward_state.h"
+#include <cstdint>
+
+using namespace godot;
+
+class BedView;
+
+/**
+ * @class BedWard
+ * @brief Godot node holding the hot state of hundreds of beds in one place
+ *
+ * Beds here are slots in a BedWardState, not nodes: scripts drive the whole
+ * ward with one call per operation and read results back as packed arrays.
+ * Masks are PackedByteArrays with one byte per bed, nonzero selecting it;
+ * an empty mask selects every bed. Lifts move from _physics_process().
+ * get_bed() hands out a BedView for scripts that want one bed at a time;
+ * execute_commands() runs a mixed batch for many beds in a single call.
+ */
+class BedWard : public Node {
+    GDCLASS(BedWard, Node)
+
+public:
+    // Bed kind constants for GDScript binding
+    static const int BED_PATIENT = static_cast<int>(BedWardState::BedKind::PATIENT);
+    static const int BED_SURGICAL = static_cast<int>(BedWardState::BedKind::SURGICAL);
+
+private:
+    BedWardState state;
+
+public:
+    BedWard();
+    ~BedWard() = default;
+
+    // Ward layout; returns the first new slot, or -1
+    int addBeds(int count, int kind);
+    void clearBeds();
+    int getBedCount() const { return static_cast<int>(state.size()); }
+
+    // Batch operations; each returns the number of beds it changed
+    int powerOn(const PackedByteArray& mask);
+    int powerOff(const PackedByteArray& mask);
+    int setHeights(const PackedFloat32Array& heights);
+    int setHeightMasked(const PackedByteArray& mask, float height);
+    int setTemperature(const PackedByteArray& mask, int mode);
+    int setLights(const PackedByteArray& mask, bool on);
+    int setLightBrightness(const PackedByteArray& mask, float brightness);
+    int setLightColor(const PackedByteArray& mask, const Color& color);
+    int triggerEmergency(const PackedByteArray& mask);
+    int clearEmergency(const PackedByteArray& mask);
+
+    // Whole-ward queries, one entry per bed
+    PackedFloat32Array getHeights() const;
+    PackedByteArray getPowerStates() const;
+    PackedByteArray getTemperatureModes() const;
+    PackedByteArray getLightStates() const;
+    PackedByteArray getEmergencyFlags() const;
+    int getPoweredCount() const { return static_cast<int>(state.countPowered()); }
+    int getEmergencyCount() const { return static_cast<int>(state.countEmergencies()); }
+    
+    // Runs a command stream (opcodes are Bed.COMMAND_*) in one call; one status byte per command
+    PackedByteArray executeCommands(const PackedByteArray& commands);
+    
+    // Whole-ward snapshot files; loading replaces every bed in the ward
+    bool saveSnapshot(const String& path) const;
+    bool loadSnapshot(const String& path);
+    
+    // Maintenance checks of every slot on the worker pool, reported like Bed.run_maintenance_sweep
+    Dictionary runMaintenance() const;
+
+    // One-bed view onto a slot
+    Ref<BedView> getBed(int slot);
+
+    void _physics_process(double delta) override;
+
+    BedWardState& getState() { return state; }
+    const BedWardState& getState() const { return state; }
+
+protected:
+    static void _bind_methods();
+
+private:
+    // Null for an empty mask; false if the mask does not cover the ward exactly
+    bool resolveMask(const PackedByteArray& mask, const uint8_t*& bytes) const;
+    bool isValidTemperature(int mode) const;
+};
+
+/**
+ * @class BedView
+ * @brief One slot of a BedWard with the familiar per-bed methods
+ *
+ * Holds no state of its own: every call reads or writes the ward's arrays.
+ * The ward is tracked by instance id, so a view outliving its ward, or a
+ * slot removed by clear_beds(), is simply invalid.
+ */
+class BedView : public RefCounted {
+    GDCLASS(BedView, RefCounted)
+
+private:
+    uint64_t wardId;
+    int slot;
+
+public:
+    BedView();
+    ~BedView() = default;
+
+    void attach(const BedWard* ward, int slot);
+    bool isValid() const { return resolve() != nullptr; }
+    int getSlot() const { return slot; }
+
+    void powerOn();
+    void powerOff();
+    bool isPoweredOn() const;
+    bool setHeight(float height);
+    float getHeight() const;
+    float getTargetHeight() const;
+    bool isHeightMoving() const;
+    void setTemperature(int mode);
+    int getCurrentTemperature() const;
+    float getTemperatureValue() const;
+    void activateLights();
+    void deactivateLights();
+    bool areLightsOn() const;
+    void setLightBrightness(float brightness);
+    void setLightColor(const Color& color);
+    void triggerEmergency();
+    void clearEmergency();
+    bool isEmergencyActive() const;
+
+protected:
+    static void _bind_methods();
+
+private:
+    BedWardState* resolve() const;
+};
+
+#endif // BED_WARD_H
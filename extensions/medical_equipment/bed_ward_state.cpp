@@ -0,0 +1,480 @@
+#include "bed_ward_state.h"
+#include "device_log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+struct KindSpec {
+    float minHeight;
+    float maxHeight;
+    float defaultHeight;
+};
+
+// Same ranges and defaults as PatientBed and SurgicalBed
+constexpr KindSpec kPatientSpec{40.0f, 90.0f, 55.0f};
+constexpr KindSpec kSurgicalSpec{60.0f, 120.0f, 85.0f};
+
+const KindSpec& specFor(BedWardState::BedKind kind) {
+    return kind == BedWardState::BedKind::SURGICAL ? kSurgicalSpec : kPatientSpec;
+}
+
+constexpr uint8_t kNeutral = static_cast<uint8_t>(BedWardState::TemperatureMode::NEUTRAL);
+
+template <typename T>
+void copyColumn(const BedSnapshotMapping& mapping, BedSnapshotFormat::Column column, std::vector<T>& target) {
+    target.resize(mapping.getCount());
+    if (!target.empty()) {
+        std::memcpy(target.data(), mapping.getColumn(column), target.size() * sizeof(T));
+    }
+}
+
+// Command stream selections other than a slot
+constexpr size_t kAllSlots = static_cast<size_t>(-1);
+constexpr size_t kNoSlot = static_cast<size_t>(-2);
+
+} // namespace
+
+BedWardState::BedWardState(double timestep) : fleet(timestep), liftsMoving(false) {}
+
+size_t BedWardState::addBeds(size_t count, BedKind kind) {
+    size_t first = size();
+    const KindSpec& spec = specFor(kind);
+
+    heights.resize(first + count, spec.defaultHeight);
+    powered.resize(first + count, 0);
+    temperatureModes.resize(first + count, kNeutral);
+    lightsOn.resize(first + count, 0);
+    brightness.resize(first + count, 1.0f);
+    colors.resize(first + count, PackedColor(255, 255, 255));
+    emergency.resize(first + count, 0);
+    kinds.resize(first + count, kind);
+    lifts.resize(first + count, HeightActuator(spec.defaultHeight, spec.minHeight, spec.maxHeight));
+    bindFleet();
+    return first;
+}
+
+void BedWardState::clear() {
+    heights.clear();
+    powered.clear();
+    temperatureModes.clear();
+    lightsOn.clear();
+    brightness.clear();
+    colors.clear();
+    emergency.clear();
+    kinds.clear();
+    lifts.clear();
+    fleet.setActuators({});
+    liftsMoving = false;
+}
+
+bool BedWardState::powerOn(size_t slot) {
+    if (slot >= size() || powered[slot]) {
+        return false;
+    }
+    
+    // Powering on resets comfort defaults, like Bed::powerOn
+    powered[slot] = 1;
+    temperatureModes[slot] = kNeutral;
+    lightsOn[slot] = 1;
+    return true;
+}
+
+bool BedWardState::powerOff(size_t slot) {
+    if (slot >= size() || !powered[slot]) {
+        return false;
+    }
+    
+    powered[slot] = 0;
+    lightsOn[slot] = 0;
+    return true;
+}
+
+bool BedWardState::setHeight(size_t slot, float height) {
+    if (slot >= size() || !powered[slot] || !lifts[slot].moveTo(height)) {
+        return false;
+    }
+    liftsMoving = liftsMoving || lifts[slot].isMoving();
+    return true;
+}
+
+bool BedWardState::queueHeight(size_t slot, float height) {
+    if (slot >= size() || !powered[slot] || !lifts[slot].enqueue(height)) {
+        return false;
+    }
+    liftsMoving = liftsMoving || lifts[slot].isMoving();
+    return true;
+}
+
+bool BedWardState::stopHeight(size_t slot) {
+    if (slot >= size() || !lifts[slot].isMoving()) {
+        return false;
+    }
+    lifts[slot].stop();
+    return true;
+}
+
+bool BedWardState::setTemperature(size_t slot, TemperatureMode mode) {
+    // A powered-off bed ignores comfort changes, like Bed::setTemperature
+    if (slot >= size() || !powered[slot]) {
+        return false;
+    }
+    temperatureModes[slot] = static_cast<uint8_t>(mode);
+    return true;
+}
+
+bool BedWardState::setLights(size_t slot, bool on) {
+    if (slot >= size()) {
+        return false;
+    }
+    lightsOn[slot] = on ? 1 : 0;
+    return true;
+}
+
+bool BedWardState::setBrightness(size_t slot, float value) {
+    // NaN would survive the clamp and make the ward's own snapshots unloadable
+    if (slot >= size() || std::isnan(value)) {
+        return false;
+    }
+    brightness[slot] = std::min(std::max(value, 0.0f), 1.0f);
+    return true;
+}
+
+bool BedWardState::setColor(size_t slot, PackedColor color) {
+    if (slot >= size()) {
+        return false;
+    }
+    colors[slot] = color;
+    return true;
+}
+
+bool BedWardState::setEmergency(size_t slot, bool active) {
+    if (slot >= size() || (emergency[slot] != 0) == active) {
+        return false;
+    }
+    emergency[slot] = active ? 1 : 0;
+    return true;
+}
+
+template <typename Operation>
+size_t BedWardState::forEachSelected(const uint8_t* mask, Operation operation) {
+    size_t changed = 0;
+    for (size_t i = 0; i < size(); ++i) {
+        if ((!mask || mask[i]) && operation(i)) {
+            ++changed;
+        }
+    }
+    return changed;
+}
+
+size_t BedWardState::powerOnMasked(const uint8_t* mask) {
+    return forEachSelected(mask, [this](size_t i) { return powerOn(i); });
+}
+
+size_t BedWardState::powerOffMasked(const uint8_t* mask) {
+    return forEachSelected(mask, [this](size_t i) { return powerOff(i); });
+}
+
+size_t BedWardState::setHeightMasked(const uint8_t* mask, float height) {
+    return forEachSelected(mask, [this, height](size_t i) { return setHeight(i, height); });
+}
+
+size_t BedWardState::setTemperatureMasked(const uint8_t* mask, TemperatureMode mode) {
+    return forEachSelected(mask, [this, mode](size_t i) { return setTemperature(i, mode); });
+}
+
+size_t BedWardState::setLightsMasked(const uint8_t* mask, bool on) {
+    return forEachSelected(mask, [this, on](size_t i) {
+        lightsOn[i] = on ? 1 : 0;
+        return true;
+    });
+}
+
+size_t BedWardState::setBrightnessMasked(const uint8_t* mask, float value) {
+    if (std::isnan(value)) {
+        return 0;
+    }
+    float clamped = std::min(std::max(value, 0.0f), 1.0f);
+    return forEachSelected(mask, [this, clamped](size_t i) {
+        brightness[i] = clamped;
+        return true;
+    });
+}
+
+size_t BedWardState::setColorMasked(const uint8_t* mask, PackedColor color) {
+    return forEachSelected(mask, [this, color](size_t i) {
+        colors[i] = color;
+        return true;
+    });
+}
+
+size_t BedWardState::setEmergencyMasked(const uint8_t* mask, bool active) {
+    return forEachSelected(mask, [this, active](size_t i) { return setEmergency(i, active); });
+}
+
+size_t BedWardState::setHeights(const float* targets, size_t count) {
+    size_t accepted = 0;
+    size_t beds = std::min(count, size());
+    for (size_t i = 0; i < beds; ++i) {
+        if (setHeight(i, targets[i])) {
+            ++accepted;
+        }
+    }
+    return accepted;
+}
+
+size_t BedWardState::executeCommands(const uint8_t* commands, size_t length, uint8_t* statuses) {
+    size_t selected = kAllSlots;
+    return runBedCommands(commands, length, statuses, [&](const BedCommand& command) {
+        // Selection and the checks that do not depend on the bed
+        switch (command.opcode) {
+            case BedCommand::SELECT_ALL:
+                selected = kAllSlots;
+                return BedCommand::OK;
+            case BedCommand::SELECT_BED:
+                // A bad slot selects nothing, so what follows cannot land on the wrong bed
+                selected = command.slot < size() ? command.slot : kNoSlot;
+                return selected == kNoSlot ? BedCommand::INVALID_ARGUMENT : BedCommand::OK;
+            case BedCommand::SET_TEMPERATURE:
+                if (command.mode > static_cast<uint8_t>(TemperatureMode::WARM)) {
+                    return BedCommand::INVALID_ARGUMENT;
+                }
+                break;
+            case BedCommand::SET_HEIGHT:
+            case BedCommand::RAISE_HEIGHT:
+            case BedCommand::LOWER_HEIGHT:
+            case BedCommand::QUEUE_HEIGHT:
+            case BedCommand::SET_LIGHT_BRIGHTNESS:
+                if (std::isnan(command.value)) {
+                    return BedCommand::INVALID_ARGUMENT;
+                }
+                break;
+            default:
+                break;
+        }
+
+        if (selected == kNoSlot) {
+            return BedCommand::NO_TARGET;
+        }
+        if (selected != kAllSlots) {
+            return applyCommand(selected, command);
+        }
+
+        // Statuses are ordered best first, so the ward reports its best bed; refusals by the rest are hidden
+        BedCommand::Status best = BedCommand::NO_TARGET;
+        for (size_t i = 0; i < size(); ++i) {
+            best = std::min(best, applyCommand(i, command));
+        }
+        return best;
+    });
+}
+
+BedCommand::Status BedWardState::applyCommand(size_t slot, const BedCommand& command) {
+    switch (command.opcode) {
+        case BedCommand::POWER_ON:
+            powerOn(slot);
+            return BedCommand::OK;
+        case BedCommand::POWER_OFF:
+            powerOff(slot);
+            return BedCommand::OK;
+        case BedCommand::SET_HEIGHT:
+        case BedCommand::RAISE_HEIGHT:
+        case BedCommand::LOWER_HEIGHT:
+        case BedCommand::QUEUE_HEIGHT: {
+            if (!powered[slot]) {
+                return BedCommand::REJECTED;
+            }
+            
+            // Relative moves start from where the lift is headed, like Bed::raiseHeight
+            HeightActuator& lift = lifts[slot];
+            float target = command.value;
+            if (command.opcode == BedCommand::RAISE_HEIGHT) {
+                target = lift.getFinalTarget() + command.value;
+            } else if (command.opcode == BedCommand::LOWER_HEIGHT) {
+                target = lift.getFinalTarget() - command.value;
+            }
+            if (target < lift.getMinPosition() || target > lift.getMaxPosition()) {
+                return BedCommand::INVALID_ARGUMENT;
+            }
+            
+            bool queued = command.opcode == BedCommand::QUEUE_HEIGHT;
+            if (queued ? !lift.enqueue(target) : !lift.moveTo(target)) {
+                return BedCommand::REJECTED;
+            }
+            liftsMoving = liftsMoving || lift.isMoving();
+            return BedCommand::OK;
+        }
+        case BedCommand::STOP_HEIGHT:
+            stopHeight(slot);
+            return BedCommand::OK;
+        case BedCommand::SET_TEMPERATURE:
+            return setTemperature(slot, static_cast<TemperatureMode>(command.mode)) ? BedCommand::OK
+                                                                                     : BedCommand::REJECTED;
+        case BedCommand::ACTIVATE_LIGHTS:
+        case BedCommand::DEACTIVATE_LIGHTS:
+            lightsOn[slot] = command.opcode == BedCommand::ACTIVATE_LIGHTS ? 1 : 0;
+            return BedCommand::OK;
+        case BedCommand::SET_LIGHT_BRIGHTNESS:
+            brightness[slot] = std::min(std::max(command.value, 0.0f), 1.0f);
+            return BedCommand::OK;
+        case BedCommand::SET_LIGHT_COLOR:
+            colors[slot] = command.color;
+            return BedCommand::OK;
+        case BedCommand::TRIGGER_EMERGENCY:
+        case BedCommand::CLEAR_EMERGENCY:
+            emergency[slot] = command.opcode == BedCommand::TRIGGER_EMERGENCY ? 1 : 0;
+            return BedCommand::OK;
+        default:
+            return BedCommand::UNSUPPORTED;
+    }
+}
+
+int BedWardState::step(double frameDelta) {
+    if (!liftsMoving) {
+        return 0;
+    }
+    
+    int steps = fleet.advance(frameDelta);
+    if (steps > 0) {
+        refreshHeights();
+    }
+    return steps;
+}
+
+bool BedWardState::saveSnapshot(const std::string& path) const {
+    std::vector<float> targets(size());
+    for (size_t i = 0; i < size(); ++i) {
+        targets[i] = lifts[i].getFinalTarget();
+    }
+    
+    // In BedSnapshotFormat::Column order
+    const void* columns[] = {heights.data(), targets.data(), powered.data(), temperatureModes.data(),
+                             lightsOn.data(), brightness.data(), colors.data(), emergency.data(), kinds.data()};
+    static_assert(sizeof(columns) / sizeof(columns[0]) == static_cast<size_t>(BedSnapshotFormat::Column::COUNT),
+                  "every snapshot column needs a source");
+    return BedSnapshotFormat::writeWardColumns(path, size(), columns);
+}
+
+bool BedWardState::loadSnapshot(const std::string& path) {
+    using BedSnapshotFormat::Column;
+    BedSnapshotMapping mapping;
+    if (!mapping.open(path, BedSnapshotFormat::Payload::WARD_COLUMNS)) {
+        return false;
+    }
+    
+    if (!validateSnapshot(mapping)) {
+        DEVICE_LOG_INFO("❌ Invalid ward snapshot {}", path);
+        return false;
+    }
+    
+    size_t count = mapping.getCount();
+    copyColumn(mapping, Column::HEIGHT, heights);
+    copyColumn(mapping, Column::POWERED, powered);
+    copyColumn(mapping, Column::TEMPERATURE, temperatureModes);
+    copyColumn(mapping, Column::LIGHTS_ON, lightsOn);
+    copyColumn(mapping, Column::BRIGHTNESS, brightness);
+    copyColumn(mapping, Column::COLOR, colors);
+    copyColumn(mapping, Column::EMERGENCY, emergency);
+    copyColumn(mapping, Column::KIND, kinds);
+    
+    const float* targets = reinterpret_cast<const float*>(mapping.getColumn(Column::TARGET_HEIGHT));
+    lifts.clear();
+    lifts.reserve(count);
+    liftsMoving = false;
+    for (size_t i = 0; i < count; ++i) {
+        const KindSpec& spec = specFor(kinds[i]);
+        float height = heights[i];
+        lifts.emplace_back(height, spec.minHeight, spec.maxHeight);
+        if (powered[i] && targets[i] != height) {
+            lifts[i].moveTo(targets[i]);
+        }
+        heights[i] = lifts[i].getPosition();
+        liftsMoving = liftsMoving || lifts[i].isMoving();
+    }
+    bindFleet();
+    return true;
+}
+
+bool BedWardState::validateSnapshot(const BedSnapshotMapping& mapping) {
+    using BedSnapshotFormat::Column;
+    size_t count = mapping.getCount();
+    const uint8_t* kindColumn = mapping.getColumn(Column::KIND);
+    const uint8_t* temperatures = mapping.getColumn(Column::TEMPERATURE);
+    const float* heightColumn = reinterpret_cast<const float*>(mapping.getColumn(Column::HEIGHT));
+    const float* targets = reinterpret_cast<const float*>(mapping.getColumn(Column::TARGET_HEIGHT));
+    const float* levels = reinterpret_cast<const float*>(mapping.getColumn(Column::BRIGHTNESS));
+    const uint8_t* flags[] = {mapping.getColumn(Column::POWERED), mapping.getColumn(Column::LIGHTS_ON),
+                              mapping.getColumn(Column::EMERGENCY)};
+    
+    // One pass over the columns before any is copied; comparisons fail for NaN, so it is
+    // rejected with anything out of range. Every RGBA8 value is a valid color.
+    for (size_t i = 0; i < count; ++i) {
+        if (kindColumn[i] > static_cast<uint8_t>(BedKind::SURGICAL) ||
+            temperatures[i] > static_cast<uint8_t>(TemperatureMode::WARM) ||
+            !(levels[i] >= 0.0f && levels[i] <= 1.0f)) {
+            return false;
+        }
+        for (const uint8_t* column : flags) {
+            if (column[i] > 1) {
+                return false;
+            }
+        }
+        
+        const KindSpec& spec = specFor(static_cast<BedKind>(kindColumn[i]));
+        if (!(heightColumn[i] >= spec.minHeight && heightColumn[i] <= spec.maxHeight) ||
+            !(targets[i] >= spec.minHeight && targets[i] <= spec.maxHeight)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BedWardState::bindFleet() {
+    // Growing the column may have moved every actuator
+    std::vector<HeightActuator*> pointers;
+    pointers.reserve(lifts.size());
+    for (HeightActuator& lift : lifts) {
+        pointers.push_back(&lift);
+    }
+    fleet.setActuators(std::move(pointers));
+}
+
+void BedWardState::refreshHeights() {
+    bool moving = false;
+    for (size_t i = 0; i < lifts.size(); ++i) {
+        heights[i] = lifts[i].getPosition();
+        moving = moving || lifts[i].isMoving();
+    }
+    liftsMoving = moving;
+}
+
+MaintenanceRecord BedWardState::inspect(size_t slot) const {
+    // Every ward bed has lights and temperature control; the checks are the ones Bed runs
+    MaintenanceRecord record;
+    const KindSpec& spec = specFor(kinds[slot]);
+    record.recordPower(powered[slot] != 0);
+    record.recordLift(heights[slot], spec.minHeight, spec.maxHeight, lifts[slot].isMoving());
+    record.recordLights(true, emergency[slot] != 0);
+    record.recordTemperature(true, temperatureModes[slot]);
+    return record;
+}
+
+size_t BedWardState::countPowered() const {
+    return static_cast<size_t>(std::count_if(powered.begin(), powered.end(), [](uint8_t on) { return on != 0; }));
+}
+
+size_t BedWardState::countEmergencies() const {
+    return static_cast<size_t>(std::count_if(emergency.begin(), emergency.end(), [](uint8_t on) { return on != 0; }));
+}
+
+float BedWardState::getTemperatureValue(TemperatureMode mode) {
+    switch (mode) {
+        case TemperatureMode::COLD:
+            return 18.0f;
+        case TemperatureMode::WARM:
+            return 26.0f;
+        default:
+            return 22.0f;
+    }
+}
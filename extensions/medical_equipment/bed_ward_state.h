@@ -0,0 +1,135 @@
+#ifndef BED_WARD_STATE_H
+#define BED_WARD_STATE_H
+
+#include "bed_commands.h"
+#include "bed_snapshot.h"
+#include "height_actuator.h"
+#include "maintenance_sweep.h"
+#include "packed_color.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class BedWardState
+ * @brief Hot state of a whole ward of beds, one contiguous array per field
+ *
+ * Height, power, temperature mode, light state and the emergency flag of
+ * bed i live at index i of their own array, so batch operations and
+ * whole-ward queries are straight loops over a few kilobytes instead of a
+ * walk over hundreds of nodes. Lift motion plans sit in a separate,
+ * colder column and are stepped together by an ActuatorFleet; the height
+ * column is refreshed after every step.
+ *
+ * The *Masked operations take a byte mask with one entry per bed (nonzero
+ * selects the bed), or nullptr for every bed, and return how many beds
+ * they changed. Like a Bed, a powered-off bed ignores height commands.
+ */
+class BedWardState {
+public:
+    enum class BedKind : uint8_t { PATIENT, SURGICAL };
+    enum class TemperatureMode : uint8_t { COLD, NEUTRAL, WARM };
+
+    explicit BedWardState(double timestep = HeightActuator::kDefaultTimestep);
+
+    // Appends beds at the kind's default height; returns the first new slot
+    size_t addBeds(size_t count, BedKind kind);
+    void clear();
+    size_t size() const { return heights.size(); }
+
+    // Single-bed operations, for views onto one slot
+    bool powerOn(size_t slot);
+    bool powerOff(size_t slot);
+    bool setHeight(size_t slot, float height);
+    bool queueHeight(size_t slot, float height);
+    bool stopHeight(size_t slot);
+    bool setTemperature(size_t slot, TemperatureMode mode);
+    bool setLights(size_t slot, bool on);
+    bool setBrightness(size_t slot, float brightness);  // clamped to [0, 1]; NaN is rejected
+    bool setColor(size_t slot, PackedColor color);
+    bool setEmergency(size_t slot, bool active);
+
+    // Batch operations over a mask of size() bytes, or every bed when mask is nullptr
+    size_t powerOnMasked(const uint8_t* mask);
+    size_t powerOffMasked(const uint8_t* mask);
+    size_t setHeightMasked(const uint8_t* mask, float height);
+    size_t setTemperatureMasked(const uint8_t* mask, TemperatureMode mode);
+    size_t setLightsMasked(const uint8_t* mask, bool on);
+    size_t setBrightnessMasked(const uint8_t* mask, float brightness);
+    size_t setColorMasked(const uint8_t* mask, PackedColor color);
+    size_t setEmergencyMasked(const uint8_t* mask, bool active);
+
+    // One target per bed; out-of-range targets and powered-off beds are skipped
+    size_t setHeights(const float* targets, size_t count);
+
+    /**
+     * Runs a command stream (see BedCommand) and writes one status per command.
+     * Commands apply to every bed until a SELECT_BED. With every bed selected
+     * the status is the best any bed returned: OK if any bed took the command,
+     * even when others refused it (powered off, out of their range). Select
+     * beds one at a time, or check the columns, when every bed must take it.
+     * statuses needs room for length bytes.
+     * @return the number of statuses written
+     */
+    size_t executeCommands(const uint8_t* commands, size_t length, uint8_t* statuses);
+
+    /**
+     * Whole-ward snapshots: one contiguous block per column (see BedSnapshotFormat).
+     * Loading maps the file and copies each column in; lifts start from rest
+     * at the saved height and head for the saved target.
+     * @return false if the file cannot be written, or read as a ward snapshot
+     */
+    bool saveSnapshot(const std::string& path) const;
+    bool loadSnapshot(const std::string& path);
+
+    // Advances every moving lift at the fixed timestep; returns the substeps taken
+    int step(double frameDelta);
+
+    // Columns, each size() long
+    const float* getHeights() const { return heights.data(); }
+    const uint8_t* getPowered() const { return powered.data(); }
+    const uint8_t* getTemperatureModes() const { return temperatureModes.data(); }
+    const uint8_t* getLightsOn() const { return lightsOn.data(); }
+    const float* getBrightness() const { return brightness.data(); }
+    const PackedColor* getColors() const { return colors.data(); }
+    const uint8_t* getEmergency() const { return emergency.data(); }
+
+    BedKind getKind(size_t slot) const { return kinds[slot]; }
+    float getTargetHeight(size_t slot) const { return lifts[slot].getFinalTarget(); }
+    bool isHeightMoving(size_t slot) const { return lifts[slot].isMoving(); }
+    // The Bed maintenance checks applied to one slot; read-only, safe from worker threads
+    MaintenanceRecord inspect(size_t slot) const;
+
+    size_t countPowered() const;
+    size_t countEmergencies() const;
+
+    // Temperature of a mode in Celsius, as StandardTemperatureControl sets it
+    static float getTemperatureValue(TemperatureMode mode);
+
+private:
+    template <typename Operation>
+    size_t forEachSelected(const uint8_t* mask, Operation operation);
+
+    void refreshHeights();
+    void bindFleet();
+    
+    // Every column of a ward snapshot is in range for its bed kind
+    static bool validateSnapshot(const BedSnapshotMapping& mapping);
+    BedCommand::Status applyCommand(size_t slot, const BedCommand& command);
+
+    std::vector<float> heights;
+    std::vector<uint8_t> powered;
+    std::vector<uint8_t> temperatureModes;
+    std::vector<uint8_t> lightsOn;
+    std::vector<float> brightness;
+    std::vector<PackedColor> colors;
+    std::vector<uint8_t> emergency;
+    std::vector<BedKind> kinds;
+
+    std::vector<HeightActuator> lifts;
+    ActuatorFleet fleet;
+    bool liftsMoving;
+};
+
+#endif // BED_WARD_STATE_H
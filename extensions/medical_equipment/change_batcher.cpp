@@ -0,0 +1,100 @@
+#include "change_batcher.h"
+#include <algorithm>
+
+ChangeTracker::~ChangeTracker() {
+    if (batcher) {
+        batcher->remove(this);
+    }
+}
+
+void ChangeTracker::markChanged(uint32_t properties) {
+    properties &= BedChange::ALL;
+    if (!properties) {
+        return;
+    }
+
+    pendingChanges |= properties;
+    if (batcher) {
+        ++batcher->stats.totalMarks;
+        if (!queued) {
+            batcher->enqueue(this);
+        }
+    }
+}
+
+ChangeBatcher::~ChangeBatcher() {
+    clear();
+}
+
+bool ChangeBatcher::add(ChangeTracker* tracker) {
+    if (!tracker || tracker->batcher) {
+        return false;
+    }
+
+    // Changes from before joining are not reported
+    tracker->batcher = this;
+    tracker->pendingChanges = 0;
+    trackers.push_back(tracker);
+    stats.trackers = trackers.size();
+    return true;
+}
+
+bool ChangeBatcher::remove(ChangeTracker* tracker) {
+    auto it = std::find(trackers.begin(), trackers.end(), tracker);
+    if (it == trackers.end()) {
+        return false;
+    }
+
+    trackers.erase(it);
+    if (tracker->queued) {
+        pending.erase(std::find(pending.begin(), pending.end(), tracker));
+    }
+    flushed.erase(std::remove_if(flushed.begin(), flushed.end(),
+                                 [tracker](const Change& change) { return change.tracker == tracker; }),
+                  flushed.end());
+    detach(tracker);
+    stats.trackers = trackers.size();
+    stats.pending = pending.size();
+    return true;
+}
+
+void ChangeBatcher::clear() {
+    for (ChangeTracker* tracker : trackers) {
+        detach(tracker);
+    }
+    trackers.clear();
+    pending.clear();
+    flushed.clear();
+    stats.trackers = 0;
+    stats.pending = 0;
+}
+
+const std::vector<ChangeBatcher::Change>& ChangeBatcher::flush() {
+    // Trackers leave the pending list first, so changes made while the batch is handled queue afresh
+    flushed.clear();
+    flushed.reserve(pending.size());
+    for (ChangeTracker* tracker : pending) {
+        flushed.push_back({tracker, tracker->pendingChanges});
+        tracker->pendingChanges = 0;
+        tracker->queued = false;
+    }
+    pending.clear();
+
+    stats.pending = 0;
+    stats.lastFlushChanges = flushed.size();
+    stats.totalChanges += flushed.size();
+    ++stats.flushes;
+    return flushed;
+}
+
+void ChangeBatcher::enqueue(ChangeTracker* tracker) {
+    tracker->queued = true;
+    pending.push_back(tracker);
+    stats.pending = pending.size();
+}
+
+void ChangeBatcher::detach(ChangeTracker* tracker) {
+    tracker->batcher = nullptr;
+    tracker->pendingChanges = 0;
+    tracker->queued = false;
+}
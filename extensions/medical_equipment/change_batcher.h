@@ -0,0 +1,117 @@
+#ifndef CHANGE_BATCHER_H
+#define CHANGE_BATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ChangeBatcher;
+
+/**
+ * @struct BedChange
+ * @brief Property bits of a bed that a UI may show, one per observable group
+ */
+struct BedChange {
+    enum Property : uint32_t {
+        POWER = 1u << 0,
+        HEIGHT = 1u << 1,            // position or moving state, every frame the lift moves
+        TARGET_HEIGHT = 1u << 2,
+        TEMPERATURE = 1u << 3,
+        LIGHTS = 1u << 4,            // on/off, brightness, color, effect, LED count
+        EMERGENCY = 1u << 5,         // emergency mode or domain
+        OCCUPANCY = 1u << 6,
+        COMFORT_MODE = 1u << 7,
+        STERILE_MODE = 1u << 8,
+        PROCEDURE = 1u << 9,         // procedure or patient
+        VITALS = 1u << 10,           // monitoring state or a new reading
+        SCANNER = 1u << 11,          // scan state, every frame a scan runs
+        DEVICE_POSITION = 1u << 12,  // scanner swivel
+        ALL = (1u << 13) - 1
+    };
+
+    static constexpr int kPropertyCount = 13;
+};
+
+/**
+ * @class ChangeTracker
+ * @brief Anything whose property changes are reported in batches
+ *
+ * Owners call markChanged() whenever an observable property changes; the
+ * bits accumulate until the batcher the tracker is registered with flushes
+ * them. A tracker joins its batcher's pending list on its first change
+ * since the last flush, so a flush never scans unchanged trackers and
+ * repeated changes to one tracker cost one entry.
+ */
+class ChangeTracker {
+public:
+    ChangeTracker() = default;
+    ChangeTracker(const ChangeTracker&) = delete;
+    ChangeTracker& operator=(const ChangeTracker&) = delete;
+    virtual ~ChangeTracker();
+
+    void markChanged(uint32_t properties);
+    uint32_t getPendingChanges() const { return pendingChanges; }
+
+private:
+    friend class ChangeBatcher;
+
+    ChangeBatcher* batcher = nullptr;
+    uint32_t pendingChanges = 0;
+    bool queued = false;
+};
+
+/**
+ * @class ChangeBatcher
+ * @brief Collects the trackers changed during a frame for one notification
+ *
+ * flush() hands back each changed tracker once, with every property it
+ * changed, in the order the trackers first changed, and clears them.
+ * Changes made while the caller handles a flush land in the next one.
+ * Trackers are borrowed, not owned; a tracker destroyed while registered
+ * removes itself.
+ */
+class ChangeBatcher {
+public:
+    struct Change {
+        ChangeTracker* tracker;
+        uint32_t properties;
+    };
+
+    struct Stats {
+        size_t trackers = 0;
+        size_t pending = 0;
+        size_t lastFlushChanges = 0;  // trackers in the last flush
+        uint64_t totalChanges = 0;    // tracker entries flushed
+        uint64_t totalMarks = 0;      // markChanged() calls they coalesced
+        uint64_t flushes = 0;
+    };
+
+    ChangeBatcher() = default;
+    ~ChangeBatcher();
+    ChangeBatcher(const ChangeBatcher&) = delete;
+    ChangeBatcher& operator=(const ChangeBatcher&) = delete;
+
+    bool add(ChangeTracker* tracker);
+    bool remove(ChangeTracker* tracker);
+    void clear();
+    size_t size() const { return trackers.size(); }
+    const std::vector<ChangeTracker*>& getTrackers() const { return trackers; }
+
+    // Takes every change since the last flush; valid until the next flush or remove
+    const std::vector<Change>& flush();
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    friend class ChangeTracker;
+
+    void enqueue(ChangeTracker* tracker);
+    void detach(ChangeTracker* tracker);
+
+    std::vector<ChangeTracker*> trackers;
+    std::vector<ChangeTracker*> pending;
+    std::vector<Change> flushed;
+    Stats stats;
+};
+
+#endif // CHANGE_BATCHER_H
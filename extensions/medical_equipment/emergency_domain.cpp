@@ -0,0 +1,190 @@
+#include "emergency_domain.h"
+#include "device_log.h"
+#include <algorithm>
+#include <chrono>
+
+EmergencyDomainTree::EmergencyDomainTree() : epoch(0), generation(0) {
+    reset();
+}
+
+EmergencyDomainTree& EmergencyDomainTree::shared() {
+    static EmergencyDomainTree instance;
+    return instance;
+}
+
+int32_t EmergencyDomainTree::addDomain(int32_t parent, const std::string& name) {
+    if (!isValid(parent) || domains[parent].level == Level::ROOM) {
+        DEVICE_LOG_INFO("❌ Cannot add emergency domain '{}' under domain {}", name, parent);
+        return kNoDomain;
+    }
+
+    const Domain& above = domains[parent];
+    Domain domain;
+    domain.name = name;
+    domain.level = static_cast<Level>(static_cast<int>(above.level) + 1);
+    domain.path = above.path;
+
+    int32_t id = static_cast<int32_t>(domains.size());
+    domain.path[static_cast<size_t>(domain.level)] = id;
+    domains.push_back(std::move(domain));
+    return id;
+}
+
+void EmergencyDomainTree::reset() {
+    Domain hospital;
+    hospital.name = "Hospital";
+    hospital.level = Level::HOSPITAL;
+    hospital.path.fill(kNoDomain);
+    hospital.path[0] = kRootDomain;
+
+    domains.clear();
+    domains.push_back(std::move(hospital));
+
+    // Ids are reused from here on, so older subscriptions must not bind to them; moving the
+    // epoch makes every subscriber poll and find out
+    ++generation;
+    ++epoch;
+}
+
+EmergencyDomainTree::Subscription EmergencyDomainTree::subscribe(int32_t domain) const {
+    Subscription subscription;
+    subscription.domain = domain;
+    subscription.generation = generation;
+    subscription.subscribedEpoch = epoch;
+    return subscription;
+}
+
+bool EmergencyDomainTree::broadcast(int32_t domain) {
+    if (!stamp(domain, true)) {
+        return false;
+    }
+    DEVICE_LOG_ALERT("🚨 Emergency broadcast to {} '{}'", getLevelName(domains[domain].level), domains[domain].name);
+    return true;
+}
+
+bool EmergencyDomainTree::clear(int32_t domain) {
+    if (!stamp(domain, false)) {
+        return false;
+    }
+    DEVICE_LOG_ALERT("✅ Emergency cleared for {} '{}'", getLevelName(domains[domain].level), domains[domain].name);
+    return true;
+}
+
+bool EmergencyDomainTree::stamp(int32_t domain, bool active) {
+    if (!isValid(domain)) {
+        DEVICE_LOG_INFO("❌ Unknown emergency domain: {}", domain);
+        return false;
+    }
+
+    Domain& target = domains[domain];
+    target.eventEpoch = ++epoch;
+    target.eventActive = active;
+    target.eventUs = nowMicros();
+
+    LevelCounters& level = counters[static_cast<size_t>(target.level)];
+    ++(active ? level.broadcasts : level.clears);
+    return true;
+}
+
+const EmergencyDomainTree::Domain* EmergencyDomainTree::newestEvent(int32_t domain) const {
+    const Domain& leaf = domains[domain];
+    const Domain* newest = nullptr;
+    for (size_t i = 0; i <= static_cast<size_t>(leaf.level); ++i) {
+        const Domain& candidate = domains[leaf.path[i]];
+        if (candidate.eventEpoch != 0 && (!newest || candidate.eventEpoch > newest->eventEpoch)) {
+            newest = &candidate;
+        }
+    }
+    return newest;
+}
+
+bool EmergencyDomainTree::isActive(int32_t domain) const {
+    if (!isValid(domain)) {
+        return false;
+    }
+    const Domain* newest = newestEvent(domain);
+    return newest && newest->eventActive;
+}
+
+bool EmergencyDomainTree::poll(Subscription& subscription, Update& update) {
+    if (subscription.seenEpoch == epoch) {
+        return false;
+    }
+
+    uint64_t previouslySeen = subscription.seenEpoch;
+    subscription.seenEpoch = epoch;
+    if (subscription.generation != generation || !isValid(subscription.domain)) {
+        subscription.domain = kNoDomain;
+        subscription.generation = generation;
+        bool changed = subscription.active;
+        subscription.active = false;
+        return changed;
+    }
+
+    const Domain* newest = newestEvent(subscription.domain);
+    if (!newest) {
+        // Nothing ever raised on this path; a subscriber moved here from an active domain goes quiet
+        bool changed = subscription.active;
+        subscription.active = false;
+        return changed;
+    }
+    if (newest->eventEpoch <= previouslySeen) {
+        // Events elsewhere in the hospital; nothing new on this path
+        return false;
+    }
+
+    update.active = newest->eventActive;
+    update.source = newest->path[static_cast<size_t>(newest->level)];
+    update.level = newest->level;
+    update.latencyUs = std::max<int64_t>(0, nowMicros() - newest->eventUs);
+
+    // Catching up on an event from before the subscription is not a delivery
+    if (newest->eventEpoch > subscription.subscribedEpoch) {
+        LevelCounters& level = counters[static_cast<size_t>(newest->level)];
+        ++level.deliveries;
+        level.totalLatencyUs += update.latencyUs;
+        level.maxLatencyUs = std::max(level.maxLatencyUs, update.latencyUs);
+        level.lastLatencyUs = update.latencyUs;
+    }
+
+    bool changed = subscription.active != newest->eventActive;
+    subscription.active = newest->eventActive;
+    return changed;
+}
+
+int32_t EmergencyDomainTree::getParent(int32_t domain) const {
+    const Domain& target = domains[domain];
+    return target.level == Level::HOSPITAL ? kNoDomain : target.path[static_cast<size_t>(target.level) - 1];
+}
+
+EmergencyDomainTree::LevelStats EmergencyDomainTree::getLevelStats(Level level) const {
+    const LevelCounters& source = counters[static_cast<size_t>(level)];
+    LevelStats stats;
+    stats.broadcasts = source.broadcasts;
+    stats.clears = source.clears;
+    stats.deliveries = source.deliveries;
+    stats.averageLatencyUs = source.deliveries
+        ? static_cast<double>(source.totalLatencyUs) / static_cast<double>(source.deliveries) : 0.0;
+    stats.maxLatencyUs = source.maxLatencyUs;
+    stats.lastLatencyUs = source.lastLatencyUs;
+    return stats;
+}
+
+void EmergencyDomainTree::resetStats() {
+    counters.fill(LevelCounters());
+}
+
+const char* EmergencyDomainTree::getLevelName(Level level) {
+    switch (level) {
+        case Level::HOSPITAL: return "hospital";
+        case Level::FLOOR: return "floor";
+        case Level::WARD: return "ward";
+        case Level::ROOM: return "room";
+    }
+    return "unknown";
+}
+
+int64_t EmergencyDomainTree::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
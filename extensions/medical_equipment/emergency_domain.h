@@ -0,0 +1,134 @@
+#ifndef EMERGENCY_DOMAIN_H
+#define EMERGENCY_DOMAIN_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class EmergencyDomainTree
+ * @brief Hospital → floor → ward → room hierarchy for emergency broadcasts
+ *
+ * Broadcasting or clearing a domain stamps it with the next value of a
+ * global epoch counter, so marking a whole subtree costs O(1) whatever its
+ * size. Beds subscribe to one domain and poll on their own tick: when the
+ * epoch has not moved since their last poll they are done after a single
+ * compare, otherwise they walk at most kLevelCount ancestors and take the
+ * newest event on the path. A clear lower in the tree therefore overrides
+ * an older broadcast above it, and a newer broadcast above overrides it
+ * again. Propagation latency, from broadcast to the bed picking it up, is
+ * recorded per level of the domain that raised the event; a subscriber
+ * catching up on an event older than its subscription is not counted.
+ *
+ * Domain 0 is the hospital and always exists. reset() starts a new
+ * generation of domain ids; subscriptions from an older generation are
+ * dropped on their next poll rather than bound to a reused id. Main
+ * thread only.
+ */
+class EmergencyDomainTree {
+public:
+    enum class Level : uint8_t { HOSPITAL, FLOOR, WARD, ROOM };
+    static constexpr size_t kLevelCount = 4;
+    static constexpr int32_t kRootDomain = 0;
+    static constexpr int32_t kNoDomain = -1;
+
+    // Held by each subscriber, made by subscribe(); polling updates it in place
+    struct Subscription {
+        int32_t domain = kNoDomain;
+        uint64_t generation = 0;  // reset() count when subscribed; 0 never matches
+        uint64_t seenEpoch = 0;
+        uint64_t subscribedEpoch = 0;  // events up to here were raised before it existed
+        bool active = false;
+    };
+
+    // Newest event seen by a subscriber, filled by poll()
+    struct Update {
+        bool active;
+        int32_t source;     // domain that raised or cleared it
+        Level level;
+        int64_t latencyUs;  // event to pickup
+    };
+
+    struct LevelStats {
+        uint64_t broadcasts;
+        uint64_t clears;
+        uint64_t deliveries;  // subscribers that picked up an event raised at this level
+        double averageLatencyUs;
+        int64_t maxLatencyUs;
+        int64_t lastLatencyUs;
+    };
+
+    EmergencyDomainTree();
+
+    // Hospital topology shared by every bed
+    static EmergencyDomainTree& shared();
+
+    /**
+     * Adds a domain one level below its parent
+     * @return New domain id, or kNoDomain if the parent is unknown or a room
+     */
+    int32_t addDomain(int32_t parent, const std::string& name);
+
+    // Drops every domain but the hospital; subscribers of removed domains fall back to inactive
+    void reset();
+
+    bool broadcast(int32_t domain);
+    bool clear(int32_t domain);
+
+    // A subscription to domain in the current generation; its first poll reads the whole path
+    Subscription subscribe(int32_t domain) const;
+
+    // Whether the newest event on the domain's path is a broadcast
+    bool isActive(int32_t domain) const;
+
+    /**
+     * Brings a subscription up to date
+     * @param update Filled when a new event reached the subscriber
+     * @return true if the subscription's active state changed
+     */
+    bool poll(Subscription& subscription, Update& update);
+
+    bool isValid(int32_t domain) const { return domain >= 0 && static_cast<size_t>(domain) < domains.size(); }
+    size_t getDomainCount() const { return domains.size(); }
+    Level getLevel(int32_t domain) const { return domains[domain].level; }
+    int32_t getParent(int32_t domain) const;
+    const std::string& getName(int32_t domain) const { return domains[domain].name; }
+    uint64_t getEpoch() const { return epoch; }
+
+    LevelStats getLevelStats(Level level) const;
+    void resetStats();
+
+    static const char* getLevelName(Level level);
+
+private:
+    struct Domain {
+        std::string name;
+        Level level;
+        std::array<int32_t, kLevelCount> path;  // root first, this domain at index level
+        uint64_t eventEpoch = 0;                // 0 until the first broadcast or clear
+        bool eventActive = false;
+        int64_t eventUs = 0;
+    };
+
+    struct LevelCounters {
+        uint64_t broadcasts = 0;
+        uint64_t clears = 0;
+        uint64_t deliveries = 0;
+        int64_t totalLatencyUs = 0;
+        int64_t maxLatencyUs = 0;
+        int64_t lastLatencyUs = 0;
+    };
+
+    bool stamp(int32_t domain, bool active);
+    const Domain* newestEvent(int32_t domain) const;
+    static int64_t nowMicros();
+
+    std::vector<Domain> domains;
+    std::array<LevelCounters, kLevelCount> counters;
+    uint64_t epoch;
+    uint64_t generation;
+};
+
+#endif // EMERGENCY_DOMAIN_H
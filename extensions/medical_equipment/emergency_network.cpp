@@ -0,0 +1,85 @@
+#include "emergency_network.h"
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+int EmergencyNetwork::addDomain(int parent, const String& name) {
+    return EmergencyDomainTree::shared().addDomain(parent, name.utf8().get_data());
+}
+
+void EmergencyNetwork::resetDomains() {
+    EmergencyDomainTree::shared().reset();
+}
+
+int EmergencyNetwork::getDomainCount() const {
+    return static_cast<int>(EmergencyDomainTree::shared().getDomainCount());
+}
+
+int EmergencyNetwork::getDomainLevel(int domain) const {
+    const EmergencyDomainTree& tree = EmergencyDomainTree::shared();
+    return tree.isValid(domain) ? static_cast<int>(tree.getLevel(domain)) : -1;
+}
+
+int EmergencyNetwork::getDomainParent(int domain) const {
+    const EmergencyDomainTree& tree = EmergencyDomainTree::shared();
+    return tree.isValid(domain) ? tree.getParent(domain) : EmergencyDomainTree::kNoDomain;
+}
+
+String EmergencyNetwork::getDomainName(int domain) const {
+    const EmergencyDomainTree& tree = EmergencyDomainTree::shared();
+    return tree.isValid(domain) ? String::utf8(tree.getName(domain).c_str()) : String();
+}
+
+bool EmergencyNetwork::broadcastEmergency(int domain) {
+    return EmergencyDomainTree::shared().broadcast(domain);
+}
+
+bool EmergencyNetwork::clearEmergency(int domain) {
+    return EmergencyDomainTree::shared().clear(domain);
+}
+
+bool EmergencyNetwork::isEmergencyActive(int domain) const {
+    return EmergencyDomainTree::shared().isActive(domain);
+}
+
+Dictionary EmergencyNetwork::getLatencyStats() const {
+    Dictionary result;
+    for (size_t i = 0; i < EmergencyDomainTree::kLevelCount; ++i) {
+        auto level = static_cast<EmergencyDomainTree::Level>(i);
+        EmergencyDomainTree::LevelStats stats = EmergencyDomainTree::shared().getLevelStats(level);
+        
+        Dictionary levelStats;
+        levelStats["broadcasts"] = static_cast<int64_t>(stats.broadcasts);
+        levelStats["clears"] = static_cast<int64_t>(stats.clears);
+        levelStats["deliveries"] = static_cast<int64_t>(stats.deliveries);
+        levelStats["average_latency_usec"] = stats.averageLatencyUs;
+        levelStats["max_latency_usec"] = stats.maxLatencyUs;
+        levelStats["last_latency_usec"] = stats.lastLatencyUs;
+        result[EmergencyDomainTree::getLevelName(level)] = levelStats;
+    }
+    return result;
+}
+
+void EmergencyNetwork::resetLatencyStats() {
+    EmergencyDomainTree::shared().resetStats();
+}
+
+void EmergencyNetwork::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_domain", "parent", "name"), &EmergencyNetwork::addDomain);
+    ClassDB::bind_method(D_METHOD("reset_domains"), &EmergencyNetwork::resetDomains);
+    ClassDB::bind_method(D_METHOD("get_domain_count"), &EmergencyNetwork::getDomainCount);
+    ClassDB::bind_method(D_METHOD("get_domain_level", "domain"), &EmergencyNetwork::getDomainLevel);
+    ClassDB::bind_method(D_METHOD("get_domain_parent", "domain"), &EmergencyNetwork::getDomainParent);
+    ClassDB::bind_method(D_METHOD("get_domain_name", "domain"), &EmergencyNetwork::getDomainName);
+    ClassDB::bind_method(D_METHOD("broadcast_emergency", "domain"), &EmergencyNetwork::broadcastEmergency);
+    ClassDB::bind_method(D_METHOD("clear_emergency", "domain"), &EmergencyNetwork::clearEmergency);
+    ClassDB::bind_method(D_METHOD("is_emergency_active", "domain"), &EmergencyNetwork::isEmergencyActive);
+    ClassDB::bind_method(D_METHOD("get_latency_stats"), &EmergencyNetwork::getLatencyStats);
+    ClassDB::bind_method(D_METHOD("reset_latency_stats"), &EmergencyNetwork::resetLatencyStats);
+    
+    BIND_CONSTANT(LEVEL_HOSPITAL);
+    BIND_CONSTANT(LEVEL_FLOOR);
+    BIND_CONSTANT(LEVEL_WARD);
+    BIND_CONSTANT(LEVEL_ROOM);
+    BIND_CONSTANT(HOSPITAL_DOMAIN);
+}
@@ -0,0 +1,54 @@
+#ifndef EMERGENCY_NETWORK_H
+#define EMERGENCY_NETWORK_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "emergency_domain.h"
+
+using namespace godot;
+
+/**
+ * @class EmergencyNetwork
+ * @brief Godot node for building the hospital's emergency domains and broadcasting to them
+ *
+ * Every network node edits the one shared EmergencyDomainTree. Beds join a
+ * domain with Bed.set_emergency_domain(id) and pick up broadcasts on their
+ * next _process, so a floor-wide code blue is a single broadcast_emergency()
+ * call rather than a loop over bed nodes.
+ */
+class EmergencyNetwork : public Node {
+    GDCLASS(EmergencyNetwork, Node)
+
+public:
+    static const int LEVEL_HOSPITAL = static_cast<int>(EmergencyDomainTree::Level::HOSPITAL);
+    static const int LEVEL_FLOOR = static_cast<int>(EmergencyDomainTree::Level::FLOOR);
+    static const int LEVEL_WARD = static_cast<int>(EmergencyDomainTree::Level::WARD);
+    static const int LEVEL_ROOM = static_cast<int>(EmergencyDomainTree::Level::ROOM);
+    static const int HOSPITAL_DOMAIN = EmergencyDomainTree::kRootDomain;
+
+    EmergencyNetwork() = default;
+    ~EmergencyNetwork() = default;
+
+    // Topology; returns -1 if the parent is unknown or already a room
+    int addDomain(int parent, const String& name);
+    void resetDomains();
+    int getDomainCount() const;
+    int getDomainLevel(int domain) const;
+    int getDomainParent(int domain) const;
+    String getDomainName(int domain) const;
+
+    // O(1) whatever the number of beds below the domain
+    bool broadcastEmergency(int domain);
+    bool clearEmergency(int domain);
+    bool isEmergencyActive(int domain) const;
+
+    // Broadcast-to-pickup latency keyed by level name
+    Dictionary getLatencyStats() const;
+    void resetLatencyStats();
+
+protected:
+    static void _bind_methods();
+};
+
+#endif // EMERGENCY_NETWORK_H
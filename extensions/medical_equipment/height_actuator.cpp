@@ -0,0 +1,286 @@
+#include "height_actuator.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+// Moves shorter than this are treated as already there
+constexpr float kPositionEpsilon = 1e-4f;
+
+// Actuators per worker chunk; a step is a few dozen flops
+constexpr size_t kActuatorsPerChunk = 1024;
+
+// Share of the ramp distance covered at progress u, and the velocity share there.
+// The S-curve follows a smoothstep in velocity, so acceleration starts and ends at 0.
+inline double rampDistance(MotionLimits::Profile profile, double u) {
+    return profile == MotionLimits::Profile::S_CURVE ? u * u * u - 0.5 * u * u * u * u : 0.5 * u * u;
+}
+
+inline double rampVelocity(MotionLimits::Profile profile, double u) {
+    return profile == MotionLimits::Profile::S_CURVE ? u * u * (3.0 - 2.0 * u) : u;
+}
+
+} // namespace
+
+HeightActuator::HeightActuator(float initialPosition, float minimum, float maximum)
+    : minPosition(minimum), maxPosition(maximum), position(initialPosition), velocity(0.0f), moving(false),
+      managed(false), queueHead(0), queueSize(0), accumulator(0.0) {
+    reset(initialPosition);
+}
+
+void HeightActuator::reset(float newPosition) {
+    position = std::isfinite(newPosition) ? std::min(std::max(newPosition, minPosition), maxPosition) : minPosition;
+    velocity = 0.0f;
+    moving = false;
+    accumulator = 0.0;
+    clearQueue();
+}
+
+bool HeightActuator::setRange(float minimum, float maximum) {
+    if (!std::isfinite(minimum) || !std::isfinite(maximum)) {
+        return false;
+    }
+    
+    minPosition = std::min(minimum, maximum);
+    maxPosition = std::max(minimum, maximum);
+    if (!moving) {
+        position = std::min(std::max(position, minPosition), maxPosition);
+    }
+    return true;
+}
+
+bool HeightActuator::setLimits(const MotionLimits& newLimits) {
+    // NaN would pass through std::max below
+    if (!std::isfinite(newLimits.maxVelocity) || !std::isfinite(newLimits.maxAcceleration) ||
+        !std::isfinite(newLimits.maxJerk)) {
+        return false;
+    }
+    
+    limits = newLimits;
+    limits.maxVelocity = std::max(newLimits.maxVelocity, 0.01f);
+    limits.maxAcceleration = std::max(newLimits.maxAcceleration, 0.01f);
+    limits.maxJerk = std::max(newLimits.maxJerk, 0.01f);
+    return true;
+}
+
+bool HeightActuator::moveTo(float target) {
+    if (!std::isfinite(target) || target < minPosition || target > maxPosition) {
+        return false;
+    }
+    if (moving && queueSize == 0 && plan.target == target) {
+        return true;  // already on its way there
+    }
+
+    clearQueue();
+    queue[0] = target;
+    queueSize = 1;
+    if (moving) {
+        // Changing course mid-move goes through rest, so the limits still hold
+        plan = planStop();
+    } else {
+        beginNext();
+    }
+    return true;
+}
+
+bool HeightActuator::enqueue(float target) {
+    if (!std::isfinite(target) || target < minPosition || target > maxPosition || queueSize == kQueueCapacity) {
+        return false;
+    }
+
+    queue[(queueHead + queueSize) % kQueueCapacity] = target;
+    ++queueSize;
+    if (!moving) {
+        beginNext();
+    }
+    return true;
+}
+
+void HeightActuator::stop() {
+    clearQueue();
+    if (moving) {
+        plan = planStop();
+    }
+}
+
+void HeightActuator::step(double dt) {
+    if (!moving) {
+        return;
+    }
+
+    plan.elapsed += dt;
+    double overshoot = plan.elapsed - plan.duration();
+    if (overshoot < 0.0) {
+        evaluate();
+        return;
+    }
+
+    // Land exactly on the target and spend the rest of the step on the next move
+    position = plan.target;
+    velocity = 0.0f;
+    moving = false;
+    beginNext();
+    if (moving) {
+        plan.elapsed = overshoot;
+        evaluate();
+    }
+}
+
+int HeightActuator::advance(double frameDelta, double timestep) {
+    accumulator += std::max(frameDelta, 0.0);
+    int steps = 0;
+    while (accumulator >= timestep && steps < kMaxSubsteps) {
+        step(timestep);
+        accumulator -= timestep;
+        ++steps;
+    }
+    if (accumulator >= timestep) {
+        accumulator = std::fmod(accumulator, timestep);
+    }
+    return steps;
+}
+
+float HeightActuator::getFinalTarget() const {
+    if (queueSize > 0) {
+        return queue[(queueHead + queueSize - 1) % kQueueCapacity];
+    }
+    return moving ? plan.target : position;
+}
+
+void HeightActuator::beginNext() {
+    while (queueSize > 0) {
+        float target = queue[queueHead];
+        queueHead = (queueHead + 1) % kQueueCapacity;
+        --queueSize;
+
+        plan = planRestToRest(position, target);
+        if (plan.duration() > 0.0) {
+            moving = true;
+            return;
+        }
+        position = target;
+    }
+    moving = false;
+}
+
+double HeightActuator::rampTime(float peak) const {
+    if (limits.profile == MotionLimits::Profile::S_CURVE) {
+        // Smoothstep velocity peaks at 1.5x the mean acceleration and 6x peak / t² jerk
+        return std::max(1.5 * peak / limits.maxAcceleration, std::sqrt(6.0 * peak / limits.maxJerk));
+    }
+    return peak / limits.maxAcceleration;
+}
+
+HeightActuator::Plan HeightActuator::planRestToRest(float from, float to) const {
+    Plan next;
+    next.profile = limits.profile;
+    next.start = from;
+    next.target = to;
+    next.direction = to >= from ? 1.0f : -1.0f;
+
+    double distance = std::fabs(static_cast<double>(to) - from);
+    if (distance < kPositionEpsilon) {
+        return next;
+    }
+
+    // Each ramp covers peak * rampTime / 2, so cruise covers what is left
+    double peak = limits.maxVelocity;
+    double ramp = rampTime(static_cast<float>(peak));
+    if (peak * ramp > distance) {
+        // Too short to reach full speed: the fastest peak whose two ramps fit exactly
+        double accel = limits.maxAcceleration;
+        if (limits.profile == MotionLimits::Profile::S_CURVE) {
+            peak = std::sqrt(distance * accel / 1.5);
+            if (std::sqrt(6.0 * peak / limits.maxJerk) > 1.5 * peak / accel) {
+                peak = std::cbrt(distance * distance * limits.maxJerk / 6.0);
+            }
+        } else {
+            peak = std::sqrt(distance * accel);
+        }
+        ramp = rampTime(static_cast<float>(peak));
+        next.cruiseTime = 0.0;
+    } else {
+        next.cruiseTime = (distance - peak * ramp) / peak;
+    }
+
+    next.peak = static_cast<float>(peak);
+    next.accelTime = ramp;
+    next.decelTime = ramp;
+    return next;
+}
+
+HeightActuator::Plan HeightActuator::planStop() const {
+    Plan next;
+    next.profile = limits.profile;
+    next.start = position;
+    next.direction = velocity >= 0.0f ? 1.0f : -1.0f;
+    next.peak = std::fabs(velocity);
+    next.decelTime = rampTime(next.peak);
+
+    double distance = 0.5 * next.peak * next.decelTime;
+    float target = position + next.direction * static_cast<float>(distance);
+    next.target = std::min(std::max(target, minPosition), maxPosition);
+    return next;
+}
+
+void HeightActuator::evaluate() {
+    double t = plan.elapsed;
+    double peak = plan.peak;
+    double distance;
+    double speed;
+
+    if (t < plan.accelTime) {
+        double u = t / plan.accelTime;
+        distance = peak * plan.accelTime * rampDistance(plan.profile, u);
+        speed = peak * rampVelocity(plan.profile, u);
+    } else if (t < plan.accelTime + plan.cruiseTime) {
+        distance = peak * (0.5 * plan.accelTime + (t - plan.accelTime));
+        speed = peak;
+    } else {
+        double u = std::min(1.0, (t - plan.accelTime - plan.cruiseTime) / plan.decelTime);
+        distance = peak * (0.5 * plan.accelTime + plan.cruiseTime) +
+                   peak * plan.decelTime * (u - rampDistance(plan.profile, u));
+        speed = peak * (1.0 - rampVelocity(plan.profile, u));
+    }
+
+    float next = plan.start + plan.direction * static_cast<float>(distance);
+    position = std::min(std::max(next, minPosition), maxPosition);
+    velocity = plan.direction * static_cast<float>(speed);
+}
+
+void HeightActuator::clearQueue() {
+    queueHead = 0;
+    queueSize = 0;
+}
+
+ActuatorFleet::ActuatorFleet(double fixedTimestep) : timestep(HeightActuator::kDefaultTimestep), accumulator(0.0) {
+    setTimestep(fixedTimestep);
+}
+
+void ActuatorFleet::setActuators(std::vector<HeightActuator*> fleet) {
+    actuators = std::move(fleet);
+}
+
+void ActuatorFleet::setTimestep(double fixedTimestep) {
+    timestep = std::max(fixedTimestep, 1e-4);
+}
+
+int ActuatorFleet::advance(double frameDelta) {
+    accumulator += std::max(frameDelta, 0.0);
+    int steps = 0;
+    while (accumulator >= timestep && steps < HeightActuator::kMaxSubsteps) {
+        WorkerPool::shared().parallelFor(actuators.size(), kActuatorsPerChunk, [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                actuators[i]->step(timestep);
+            }
+        });
+        accumulator -= timestep;
+        ++steps;
+    }
+    if (accumulator >= timestep) {
+        accumulator = std::fmod(accumulator, timestep);
+    }
+    return steps;
+}
@@ -0,0 +1,159 @@
+#ifndef HEIGHT_ACTUATOR_H
+#define HEIGHT_ACTUATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct MotionLimits
+ * @brief Kinematic limits of a height actuator, in cm, s
+ *
+ * TRAPEZOIDAL ramps velocity linearly, so acceleration jumps between 0 and
+ * maxAcceleration. S_CURVE ramps velocity along a smoothstep, so
+ * acceleration rises and falls continuously and peak jerk stays within
+ * maxJerk.
+ */
+struct MotionLimits {
+    enum class Profile : uint8_t { TRAPEZOIDAL, S_CURVE };
+
+    Profile profile = Profile::S_CURVE;
+    float maxVelocity = 4.0f;       // cm/s
+    float maxAcceleration = 8.0f;   // cm/s²
+    float maxJerk = 40.0f;          // cm/s³, S_CURVE only
+};
+
+/**
+ * @class HeightActuator
+ * @brief Bed lift driven along planned motion profiles
+ *
+ * Every move is planned once as accelerate, cruise, decelerate and then
+ * evaluated in closed form from the time since it started, so stepping is
+ * cheap, never drifts and lands exactly on the target. Targets wait in a
+ * small fixed queue and run one after another, each from rest. A new
+ * moveTo() during a move brings the lift to a controlled stop first,
+ * within the limits, and then heads for the new target.
+ *
+ * step() advances by an exact time; advance() feeds frame deltas through a
+ * fixed-timestep accumulator.
+ */
+class HeightActuator {
+public:
+    static constexpr size_t kQueueCapacity = 8;
+    static constexpr double kDefaultTimestep = 1.0 / 60.0;
+
+    // advance() steps at most this many times per call, dropping the rest of a long stall
+    static constexpr int kMaxSubsteps = 8;
+
+    explicit HeightActuator(float position = 50.0f, float minPosition = 30.0f, float maxPosition = 100.0f);
+
+    // Jumps to a position at rest, dropping any motion; used for initial placement.
+    // A non-finite position lands on the minimum.
+    void reset(float position);
+    
+    // Each of these returns false, changing nothing, for non-finite values
+    bool setRange(float minPosition, float maxPosition);
+    bool setLimits(const MotionLimits& limits);
+    const MotionLimits& getLimits() const { return limits; }
+
+    /**
+     * Replaces every pending target with this one
+     * @return false if the target is outside the range or not finite
+     */
+    bool moveTo(float target);
+
+    /**
+     * Runs the target after the ones already queued
+     * @return false if it is out of range, not finite, or the queue is full
+     */
+    bool enqueue(float target);
+
+    // Decelerates to rest as quickly as the limits allow and drops the queue
+    void stop();
+
+    void step(double dt);
+
+    // Fixed-timestep stepping of frame deltas; returns the steps taken
+    int advance(double frameDelta, double timestep = kDefaultTimestep);
+
+    float getPosition() const { return position; }
+    float getVelocity() const { return velocity; }
+    bool isMoving() const { return moving; }
+    float getMinPosition() const { return minPosition; }
+    float getMaxPosition() const { return maxPosition; }
+
+    // Where the lift ends up once the queue drains
+    float getFinalTarget() const;
+    size_t getQueuedCount() const { return queueSize; }
+
+    // Set while a fleet steps this actuator, so its owner does not step it as well
+    void setManaged(bool value) { managed = value; }
+    bool isManaged() const { return managed; }
+
+private:
+    // Ramp up to peak over accelTime, cruise, ramp down over decelTime
+    struct Plan {
+        MotionLimits::Profile profile = MotionLimits::Profile::TRAPEZOIDAL;
+        float start = 0.0f;
+        float direction = 1.0f;
+        float peak = 0.0f;
+        double accelTime = 0.0;
+        double cruiseTime = 0.0;
+        double decelTime = 0.0;
+        double elapsed = 0.0;
+        float target = 0.0f;
+
+        double duration() const { return accelTime + cruiseTime + decelTime; }
+    };
+
+    void beginNext();
+    Plan planRestToRest(float from, float to) const;
+    Plan planStop() const;
+    double rampTime(float peak) const;
+    void evaluate();
+    void clearQueue();
+
+    MotionLimits limits;
+    float minPosition;
+    float maxPosition;
+    float position;
+    float velocity;
+    bool moving;
+    bool managed;
+    Plan plan;
+    std::array<float, kQueueCapacity> queue;
+    size_t queueHead;
+    size_t queueSize;
+    double accumulator;
+};
+
+/**
+ * @class ActuatorFleet
+ * @brief Steps many actuators together at one fixed timestep
+ *
+ * One accumulator is shared by the whole fleet, so every actuator sees the
+ * same substeps. Each substep is a single pass over the fleet, split across
+ * the worker pool once the fleet is large enough to be worth it.
+ * Actuators are borrowed, not owned.
+ */
+class ActuatorFleet {
+public:
+    explicit ActuatorFleet(double timestep = HeightActuator::kDefaultTimestep);
+
+    void setActuators(std::vector<HeightActuator*> actuators);
+    const std::vector<HeightActuator*>& getActuators() const { return actuators; }
+
+    void setTimestep(double timestep);
+    double getTimestep() const { return timestep; }
+
+    // Returns the substeps taken, at most HeightActuator::kMaxSubsteps
+    int advance(double frameDelta);
+
+private:
+    std::vector<HeightActuator*> actuators;
+    double timestep;
+    double accumulator;
+};
+
+#endif // HEIGHT_ACTUATOR_H
@@ -0,0 +1,273 @@
+#include "led_framebuffer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+
+// LEDs per kernel block; the block's linear-light lanes live on the stack
+constexpr size_t kBlock = 64;
+
+inline double fraction(double value) {
+    return value - std::floor(value);
+}
+
+inline LedColor scaled(LedColor color, float scale) {
+    return {color.r * scale, color.g * scale, color.b * scale};
+}
+
+// plane[i] = start + i * step
+void rampPlane(float* plane, size_t n, float start, float step) {
+    size_t i = 0;
+
+#if defined(MEDICAL_SIMD_AVX2)
+    const __m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 vstart = _mm256_set1_ps(start);
+    const __m256 vstep = _mm256_set1_ps(step);
+    for (; i + 8 <= n; i += 8) {
+        __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), lanes);
+        _mm256_storeu_ps(plane + i, _mm256_add_ps(vstart, _mm256_mul_ps(index, vstep)));
+    }
+#endif
+
+#if defined(MEDICAL_SIMD_SSE2)
+    const __m128 lanes4 = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 vstart4 = _mm_set1_ps(start);
+    const __m128 vstep4 = _mm_set1_ps(step);
+    for (; i + 4 <= n; i += 4) {
+        __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lanes4);
+        _mm_storeu_ps(plane + i, _mm_add_ps(vstart4, _mm_mul_ps(index, vstep4)));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        plane[i] = start + static_cast<float>(i) * step;
+    }
+}
+
+// Chase intensity for LEDs first..first+n of a strip of length LEDs: 1 at the
+// head, falling to 0 one tail length behind it, wrapping
+void chaseBlend(float* red, float* green, float* blue, size_t first, size_t n, float length, LedColor color,
+                LedColor background, float head, float invTail) {
+    const LedColor delta = {color.r - background.r, color.g - background.g, color.b - background.b};
+    size_t i = 0;
+
+#if defined(MEDICAL_SIMD_AVX2)
+    const __m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 vhead = _mm256_set1_ps(head);
+    const __m256 vlength = _mm256_set1_ps(length);
+    const __m256 vinvTail = _mm256_set1_ps(invTail);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + 8 <= n; i += 8) {
+        __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(first + i)), lanes);
+        __m256 distance = _mm256_sub_ps(vhead, index);
+        distance = _mm256_add_ps(distance, _mm256_and_ps(_mm256_cmp_ps(distance, zero, _CMP_LT_OQ), vlength));
+        __m256 k = _mm256_max_ps(zero, _mm256_sub_ps(one, _mm256_mul_ps(distance, vinvTail)));
+        _mm256_storeu_ps(red + i, _mm256_add_ps(_mm256_set1_ps(background.r), _mm256_mul_ps(_mm256_set1_ps(delta.r), k)));
+        _mm256_storeu_ps(green + i, _mm256_add_ps(_mm256_set1_ps(background.g), _mm256_mul_ps(_mm256_set1_ps(delta.g), k)));
+        _mm256_storeu_ps(blue + i, _mm256_add_ps(_mm256_set1_ps(background.b), _mm256_mul_ps(_mm256_set1_ps(delta.b), k)));
+    }
+#endif
+
+#if defined(MEDICAL_SIMD_SSE2)
+    const __m128 lanes4 = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 vhead4 = _mm_set1_ps(head);
+    const __m128 vlength4 = _mm_set1_ps(length);
+    const __m128 vinvTail4 = _mm_set1_ps(invTail);
+    const __m128 zero4 = _mm_setzero_ps();
+    const __m128 one4 = _mm_set1_ps(1.0f);
+    for (; i + 4 <= n; i += 4) {
+        __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(first + i)), lanes4);
+        __m128 distance = _mm_sub_ps(vhead4, index);
+        distance = _mm_add_ps(distance, _mm_and_ps(_mm_cmplt_ps(distance, zero4), vlength4));
+        __m128 k = _mm_max_ps(zero4, _mm_sub_ps(one4, _mm_mul_ps(distance, vinvTail4)));
+        _mm_storeu_ps(red + i, _mm_add_ps(_mm_set1_ps(background.r), _mm_mul_ps(_mm_set1_ps(delta.r), k)));
+        _mm_storeu_ps(green + i, _mm_add_ps(_mm_set1_ps(background.g), _mm_mul_ps(_mm_set1_ps(delta.g), k)));
+        _mm_storeu_ps(blue + i, _mm_add_ps(_mm_set1_ps(background.b), _mm_mul_ps(_mm_set1_ps(delta.b), k)));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        float distance = head - static_cast<float>(first + i);
+        if (distance < 0.0f) {
+            distance += length;
+        }
+        float k = std::max(0.0f, 1.0f - distance * invTail);
+        red[i] = background.r + delta.r * k;
+        green[i] = background.g + delta.g * k;
+        blue[i] = background.b + delta.b * k;
+    }
+}
+
+} // namespace
+
+LedEffect LedEffect::solid(LedColor color) {
+    LedEffect effect;
+    effect.type = Type::SOLID;
+    effect.primary = color;
+    return effect;
+}
+
+LedEffect LedEffect::gradient(LedColor from, LedColor to) {
+    LedEffect effect;
+    effect.type = Type::GRADIENT;
+    effect.primary = from;
+    effect.secondary = to;
+    return effect;
+}
+
+LedEffect LedEffect::pulse(LedColor color, float frequencyHz, float floor) {
+    LedEffect effect;
+    effect.type = Type::PULSE;
+    effect.primary = color;
+    effect.rateHz = frequencyHz;
+    effect.width = floor;
+    return effect;
+}
+
+LedEffect LedEffect::chase(LedColor color, LedColor background, float ledsPerSecond, float tailLength) {
+    LedEffect effect;
+    effect.type = Type::CHASE;
+    effect.primary = color;
+    effect.secondary = background;
+    effect.rateHz = ledsPerSecond;
+    effect.width = tailLength;
+    return effect;
+}
+
+LedEffect LedEffect::strobe(LedColor color, float frequencyHz, float dutyCycle) {
+    LedEffect effect;
+    effect.type = Type::STROBE;
+    effect.primary = color;
+    effect.rateHz = frequencyHz;
+    effect.width = dutyCycle;
+    return effect;
+}
+
+LedGammaTable::LedGammaTable(float gammaValue) : gamma(gammaValue) {
+    for (size_t i = 0; i < kEntries; ++i) {
+        double linear = static_cast<double>(i) / static_cast<double>(kEntries - 1);
+        table[i] = static_cast<uint8_t>(std::lround(255.0 * std::pow(linear, 1.0 / static_cast<double>(gamma))));
+    }
+}
+
+const LedGammaTable& LedGammaTable::standard() {
+    static const LedGammaTable instance;
+    return instance;
+}
+
+LedFramebuffer::LedFramebuffer(size_t ledCount) {
+    resize(ledCount);
+}
+
+void LedFramebuffer::resize(size_t ledCount) {
+    pixels.resize(std::min(ledCount, kMaxLedCount), PackedColor(0, 0, 0));
+}
+
+void LedFramebuffer::storeBlock(size_t first, size_t count, const float* red, const float* green, const float* blue) {
+    ColorSpace::encodeLinear(red, green, blue, count, 255, pixels.data() + first);
+}
+
+void LedFramebuffer::fillSolid(LedColor color) {
+    std::fill(pixels.begin(), pixels.end(), ColorSpace::fromLinear(color));
+}
+
+void LedFramebuffer::fillGradient(LedColor from, LedColor to) {
+    size_t n = size();
+    float inv = n > 1 ? 1.0f / static_cast<float>(n - 1) : 0.0f;
+    LedColor step = {(to.r - from.r) * inv, (to.g - from.g) * inv, (to.b - from.b) * inv};
+    alignas(32) float r[kBlock];
+    alignas(32) float g[kBlock];
+    alignas(32) float b[kBlock];
+    
+    // Ramped in linear light, so the midpoint of red to green is not muddy
+    for (size_t first = 0; first < n; first += kBlock) {
+        size_t count = std::min(kBlock, n - first);
+        float offset = static_cast<float>(first);
+        rampPlane(r, count, from.r + step.r * offset, step.r);
+        rampPlane(g, count, from.g + step.g * offset, step.g);
+        rampPlane(b, count, from.b + step.b * offset, step.b);
+        storeBlock(first, count, r, g, b);
+    }
+}
+
+void LedFramebuffer::fillPulse(LedColor color, double timeSeconds, float frequencyHz, float floor) {
+    // Phase in double so long uptimes do not lose sub-frame precision
+    double phase = fraction(timeSeconds * frequencyHz);
+    float wave = static_cast<float>(0.5 * (1.0 - std::cos(kTwoPi * phase)));
+    floor = std::min(std::max(floor, 0.0f), 1.0f);
+    fillSolid(scaled(color, floor + (1.0f - floor) * wave));
+}
+
+void LedFramebuffer::fillChase(LedColor color, LedColor background, double timeSeconds, float ledsPerSecond,
+                               float tailLength) {
+    size_t n = size();
+    if (n == 0) {
+        return;
+    }
+    double length = static_cast<double>(n);
+    float head = static_cast<float>(fraction(timeSeconds * ledsPerSecond / length) * length);
+    float invTail = 1.0f / std::max(tailLength, 1.0f);
+    alignas(32) float r[kBlock];
+    alignas(32) float g[kBlock];
+    alignas(32) float b[kBlock];
+    
+    for (size_t first = 0; first < n; first += kBlock) {
+        size_t count = std::min(kBlock, n - first);
+        chaseBlend(r, g, b, first, count, static_cast<float>(n), color, background, head, invTail);
+        storeBlock(first, count, r, g, b);
+    }
+}
+
+void LedFramebuffer::fillStrobe(LedColor color, double timeSeconds, float frequencyHz, float dutyCycle) {
+    bool lit = fraction(timeSeconds * frequencyHz) < dutyCycle;
+    fillSolid(lit ? color : LedColor{0.0f, 0.0f, 0.0f});
+}
+
+void LedFramebuffer::render(const LedEffect& effect, double timeSeconds) {
+    switch (effect.type) {
+        case LedEffect::Type::SOLID:
+            fillSolid(effect.primary);
+            break;
+        case LedEffect::Type::GRADIENT:
+            fillGradient(effect.primary, effect.secondary);
+            break;
+        case LedEffect::Type::PULSE:
+            fillPulse(effect.primary, timeSeconds, effect.rateHz, effect.width);
+            break;
+        case LedEffect::Type::CHASE:
+            fillChase(effect.primary, effect.secondary, timeSeconds, effect.rateHz, effect.width);
+            break;
+        case LedEffect::Type::STROBE:
+            fillStrobe(effect.primary, timeSeconds, effect.rateHz, effect.width);
+            break;
+    }
+}
+
+void LedFramebuffer::encodeRgb8(uint8_t* out, float brightness, const LedGammaTable& gamma) const {
+    brightness = !(brightness > 0.0f) ? 0.0f : std::min(brightness, 1.0f);
+    
+    // Only 256 stored codes exist, so the whole decode, scale and gamma
+    // chain is folded into one table, rebuilt when brightness or gamma change
+    if (output.brightness != brightness || output.table != &gamma || output.gamma != gamma.getGamma()) {
+        float scale = brightness * static_cast<float>(LedGammaTable::kEntries - 1);
+        for (size_t code = 0; code < output.codes.size(); ++code) {
+            float index = ColorSpace::toLinear(static_cast<uint8_t>(code)) * scale;
+            output.codes[code] = gamma[static_cast<size_t>(std::nearbyint(index))];
+        }
+        output.brightness = brightness;
+        output.table = &gamma;
+        output.gamma = gamma.getGamma();
+    }
+    
+    const uint8_t* codes = output.codes.data();
+    const PackedColor* pixel = pixels.data();
+    for (size_t i = 0, n = size(); i < n; ++i) {
+        out[0] = codes[pixel[i].r];
+        out[1] = codes[pixel[i].g];
+        out[2] = codes[pixel[i].b];
+        out += 3;
+    }
+}
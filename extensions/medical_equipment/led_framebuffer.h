@@ -0,0 +1,124 @@
+#ifndef LED_FRAMEBUFFER_H
+#define LED_FRAMEBUFFER_H
+
+#include "packed_color.h"
+#include "simd_config.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct LedEffect
+ * @brief What a strip shows, independent of how many LEDs it has
+ *
+ * rateHz is the pulse/strobe frequency or, for CHASE, the speed in LEDs per
+ * second. width is the pulse floor (0..1), the strobe duty cycle (0..1) or
+ * the chase tail length in LEDs.
+ */
+struct LedEffect {
+    enum class Type : uint8_t { SOLID, GRADIENT, PULSE, CHASE, STROBE };
+
+    Type type = Type::SOLID;
+    LedColor primary = {1.0f, 1.0f, 1.0f};
+    LedColor secondary = {0.0f, 0.0f, 0.0f};  // gradient end, chase background
+    float rateHz = 1.0f;
+    float width = 0.0f;
+
+    static LedEffect solid(LedColor color);
+    static LedEffect gradient(LedColor from, LedColor to);
+    static LedEffect pulse(LedColor color, float frequencyHz, float floor);
+    static LedEffect chase(LedColor color, LedColor background, float ledsPerSecond, float tailLength);
+    static LedEffect strobe(LedColor color, float frequencyHz, float dutyCycle);
+};
+
+/**
+ * @class LedGammaTable
+ * @brief Linear light to 8-bit output code
+ *
+ * Output codes are linear light raised to 1 / gamma: 2.2 suits RGB8
+ * textures shown on screen, 1.0 drives LED PWM, which is already linear in
+ * emitted light. The table holds kEntries samples of the curve so encoding
+ * never calls pow().
+ */
+class LedGammaTable {
+public:
+    static constexpr size_t kEntries = 4096;
+
+    explicit LedGammaTable(float gamma = 2.2f);
+
+    // Process-wide table for the default gamma
+    static const LedGammaTable& standard();
+
+    float getGamma() const { return gamma; }
+    uint8_t operator[](size_t index) const { return table[index]; }
+
+private:
+    float gamma;
+    std::array<uint8_t, kEntries> table;
+};
+
+/**
+ * @class LedFramebuffer
+ * @brief Per-LED color of one addressable strip, with SIMD effect kernels
+ *
+ * Each LED is one PackedColor, 4 bytes. Kernels evaluate effects in blocks
+ * of linear-light float lanes, so gradients and chase tails blend in linear
+ * light, and store the block sRGB-encoded. Effects are evaluated at an
+ * absolute time in seconds, so a frame can be rendered for any moment
+ * without per-strip animation state. encodeRgb8() applies brightness to
+ * linear light and gamma-encodes interleaved bytes ready for an RGB8
+ * texture row.
+ */
+class LedFramebuffer {
+public:
+    static constexpr size_t kDefaultLedCount = 60;
+    static constexpr size_t kMaxLedCount = 1024;
+
+    explicit LedFramebuffer(size_t ledCount = kDefaultLedCount);
+
+    // Clamped to kMaxLedCount; new LEDs start dark
+    void resize(size_t ledCount);
+    size_t size() const { return pixels.size(); }
+
+    void fillSolid(LedColor color);
+    void fillGradient(LedColor from, LedColor to);
+
+    // Solid color breathing between floor and full intensity
+    void fillPulse(LedColor color, double timeSeconds, float frequencyHz, float floor);
+
+    // A lit head moving along the strip, fading linearly over its tail; wraps around
+    void fillChase(LedColor color, LedColor background, double timeSeconds, float ledsPerSecond, float tailLength);
+
+    // Full color for dutyCycle of each period, dark for the rest
+    void fillStrobe(LedColor color, double timeSeconds, float frequencyHz, float dutyCycle);
+
+    // Dispatches to the kernel for the effect's type
+    void render(const LedEffect& effect, double timeSeconds);
+
+    /**
+     * Writes the frame as interleaved RGB bytes
+     * @param out size() * 3 bytes
+     * @param brightness Linear-light scale applied before gamma, clamped to 0..1
+     */
+    void encodeRgb8(uint8_t* out, float brightness, const LedGammaTable& gamma = LedGammaTable::standard()) const;
+
+    // Linear light of one LED, decoded from its packed color
+    LedColor getLed(size_t index) const { return pixels[index].toLinear(); }
+    const PackedColor* data() const { return pixels.data(); }
+
+private:
+    // Output code per stored sRGB code for the last brightness and gamma encoded
+    struct OutputTable {
+        std::array<uint8_t, 256> codes;
+        float brightness = -1.0f;
+        const LedGammaTable* table = nullptr;
+        float gamma = 0.0f;
+    };
+
+    void storeBlock(size_t first, size_t count, const float* red, const float* green, const float* blue);
+
+    SimdVector<PackedColor> pixels;
+    mutable OutputTable output;
+};
+
+#endif // LED_FRAMEBUFFER_H
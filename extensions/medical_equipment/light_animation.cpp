@@ -0,0 +1,94 @@
+#include "light_animation.h"
+#include "device_log.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace godot;
+
+LightAnimation::LightAnimation() : loop(true), frameRate(LightTimeline::kDefaultFrameRate) {}
+
+bool LightAnimation::addKeyframe(double timeSeconds, const Color& color, float brightness, int easing) {
+    if (easing < EASE_LINEAR || easing > EASE_IN_OUT) {
+        DEVICE_LOG_INFO("❌ Unknown light easing: {}", easing);
+        return false;
+    }
+    if (!std::isfinite(timeSeconds)) {
+        DEVICE_LOG_INFO("❌ Light keyframe time must be finite");
+        return false;
+    }
+    
+    LightKeyframe keyframe;
+    keyframe.timeSeconds = timeSeconds;
+    keyframe.color = PackedColor::fromFloat(color.r, color.g, color.b).toLinear();
+    keyframe.brightness = std::max(0.0f, std::min(1.0f, brightness));
+    keyframe.easing = static_cast<LightKeyframe::Easing>(easing);
+    keyframes.push_back(keyframe);
+    return true;
+}
+
+void LightAnimation::clearKeyframes() {
+    keyframes.clear();
+}
+
+void LightAnimation::setFrameRate(float rate) {
+    if (!std::isfinite(rate)) {
+        DEVICE_LOG_INFO("❌ Light animation frame rate must be finite");
+        return;
+    }
+    frameRate = std::max(1.0f, rate);
+}
+
+bool LightAnimation::compile() {
+    timeline = LightTimeline::compile(keyframes, loop, frameRate);
+    if (!timeline) {
+        DEVICE_LOG_INFO("❌ Light animation has no keyframes to compile");
+        return false;
+    }
+    
+    DEVICE_LOG_DEBUG("Light animation compiled: {} keyframes, {} frames", keyframes.size(), timeline->getFrameCount());
+    return true;
+}
+
+double LightAnimation::getDuration() const {
+    return timeline ? timeline->getDuration() : 0.0;
+}
+
+int LightAnimation::getFrameCount() const {
+    return timeline ? static_cast<int>(timeline->getFrameCount()) : 0;
+}
+
+Color LightAnimation::sample(double timeSeconds) const {
+    if (!timeline) {
+        return Color(0, 0, 0);
+    }
+    PackedColor frame = ColorSpace::fromLinear(timeline->sample(timeSeconds).color);
+    return Color(frame.r / 255.0f, frame.g / 255.0f, frame.b / 255.0f);
+}
+
+float LightAnimation::sampleBrightness(double timeSeconds) const {
+    return timeline ? timeline->sample(timeSeconds).brightness : 0.0f;
+}
+
+void LightAnimation::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_keyframe", "time_sec", "color", "brightness", "easing"), &LightAnimation::addKeyframe,
+                         DEFVAL(1.0f), DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("clear_keyframes"), &LightAnimation::clearKeyframes);
+    ClassDB::bind_method(D_METHOD("get_keyframe_count"), &LightAnimation::getKeyframeCount);
+    ClassDB::bind_method(D_METHOD("set_loop", "enabled"), &LightAnimation::setLoop);
+    ClassDB::bind_method(D_METHOD("get_loop"), &LightAnimation::getLoop);
+    ClassDB::bind_method(D_METHOD("set_frame_rate", "rate"), &LightAnimation::setFrameRate);
+    ClassDB::bind_method(D_METHOD("get_frame_rate"), &LightAnimation::getFrameRate);
+    ClassDB::bind_method(D_METHOD("compile"), &LightAnimation::compile);
+    ClassDB::bind_method(D_METHOD("is_compiled"), &LightAnimation::isCompiled);
+    ClassDB::bind_method(D_METHOD("get_duration"), &LightAnimation::getDuration);
+    ClassDB::bind_method(D_METHOD("get_frame_count"), &LightAnimation::getFrameCount);
+    ClassDB::bind_method(D_METHOD("sample", "time_sec"), &LightAnimation::sample);
+    ClassDB::bind_method(D_METHOD("sample_brightness", "time_sec"), &LightAnimation::sampleBrightness);
+    
+    BIND_CONSTANT(EASE_LINEAR);
+    BIND_CONSTANT(EASE_STEP);
+    BIND_CONSTANT(EASE_IN);
+    BIND_CONSTANT(EASE_OUT);
+    BIND_CONSTANT(EASE_IN_OUT);
+}
@@ -0,0 +1,68 @@
+#ifndef LIGHT_ANIMATION_H
+#define LIGHT_ANIMATION_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include "light_timeline.h"
+#include <memory>
+#include <vector>
+
+using namespace godot;
+
+/**
+ * @class LightAnimation
+ * @brief Godot resource for authoring a keyframed light timeline
+ *
+ * Keyframes are collected with add_keyframe() and baked by compile(). The
+ * compiled table is shared, not copied, by every bed that plays it, so one
+ * animation can drive a whole ward. Editing keyframes does not touch beds
+ * already playing the previous compile.
+ */
+class LightAnimation : public RefCounted {
+    GDCLASS(LightAnimation, RefCounted)
+
+public:
+    // Easing constants for GDScript binding
+    static const int EASE_LINEAR = static_cast<int>(LightKeyframe::Easing::LINEAR);
+    static const int EASE_STEP = static_cast<int>(LightKeyframe::Easing::STEP);
+    static const int EASE_IN = static_cast<int>(LightKeyframe::Easing::EASE_IN);
+    static const int EASE_OUT = static_cast<int>(LightKeyframe::Easing::EASE_OUT);
+    static const int EASE_IN_OUT = static_cast<int>(LightKeyframe::Easing::EASE_IN_OUT);
+
+private:
+    std::vector<LightKeyframe> keyframes;
+    std::shared_ptr<const LightTimeline> timeline;
+    bool loop;
+    float frameRate;
+
+public:
+    LightAnimation();
+    ~LightAnimation() = default;
+
+    // Keyframe authoring; easing shapes the segment to the next keyframe
+    bool addKeyframe(double timeSeconds, const Color& color, float brightness, int easing);
+    void clearKeyframes();
+    int getKeyframeCount() const { return static_cast<int>(keyframes.size()); }
+
+    void setLoop(bool enabled) { loop = enabled; }
+    bool getLoop() const { return loop; }
+    void setFrameRate(float rate);
+    float getFrameRate() const { return frameRate; }
+
+    // Bakes the keyframes into the lookup table beds sample from
+    bool compile();
+    bool isCompiled() const { return timeline != nullptr; }
+    double getDuration() const;
+    int getFrameCount() const;
+
+    // Compiled color and brightness at a time, for previews
+    Color sample(double timeSeconds) const;
+    float sampleBrightness(double timeSeconds) const;
+
+    std::shared_ptr<const LightTimeline> getTimeline() const { return timeline; }
+
+protected:
+    static void _bind_methods();
+};
+
+#endif // LIGHT_ANIMATION_H
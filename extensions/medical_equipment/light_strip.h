@@ -1,16 +1,18 @@
 #ifndef LIGHT_STRIP_H
 #define LIGHT_STRIP_H
 
-#include <godot_cpp/variant/utility_functions.hpp>
+#include "device_log.h"
+#include "led_framebuffer.h"
+#include "packed_color.h"
+#include "light_timeline.h"
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
-using namespace godot;
-
-// Color structure for RGB values
-struct LightColor {
-    int red, green, blue;
-    LightColor(int r = 255, int g = 255, int b = 255) : red(r), green(g), blue(b) {}
-};
+// sRGB-encoded RGBA8; channels clamp to 0..255 on construction
+using LightColor = PackedColor;
 
 // Strategy Pattern Interface for Light Behaviors
 class LightBehavior {
@@ -20,48 +22,76 @@ public:
     virtual void deactivate() = 0;
     virtual void setBrightness(float intensity) = 0;
     virtual void setColor(const LightColor& color) = 0;
+    virtual void setEffect(const LedEffect& effect) = 0;
     virtual bool isEmergencyMode() const = 0;
     virtual std::string getBehaviorType() const = 0;
+    
+    // What the LEDs show, and at what linear brightness
+    virtual LedEffect getEffect() const = 0;
+    virtual float getBrightness() const = 0;
 };
 
 // Concrete Light Behaviors
-class NormalLightBehavior : public LightBehavior {
+class NormalLightBehavior final : public LightBehavior {
 private:
     float brightness;
     LightColor currentColor;
+    LedEffect effect;
     bool isActive;
+    
+    // Share of the set brightness kept while deactivated
+    static constexpr float kGlowLevel = 0.1f;
 
 public:
-    NormalLightBehavior() : brightness(0.5f), currentColor(255, 255, 255), isActive(false) {}
+    NormalLightBehavior() : brightness(0.5f), currentColor(255, 255, 255), isActive(false) {
+        effect = LedEffect::solid(currentColor.toLinear());
+    }
     
     void activate() override {
         isActive = true;
-        UtilityFunctions::print("Normal lights activated");
+        DEVICE_LOG_DEBUG("Normal lights activated");
     }
     
     void deactivate() override {
         isActive = false;
-        UtilityFunctions::print("Normal lights deactivated - gentle glow mode");
+        DEVICE_LOG_DEBUG("Normal lights deactivated - gentle glow mode");
     }
     
     void setBrightness(float intensity) override {
         brightness = std::max(0.0f, std::min(1.0f, intensity));
-        UtilityFunctions::print("Brightness set to: ", brightness);
+        DEVICE_LOG_DEBUG("Brightness set to: {}", brightness);
     }
     
     void setColor(const LightColor& color) override {
         currentColor = color;
-        UtilityFunctions::print("Color set to RGB(", color.red, ",", color.green, ",", color.blue, ")");
+        effect.primary = color.toLinear();
+        DEVICE_LOG_DEBUG("Color set to RGB({},{},{})", static_cast<int>(color.r), static_cast<int>(color.g), static_cast<int>(color.b));
+    }
+    
+    // Keeps the current color as the effect's primary
+    void setEffect(const LedEffect& newEffect) override {
+        effect = newEffect;
+        effect.primary = currentColor.toLinear();
     }
     
     bool isEmergencyMode() const override { return false; }
     std::string getBehaviorType() const override { return "Normal"; }
+    
+    // Settings as set, whether or not the lights are on; snapshots save these
+    bool isActivated() const { return isActive; }
+    float getBrightnessSetting() const { return brightness; }
+    LightColor getColor() const { return currentColor; }
+    LedEffect getEffect() const override { return effect; }
+    float getBrightness() const override { return isActive ? brightness : brightness * kGlowLevel; }
 };
 
-class EmergencyLightBehavior : public LightBehavior {
+class EmergencyLightBehavior final : public LightBehavior {
 private:
     bool isBlinking;
     bool isActive;
+    
+    static constexpr float kStrobeHz = 2.0f;
+    static constexpr float kStrobeDuty = 0.5f;
 
 public:
     EmergencyLightBehavior() : isBlinking(false), isActive(false) {}
@@ -69,25 +99,35 @@ public:
     void activate() override {
         isActive = true;
         isBlinking = true;
-        UtilityFunctions::print("🚨 EMERGENCY LIGHTS ACTIVATED - RED BLINKING!");
+        DEVICE_LOG_ALERT("🚨 EMERGENCY LIGHTS ACTIVATED - RED BLINKING!");
     }
     
     void deactivate() override {
         isActive = false;
         isBlinking = false;
-        UtilityFunctions::print("Emergency lights deactivated");
+        DEVICE_LOG_ALERT("Emergency lights deactivated");
     }
     
-    void setBrightness(float intensity) override {
-        UtilityFunctions::print("Emergency mode - brightness locked to maximum");
+    void setBrightness(float /*intensity*/) override {
+        DEVICE_LOG_DEBUG("Emergency mode - brightness locked to maximum");
     }
     
-    void setColor(const LightColor& color) override {
-        UtilityFunctions::print("Emergency mode - color locked to red");
+    void setColor(const LightColor& /*color*/) override {
+        DEVICE_LOG_DEBUG("Emergency mode - color locked to red");
+    }
+    
+    void setEffect(const LedEffect& /*effect*/) override {
+        DEVICE_LOG_DEBUG("Emergency mode - effect locked to red strobe");
     }
     
     bool isEmergencyMode() const override { return true; }
     std::string getBehaviorType() const override { return "Emergency"; }
+    
+    LedEffect getEffect() const override {
+        return isBlinking ? LedEffect::strobe({1.0f, 0.0f, 0.0f}, kStrobeHz, kStrobeDuty)
+                          : LedEffect::solid({1.0f, 0.0f, 0.0f});
+    }
+    float getBrightness() const override { return isActive ? 1.0f : 0.0f; }
 };
 
 // Observer Pattern Interface for Emergency Notifications
@@ -99,61 +139,154 @@ public:
 };
 
 // Main LightStrip class using Strategy Pattern
+//
+// The built-in normal and emergency behaviors live inline in the strip and
+// are selected by a mode tag, so entering or leaving emergency mode never
+// allocates and the normal behavior's brightness, color and effect are
+// still there when the emergency ends. Calls on the built-in behaviors go
+// to their final types directly; only a custom behavior installed with
+// setBehavior() is heap-allocated and dispatched virtually.
+//
+// A playing timeline animates the color and brightness of whatever the
+// non-emergency behavior shows: each frame takes the timeline's color as
+// the effect's primary and scales the behavior's brightness by the
+// timeline's. Emergency mode always overrides the timeline.
 class LightStrip {
+public:
+    enum class Mode : uint8_t { NORMAL, EMERGENCY, CUSTOM };
+
 private:
-    std::unique_ptr<LightBehavior> lightBehavior;
+    NormalLightBehavior normalBehavior;
+    EmergencyLightBehavior emergencyBehavior;
+    std::unique_ptr<LightBehavior> customBehavior;
+    Mode mode;
+    Mode resumeMode;  // restored when emergency mode ends
     std::vector<EmergencyObserver*> observers;
+    LedFramebuffer framebuffer;
+    std::shared_ptr<const LightTimeline> timeline;
+    double timelineOffset;  // seconds added to the frame time
+    float frameBrightness;  // brightness of the last rendered frame
+    
+    // Calls fn with the active behavior as its concrete type
+    template <typename Fn>
+    decltype(auto) withBehavior(Fn&& fn) {
+        switch (mode) {
+            case Mode::EMERGENCY: return fn(emergencyBehavior);
+            case Mode::CUSTOM: return fn(*customBehavior);
+            case Mode::NORMAL:
+            default: return fn(normalBehavior);
+        }
+    }
+    
+    template <typename Fn>
+    decltype(auto) withBehavior(Fn&& fn) const {
+        switch (mode) {
+            case Mode::EMERGENCY: return fn(emergencyBehavior);
+            case Mode::CUSTOM: return fn(*customBehavior);
+            case Mode::NORMAL:
+            default: return fn(normalBehavior);
+        }
+    }
     
 public:
-    LightStrip() : lightBehavior(std::make_unique<NormalLightBehavior>()) {}
+    LightStrip() : mode(Mode::NORMAL), resumeMode(Mode::NORMAL), timelineOffset(0.0), frameBrightness(0.0f) {}
     
     virtual ~LightStrip() = default;
     
+    // Installs a custom behavior; nullptr returns to the built-in normal behavior
     void setBehavior(std::unique_ptr<LightBehavior> behavior) {
-        lightBehavior = std::move(behavior);
+        customBehavior = std::move(behavior);
+        mode = customBehavior ? Mode::CUSTOM : Mode::NORMAL;
+        resumeMode = mode;
     }
     
     void activate() {
-        if (lightBehavior) {
-            lightBehavior->activate();
-        }
+        withBehavior([](auto& behavior) { behavior.activate(); });
     }
     
     void deactivate() {
-        if (lightBehavior) {
-            lightBehavior->deactivate();
-        }
+        withBehavior([](auto& behavior) { behavior.deactivate(); });
     }
     
     void setBrightness(float intensity) {
-        if (lightBehavior) {
-            lightBehavior->setBrightness(intensity);
-        }
+        withBehavior([intensity](auto& behavior) { behavior.setBrightness(intensity); });
     }
     
     void setColor(const LightColor& color) {
-        if (lightBehavior) {
-            lightBehavior->setColor(color);
-        }
+        withBehavior([&color](auto& behavior) { behavior.setColor(color); });
     }
     
     void activateEmergencyMode() {
-        setBehavior(std::make_unique<EmergencyLightBehavior>());
-        activate();
+        if (mode != Mode::EMERGENCY) {
+            resumeMode = mode;
+            mode = Mode::EMERGENCY;
+        }
+        emergencyBehavior.activate();
         notifyEmergencyActivated();
     }
     
     void deactivateEmergencyMode() {
-        setBehavior(std::make_unique<NormalLightBehavior>());
+        if (mode == Mode::EMERGENCY) {
+            emergencyBehavior.deactivate();
+            mode = resumeMode;
+        }
         notifyEmergencyDeactivated();
     }
     
+    Mode getMode() const { return mode; }
+    
+    // The built-in normal behavior, even while emergency mode overrides it
+    NormalLightBehavior& getNormalBehavior() { return normalBehavior; }
+    const NormalLightBehavior& getNormalBehavior() const { return normalBehavior; }
+    
     bool isEmergencyMode() const {
-        return lightBehavior && lightBehavior->isEmergencyMode();
+        return withBehavior([](const auto& behavior) { return behavior.isEmergencyMode(); });
     }
     
     std::string getCurrentMode() const {
-        return lightBehavior ? lightBehavior->getBehaviorType() : "None";
+        return withBehavior([](const auto& behavior) { return behavior.getBehaviorType(); });
+    }
+    
+    // The behavior currently driving the LEDs
+    const LightBehavior& getBehavior() const {
+        return withBehavior([](const auto& behavior) -> const LightBehavior& { return behavior; });
+    }
+    
+    void setEffect(const LedEffect& effect) {
+        withBehavior([&effect](auto& behavior) { behavior.setEffect(effect); });
+    }
+    
+    // Addressable LEDs on the physical strip
+    void setLedCount(size_t count) { framebuffer.resize(count); }
+    size_t getLedCount() const { return framebuffer.size(); }
+    const LedFramebuffer& getFramebuffer() const { return framebuffer; }
+    
+    // Plays a compiled timeline shifted by phaseOffset seconds; nullptr stops it
+    void playTimeline(std::shared_ptr<const LightTimeline> animation, double phaseOffset = 0.0) {
+        timeline = std::move(animation);
+        timelineOffset = phaseOffset;
+    }
+    
+    void stopTimeline() { timeline.reset(); }
+    bool isTimelinePlaying() const { return timeline != nullptr; }
+    const LightTimeline* getTimeline() const { return timeline.get(); }
+    
+    // Evaluates the current behavior's effect for every LED; strips only
+    // read the shared timeline, so different strips may render on different threads
+    void renderFrame(double timeSeconds) {
+        LedEffect effect = withBehavior([](const auto& behavior) { return behavior.getEffect(); });
+        frameBrightness = withBehavior([](const auto& behavior) { return behavior.getBrightness(); });
+        if (timeline && mode != Mode::EMERGENCY) {
+            const LightTimeline::Sample& sample = timeline->sample(timeSeconds + timelineOffset);
+            effect.primary = sample.color;
+            frameBrightness *= sample.brightness;
+        }
+        framebuffer.render(effect, timeSeconds);
+    }
+    
+    // Last rendered frame as getLedCount() * 3 RGB bytes, brightness and gamma applied
+    void encodeFrame(uint8_t* out, const LedGammaTable& gamma = LedGammaTable::standard()) const {
+        framebuffer.encodeRgb8(out, frameBrightness, gamma);
     }
     
     // Observer pattern methods
@@ -0,0 +1,90 @@
+#include "light_timeline.h"
+#include <algorithm>
+#include <cmath>
+
+std::shared_ptr<const LightTimeline> LightTimeline::compile(std::vector<LightKeyframe> keyframes, bool loop,
+                                                            float frameRate) {
+    // An infinite or NaN time would make the duration, and so the frame count, meaningless
+    bool finite = std::isfinite(frameRate) &&
+                  std::all_of(keyframes.begin(), keyframes.end(),
+                              [](const LightKeyframe& keyframe) { return std::isfinite(keyframe.timeSeconds); });
+    if (keyframes.empty() || !finite) {
+        return nullptr;
+    }
+
+    for (auto& keyframe : keyframes) {
+        keyframe.timeSeconds = std::max(0.0, keyframe.timeSeconds);
+    }
+    std::stable_sort(keyframes.begin(), keyframes.end(), [](const LightKeyframe& a, const LightKeyframe& b) {
+        return a.timeSeconds < b.timeSeconds;
+    });
+
+    std::shared_ptr<LightTimeline> timeline(new LightTimeline());
+    timeline->loop = loop;
+    timeline->duration = keyframes.back().timeSeconds;
+
+    double rate = std::max(1.0f, frameRate);
+    if (timeline->duration * rate >= static_cast<double>(kMaxFrames - 1)) {
+        rate = static_cast<double>(kMaxFrames - 1) / timeline->duration;
+    }
+    timeline->frameRate = static_cast<float>(rate);
+
+    size_t frameCount = static_cast<size_t>(std::floor(timeline->duration * rate)) + 1;
+    timeline->frames.resize(frameCount);
+
+    // Frames are visited in time order, so the segment cursor only moves forward
+    size_t segment = 0;
+    for (size_t i = 0; i < frameCount; ++i) {
+        double time = static_cast<double>(i) / rate;
+        while (segment + 1 < keyframes.size() && keyframes[segment + 1].timeSeconds <= time) {
+            ++segment;
+        }
+
+        const LightKeyframe& from = keyframes[segment];
+        Sample& frame = timeline->frames[i];
+        if (segment + 1 == keyframes.size() || time <= from.timeSeconds) {
+            frame = {from.color, from.brightness};
+            continue;
+        }
+
+        const LightKeyframe& to = keyframes[segment + 1];
+        float progress = static_cast<float>((time - from.timeSeconds) / (to.timeSeconds - from.timeSeconds));
+        float t = ease(from.easing, progress);
+        frame.color.r = from.color.r + (to.color.r - from.color.r) * t;
+        frame.color.g = from.color.g + (to.color.g - from.color.g) * t;
+        frame.color.b = from.color.b + (to.color.b - from.color.b) * t;
+        frame.brightness = from.brightness + (to.brightness - from.brightness) * t;
+    }
+    return timeline;
+}
+
+float LightTimeline::ease(LightKeyframe::Easing easing, float progress) {
+    float t = std::max(0.0f, std::min(1.0f, progress));
+    switch (easing) {
+        case LightKeyframe::Easing::STEP: return t < 1.0f ? 0.0f : 1.0f;
+        case LightKeyframe::Easing::EASE_IN: return t * t * t;
+        case LightKeyframe::Easing::EASE_OUT: {
+            float inverse = 1.0f - t;
+            return 1.0f - inverse * inverse * inverse;
+        }
+        case LightKeyframe::Easing::EASE_IN_OUT: return t * t * (3.0f - 2.0f * t);
+        case LightKeyframe::Easing::LINEAR:
+        default: return t;
+    }
+}
+
+const LightTimeline::Sample& LightTimeline::sample(double timeSeconds) const {
+    if (loop && duration > 0.0) {
+        timeSeconds = std::fmod(timeSeconds, duration);
+        if (timeSeconds < 0.0) {
+            timeSeconds += duration;
+        }
+    }
+
+    double position = timeSeconds * frameRate + 0.5;
+    if (!(position > 0.0)) {
+        return frames.front();
+    }
+    size_t index = static_cast<size_t>(std::min(position, static_cast<double>(frames.size() - 1)));
+    return frames[index];
+}
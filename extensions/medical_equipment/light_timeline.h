@@ -0,0 +1,79 @@
+#ifndef LIGHT_TIMELINE_H
+#define LIGHT_TIMELINE_H
+
+#include "led_framebuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct LightKeyframe
+ * @brief Color and brightness at a point in a light animation
+ *
+ * easing shapes the segment from this keyframe to the next one.
+ */
+struct LightKeyframe {
+    enum class Easing : uint8_t { LINEAR, STEP, EASE_IN, EASE_OUT, EASE_IN_OUT };
+
+    double timeSeconds = 0.0;
+    LedColor color = {1.0f, 1.0f, 1.0f};
+    float brightness = 1.0f;
+    Easing easing = Easing::LINEAR;
+};
+
+/**
+ * @class LightTimeline
+ * @brief Keyframed light animation baked into a per-frame lookup table
+ *
+ * compile() evaluates the keyframes and their easing curves once per frame
+ * at the given frame rate, so sample() is an index computation and a single
+ * table read whatever the number of keyframes. A compiled timeline is
+ * immutable and handed out as a shared pointer: any number of strips, on
+ * any thread, can play it at their own phase offset.
+ *
+ * Before the first keyframe the animation holds the first keyframe, and a
+ * non-looping animation holds its last keyframe once it has finished. A
+ * looping animation wraps at its last keyframe, so a seamless loop ends on
+ * the same values it starts with.
+ */
+class LightTimeline {
+public:
+    struct Sample {
+        LedColor color;
+        float brightness;
+    };
+
+    static constexpr float kDefaultFrameRate = 60.0f;
+
+    // Longer animations are baked at a lower rate to stay within this many frames
+    static constexpr size_t kMaxFrames = 1 << 16;
+
+    /**
+     * Sorts the keyframes by time and bakes them
+     * @param frameRate Table entries per second of animation
+     * @return nullptr if there are no keyframes, or a keyframe time or the frame rate is not finite
+     */
+    static std::shared_ptr<const LightTimeline> compile(std::vector<LightKeyframe> keyframes, bool loop,
+                                                        float frameRate = kDefaultFrameRate);
+
+    // Eased 0..1 progress through a segment
+    static float ease(LightKeyframe::Easing easing, float progress);
+
+    const Sample& sample(double timeSeconds) const;
+
+    double getDuration() const { return duration; }
+    float getFrameRate() const { return frameRate; }
+    size_t getFrameCount() const { return frames.size(); }
+    bool isLooping() const { return loop; }
+
+private:
+    LightTimeline() = default;
+
+    std::vector<Sample> frames;
+    double duration = 0.0;
+    float frameRate = kDefaultFrameRate;
+    bool loop = false;
+};
+
+#endif // LIGHT_TIMELINE_H
@@ -0,0 +1,154 @@
+#include "maintenance_scheduler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+int popcount(uint8_t bits) {
+    int count = 0;
+    for (; bits; bits &= static_cast<uint8_t>(bits - 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+MaintenanceTarget::~MaintenanceTarget() {
+    if (scheduler) {
+        scheduler->remove(this);
+    }
+}
+
+void MaintenanceTarget::markMaintenanceDirty(uint8_t subsystems) {
+    maintenanceDirty |= subsystems & MaintenanceRecord::SUBSYSTEM_ALL;
+    if (maintenanceDirty && scheduler && !queued) {
+        scheduler->enqueue(this);
+    }
+}
+
+const MaintenanceRecord& MaintenanceTarget::refreshMaintenance() {
+    if (maintenanceDirty) {
+        // Cleared first, so a check that marks its own subsystem dirty again is kept
+        uint8_t subsystems = maintenanceDirty;
+        maintenanceDirty = 0;
+        lastMaintenance = inspectSubsystems(subsystems, lastMaintenance);
+    }
+    return lastMaintenance;
+}
+
+MaintenanceScheduler::MaintenanceScheduler(int64_t budget)
+    : budgetUs(kDefaultBudgetUs), windowSeconds(0.0), windowChecks(0) {
+    setBudgetUs(budget);
+}
+
+MaintenanceScheduler::~MaintenanceScheduler() {
+    clear();
+}
+
+bool MaintenanceScheduler::add(MaintenanceTarget* target) {
+    if (!target || target->scheduler) {
+        return false;
+    }
+    
+    target->scheduler = this;
+    targets.push_back(target);
+    if (target->maintenanceDirty) {
+        enqueue(target);
+    }
+    stats.targets = targets.size();
+    return true;
+}
+
+bool MaintenanceScheduler::remove(MaintenanceTarget* target) {
+    auto it = std::find(targets.begin(), targets.end(), target);
+    if (it == targets.end()) {
+        return false;
+    }
+    
+    targets.erase(it);
+    if (target->queued) {
+        backlog.erase(std::find(backlog.begin(), backlog.end(), target));
+    }
+    faultChanges.erase(std::remove(faultChanges.begin(), faultChanges.end(), target), faultChanges.end());
+    detach(target);
+    stats.targets = targets.size();
+    stats.backlog = backlog.size();
+    return true;
+}
+
+void MaintenanceScheduler::clear() {
+    for (MaintenanceTarget* target : targets) {
+        detach(target);
+    }
+    targets.clear();
+    backlog.clear();
+    faultChanges.clear();
+    stats.targets = 0;
+    stats.backlog = 0;
+}
+
+void MaintenanceScheduler::setBudgetUs(int64_t budget) {
+    budgetUs = std::max<int64_t>(budget, 1);
+}
+
+size_t MaintenanceScheduler::runFrame(double frameDelta) {
+    faultChanges.clear();
+    int64_t start = nowMicros();
+    int64_t elapsed = 0;
+    size_t checks = 0;
+
+    // At least one check per frame, then only while the budget lasts
+    while (!backlog.empty() && (checks == 0 || elapsed < budgetUs)) {
+        MaintenanceTarget* target = backlog.front();
+        backlog.pop_front();
+        target->queued = false;
+
+        int rechecked = popcount(target->maintenanceDirty);
+        uint16_t faultsBefore = target->lastMaintenance.faults;
+        target->refreshMaintenance();
+        if (target->lastMaintenance.faults != faultsBefore) {
+            faultChanges.push_back(target);
+        }
+        if (target->maintenanceDirty && !target->queued) {
+            enqueue(target);
+        }
+
+        stats.subsystemsChecked += static_cast<uint64_t>(rechecked);
+        stats.subsystemsSkipped += static_cast<uint64_t>(MaintenanceRecord::kSubsystemCount - rechecked);
+        ++checks;
+        elapsed = nowMicros() - start;
+    }
+
+    stats.lastFrameChecks = checks;
+    stats.lastFrameUs = elapsed;
+    stats.totalChecks += checks;
+    stats.backlog = backlog.size();
+
+    // Rates settle once per second of frames
+    windowSeconds += std::max(frameDelta, 0.0);
+    windowChecks += checks;
+    if (windowSeconds >= 1.0) {
+        stats.checksPerSecond = static_cast<double>(windowChecks) / windowSeconds;
+        stats.coveragePerSecond = targets.empty() ? 0.0 : stats.checksPerSecond / static_cast<double>(targets.size());
+        windowSeconds = 0.0;
+        windowChecks = 0;
+    }
+    return checks;
+}
+
+void MaintenanceScheduler::enqueue(MaintenanceTarget* target) {
+    target->queued = true;
+    backlog.push_back(target);
+    stats.backlog = backlog.size();
+}
+
+void MaintenanceScheduler::detach(MaintenanceTarget* target) {
+    target->scheduler = nullptr;
+    target->queued = false;
+}
+
+int64_t MaintenanceScheduler::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,115 @@
+#ifndef MAINTENANCE_SCHEDULER_H
+#define MAINTENANCE_SCHEDULER_H
+
+#include "maintenance_sweep.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class MaintenanceScheduler;
+
+/**
+ * @class MaintenanceTarget
+ * @brief Anything with maintenance checks that can be rechecked incrementally
+ *
+ * Keeps the last record and a dirty bit per MaintenanceRecord::Subsystem.
+ * Owners call markMaintenanceDirty() whenever a subsystem's state changes;
+ * refreshMaintenance() rechecks only the dirty subsystems and keeps the
+ * rest of the record. Everything starts dirty. Targets registered with a
+ * scheduler join its backlog the moment they turn dirty, so the scheduler
+ * never scans clean ones.
+ */
+class MaintenanceTarget {
+public:
+    MaintenanceTarget() = default;
+    MaintenanceTarget(const MaintenanceTarget&) = delete;
+    MaintenanceTarget& operator=(const MaintenanceTarget&) = delete;
+    virtual ~MaintenanceTarget();
+
+    void markMaintenanceDirty(uint8_t subsystems);
+    uint8_t getMaintenanceDirty() const { return maintenanceDirty; }
+    const MaintenanceRecord& getLastMaintenance() const { return lastMaintenance; }
+
+    // Rechecks the dirty subsystems and returns the updated record
+    const MaintenanceRecord& refreshMaintenance();
+
+protected:
+    // Checks the given subsystems into a copy of the previous record
+    virtual MaintenanceRecord inspectSubsystems(uint8_t subsystems, MaintenanceRecord previous) const = 0;
+
+private:
+    friend class MaintenanceScheduler;
+
+    MaintenanceRecord lastMaintenance;
+    uint8_t maintenanceDirty = MaintenanceRecord::SUBSYSTEM_ALL;
+    MaintenanceScheduler* scheduler = nullptr;
+    bool queued = false;
+};
+
+/**
+ * @class MaintenanceScheduler
+ * @brief Spreads incremental maintenance checks across frames
+ *
+ * runFrame() rechecks backlogged targets in the order they turned dirty
+ * until its microsecond budget is spent, always at least one per frame so
+ * the backlog drains even under a tiny budget. Stats report the backlog,
+ * per-frame cost, and the share of the fleet rechecked per second,
+ * averaged over one-second windows. Targets are borrowed, not owned; a
+ * target destroyed while registered removes itself.
+ */
+class MaintenanceScheduler {
+public:
+    static constexpr int64_t kDefaultBudgetUs = 500;
+
+    struct Stats {
+        size_t targets = 0;
+        size_t backlog = 0;
+        size_t lastFrameChecks = 0;
+        int64_t lastFrameUs = 0;
+        uint64_t totalChecks = 0;
+        uint64_t subsystemsChecked = 0;  // dirty subsystems rechecked
+        uint64_t subsystemsSkipped = 0;  // clean subsystems a full check would have repeated
+        double checksPerSecond = 0.0;
+        double coveragePerSecond = 0.0;  // checksPerSecond / targets
+    };
+
+    explicit MaintenanceScheduler(int64_t budgetUs = kDefaultBudgetUs);
+    ~MaintenanceScheduler();
+    MaintenanceScheduler(const MaintenanceScheduler&) = delete;
+    MaintenanceScheduler& operator=(const MaintenanceScheduler&) = delete;
+
+    bool add(MaintenanceTarget* target);
+    bool remove(MaintenanceTarget* target);
+    void clear();
+    size_t size() const { return targets.size(); }
+    const std::vector<MaintenanceTarget*>& getTargets() const { return targets; }
+
+    void setBudgetUs(int64_t budgetUs);
+    int64_t getBudgetUs() const { return budgetUs; }
+
+    // Rechecks targets until the budget runs out; frameDelta feeds the per-second rates
+    size_t runFrame(double frameDelta);
+
+    // Targets whose faults changed during the last runFrame()
+    const std::vector<MaintenanceTarget*>& getFaultChanges() const { return faultChanges; }
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    friend class MaintenanceTarget;
+
+    void enqueue(MaintenanceTarget* target);
+    void detach(MaintenanceTarget* target);
+    static int64_t nowMicros();
+
+    std::vector<MaintenanceTarget*> targets;
+    std::deque<MaintenanceTarget*> backlog;
+    std::vector<MaintenanceTarget*> faultChanges;
+    int64_t budgetUs;
+    Stats stats;
+    double windowSeconds;
+    uint64_t windowChecks;
+};
+
+#endif // MAINTENANCE_SCHEDULER_H
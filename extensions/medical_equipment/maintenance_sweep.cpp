@@ -0,0 +1,145 @@
+#include "maintenance_sweep.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+// Beds per worker chunk; one inspection is a handful of virtual calls
+constexpr size_t kBedsPerChunk = 64;
+
+constexpr const char* kFaultNames[MaintenanceRecord::kFaultCount] = {
+    "height", "lights", "temperature", "occupancy_sensor", "medical_device", "positioning",
+};
+
+} // namespace
+
+void MaintenanceRecord::recordHeight(float height, float minHeight, float maxHeight) {
+    if (height < minHeight) {
+        heightCode = HeightCode::BELOW_RANGE;
+    } else if (height > maxHeight) {
+        heightCode = HeightCode::ABOVE_RANGE;
+    } else {
+        heightCode = HeightCode::OK;
+    }
+    if (heightCode != HeightCode::OK) {
+        faults |= FAULT_HEIGHT;
+    }
+    heightCm = static_cast<uint8_t>(std::lround(std::min(std::max(height, 0.0f), 255.0f)));
+}
+
+void MaintenanceRecord::recordPower(bool powered) {
+    if (powered) {
+        status |= STATUS_POWERED;
+    }
+}
+
+void MaintenanceRecord::recordLift(float height, float minHeight, float maxHeight, bool moving) {
+    recordHeight(height, minHeight, maxHeight);
+    if (moving) {
+        status |= STATUS_HEIGHT_MOVING;
+    }
+}
+
+void MaintenanceRecord::recordLights(bool present, bool emergency) {
+    if (!present) {
+        faults |= FAULT_LIGHTS;
+    } else if (emergency) {
+        status |= STATUS_EMERGENCY;
+    }
+}
+
+void MaintenanceRecord::recordTemperature(bool present, uint8_t mode) {
+    if (!present) {
+        faults |= FAULT_TEMPERATURE;
+        return;
+    }
+    temperatureMode = mode;
+}
+
+void MaintenanceRecord::clearSubsystems(uint8_t subsystems) {
+    if (subsystems & SUBSYSTEM_POWER) {
+        status &= static_cast<uint16_t>(~STATUS_POWERED);
+    }
+    if (subsystems & SUBSYSTEM_HEIGHT) {
+        faults &= static_cast<uint16_t>(~(FAULT_HEIGHT | FAULT_POSITIONING));
+        status &= static_cast<uint16_t>(~STATUS_HEIGHT_MOVING);
+        heightCode = HeightCode::OK;
+        heightCm = 0;
+    }
+    if (subsystems & SUBSYSTEM_LIGHTS) {
+        faults &= static_cast<uint16_t>(~FAULT_LIGHTS);
+        status &= static_cast<uint16_t>(~STATUS_EMERGENCY);
+    }
+    if (subsystems & SUBSYSTEM_TEMPERATURE) {
+        faults &= static_cast<uint16_t>(~FAULT_TEMPERATURE);
+        temperatureMode = kNoTemperature;
+    }
+    if (subsystems & SUBSYSTEM_DEVICE) {
+        faults &= static_cast<uint16_t>(~(FAULT_OCCUPANCY_SENSOR | FAULT_MEDICAL_DEVICE));
+        status &= static_cast<uint16_t>(~(STATUS_OCCUPIED | STATUS_COMFORT_MODE | STATUS_STERILE | STATUS_PROCEDURE));
+    }
+}
+
+uint64_t MaintenanceRecord::pack() const {
+    return static_cast<uint64_t>(faults) | (static_cast<uint64_t>(status) << 16) |
+           (static_cast<uint64_t>(heightCode) << 32) | (static_cast<uint64_t>(heightCm) << 40) |
+           (static_cast<uint64_t>(temperatureMode) << 48);
+}
+
+MaintenanceRecord MaintenanceRecord::unpack(uint64_t packed) {
+    MaintenanceRecord record;
+    record.faults = static_cast<uint16_t>(packed);
+    record.status = static_cast<uint16_t>(packed >> 16);
+    record.heightCode = static_cast<HeightCode>(static_cast<uint8_t>(packed >> 32));
+    record.heightCm = static_cast<uint8_t>(packed >> 40);
+    record.temperatureMode = static_cast<uint8_t>(packed >> 48);
+    return record;
+}
+
+MaintenanceSweep::Summary MaintenanceSweep::run(size_t count, const Inspector& inspect,
+                                                std::vector<MaintenanceRecord>& records, WorkerPool* pool) {
+    auto start = std::chrono::steady_clock::now();
+    records.resize(count);
+
+    // Each chunk writes only its own slice of records
+    auto inspectRange = [&inspect, &records](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            records[i] = inspect(i);
+        }
+    };
+    if (pool) {
+        pool->parallelFor(count, kBedsPerChunk, inspectRange);
+    } else {
+        inspectRange(0, count);
+    }
+
+    Summary summary = summarize(records.data(), count);
+    summary.durationUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    return summary;
+}
+
+MaintenanceSweep::Summary MaintenanceSweep::summarize(const MaintenanceRecord* records, size_t count) {
+    Summary summary;
+    summary.checked = count;
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t faults = records[i].faults;
+        if (faults == 0) {
+            ++summary.healthy;
+            continue;
+        }
+        for (int bit = 0; bit < MaintenanceRecord::kFaultCount; ++bit) {
+            summary.faultCounts[bit] += (faults >> bit) & 1u;
+        }
+    }
+    return summary;
+}
+
+const char* MaintenanceSweep::getFaultName(int bit) {
+    if (bit < 0 || bit >= MaintenanceRecord::kFaultCount) {
+        return "unknown";
+    }
+    return kFaultNames[bit];
+}
@@ -0,0 +1,120 @@
+#ifndef MAINTENANCE_SWEEP_H
+#define MAINTENANCE_SWEEP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class WorkerPool;
+
+/**
+ * @struct MaintenanceRecord
+ * @brief Outcome of one bed's maintenance checks, 8 bytes
+ *
+ * faults has a bit per failed check, so zero means the bed passed; status
+ * carries informational state that is not a failure. pack() folds the
+ * record into one 64-bit integer for GDScript:
+ * bits 0-15 faults, 16-31 status, 32-39 height code, 40-47 height in cm,
+ * 48-55 temperature mode (kNoTemperature if the bed has no control).
+ */
+struct MaintenanceRecord {
+    enum Fault : uint16_t {
+        FAULT_HEIGHT = 1 << 0,
+        FAULT_LIGHTS = 1 << 1,
+        FAULT_TEMPERATURE = 1 << 2,
+        FAULT_OCCUPANCY_SENSOR = 1 << 3,
+        FAULT_MEDICAL_DEVICE = 1 << 4,
+        FAULT_POSITIONING = 1 << 5,
+    };
+    static constexpr int kFaultCount = 6;
+    // Bit index of the first subclass sensor check; the bits below it are the base bed systems
+    static constexpr int kFirstSensorFault = 3;
+    static_assert(FAULT_OCCUPANCY_SENSOR == 1 << kFirstSensorFault, "sensor faults must follow the base faults");
+
+    enum Status : uint16_t {
+        STATUS_POWERED = 1 << 0,
+        STATUS_HEIGHT_MOVING = 1 << 1,
+        STATUS_EMERGENCY = 1 << 2,
+        STATUS_OCCUPIED = 1 << 3,
+        STATUS_COMFORT_MODE = 1 << 4,
+        STATUS_STERILE = 1 << 5,
+        STATUS_PROCEDURE = 1 << 6,
+    };
+
+    enum class HeightCode : uint8_t { OK, BELOW_RANGE, ABOVE_RANGE };
+
+    // Subsystems a check can be limited to; each owns a fixed set of the fields above
+    enum Subsystem : uint8_t {
+        SUBSYSTEM_POWER = 1 << 0,        // STATUS_POWERED
+        SUBSYSTEM_HEIGHT = 1 << 1,       // FAULT_HEIGHT, FAULT_POSITIONING, STATUS_HEIGHT_MOVING, height fields
+        SUBSYSTEM_LIGHTS = 1 << 2,       // FAULT_LIGHTS, STATUS_EMERGENCY
+        SUBSYSTEM_TEMPERATURE = 1 << 3,  // FAULT_TEMPERATURE, temperatureMode
+        SUBSYSTEM_DEVICE = 1 << 4,       // the bed type's own sensors and surgical device
+        SUBSYSTEM_ALL = 0x1F,
+    };
+    static constexpr int kSubsystemCount = 5;
+
+    static constexpr uint8_t kNoTemperature = 0xFF;
+
+    uint16_t faults = 0;
+    uint16_t status = 0;
+    HeightCode heightCode = HeightCode::OK;
+    uint8_t heightCm = 0;
+    uint8_t temperatureMode = kNoTemperature;
+    uint8_t reserved = 0;
+
+    bool isHealthy() const { return faults == 0; }
+
+    // Resets the fields owned by the given subsystems, ready for them to be checked again
+    void clearSubsystems(uint8_t subsystems);
+
+    // Fills height code, rounded height and FAULT_HEIGHT from a reading and its valid range
+    void recordHeight(float height, float minHeight, float maxHeight);
+
+    // The core subsystem checks, shared by Bed and BedWardState so both report a bed alike
+    void recordPower(bool powered);
+    void recordLift(float height, float minHeight, float maxHeight, bool moving);
+    void recordLights(bool present, bool emergency);
+    void recordTemperature(bool present, uint8_t mode);
+
+    uint64_t pack() const;
+    static MaintenanceRecord unpack(uint64_t packed);
+};
+
+static_assert(sizeof(MaintenanceRecord) == 8, "MaintenanceRecord must stay 8 bytes");
+
+/**
+ * @class MaintenanceSweep
+ * @brief Runs maintenance checks for a whole fleet on the worker pool
+ *
+ * The caller supplies an inspector that checks bed i and returns its
+ * record; the sweep calls it for every index in parallel chunks and then
+ * tallies the records. Inspectors must only read bed state, and the beds
+ * must not change until run() returns.
+ */
+class MaintenanceSweep {
+public:
+    using Inspector = std::function<MaintenanceRecord(size_t index)>;
+
+    struct Summary {
+        size_t checked = 0;
+        size_t healthy = 0;
+        std::array<size_t, MaintenanceRecord::kFaultCount> faultCounts{};  // beds failing each check
+        uint64_t durationUs = 0;
+
+        size_t faulty() const { return checked - healthy; }
+    };
+
+    // Writes one record per bed into records, in index order; pool may be nullptr to run inline
+    static Summary run(size_t count, const Inspector& inspect, std::vector<MaintenanceRecord>& records,
+                       WorkerPool* pool);
+
+    static Summary summarize(const MaintenanceRecord* records, size_t count);
+
+    // Name of fault bit index 0..kFaultCount-1
+    static const char* getFaultName(int bit);
+};
+
+#endif // MAINTENANCE_SWEEP_H
@@ -0,0 +1,56 @@
+#ifndef MEDICAL_DATA_H
+#define MEDICAL_DATA_H
+
+#include "scan_buffer_pool.h"
+#include <cstddef>
+#include <string>
+
+// Medical data structures shared by devices and the Godot-free engines
+struct VitalSigns {
+    float oxygenLevel;      // %
+    float heartRate;        // BPM
+    float bloodPressure;    // mmHg
+    float temperature;      // °C
+    float respirationRate;  // per minute
+    
+    VitalSigns() : oxygenLevel(98.0f), heartRate(75.0f), bloodPressure(120.0f), 
+                   temperature(37.0f), respirationRate(16.0f) {}
+};
+
+// Index of each vital in structure-of-arrays storage
+enum class VitalLane {
+    OXYGEN_LEVEL,
+    HEART_RATE,
+    BLOOD_PRESSURE,
+    TEMPERATURE,
+    RESPIRATION_RATE
+};
+
+constexpr size_t kVitalLaneCount = 5;
+
+inline const char* getVitalLaneName(VitalLane lane) {
+    switch (lane) {
+        case VitalLane::OXYGEN_LEVEL: return "oxygen_level";
+        case VitalLane::HEART_RATE: return "heart_rate";
+        case VitalLane::BLOOD_PRESSURE: return "blood_pressure";
+        case VitalLane::TEMPERATURE: return "temperature";
+        case VitalLane::RESPIRATION_RATE: return "respiration_rate";
+        default: return "unknown";
+    }
+}
+
+class ScanVolume;
+
+struct ScanData {
+    std::string scanType;
+    ScanImageHandle image;  // shared, immutable pixels; copying ScanData never copies them
+    std::shared_ptr<const ScanVolume> volume;  // voxels behind the image, if the scan was volumetric
+    int64_t timestampUs;    // acquisition time, microseconds since the Unix epoch
+    float quality;
+    bool isValid;
+    
+    ScanData(const std::string& type = "full_body") 
+        : scanType(type), timestampUs(0), quality(0.95f), isValid(true) {}
+};
+
+#endif // MEDICAL_DATA_H
@@ -2,34 +2,25 @@
 #define MEDICAL_DEVICES_H
 
 #include <godot_cpp/variant/utility_functions.hpp>
+#include "device_log.h"
+#include "medical_data.h"
+#include "scan_cache.h"
+#include "scan_job.h"
+#include "scan_scheduler.h"
+#include "scan_tiles.h"
+#include "vital_history.h"
+#include "vital_thresholds.h"
+#include "vitals_recorder.h"
+#include "vitals_replay.h"
+#include "worker_pool.h"
+#include <chrono>
 #include <memory>
 #include <map>
 #include <string>
+#include <utility>
 
 using namespace godot;
 
-// Medical data structures
-struct VitalSigns {
-    float oxygenLevel;      // %
-    float heartRate;        // BPM
-    float bloodPressure;    // mmHg
-    float temperature;      // °C
-    float respirationRate;  // per minute
-    
-    VitalSigns() : oxygenLevel(98.0f), heartRate(75.0f), bloodPressure(120.0f), 
-                   temperature(37.0f), respirationRate(16.0f) {}
-};
-
-struct ScanData {
-    std::string scanType;
-    std::string imageData;
-    float quality;
-    bool isValid;
-    
-    ScanData(const std::string& type = "full_body") 
-        : scanType(type), imageData(""), quality(0.95f), isValid(true) {}
-};
-
 // Observer pattern for device monitoring
 class DeviceObserver {
 public:
@@ -44,45 +35,93 @@ class Scanner {
 public:
     enum class ScanType { FULL_BODY, BRAIN, HEART, LUNGS };
     enum class ScanState { IDLE, SCANNING, PROCESSING, COMPLETE, ERROR };
+    using Priority = ScanScheduler::Priority;
 
 private:
     ScanState currentState;
     ScanType currentScanType;
-    float scanProgress;
+    ScanScheduler& scheduler;
+    std::vector<uint64_t> pendingRequests; // queued or running in the scan suite
     std::vector<DeviceObserver*> observers;
     ScanData currentScan;
 
 public:
-    Scanner() : currentState(ScanState::IDLE), currentScanType(ScanType::FULL_BODY), scanProgress(0.0f) {}
+    explicit Scanner(ScanScheduler& suite = ScanScheduler::shared())
+        : currentState(ScanState::IDLE), currentScanType(ScanType::FULL_BODY), scheduler(suite) {}
     
-    void startScan(ScanType type) {
-        if (currentState != ScanState::IDLE) {
-            UtilityFunctions::print("❌ Cannot start scan - scanner busy");
-            return;
+    ~Scanner() {
+        for (uint64_t id : pendingRequests) {
+            scheduler.cancel(id);
         }
-        
+    }
+    
+    // Queues the scan with the scan suite; it starts as soon as a scanner is free
+    void startScan(ScanType type, Priority priority = Priority::ROUTINE) {
         currentScanType = type;
         currentState = ScanState::SCANNING;
-        scanProgress = 0.0f;
         
         std::string scanTypeName = getScanTypeName(type);
         currentScan = scanTypeName;
-        UtilityFunctions::print("🔍 Starting ", scanTypeName.c_str(), " scan...");
+        DEVICE_LOG_INFO("🔍 Requesting {} {} scan...", ScanScheduler::getPriorityName(priority), scanTypeName);
         
-        // Simulate scan process
-        processScan();
+        pendingRequests.push_back(scheduler.submit(scanTypeName, priority,
+            [this](const ScanScheduler::Request& request, ScanJob::Status status, const ScanData& scan) {
+                onRequestFinished(request, status, scan);
+            }));
     }
     
+    // Cancels every queued or running scan of this scanner
     void stopScan() {
-        if (currentState == ScanState::SCANNING || currentState == ScanState::PROCESSING) {
+        if (!pendingRequests.empty()) {
+            for (uint64_t id : pendingRequests) {
+                scheduler.cancel(id);
+            }
+            pendingRequests.clear();
             currentState = ScanState::IDLE;
-            scanProgress = 0.0f;
-            UtilityFunctions::print("🛑 Scan stopped");
+            DEVICE_LOG_INFO("🛑 Scan stopped");
         }
     }
     
+    /**
+     * Delivers finished scans on the calling (main) thread. The scheduler is
+     * shared, so this hands every scanner its finished scans, not just this
+     * one; observers and getState() tell which scanner completed.
+     */
+    void poll() {
+        scheduler.poll();
+    }
+    
     ScanState getState() const { return currentState; }
-    float getProgress() const { return scanProgress; }
+    float getProgress() const {
+        for (uint64_t id : pendingRequests) {
+            if (scheduler.isRunning(id)) {
+                return scheduler.getProgress(id);
+            }
+        }
+        return 0.0f;
+    }
+    
+    // Requests ahead of this scanner's next queued scan, or -1 if none is waiting
+    int getQueuePosition() const {
+        int position = -1;
+        for (uint64_t id : pendingRequests) {
+            int ahead = scheduler.getQueuePosition(id);
+            if (ahead >= 0 && (position < 0 || ahead < position)) {
+                position = ahead;
+            }
+        }
+        return position;
+    }
+    
+    static bool getScanTypeFromName(const std::string& name, ScanType& type) {
+        for (ScanType candidate : {ScanType::FULL_BODY, ScanType::BRAIN, ScanType::HEART, ScanType::LUNGS}) {
+            if (name == getScanTypeName(candidate)) {
+                type = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
     ScanType getCurrentScanType() const { return currentScanType; }
     
     void addObserver(DeviceObserver* observer) {
@@ -97,33 +136,29 @@ public:
     }
 
 private:
-    void processScan() {
-        currentState = ScanState::PROCESSING;
-        
-        // Simulate scan processing
-        for (int i = 0; i <= 100; i += 20) {
-            scanProgress = i / 100.0f;
-            UtilityFunctions::print("Scan progress: ", i, "%");
-        }
-        
-        // Create scan data
-        currentScan = ScanData(getScanTypeName(currentScanType));
-        currentScan.imageData = "scan_image_" + getScanTypeName(currentScanType) + "_data";
+    void onRequestFinished(const ScanScheduler::Request& request, ScanJob::Status status, const ScanData& scan) {
+        pendingRequests.erase(std::remove(pendingRequests.begin(), pendingRequests.end(), request.id),
+                              pendingRequests.end());
         
-        currentState = ScanState::COMPLETE;
-        UtilityFunctions::print("✅ Scan completed successfully");
-        
-        // Notify observers
-        for (auto* observer : observers) {
-            if (observer) {
-                observer->onScanCompleted(currentScan);
+        if (status != ScanJob::Status::COMPLETED) {
+            DEVICE_LOG_INFO("❌ Scan failed");
+        } else {
+            currentScan = scan;
+            currentState = ScanState::COMPLETE;
+            DEVICE_LOG_INFO("✅ Scan completed successfully");
+            
+            // Notify observers
+            for (auto* observer : observers) {
+                if (observer) {
+                    observer->onScanCompleted(currentScan);
+                }
             }
         }
         
-        currentState = ScanState::IDLE;
+        currentState = pendingRequests.empty() ? ScanState::IDLE : ScanState::SCANNING;
     }
     
-    std::string getScanTypeName(ScanType type) const {
+    static std::string getScanTypeName(ScanType type) {
         switch (type) {
             case ScanType::FULL_BODY: return "full_body";
             case ScanType::BRAIN: return "brain";
@@ -134,33 +169,87 @@ private:
     }
 };
 
-// Vital Signs Monitor
-class VitalSignMonitor {
-private:
+// Common base for anything that feeds vital signs to a ScannerDevice
+class VitalSignsSource {
+protected:
     VitalSigns currentVitals;
+    std::unique_ptr<VitalSignsHistory> history;
     bool isMonitoring;
     std::vector<DeviceObserver*> observers;
+    VitalsRecorder* recorder; // not owned
+
+public:
+    VitalSignsSource() : history(std::make_unique<VitalSignsHistory>()), isMonitoring(false), recorder(nullptr) {}
+    virtual ~VitalSignsSource() = default;
+    
+    virtual void startMonitoring() = 0;
+    virtual void stopMonitoring() = 0;
+    
+    // Produces the next update(s) and notifies observers
+    virtual void update() = 0;
+    
+    VitalSigns getCurrentVitals() const { return currentVitals; }
+    bool getMonitoringStatus() const { return isMonitoring; }
+    const VitalSignsHistory& getHistory() const { return *history; }
+    void setRecorder(VitalsRecorder* vitalsRecorder) { recorder = vitalsRecorder; }
+    
+    void addObserver(DeviceObserver* observer) {
+        observers.push_back(observer);
+    }
+    
+    void removeObserver(DeviceObserver* observer) {
+        observers.erase(
+            std::remove(observers.begin(), observers.end(), observer),
+            observers.end()
+        );
+    }
+
+protected:
+    void updateVitalSigns() {
+        DEVICE_LOG_TRACE("💓 Vitals: HR={} O2={}% BP={} Temp={}°C",
+                         currentVitals.heartRate, currentVitals.oxygenLevel,
+                         currentVitals.bloodPressure, currentVitals.temperature);
+        
+        history->push(currentVitals);
+        if (recorder) {
+            recorder->record(currentVitals);
+        }
+        
+        // Notify observers
+        for (auto* observer : observers) {
+            if (observer) {
+                observer->onVitalSignsUpdated(currentVitals);
+            }
+        }
+    }
+};
+
+// Vital Signs Monitor
+class VitalSignMonitor : public VitalSignsSource {
+private:
     float updateInterval; // seconds
     float lastUpdateTime;
 
 public:
-    VitalSignMonitor() : isMonitoring(false), updateInterval(1.0f), lastUpdateTime(0.0f) {}
+    VitalSignMonitor() : updateInterval(1.0f), lastUpdateTime(0.0f) {}
     
-    void startMonitoring() {
+    void startMonitoring() override {
         if (!isMonitoring) {
             isMonitoring = true;
-            UtilityFunctions::print("💓 Vital signs monitoring started");
+            DEVICE_LOG_INFO("💓 Vital signs monitoring started");
             updateVitalSigns();
         }
     }
     
-    void stopMonitoring() {
+    void stopMonitoring() override {
         if (isMonitoring) {
             isMonitoring = false;
-            UtilityFunctions::print("⏹️  Vital signs monitoring stopped");
+            DEVICE_LOG_INFO("⏹️  Vital signs monitoring stopped");
         }
     }
     
+    void update() override { simulateVitalSigns(); }
+    
     void simulateVitalSigns() {
         if (!isMonitoring) return;
         
@@ -180,49 +269,75 @@ public:
         
         updateVitalSigns();
     }
+};
+
+// Replays a recorded session through the same observers as a live monitor
+class VitalsReplaySource : public VitalSignsSource {
+private:
+    VitalsReplay replay;
+    std::chrono::steady_clock::time_point lastUpdate;
+
+public:
+    bool open(const std::string& path, double speed) {
+        if (!replay.open(path)) {
+            return false;
+        }
+        replay.setSpeed(speed);
+        DEVICE_LOG_INFO("⏯️  Replaying {} vital samples from {}", replay.getSampleCount(), path);
+        return true;
+    }
     
-    VitalSigns getCurrentVitals() const { return currentVitals; }
-    bool getMonitoringStatus() const { return isMonitoring; }
-    
-    void addObserver(DeviceObserver* observer) {
-        observers.push_back(observer);
+    void startMonitoring() override {
+        if (!isMonitoring) {
+            isMonitoring = true;
+            lastUpdate = std::chrono::steady_clock::now();
+            DEVICE_LOG_INFO("💓 Vital signs replay started");
+            update();
+        }
     }
     
-    void removeObserver(DeviceObserver* observer) {
-        observers.erase(
-            std::remove(observers.begin(), observers.end(), observer),
-            observers.end()
-        );
+    void stopMonitoring() override {
+        if (isMonitoring) {
+            isMonitoring = false;
+            DEVICE_LOG_INFO("⏹️  Vital signs replay stopped");
+        }
     }
-
-private:
-    void updateVitalSigns() {
-        UtilityFunctions::print("💓 Vitals: HR=", currentVitals.heartRate, 
-                              " O2=", currentVitals.oxygenLevel, "%",
-                              " BP=", currentVitals.bloodPressure,
-                              " Temp=", currentVitals.temperature, "°C");
+    
+    // Dispatches every sample the playhead passed since the previous update
+    void update() override {
+        if (!isMonitoring) return;
         
-        // Notify observers
-        for (auto* observer : observers) {
-            if (observer) {
-                observer->onVitalSignsUpdated(currentVitals);
-            }
-        }
+        auto now = std::chrono::steady_clock::now();
+        int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(now - lastUpdate).count();
+        lastUpdate = now;
+        
+        replay.advance(elapsedUs, [this](int64_t, const VitalSigns& vitals) {
+            currentVitals = vitals;
+            updateVitalSigns();
+        });
     }
+    
+    VitalsReplay& getReplay() { return replay; }
+    const VitalsReplay& getReplay() const { return replay; }
 };
 
 // Composite pattern - Combines Scanner and Monitor into one device
 class ScannerDevice : public DeviceObserver {
 private:
     std::unique_ptr<Scanner> scanner;
-    std::unique_ptr<VitalSignMonitor> vitalMonitor;
+    std::unique_ptr<VitalSignsSource> vitalMonitor;
+    VitalsReplaySource* vitalReplay; // vitalMonitor while replaying, otherwise nullptr
+    std::unique_ptr<VitalsRecorder> vitalRecorder;
+    std::vector<DeviceObserver*> vitalObservers;
     bool canSwivel;
     float swivelAngle; // degrees from center
-    std::map<std::string, ScanData> storedScans;
+    ScanCache scanCache;
+    ScanTileStream tileStream;
+    std::string patientId;
     VitalSigns lastVitals;
 
 public:
-    ScannerDevice() : canSwivel(true), swivelAngle(0.0f) {
+    ScannerDevice() : vitalReplay(nullptr), canSwivel(true), swivelAngle(0.0f) {
         scanner = std::make_unique<Scanner>();
         vitalMonitor = std::make_unique<VitalSignMonitor>();
         
@@ -230,37 +345,125 @@ public:
         scanner->addObserver(this);
         vitalMonitor->addObserver(this);
         
-        UtilityFunctions::print("🏥 Medical scanner device initialized");
+        DEVICE_LOG_INFO("🏥 Medical scanner device initialized");
     }
     
     // Scanner operations
     void startFullBodyScan() { scanner->startScan(Scanner::ScanType::FULL_BODY); }
     void startBrainScan() { scanner->startScan(Scanner::ScanType::BRAIN); }
+    void startHeartScan() { scanner->startScan(Scanner::ScanType::HEART); }
+    void startLungScan() { scanner->startScan(Scanner::ScanType::LUNGS); }
+    void startEmergencyScan(Scanner::ScanType type) { scanner->startScan(type, Scanner::Priority::EMERGENCY); }
+    void startScan(Scanner::ScanType type) { scanner->startScan(type); }
+    Scanner::ScanType getCurrentScanType() const { return scanner->getCurrentScanType(); }
+    int getScanQueuePosition() const { return scanner->getQueuePosition(); }
     void stopScan() { scanner->stopScan(); }
     
+    // Delivers finished scans to observers; call from the main thread
+    void pollScanner() { scanner->poll(); }
+    float getScanProgress() const { return scanner->getProgress(); }
+    
+    void addScanObserver(DeviceObserver* observer) { scanner->addObserver(observer); }
+    void removeScanObserver(DeviceObserver* observer) { scanner->removeObserver(observer); }
+    
     // Vital signs operations
     void startVitalMonitoring() { vitalMonitor->startMonitoring(); }
     void stopVitalMonitoring() { vitalMonitor->stopMonitoring(); }
-    void updateVitals() { vitalMonitor->simulateVitalSigns(); }
+    void updateVitals() { vitalMonitor->update(); }
+    
+    // Additional observers of vital sign updates, kept across source changes
+    void addVitalObserver(DeviceObserver* observer) {
+        vitalObservers.push_back(observer);
+        vitalMonitor->addObserver(observer);
+    }
+    
+    void removeVitalObserver(DeviceObserver* observer) {
+        vitalObservers.erase(
+            std::remove(vitalObservers.begin(), vitalObservers.end(), observer),
+            vitalObservers.end()
+        );
+        vitalMonitor->removeObserver(observer);
+    }
+    
+    // Swaps the vital signs source, keeping observers and recording attached
+    void setVitalSource(std::unique_ptr<VitalSignsSource> source) {
+        vitalMonitor->stopMonitoring();
+        vitalMonitor->setRecorder(nullptr);
+        
+        source->addObserver(this);
+        for (auto* observer : vitalObservers) {
+            source->addObserver(observer);
+        }
+        source->setRecorder(vitalRecorder.get());
+        vitalMonitor = std::move(source);
+        vitalReplay = nullptr;
+    }
+    
+    // Vital signs replay from a recording made with startVitalRecording
+    bool startVitalReplay(const std::string& path, double speed) {
+        auto replay = std::make_unique<VitalsReplaySource>();
+        if (!replay->open(path, speed)) {
+            return false;
+        }
+        VitalsReplaySource* replayPtr = replay.get();
+        setVitalSource(std::move(replay));
+        vitalReplay = replayPtr;
+        vitalMonitor->startMonitoring();
+        return true;
+    }
+    
+    void stopVitalReplay() {
+        if (vitalReplay) {
+            setVitalSource(std::make_unique<VitalSignMonitor>());
+        }
+    }
+    
+    VitalsReplaySource* getVitalReplay() { return vitalReplay; }
+    const VitalsReplaySource* getVitalReplay() const { return vitalReplay; }
+    
+    // Vital signs recording
+    bool startVitalRecording(const std::string& path) {
+        stopVitalRecording();
+        auto recorder = std::make_unique<VitalsRecorder>();
+        if (!recorder->open(path)) {
+            return false;
+        }
+        vitalRecorder = std::move(recorder);
+        vitalMonitor->setRecorder(vitalRecorder.get());
+        return true;
+    }
+    
+    void stopVitalRecording() {
+        if (vitalRecorder) {
+            vitalMonitor->setRecorder(nullptr);
+            vitalRecorder.reset();
+        }
+    }
+    
+    bool isRecordingVitals() const { return vitalRecorder != nullptr; }
     
     // Swivel functionality
     void swivelLeft(float angle = 45.0f) {
         if (canSwivel) {
             swivelAngle = std::max(-90.0f, swivelAngle - angle);
-            UtilityFunctions::print("🔄 Device swiveled left to ", swivelAngle, "°");
+            DEVICE_LOG_DEBUG("🔄 Device swiveled left to {}°", swivelAngle);
         }
     }
     
     void swivelRight(float angle = 45.0f) {
         if (canSwivel) {
             swivelAngle = std::min(90.0f, swivelAngle + angle);
-            UtilityFunctions::print("🔄 Device swiveled right to ", swivelAngle, "°");
+            DEVICE_LOG_DEBUG("🔄 Device swiveled right to {}°", swivelAngle);
         }
     }
     
     void centerDevice() {
         swivelAngle = 0.0f;
-        UtilityFunctions::print("📍 Device centered");
+        DEVICE_LOG_DEBUG("📍 Device centered");
+    }
+    
+    void setSwivelAngle(float angle) {
+        swivelAngle = std::min(90.0f, std::max(-90.0f, angle));
     }
     
     // Device status
@@ -269,10 +472,69 @@ public:
     bool isMonitoringVitals() const { return vitalMonitor->getMonitoringStatus(); }
     VitalSigns getLastVitals() const { return lastVitals; }
     
+    // Completed scans are cached under the current patient
+    void setPatientId(const std::string& id) { patientId = id; }
+    const std::string& getPatientId() const { return patientId; }
+    
+    ScanCache& getScanCache() { return scanCache; }
+    const ScanCache& getScanCache() const { return scanCache; }
+    
+    // Most recent image of a scan type for the current patient; shares the pixels, never copies them
+    ScanImageHandle getStoredScanImage(const std::string& scanType) {
+        ScanData scan;
+        return scanCache.getLatest(patientId, scanType, scan) ? scan.image : nullptr;
+    }
+    
+    // Voxels of the most recent scan of a type, if it is still held in memory
+    std::shared_ptr<const ScanVolume> getStoredScanVolume(const std::string& scanType) {
+        ScanData scan;
+        return scanCache.getLatest(patientId, scanType, scan) ? scan.volume : nullptr;
+    }
+    
+    // Image of one scan by acquisition time, reloaded from the spill directory if evicted
+    ScanImageHandle getStoredScanImage(const std::string& scanType, int64_t timestampUs) {
+        ScanData scan;
+        return scanCache.get(ScanCache::Key{patientId, scanType, timestampUs}, scan) ? scan.image : nullptr;
+    }
+    
+    // Writes the most recent image of a scan type as a tiled mip pyramid
+    bool saveScanTiles(const std::string& scanType, const std::string& path) {
+        ScanImageHandle image = getStoredScanImage(scanType);
+        if (!image) {
+            DEVICE_LOG_INFO("❌ No {} scan to save", scanType);
+            return false;
+        }
+        return ScanTileFormat::write(path, *image);
+    }
+    
+    // Opens a tiled scan and returns its coarse level; finer tiles follow through pollScanTiles
+    ScanImageHandle beginTiledLoad(const std::string& path) {
+        if (!tileStream.open(path)) {
+            return nullptr;
+        }
+        tileStream.start();
+        return tileStream.getCoarseImage();
+    }
+    
+    // Hands decoded tiles to sink(const ScanTileStream::TileUpdate&); call from the main thread
+    template <typename Sink>
+    size_t pollScanTiles(Sink&& sink, size_t maxTiles = SIZE_MAX) {
+        return tileStream.poll(std::forward<Sink>(sink), maxTiles);
+    }
+    
+    void cancelTiledLoad() { tileStream.cancel(); }
+    bool isLoadingScanTiles() const { return !tileStream.isFinished(); }
+    const ScanTileStream& getTileStream() const { return tileStream; }
+    
+    // Trend statistics over the monitor's recent samples
+    VitalSignsHistory::WindowStats getVitalStatistics(VitalSignsHistory::Lane lane, size_t window) const {
+        return vitalMonitor->getHistory().computeStats(lane, window);
+    }
+    
     // DeviceObserver implementation
     void onScanCompleted(const ScanData& data) override {
-        UtilityFunctions::print("📊 Scan completed: ", data.scanType.c_str());
-        storedScans[data.scanType] = data;
+        DEVICE_LOG_INFO("📊 Scan completed: {}", data.scanType);
+        scanCache.put(ScanCache::Key{patientId, data.scanType, data.timestampUs}, data);
     }
     
     void onVitalSignsUpdated(const VitalSigns& vitals) override {
@@ -282,25 +544,24 @@ public:
     }
     
     void onDeviceError(const String& error) override {
-        UtilityFunctions::print("❌ ScannerDevice error: ", error);
+        DEVICE_LOG_ALERT("❌ ScannerDevice error: {}", error.utf8().get_data());
     }
 
 private:
     void checkCriticalVitals(const VitalSigns& vitals) {
-        bool critical = false;
+        static const VitalThresholds thresholds = VitalThresholds::defaults();
+        int32_t alerts = thresholds.evaluate(vitals);
         
-        if (vitals.oxygenLevel < 90.0f) {
-            UtilityFunctions::print("🚨 CRITICAL: Low oxygen level!");
-            critical = true;
+        if (alerts & VitalThresholds::ALERT_LOW_OXYGEN) {
+            DEVICE_LOG_ALERT("🚨 CRITICAL: Low oxygen level!");
         }
         
-        if (vitals.heartRate < 50.0f || vitals.heartRate > 120.0f) {
-            UtilityFunctions::print("🚨 CRITICAL: Abnormal heart rate!");
-            critical = true;
+        if (alerts & VitalThresholds::ALERT_ABNORMAL_HEART_RATE) {
+            DEVICE_LOG_ALERT("🚨 CRITICAL: Abnormal heart rate!");
         }
         
-        if (vitals.temperature > 38.5f || vitals.temperature < 36.0f) {
-            UtilityFunctions::print("⚠️  WARNING: Abnormal temperature!");
+        if (alerts & VitalThresholds::ALERT_TEMPERATURE_WARNING) {
+            DEVICE_LOG_ALERT("⚠️  WARNING: Abnormal temperature!");
         }
     }
 };
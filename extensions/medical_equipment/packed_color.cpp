@@ -0,0 +1,262 @@
+#include "packed_color.h"
+#include "simd_config.h"
+#include <array>
+#include <cmath>
+
+namespace {
+
+// Colors per bulk block; the block's quantized indices live on the stack
+constexpr size_t kBlock = 64;
+
+double srgbToLinear(double value) {
+    return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+double linearToSrgb(double value) {
+    return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+}
+
+struct Tables {
+    std::array<float, 256> decode;
+    std::array<uint8_t, ColorSpace::kLinearSteps> encode;
+
+    Tables() {
+        for (size_t i = 0; i < decode.size(); ++i) {
+            decode[i] = static_cast<float>(srgbToLinear(static_cast<double>(i) / 255.0));
+        }
+        for (size_t i = 0; i < encode.size(); ++i) {
+            double linear = static_cast<double>(i) / static_cast<double>(ColorSpace::kLinearSteps - 1);
+            encode[i] = static_cast<uint8_t>(std::lround(255.0 * linearToSrgb(linear)));
+        }
+    }
+};
+
+const Tables& tables() {
+    static const Tables instance;
+    return instance;
+}
+
+// Clamps to [0, limit] and maps NaN to 0, matching the SIMD max/min lanes
+inline float clampTo(float value, float limit) {
+    return !(value > 0.0f) ? 0.0f : std::min(value, limit);
+}
+
+inline uint8_t toByte(float value) {
+    return static_cast<uint8_t>(std::nearbyint(clampTo(value, 1.0f) * 255.0f));
+}
+
+// Clamped, rounded encode table indices of plane * scale
+void quantize(const float* plane, size_t n, float scale, int32_t* indices) {
+    const float maxIndex = static_cast<float>(ColorSpace::kLinearSteps - 1);
+    size_t i = 0;
+
+#if defined(MEDICAL_SIMD_AVX2)
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 vzero = _mm256_setzero_ps();
+    const __m256 vmax = _mm256_set1_ps(maxIndex);
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_loadu_ps(plane + i), vscale);
+        v = _mm256_min_ps(_mm256_max_ps(v, vzero), vmax);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices + i), _mm256_cvtps_epi32(v));
+    }
+#endif
+
+#if defined(MEDICAL_SIMD_SSE2)
+    const __m128 vscale4 = _mm_set1_ps(scale);
+    const __m128 vzero4 = _mm_setzero_ps();
+    const __m128 vmax4 = _mm_set1_ps(maxIndex);
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_mul_ps(_mm_loadu_ps(plane + i), vscale4);
+        v = _mm_min_ps(_mm_max_ps(v, vzero4), vmax4);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + i), _mm_cvtps_epi32(v));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        float v = clampTo(plane[i] * scale, maxIndex);
+        indices[i] = static_cast<int32_t>(std::nearbyint(v));
+    }
+}
+
+} // namespace
+
+PackedColor PackedColor::fromFloat(float red, float green, float blue, float alpha) {
+    PackedColor color;
+    color.r = toByte(red);
+    color.g = toByte(green);
+    color.b = toByte(blue);
+    color.a = toByte(alpha);
+    return color;
+}
+
+LedColor PackedColor::toLinear() const {
+    const Tables& table = tables();
+    return {table.decode[r], table.decode[g], table.decode[b]};
+}
+
+namespace ColorSpace {
+
+float toLinear(uint8_t srgb) {
+    return tables().decode[srgb];
+}
+
+uint8_t toSrgb(float linear) {
+    float index = clampTo(linear, 1.0f) * static_cast<float>(kLinearSteps - 1);
+    return tables().encode[static_cast<size_t>(std::nearbyint(index))];
+}
+
+PackedColor fromLinear(LedColor color, uint8_t alpha) {
+    PackedColor packed;
+    packed.r = toSrgb(color.r);
+    packed.g = toSrgb(color.g);
+    packed.b = toSrgb(color.b);
+    packed.a = alpha;
+    return packed;
+}
+
+PackedColor scaleBrightness(PackedColor color, float brightness) {
+    LedColor linear = color.toLinear();
+    return fromLinear({linear.r * brightness, linear.g * brightness, linear.b * brightness}, color.a);
+}
+
+PackedColor blend(PackedColor from, PackedColor to, float t) {
+    t = clampTo(t, 1.0f);
+    LedColor a = from.toLinear();
+    LedColor b = to.toLinear();
+    float alpha = static_cast<float>(from.a) + (static_cast<float>(to.a) - static_cast<float>(from.a)) * t;
+    return fromLinear({a.r + (b.r - a.r) * t, a.g + (b.g - a.g) * t, a.b + (b.b - a.b) * t},
+                      static_cast<uint8_t>(std::nearbyint(alpha)));
+}
+
+PackedColor over(PackedColor dst, PackedColor src) {
+    float coverage = static_cast<float>(src.a) / 255.0f;
+    PackedColor result = blend(dst, src, coverage);
+    result.a = toByte(coverage + static_cast<float>(dst.a) / 255.0f * (1.0f - coverage));
+    return result;
+}
+
+void packFloats(const float* rgba, size_t count, PackedColor* out) {
+    size_t i = 0;
+
+#if defined(MEDICAL_SIMD_SSE2)
+    // Four colors per step: 16 floats saturate down to 16 bytes
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        const float* source = rgba + i * 4;
+        __m128i c0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source), zero), one), scale));
+        __m128i c1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + 4), zero), one), scale));
+        __m128i c2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + 8), zero), one), scale));
+        __m128i c3 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + 12), zero), one), scale));
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float* source = rgba + i * 4;
+        out[i] = PackedColor::fromFloat(source[0], source[1], source[2], source[3]);
+    }
+}
+
+void unpackFloats(const PackedColor* colors, size_t count, float* rgba) {
+    size_t i = 0;
+
+#if defined(MEDICAL_SIMD_SSE2)
+    const __m128 inverse = _mm_set1_ps(1.0f / 255.0f);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colors + i));
+        __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        __m128i high = _mm_unpackhi_epi8(bytes, zero);
+        float* target = rgba + i * 4;
+        _mm_storeu_ps(target, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), inverse));
+        _mm_storeu_ps(target + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), inverse));
+        _mm_storeu_ps(target + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), inverse));
+        _mm_storeu_ps(target + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), inverse));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float* target = rgba + i * 4;
+        target[0] = static_cast<float>(colors[i].r) / 255.0f;
+        target[1] = static_cast<float>(colors[i].g) / 255.0f;
+        target[2] = static_cast<float>(colors[i].b) / 255.0f;
+        target[3] = static_cast<float>(colors[i].a) / 255.0f;
+    }
+}
+
+void encodeLinear(const float* red, const float* green, const float* blue, size_t count, uint8_t alpha,
+                  PackedColor* out) {
+    const std::array<uint8_t, kLinearSteps>& encode = tables().encode;
+    const float scale = static_cast<float>(kLinearSteps - 1);
+    alignas(32) int32_t r[kBlock];
+    alignas(32) int32_t g[kBlock];
+    alignas(32) int32_t b[kBlock];
+
+    for (size_t begin = 0; begin < count; begin += kBlock) {
+        size_t n = std::min(kBlock, count - begin);
+        quantize(red + begin, n, scale, r);
+        quantize(green + begin, n, scale, g);
+        quantize(blue + begin, n, scale, b);
+
+        PackedColor* target = out + begin;
+        for (size_t i = 0; i < n; ++i) {
+            target[i].r = encode[static_cast<size_t>(r[i])];
+            target[i].g = encode[static_cast<size_t>(g[i])];
+            target[i].b = encode[static_cast<size_t>(b[i])];
+            target[i].a = alpha;
+        }
+    }
+}
+
+void decodeLinear(const PackedColor* colors, size_t count, float* red, float* green, float* blue) {
+    const float* decode = tables().decode.data();
+    size_t i = 0;
+
+#if defined(MEDICAL_SIMD_AVX2)
+    // Eight colors per step, each channel gathered straight from the table
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    for (; i + 8 <= count; i += 8) {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(colors + i));
+        _mm256_storeu_ps(red + i, _mm256_i32gather_ps(decode, _mm256_and_si256(pixels, mask), 4));
+        _mm256_storeu_ps(green + i, _mm256_i32gather_ps(decode, _mm256_and_si256(_mm256_srli_epi32(pixels, 8), mask), 4));
+        _mm256_storeu_ps(blue + i, _mm256_i32gather_ps(decode, _mm256_and_si256(_mm256_srli_epi32(pixels, 16), mask), 4));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        red[i] = decode[colors[i].r];
+        green[i] = decode[colors[i].g];
+        blue[i] = decode[colors[i].b];
+    }
+}
+
+void scaleBrightness(PackedColor* colors, size_t count, float brightness) {
+    alignas(32) float r[kBlock];
+    alignas(32) float g[kBlock];
+    alignas(32) float b[kBlock];
+    uint8_t alpha[kBlock];
+    const float factor = std::max(brightness, 0.0f);
+
+    for (size_t begin = 0; begin < count; begin += kBlock) {
+        size_t n = std::min(kBlock, count - begin);
+        PackedColor* block = colors + begin;
+        decodeLinear(block, n, r, g, b);
+        for (size_t i = 0; i < n; ++i) {
+            r[i] *= factor;
+            g[i] *= factor;
+            b[i] *= factor;
+            alpha[i] = block[i].a;
+        }
+
+        // Each color keeps its own alpha
+        encodeLinear(r, g, b, n, 255, block);
+        for (size_t i = 0; i < n; ++i) {
+            block[i].a = alpha[i];
+        }
+    }
+}
+
+} // namespace ColorSpace
@@ -0,0 +1,88 @@
+#ifndef PACKED_COLOR_H
+#define PACKED_COLOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Linear-light color with channels in 0..1
+struct LedColor {
+    float r, g, b;
+};
+
+/**
+ * @struct PackedColor
+ * @brief sRGB-encoded RGBA8 color, 4 bytes
+ *
+ * The 8-bit channels hold sRGB-encoded values, which spend their codes
+ * where the eye can tell them apart; anything that scales or mixes colors
+ * goes through ColorSpace and works on linear light. Construction from
+ * ints clamps to 0..255.
+ */
+struct PackedColor {
+    uint8_t r, g, b, a;
+
+    constexpr PackedColor() : r(0), g(0), b(0), a(255) {}
+    constexpr PackedColor(int red, int green, int blue, int alpha = 255)
+        : r(clampChannel(red)), g(clampChannel(green)), b(clampChannel(blue)), a(clampChannel(alpha)) {}
+
+    // From sRGB-encoded floats in 0..1, as in a Godot Color
+    static PackedColor fromFloat(float red, float green, float blue, float alpha = 1.0f);
+
+    // sRGB decoded to linear light; alpha is dropped
+    LedColor toLinear() const;
+
+    bool operator==(const PackedColor& other) const {
+        return r == other.r && g == other.g && b == other.b && a == other.a;
+    }
+    bool operator!=(const PackedColor& other) const { return !(*this == other); }
+
+private:
+    static constexpr uint8_t clampChannel(int value) {
+        return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+};
+
+static_assert(sizeof(PackedColor) == 4, "PackedColor must stay 4 bytes");
+
+/**
+ * @namespace ColorSpace
+ * @brief sRGB ↔ linear conversion through lookup tables, single and bulk
+ *
+ * Decoding is a 256-entry table. Encoding quantizes linear light to
+ * kLinearSteps levels, with SIMD where available, and looks the sRGB code
+ * up, so neither direction calls pow(). Brightness and blends are applied
+ * to linear light and re-encoded.
+ */
+namespace ColorSpace {
+
+constexpr size_t kLinearSteps = 4096;
+
+float toLinear(uint8_t srgb);
+uint8_t toSrgb(float linear);
+
+PackedColor fromLinear(LedColor color, uint8_t alpha = 255);
+
+// Scales emitted light; 0.5 is half the photons, not half the code
+PackedColor scaleBrightness(PackedColor color, float brightness);
+
+// Linear-light interpolation, alpha included, t clamped to 0..1
+PackedColor blend(PackedColor from, PackedColor to, float t);
+
+// src composited over dst by src's alpha, in linear light
+PackedColor over(PackedColor dst, PackedColor src);
+
+// Godot Color arrays: 4 sRGB-encoded floats per color
+void packFloats(const float* rgba, size_t count, PackedColor* out);
+void unpackFloats(const PackedColor* colors, size_t count, float* rgba);
+
+// Linear-light planes to packed colors and back
+void encodeLinear(const float* red, const float* green, const float* blue, size_t count, uint8_t alpha,
+                  PackedColor* out);
+void decodeLinear(const PackedColor* colors, size_t count, float* red, float* green, float* blue);
+
+void scaleBrightness(PackedColor* colors, size_t count, float brightness);
+
+} // namespace ColorSpace
+
+#endif // PACKED_COLOR_H
@@ -8,13 +8,14 @@ PatientBed::PatientBed() : comfortMode(false), lastOccupancyTime(0.0f) {
     // Set patient bed specific height ranges
     minHeight = 40.0f;   // Lower minimum for patient access
     maxHeight = 90.0f;   // Lower maximum for safety
-    currentHeight = 55.0f; // Comfortable default height
+    heightActuator.setRange(minHeight, maxHeight);
+    heightActuator.reset(55.0f); // Comfortable default height
     
     // Initialize occupancy sensor
     occupancySensor = std::make_unique<OccupancySensor>();
     occupancySensor->addObserver(this);
     
-    UtilityFunctions::print("PatientBed created with occupancy monitoring");
+    DEVICE_LOG_INFO("PatientBed created with occupancy monitoring");
 }
 
 std::string PatientBed::getClassName() const {
@@ -22,14 +23,14 @@ std::string PatientBed::getClassName() const {
 }
 
 void PatientBed::simulatePatientEntry() {
-    UtilityFunctions::print("Patient entering bed...");
+    DEVICE_LOG_INFO("Patient entering bed...");
     if (occupancySensor) {
         occupancySensor->setOccupied(true);
     }
 }
 
 void PatientBed::simulatePatientExit() {
-    UtilityFunctions::print("Patient leaving bed...");
+    DEVICE_LOG_INFO("Patient leaving bed...");
     if (occupancySensor) {
         occupancySensor->setOccupied(false);
     }
@@ -41,7 +42,9 @@ bool PatientBed::isOccupied() const {
 
 void PatientBed::enableComfortMode() {
     comfortMode = true;
-    UtilityFunctions::print("Comfort mode ENABLED");
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_DEVICE);
+    markChanged(BedChange::COMFORT_MODE);
+    DEVICE_LOG_INFO("Comfort mode ENABLED");
     
     if (isOccupied()) {
         adjustForPatientComfort();
@@ -50,14 +53,18 @@ void PatientBed::enableComfortMode() {
 
 void PatientBed::disableComfortMode() {
     comfortMode = false;
-    UtilityFunctions::print("Comfort mode DISABLED");
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_DEVICE);
+    markChanged(BedChange::COMFORT_MODE);
+    DEVICE_LOG_INFO("Comfort mode DISABLED");
     resetToDefaultSettings();
 }
 
 // Occupancy observer implementation
 void PatientBed::onPatientEntered() {
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_DEVICE);
+    markChanged(BedChange::OCCUPANCY);
     lastOccupancyTime = static_cast<float>(std::time(nullptr));
-    UtilityFunctions::print("👤 Patient detected on bed");
+    DEVICE_LOG_INFO("👤 Patient detected on bed");
     
     // Automatically adjust for patient comfort
     if (comfortMode) {
@@ -68,11 +75,14 @@ void PatientBed::onPatientEntered() {
     if (lightStrip && !lightStrip->isEmergencyMode()) {
         lightStrip->setBrightness(0.3f); // Soft lighting
         lightStrip->setColor(LightColor(255, 248, 220)); // Warm white
+        markChanged(BedChange::LIGHTS);
     }
 }
 
 void PatientBed::onPatientLeft() {
-    UtilityFunctions::print("👋 Patient left the bed");
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_DEVICE);
+    markChanged(BedChange::OCCUPANCY);
+    DEVICE_LOG_INFO("👋 Patient left the bed");
     
     // Reset to default settings when patient leaves
     resetToDefaultSettings();
@@ -81,31 +91,42 @@ void PatientBed::onPatientLeft() {
     if (lightStrip && !lightStrip->isEmergencyMode()) {
         lightStrip->setBrightness(0.5f);
         lightStrip->setColor(LightColor(255, 255, 255)); // Normal white
+        markChanged(BedChange::LIGHTS);
     }
 }
 
 // Hook method implementations
-void PatientBed::performSpecificChecks() {
+void PatientBed::performSpecificChecks(MaintenanceRecord& record) const {
     // Patient bed specific checks
-    UtilityFunctions::print("Checking occupancy sensor...");
-    bool sensorOK = occupancySensor != nullptr;
-    UtilityFunctions::print("Occupancy sensor: ", sensorOK ? "OK" : "ERROR");
-    
-    UtilityFunctions::print("Checking comfort settings...");
-    UtilityFunctions::print("Comfort mode: ", comfortMode ? "ENABLED" : "DISABLED");
-    
-    if (isOccupied()) {
-        float occupancyDuration = static_cast<float>(std::time(nullptr)) - lastOccupancyTime;
-        UtilityFunctions::print("Patient occupancy duration: ", occupancyDuration, " seconds");
+    if (!occupancySensor) {
+        record.faults |= MaintenanceRecord::FAULT_OCCUPANCY_SENSOR;
+    } else if (occupancySensor->getOccupied()) {
+        record.status |= MaintenanceRecord::STATUS_OCCUPIED;
+    }
+    if (comfortMode) {
+        record.status |= MaintenanceRecord::STATUS_COMFORT_MODE;
+    }
+}
+
+void PatientBed::captureSnapshot(BedSnapshot& snapshot) const {
+    snapshot.set(BedSnapshot::OCCUPIED, isOccupied());
+    snapshot.set(BedSnapshot::COMFORT_MODE, comfortMode);
+}
+
+void PatientBed::applySnapshot(const BedSnapshot& snapshot) {
+    // The saved lights already include any comfort adjustments, so none are re-applied
+    comfortMode = snapshot.has(BedSnapshot::COMFORT_MODE);
+    if (occupancySensor) {
+        occupancySensor->restoreOccupied(snapshot.has(BedSnapshot::OCCUPIED));
     }
 }
 
 void PatientBed::onPowerOn() {
-    UtilityFunctions::print("PatientBed systems initializing...");
+    DEVICE_LOG_INFO("PatientBed systems initializing...");
     
     // Initialize occupancy monitoring
     if (occupancySensor) {
-        UtilityFunctions::print("Occupancy monitoring activated");
+        DEVICE_LOG_INFO("Occupancy monitoring activated");
     }
     
     // Set default patient bed settings
@@ -114,11 +135,11 @@ void PatientBed::onPowerOn() {
 }
 
 void PatientBed::onPowerOff() {
-    UtilityFunctions::print("PatientBed systems shutting down...");
+    DEVICE_LOG_INFO("PatientBed systems shutting down...");
     
     // Ensure patient safety before shutdown
     if (isOccupied()) {
-        UtilityFunctions::print("⚠️  WARNING: Patient still on bed during shutdown!");
+        DEVICE_LOG_ALERT("⚠️  WARNING: Patient still on bed during shutdown!");
     }
     
     disableComfortMode();
@@ -127,7 +148,7 @@ void PatientBed::onPowerOff() {
 void PatientBed::adjustForPatientComfort() {
     if (!isPoweredOn) return;
     
-    UtilityFunctions::print("Adjusting bed for patient comfort...");
+    DEVICE_LOG_INFO("Adjusting bed for patient comfort...");
     
     // Optimal height for patient comfort
     setHeight(50.0f);
@@ -139,13 +160,14 @@ void PatientBed::adjustForPatientComfort() {
     if (lightStrip) {
         lightStrip->setBrightness(0.4f);
         lightStrip->setColor(LightColor(255, 240, 200)); // Soft warm light
+        markChanged(BedChange::LIGHTS);
     }
 }
 
 void PatientBed::resetToDefaultSettings() {
     if (!isPoweredOn) return;
     
-    UtilityFunctions::print("Resetting to default settings...");
+    DEVICE_LOG_INFO("Resetting to default settings...");
     
     // Standard height
     setHeight(55.0f);
@@ -157,6 +179,7 @@ void PatientBed::resetToDefaultSettings() {
     if (lightStrip) {
         lightStrip->setBrightness(0.5f);
         lightStrip->setColor(LightColor(255, 255, 255));
+        markChanged(BedChange::LIGHTS);
     }
 }
 
@@ -47,6 +47,9 @@ public:
     }
     
     bool getOccupied() const { return isOccupied; }
+    
+    // Sets the state without notifying observers, as when restoring a snapshot
+    void restoreOccupied(bool occupied) { isOccupied = occupied; }
 
 private:
     void notifyPatientEntered() {
@@ -96,7 +99,10 @@ public:
 
 protected:
     // Override hook methods from base class
-    void performSpecificChecks() override;
+    void performSpecificChecks(MaintenanceRecord& record) const override;
+    BedSnapshot::Kind getSnapshotKind() const override { return BedSnapshot::PATIENT; }
+    void captureSnapshot(BedSnapshot& snapshot) const override;
+    void applySnapshot(const BedSnapshot& snapshot) override;
     void onPowerOn() override;
     void onPowerOff() override;
     
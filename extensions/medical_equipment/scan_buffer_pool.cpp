@@ -0,0 +1,115 @@
+#include "scan_buffer_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+void ScanImage::PoolState::release(SimdVector<uint8_t>&& storage) {
+    size_t bytes = storage.size();
+    if (bytes == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pooledBytes + bytes > maxPooledBytes) {
+        return; // over budget: let the storage free itself
+    }
+    freeLists[bytes].push_back(std::move(storage));
+    pooledBytes += bytes;
+}
+
+ScanImage::ScanImage(std::shared_ptr<PoolState> ownerPool, SimdVector<uint8_t>&& pixels,
+                     uint32_t imageWidth, uint32_t imageHeight, uint32_t imageBytesPerPixel)
+    : pool(std::move(ownerPool)), storage(std::move(pixels)), width(imageWidth), height(imageHeight),
+      bytesPerPixel(imageBytesPerPixel) {}
+
+ScanImage::~ScanImage() {
+    if (pool) {
+        pool->release(std::move(storage));
+    }
+}
+
+bool ScanImage::windowToGray8(float windowCenter, float windowWidth, uint8_t* out) const {
+    if (bytesPerPixel != 2 || !(windowWidth > 0.0f) || !std::isfinite(windowWidth) || !std::isfinite(windowCenter)) {
+        return false;
+    }
+
+    const uint16_t* pixels = reinterpret_cast<const uint16_t*>(storage.data());
+    const float low = windowCenter - 0.5f * windowWidth;
+    const float scale = 255.0f / windowWidth;
+    for (size_t i = 0, n = static_cast<size_t>(width) * height; i < n; ++i) {
+        float gray = (static_cast<float>(pixels[i]) - low) * scale;
+        out[i] = static_cast<uint8_t>(std::min(std::max(gray, 0.0f), 255.0f) + 0.5f);
+    }
+    return true;
+}
+
+ScanBufferPool::Buffer::~Buffer() {
+    // An unpublished buffer (e.g. a cancelled scan) goes straight back
+    if (pool) {
+        pool->release(std::move(storage));
+    }
+}
+
+ScanBufferPool::ScanBufferPool(size_t maxPooledBytes)
+    : state(std::make_shared<ScanImage::PoolState>(maxPooledBytes)) {}
+
+ScanBufferPool& ScanBufferPool::shared() {
+    static ScanBufferPool instance;
+    return instance;
+}
+
+ScanBufferPool::Buffer ScanBufferPool::acquire(uint32_t width, uint32_t height, uint32_t bytesPerPixel) {
+    Buffer buffer;
+    buffer.pool = state;
+    buffer.width = width;
+    buffer.height = height;
+    buffer.bytesPerPixel = bytesPerPixel;
+
+    size_t bytes = static_cast<size_t>(width) * height * bytesPerPixel;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        auto it = state->freeLists.find(bytes);
+        if (it != state->freeLists.end() && !it->second.empty()) {
+            buffer.storage = std::move(it->second.back());
+            it->second.pop_back();
+            state->pooledBytes -= bytes;
+            state->reuses.fetch_add(1, std::memory_order_relaxed);
+            return buffer;
+        }
+    }
+
+    buffer.storage.resize(bytes);
+    state->allocations.fetch_add(1, std::memory_order_relaxed);
+    return buffer;
+}
+
+ScanImageHandle ScanBufferPool::publish(Buffer&& buffer) {
+    if (!buffer.isValid()) {
+        return nullptr;
+    }
+
+    return ScanImageHandle(new ScanImage(std::move(buffer.pool), std::move(buffer.storage),
+                                         buffer.width, buffer.height, buffer.bytesPerPixel));
+}
+
+void ScanBufferPool::recordCopy(size_t bytes) {
+    state->bytesCopied.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void ScanBufferPool::trim() {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->freeLists.clear();
+    state->pooledBytes = 0;
+}
+
+ScanBufferPool::Stats ScanBufferPool::getStats() const {
+    Stats stats;
+    stats.allocations = state->allocations.load(std::memory_order_relaxed);
+    stats.reuses = state->reuses.load(std::memory_order_relaxed);
+    stats.bytesCopied = state->bytesCopied.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        stats.pooledBytes = state->pooledBytes;
+    }
+    return stats;
+}
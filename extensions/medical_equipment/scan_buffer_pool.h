@@ -0,0 +1,145 @@
+#ifndef SCAN_BUFFER_POOL_H
+#define SCAN_BUFFER_POOL_H
+
+#include "simd_config.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class ScanBufferPool;
+
+/**
+ * @class ScanImage
+ * @brief Immutable scan pixels shared by reference between all consumers
+ *
+ * Created by ScanBufferPool::publish(). When the last ScanImageHandle goes
+ * away the pixel storage returns to the pool instead of being freed.
+ */
+class ScanImage {
+public:
+    ~ScanImage();
+
+    ScanImage(const ScanImage&) = delete;
+    ScanImage& operator=(const ScanImage&) = delete;
+
+    uint32_t getWidth() const { return width; }
+    uint32_t getHeight() const { return height; }
+    uint32_t getBytesPerPixel() const { return bytesPerPixel; }
+    size_t getByteSize() const { return static_cast<size_t>(width) * height * bytesPerPixel; }
+    const uint8_t* data() const { return storage.data(); }
+
+    /**
+     * Maps 16-bit pixels to 8-bit grayscale through a display window
+     * @param windowCenter Intensity shown as mid gray
+     * @param windowWidth Intensity span from black to white, must be positive
+     * @param out getWidth() * getHeight() bytes
+     * @return false unless the image has 2 bytes per pixel and the window is finite
+     */
+    bool windowToGray8(float windowCenter, float windowWidth, uint8_t* out) const;
+
+private:
+    friend class ScanBufferPool;
+    struct PoolState;
+
+    ScanImage(std::shared_ptr<PoolState> pool, SimdVector<uint8_t>&& storage,
+              uint32_t width, uint32_t height, uint32_t bytesPerPixel);
+
+    std::shared_ptr<PoolState> pool;
+    SimdVector<uint8_t> storage;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesPerPixel;
+};
+
+using ScanImageHandle = std::shared_ptr<const ScanImage>;
+
+/**
+ * @class ScanBufferPool
+ * @brief Recycles scan pixel buffers so steady-state scanning never allocates
+ *
+ * A producer acquires a writable Buffer, fills it (typically on a worker
+ * thread) and publishes it as an immutable ScanImageHandle. Released
+ * storage is kept per byte size up to a retention budget.
+ */
+class ScanBufferPool {
+public:
+    struct Stats {
+        uint64_t allocations;    // buffers created from the heap
+        uint64_t reuses;         // buffers served from the free lists
+        uint64_t bytesCopied;    // pixel bytes copied out, as reported by recordCopy()
+        size_t pooledBytes;      // bytes currently held for reuse
+    };
+
+    // Writable pixels owned by one producer until published
+    class Buffer {
+    public:
+        Buffer() : width(0), height(0), bytesPerPixel(0) {}
+        Buffer(Buffer&&) = default;
+        Buffer& operator=(Buffer&&) = default;
+        ~Buffer();
+
+        uint8_t* data() { return storage.data(); }
+        uint16_t* pixels16() { return reinterpret_cast<uint16_t*>(storage.data()); }
+        size_t getByteSize() const { return storage.size(); }
+        uint32_t getWidth() const { return width; }
+        uint32_t getHeight() const { return height; }
+        bool isValid() const { return !storage.empty(); }
+
+    private:
+        friend class ScanBufferPool;
+
+        std::shared_ptr<ScanImage::PoolState> pool;
+        SimdVector<uint8_t> storage;
+        uint32_t width;
+        uint32_t height;
+        uint32_t bytesPerPixel;
+    };
+
+    explicit ScanBufferPool(size_t maxPooledBytes = 64 * 1024 * 1024);
+
+    // Process-wide pool used by the scanner
+    static ScanBufferPool& shared();
+
+    /**
+     * Hands out a buffer, reusing released storage of the same size
+     * @param bytesPerPixel 2 for 16-bit grayscale slices
+     */
+    Buffer acquire(uint32_t width, uint32_t height, uint32_t bytesPerPixel = 2);
+
+    /**
+     * Freezes a filled buffer into a shareable, immutable image
+     */
+    ScanImageHandle publish(Buffer&& buffer);
+
+    // Consumers that must copy pixels (e.g. into Godot memory) report it here
+    void recordCopy(size_t bytes);
+
+    // Releases all retained storage
+    void trim();
+
+    Stats getStats() const;
+
+private:
+    std::shared_ptr<ScanImage::PoolState> state;
+};
+
+// Shared by ScanImage, Buffer and the pool so storage can outlive any of them
+struct ScanImage::PoolState {
+    std::mutex mutex;
+    std::unordered_map<size_t, std::vector<SimdVector<uint8_t>>> freeLists;
+    size_t maxPooledBytes;
+    size_t pooledBytes = 0;
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> reuses{0};
+    std::atomic<uint64_t> bytesCopied{0};
+
+    explicit PoolState(size_t maxBytes) : maxPooledBytes(maxBytes) {}
+
+    void release(SimdVector<uint8_t>&& storage);
+};
+
+#endif // SCAN_BUFFER_POOL_H
@@ -0,0 +1,291 @@
+#include "scan_cache.h"
+#include "device_log.h"
+#include "scan_volume.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <utility>
+
+namespace {
+
+constexpr char kSpillMagic[4] = {'S', 'C', 'N', 'C'};
+constexpr uint32_t kSpillVersion = 1;
+constexpr int kSpillNameAttempts = 16;
+constexpr uint32_t kMaxSpillBytesPerPixel = 16;
+
+// Fixed-size prefix of a spill file, followed by the raw pixels
+struct SpillHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesPerPixel;
+    float quality;
+    uint32_t isValid;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(SpillHeader) == 32, "spill header layout changed");
+
+struct FileCloser {
+    void operator()(std::FILE* file) const { std::fclose(file); }
+};
+
+using FileHandle = std::unique_ptr<std::FILE, FileCloser>;
+
+// Whether the header's image exactly fills the rest of the file; divides rather than
+// multiplies so a corrupt header cannot overflow into a match
+bool spillSizeMatches(const SpillHeader& header, uint64_t fileSize) {
+    if (fileSize < sizeof(SpillHeader)) {
+        return false;
+    }
+    uint64_t payload = fileSize - sizeof(SpillHeader);
+    if (header.width == 0 || header.height == 0 || header.bytesPerPixel == 0) {
+        return payload == 0;
+    }
+    if (header.bytesPerPixel > kMaxSpillBytesPerPixel) {
+        return false;
+    }
+    uint64_t rowBytes = static_cast<uint64_t>(header.width) * header.bytesPerPixel;
+    return payload % rowBytes == 0 && payload / rowBytes == header.height;
+}
+
+inline size_t scanBytes(const ScanData& scan) {
+    return (scan.image ? scan.image->getByteSize() : 0) + (scan.volume ? scan.volume->getByteSize() : 0);
+}
+
+} // namespace
+
+ScanCache::ScanCache(size_t budget, ScanBufferPool& bufferPool)
+    : pool(bufferPool), byteBudget(budget), bytesUsed(0), spillSequence(0),
+      hits(0), misses(0), evictions(0), spills(0), spillReloads(0) {}
+
+ScanCache::~ScanCache() {
+    dropSpilled();
+}
+
+void ScanCache::put(const Key& key, const ScanData& scan) {
+    auto existing = index.find(key);
+    if (existing != index.end()) {
+        bytesUsed -= existing->second->bytes;
+        entries.erase(existing->second);
+        index.erase(existing);
+    }
+
+    auto spilledFile = spilled.find(key);
+    if (spilledFile != spilled.end()) {
+        std::remove(spilledFile->second.c_str());
+        spilled.erase(spilledFile);
+    }
+
+    insertFront(key, scan);
+
+    int64_t& newest = latest.emplace(latestKey(key.patientId, key.scanType), key.timestampUs).first->second;
+    newest = std::max(newest, key.timestampUs);
+
+    evictToBudget();
+}
+
+bool ScanCache::get(const Key& key, ScanData& out) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        out = it->second->scan;
+        ++hits;
+        return true;
+    }
+
+    ++misses;
+    if (!reload(key, out)) {
+        return false;
+    }
+    ++spillReloads;
+    return true;
+}
+
+bool ScanCache::getLatest(const std::string& patientId, const std::string& scanType, ScanData& out) {
+    auto it = latest.find(latestKey(patientId, scanType));
+    if (it == latest.end()) {
+        return false;
+    }
+    return get(Key{patientId, scanType, it->second}, out);
+}
+
+bool ScanCache::contains(const Key& key) const {
+    return index.count(key) != 0 || spilled.count(key) != 0;
+}
+
+bool ScanCache::getLatestTimestamp(const std::string& patientId, const std::string& scanType,
+                                   int64_t& timestampUs) const {
+    auto it = latest.find(latestKey(patientId, scanType));
+    if (it == latest.end()) {
+        return false;
+    }
+    timestampUs = it->second;
+    return true;
+}
+
+void ScanCache::setByteBudget(size_t bytes) {
+    byteBudget = bytes;
+    evictToBudget();
+}
+
+void ScanCache::setSpillDirectory(const std::string& directory) {
+    if (directory == spillDirectory) {
+        return;
+    }
+    dropSpilled();
+    spillDirectory = directory;
+    if (!spillDirectory.empty()) {
+        DEVICE_LOG_DEBUG("💾 Scan cache spilling to {}", spillDirectory);
+    }
+}
+
+void ScanCache::clear() {
+    entries.clear();
+    index.clear();
+    latest.clear();
+    bytesUsed = 0;
+    dropSpilled();
+}
+
+ScanCache::Stats ScanCache::getStats() const {
+    Stats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.evictions = evictions;
+    stats.spills = spills;
+    stats.spillReloads = spillReloads;
+    stats.bytesUsed = bytesUsed;
+    stats.byteBudget = byteBudget;
+    stats.entryCount = entries.size();
+    stats.spilledCount = spilled.size();
+    return stats;
+}
+
+void ScanCache::insertFront(const Key& key, const ScanData& scan) {
+    size_t bytes = scanBytes(scan);
+    entries.push_front(Entry{key, scan, bytes});
+    index[key] = entries.begin();
+    bytesUsed += bytes;
+}
+
+void ScanCache::evictToBudget() {
+    while (bytesUsed > byteBudget && !entries.empty()) {
+        Entry& victim = entries.back();
+        if (!spillDirectory.empty() && spill(victim)) {
+            ++spills;
+        }
+
+        DEVICE_LOG_TRACE("🗑️ Scan cache evicted {} scan ({} bytes)", victim.key.scanType, victim.bytes);
+        bytesUsed -= victim.bytes;
+        index.erase(victim.key);
+        entries.pop_back();
+        ++evictions;
+    }
+}
+
+// Only the scan image is written; a spilled scan comes back without its volume
+bool ScanCache::spill(const Entry& entry) {
+    FileHandle file;
+    std::string path;
+    for (int attempt = 0; attempt < kSpillNameAttempts && !file; ++attempt) {
+        // Exclusive create, so caches sharing a directory never overwrite each other
+        path = spillDirectory + "/scan_" + std::to_string(reinterpret_cast<uintptr_t>(this)) + "_" +
+               std::to_string(spillSequence++) + ".bin";
+        file.reset(std::fopen(path.c_str(), "wbx"));
+    }
+    if (!file) {
+        DEVICE_LOG_INFO("❌ Scan cache cannot create a spill file for {} scan {}", entry.key.scanType,
+                        entry.key.timestampUs);
+        return false;
+    }
+
+    const ScanImageHandle& image = entry.scan.image;
+    SpillHeader header = {};
+    std::copy(kSpillMagic, kSpillMagic + 4, header.magic);
+    header.version = kSpillVersion;
+    header.width = image ? image->getWidth() : 0;
+    header.height = image ? image->getHeight() : 0;
+    header.bytesPerPixel = image ? image->getBytesPerPixel() : 0;
+    header.quality = entry.scan.quality;
+    header.isValid = entry.scan.isValid ? 1 : 0;
+
+    bool written = std::fwrite(&header, sizeof(header), 1, file.get()) == 1 &&
+                   (!image || std::fwrite(image->data(), image->getByteSize(), 1, file.get()) == 1);
+    if (std::fclose(file.release()) != 0 || !written) {
+        DEVICE_LOG_INFO("❌ Scan cache failed to spill {} scan {}", entry.key.scanType, entry.key.timestampUs);
+        std::remove(path.c_str());
+        return false;
+    }
+
+    spilled[entry.key] = std::move(path);
+    return true;
+}
+
+bool ScanCache::reload(const Key& key, ScanData& out) {
+    auto it = spilled.find(key);
+    if (it == spilled.end()) {
+        return false;
+    }
+
+    std::string path = std::move(it->second);
+    spilled.erase(it);
+
+    FileHandle file(std::fopen(path.c_str(), "rb"));
+    uint64_t fileSize = 0;
+    if (file && std::fseek(file.get(), 0, SEEK_END) == 0) {
+        long end = std::ftell(file.get());
+        fileSize = end > 0 ? static_cast<uint64_t>(end) : 0;
+        std::rewind(file.get());
+    }
+
+    // The image size is checked against the file length before it sizes a buffer
+    SpillHeader header;
+    bool valid = file && std::fread(&header, sizeof(header), 1, file.get()) == 1 &&
+                 std::equal(kSpillMagic, kSpillMagic + 4, header.magic) && header.version == kSpillVersion &&
+                 spillSizeMatches(header, fileSize);
+    if (!valid) {
+        DEVICE_LOG_INFO("❌ Scan cache spill file for {} scan {} is missing or corrupt", key.scanType,
+                        key.timestampUs);
+        file.reset();
+        std::remove(path.c_str());
+        return false;
+    }
+
+    ScanData scan(key.scanType);
+    scan.timestampUs = key.timestampUs;
+    scan.quality = header.quality;
+    scan.isValid = header.isValid != 0;
+
+    if (header.width != 0 && header.height != 0 && header.bytesPerPixel != 0) {
+        ScanBufferPool::Buffer buffer = pool.acquire(header.width, header.height, header.bytesPerPixel);
+        if (std::fread(buffer.data(), buffer.getByteSize(), 1, file.get()) != 1) {
+            DEVICE_LOG_INFO("❌ Scan cache spill file for {} scan {} is truncated", key.scanType, key.timestampUs);
+            file.reset();
+            std::remove(path.c_str());
+            return false;
+        }
+        scan.image = pool.publish(std::move(buffer));
+    }
+
+    // Back in memory, so the file is no longer needed; a later eviction writes a new one
+    file.reset();
+    std::remove(path.c_str());
+
+    out = scan;
+    insertFront(key, scan);
+    evictToBudget();
+    return true;
+}
+
+void ScanCache::dropSpilled() {
+    for (const auto& entry : spilled) {
+        std::remove(entry.second.c_str());
+    }
+    spilled.clear();
+}
+
+std::string ScanCache::latestKey(const std::string& patientId, const std::string& scanType) {
+    return patientId + '\x1f' + scanType;
+}
@@ -0,0 +1,135 @@
+#ifndef SCAN_CACHE_H
+#define SCAN_CACHE_H
+
+#include "medical_data.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class ScanCache
+ * @brief Byte-budgeted LRU store of completed scans
+ *
+ * Scans are keyed by (patient, scan type, acquisition time) and looked up
+ * in O(1). When the pixel and voxel bytes held exceed the budget the least
+ * recently used scans are evicted, and their images written to a spill
+ * directory first if one is set, so a later lookup can bring them back.
+ * Volumes are not spilled. Main-thread only.
+ */
+class ScanCache {
+public:
+    struct Key {
+        std::string patientId;
+        std::string scanType;
+        int64_t timestampUs;
+
+        bool operator==(const Key& other) const {
+            return timestampUs == other.timestampUs && scanType == other.scanType && patientId == other.patientId;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t seed = std::hash<std::string>()(key.patientId);
+            seed ^= std::hash<std::string>()(key.scanType) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= std::hash<int64_t>()(key.timestampUs) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
+    struct Stats {
+        uint64_t hits;          // found in memory
+        uint64_t misses;        // not in memory (including spill reloads)
+        uint64_t evictions;     // dropped from memory to meet the budget
+        uint64_t spills;        // evictions written to the spill directory
+        uint64_t spillReloads;  // misses served from the spill directory
+        size_t bytesUsed;       // pixel and voxel bytes held in memory
+        size_t byteBudget;
+        size_t entryCount;      // scans held in memory
+        size_t spilledCount;    // scans held on disk only
+    };
+
+    explicit ScanCache(size_t byteBudget = 256 * 1024 * 1024, ScanBufferPool& pool = ScanBufferPool::shared());
+    ~ScanCache();
+
+    ScanCache(const ScanCache&) = delete;
+    ScanCache& operator=(const ScanCache&) = delete;
+
+    /**
+     * Stores a scan as the most recently used entry, replacing any scan
+     * with the same key, then evicts down to the budget
+     */
+    void put(const Key& key, const ScanData& scan);
+
+    /**
+     * Looks a scan up, reloading it from the spill directory if needed
+     * @param out Receives the scan; its image is shared, not copied
+     * @return false if the scan is neither in memory nor spilled
+     */
+    bool get(const Key& key, ScanData& out);
+
+    /**
+     * Most recent scan of a type for a patient, by acquisition time
+     * @return false if none was ever stored
+     */
+    bool getLatest(const std::string& patientId, const std::string& scanType, ScanData& out);
+
+    bool contains(const Key& key) const;
+
+    // Acquisition time of the newest scan of a type; does not count as a lookup
+    bool getLatestTimestamp(const std::string& patientId, const std::string& scanType, int64_t& timestampUs) const;
+
+    // Shrinking the budget evicts immediately
+    void setByteBudget(size_t bytes);
+    size_t getByteBudget() const { return byteBudget; }
+
+    /**
+     * Enables spill-to-disk of evicted scans into an existing directory
+     * @param directory Empty disables spilling and deletes spilled files
+     */
+    void setSpillDirectory(const std::string& directory);
+    const std::string& getSpillDirectory() const { return spillDirectory; }
+
+    // Drops every scan, in memory and spilled
+    void clear();
+
+    Stats getStats() const;
+
+private:
+    struct Entry {
+        Key key;
+        ScanData scan;
+        size_t bytes;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    void insertFront(const Key& key, const ScanData& scan);
+    void evictToBudget();
+    bool spill(const Entry& entry);
+    bool reload(const Key& key, ScanData& out);
+    void dropSpilled();
+    static std::string latestKey(const std::string& patientId, const std::string& scanType);
+
+    ScanBufferPool& pool;
+    size_t byteBudget;
+    size_t bytesUsed;
+    EntryList entries;  // most recently used first
+    std::unordered_map<Key, EntryList::iterator, KeyHash> index;
+    std::unordered_map<Key, std::string, KeyHash> spilled;  // key -> spill file
+    std::unordered_map<std::string, int64_t> latest;        // patient + type -> newest timestamp
+
+    std::string spillDirectory;
+    uint64_t spillSequence;
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t spills;
+    uint64_t spillReloads;
+};
+
+#endif // SCAN_CACHE_H
@@ -0,0 +1,97 @@
+#include "scan_job.h"
+#include "device_log.h"
+#include <chrono>
+#include <memory>
+#include <utility>
+
+ScanJob::ScanJob(Workload jobWorkload) : workload(std::move(jobWorkload)) {}
+
+void ScanJob::execute() {
+    if (isCancelled()) {
+        status.store(Status::CANCELLED, std::memory_order_release);
+        return;
+    }
+
+    status.store(Status::RUNNING, std::memory_order_relaxed);
+    bool finished = workload && workload(*this, result);
+
+    // Publishes the result together with the final status
+    Status outcome = finished ? Status::COMPLETED : (isCancelled() ? Status::CANCELLED : Status::FAILED);
+    if (outcome == Status::COMPLETED) {
+        setProgress(1.0f);
+    }
+    status.store(outcome, std::memory_order_release);
+}
+
+ScanJob::Workload ScanJob::simulatedAcquisition(const std::string& scanType, int steps, ScanBufferPool& pool) {
+    return [scanType, steps, &pool](ScanJob& job, ScanData& result) {
+        ScanBufferPool::Buffer buffer = pool.acquire(kSliceWidth, kSliceHeight);
+        uint16_t* pixels = buffer.pixels16();
+
+        // Elliptical phantom with a soft falloff and a little texture
+        const float centerX = kSliceWidth * 0.5f;
+        const float centerY = kSliceHeight * 0.5f;
+        const float radiusX = kSliceWidth * 0.42f;
+        const float radiusY = kSliceHeight * 0.36f;
+
+        int stepCount = steps > 0 ? steps : 1;
+        for (int step = 0; step < stepCount; ++step) {
+            if (job.isCancelled()) {
+                return false; // the buffer goes back to the pool
+            }
+
+            uint32_t firstRow = kSliceHeight * step / stepCount;
+            uint32_t lastRow = kSliceHeight * (step + 1) / stepCount;
+            for (uint32_t y = firstRow; y < lastRow; ++y) {
+                float dy = (static_cast<float>(y) - centerY) / radiusY;
+                uint16_t* row = pixels + static_cast<size_t>(y) * kSliceWidth;
+                for (uint32_t x = 0; x < kSliceWidth; ++x) {
+                    float dx = (static_cast<float>(x) - centerX) / radiusX;
+                    float falloff = 1.0f - (dx * dx + dy * dy);
+                    uint16_t texture = static_cast<uint16_t>((x ^ y) & 63);
+                    row[x] = falloff > 0.0f ? static_cast<uint16_t>(1000.0f + falloff * 3000.0f) + texture : 0;
+                }
+            }
+
+            float fraction = static_cast<float>(step + 1) / static_cast<float>(stepCount);
+            job.setProgress(fraction);
+            DEVICE_LOG_TRACE("Scan progress: {}%", static_cast<int>(fraction * 100.0f));
+        }
+
+        result = ScanData(scanType);
+        result.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        result.image = pool.publish(std::move(buffer));
+        return true;
+    };
+}
+
+ScanJob::Workload ScanJob::volumetricAcquisition(const std::string& scanType, uint32_t volumeSize, uint32_t seed,
+                                                 int steps) {
+    return [scanType, volumeSize, seed, steps](ScanJob& job, ScanData& result) {
+        auto volume = std::make_shared<ScanVolume>();
+        volume->allocate(ScanVolume::phantomFromName(scanType), volumeSize, seed);
+
+        int stepCount = steps > 0 ? steps : 1;
+        for (int step = 0; step < stepCount; ++step) {
+            if (job.isCancelled()) {
+                return false;
+            }
+
+            uint32_t firstSlice = static_cast<uint32_t>(static_cast<uint64_t>(volumeSize) * step / stepCount);
+            uint32_t lastSlice = static_cast<uint32_t>(static_cast<uint64_t>(volumeSize) * (step + 1) / stepCount);
+            volume->generateSlices(firstSlice, lastSlice);
+
+            float fraction = static_cast<float>(step + 1) / static_cast<float>(stepCount);
+            job.setProgress(fraction);
+            DEVICE_LOG_TRACE("Scan progress: {}%", static_cast<int>(fraction * 100.0f));
+        }
+
+        result = ScanData(scanType);
+        result.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        result.image = volume->renderSlice(ScanVolume::Axis::AXIAL, volumeSize / 2);
+        result.volume = std::move(volume);
+        return true;
+    };
+}
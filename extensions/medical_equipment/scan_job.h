@@ -0,0 +1,83 @@
+#ifndef SCAN_JOB_H
+#define SCAN_JOB_H
+
+#include "medical_data.h"
+#include "scan_volume.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @class ScanJob
+ * @brief One scan acquisition executed off the main thread
+ *
+ * The workload runs on a worker, publishes progress through an atomic and
+ * polls isCancelled() between steps. The owning thread polls isDone() and
+ * only then reads the result, so completion is handled where the owner
+ * lives (the Godot main thread for Scanner).
+ */
+class ScanJob {
+public:
+    enum class Status : uint8_t { QUEUED, RUNNING, COMPLETED, CANCELLED, FAILED };
+
+    // Fills the result and returns true, or returns false when cancelled or failed
+    using Workload = std::function<bool(ScanJob& job, ScanData& result)>;
+
+    explicit ScanJob(Workload workload);
+
+    ScanJob(const ScanJob&) = delete;
+    ScanJob& operator=(const ScanJob&) = delete;
+
+    // Runs the workload; called once, on the worker thread
+    void execute();
+
+    // Cooperative cancellation; the workload stops at its next check
+    void cancel() { cancelRequested.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelRequested.load(std::memory_order_relaxed); }
+
+    // Lock-free progress in [0, 1]
+    void setProgress(float value) { progress.store(value, std::memory_order_relaxed); }
+    float getProgress() const { return progress.load(std::memory_order_relaxed); }
+
+    Status getStatus() const { return status.load(std::memory_order_acquire); }
+    bool isDone() const { return getStatus() >= Status::COMPLETED; }
+
+    // Valid once isDone() returned true
+    const ScanData& getResult() const { return result; }
+
+    /**
+     * Simulated acquisition used by Scanner: renders a 16-bit phantom slice
+     * into a pooled buffer in bands, checking for cancellation between them
+     * @param scanType Name stored in the resulting ScanData
+     * @param steps Number of progress steps (row bands)
+     * @param pool Pool supplying the pixel buffer
+     */
+    static Workload simulatedAcquisition(const std::string& scanType, int steps = 8,
+                                         ScanBufferPool& pool = ScanBufferPool::shared());
+
+    /**
+     * Volumetric acquisition used by Scanner: generates the procedural
+     * phantom for the scan type slab by slab, then publishes the volume with
+     * its central axial slice as the scan image
+     * @param volumeSize Voxels along each edge of the volume
+     * @param seed Varies the phantom texture between scans
+     */
+    static Workload volumetricAcquisition(const std::string& scanType, uint32_t volumeSize = ScanVolume::kDefaultSize,
+                                          uint32_t seed = 1, int steps = 8);
+
+    // Default slice size produced by simulatedAcquisition
+    static constexpr uint32_t kSliceWidth = 512;
+    static constexpr uint32_t kSliceHeight = 512;
+
+private:
+    Workload workload;
+    ScanData result;
+    std::atomic<float> progress{0.0f};
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<Status> status{Status::QUEUED};
+
+    static_assert(std::atomic<float>::is_always_lock_free, "scan progress must be readable lock-free");
+};
+
+#endif // SCAN_JOB_H
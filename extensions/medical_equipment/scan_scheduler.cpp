@@ -0,0 +1,318 @@
+#include "scan_scheduler.h"
+#include "device_log.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+ScanScheduler::ScanScheduler(size_t scannerCount, WorkerPool& workerPool)
+    : workers(workerPool), slots(std::max<size_t>(1, scannerCount)), nextId(1), statsSinceUs(nowMicros()),
+      retiredBusyUs(0), submittedCount(0), completedCount(0), failedCount(0), cancelledCount(0),
+      preemptionCount(0), startedCount(0), totalWaitUs(0), maxWaitUs(0) {
+    workloadFactory = [](const Request& request) {
+        return ScanJob::volumetricAcquisition(request.scanType, ScanVolume::kDefaultSize,
+                                              static_cast<uint32_t>(request.id));
+    };
+}
+
+ScanScheduler::~ScanScheduler() {
+    // Workers keep their own reference to each job, so cancelling is enough
+    for (auto& slot : slots) {
+        if (slot.job) {
+            slot.job->cancel();
+        }
+    }
+}
+
+ScanScheduler& ScanScheduler::shared() {
+    static ScanScheduler instance;
+    return instance;
+}
+
+void ScanScheduler::setScannerCount(size_t count) {
+    count = std::max<size_t>(1, count);
+    while (slots.size() > count) {
+        Slot& removed = slots.back();
+        // Displaced by the resize, not preempted, so the request's count is left alone
+        if (removed.entry) {
+            requeue(removed);
+        }
+        retiredBusyUs += removed.busyUs;
+        slots.pop_back();
+    }
+    slots.resize(count);
+
+    DEVICE_LOG_INFO("🏥 Scan suite now has {} scanners", count);
+    schedule();
+}
+
+void ScanScheduler::setWorkloadFactory(WorkloadFactory factory) {
+    workloadFactory = std::move(factory);
+}
+
+uint64_t ScanScheduler::submit(const std::string& scanType, Priority priority, CompletionHandler onComplete) {
+    Entry entry;
+    entry.request.id = nextId++;
+    entry.request.scanType = scanType;
+    entry.request.priority = priority;
+    entry.request.submittedUs = nowMicros();
+    entry.request.startedUs = 0;
+    entry.request.preemptions = 0;
+    entry.onComplete = std::move(onComplete);
+
+    uint64_t id = entry.request.id;
+    queues[static_cast<size_t>(priority)].push_back(std::move(entry));
+    ++submittedCount;
+    DEVICE_LOG_DEBUG("📋 Queued {} {} scan #{}", getPriorityName(priority), scanType, id);
+
+    schedule();
+    return id;
+}
+
+bool ScanScheduler::cancel(uint64_t id) {
+    for (auto& queue : queues) {
+        auto it = std::find_if(queue.begin(), queue.end(), [id](const Entry& entry) { return entry.request.id == id; });
+        if (it != queue.end()) {
+            queue.erase(it);
+            ++cancelledCount;
+            return true;
+        }
+    }
+
+    for (auto& slot : slots) {
+        if (slot.entry && slot.entry->request.id == id) {
+            slot.job->cancel();
+            closeBusySpan(slot, nowMicros());
+            slot.entry.reset();
+            slot.job.reset();
+            ++cancelledCount;
+            schedule();
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ScanScheduler::poll() {
+    struct Finished {
+        Entry entry;
+        ScanJob::Status status;
+        std::shared_ptr<ScanJob> job;
+    };
+    std::vector<Finished> finished;
+
+    int64_t now = nowMicros();
+    for (auto& slot : slots) {
+        if (!slot.job || !slot.job->isDone()) {
+            continue;
+        }
+
+        ScanJob::Status status = slot.job->getStatus();
+        closeBusySpan(slot, now);
+        if (status == ScanJob::Status::CANCELLED) {
+            ++cancelledCount;
+        } else {
+            if (status == ScanJob::Status::COMPLETED) {
+                ++completedCount;
+            } else {
+                ++failedCount;
+            }
+            finished.push_back(Finished{std::move(*slot.entry), status, std::move(slot.job)});
+        }
+        slot.entry.reset();
+        slot.job.reset();
+    }
+
+    // Freed scanners pick up queued work before anyone is told, so a handler
+    // that submits again queues behind requests that were already waiting
+    schedule();
+
+    for (auto& done : finished) {
+        if (done.entry.onComplete) {
+            done.entry.onComplete(done.entry.request, done.status, done.job->getResult());
+        }
+    }
+    return finished.size();
+}
+
+bool ScanScheduler::isPending(uint64_t id) const {
+    return isRunning(id) || getQueuePosition(id) >= 0;
+}
+
+bool ScanScheduler::isRunning(uint64_t id) const {
+    return findRunning(id) != nullptr;
+}
+
+float ScanScheduler::getProgress(uint64_t id) const {
+    const Slot* slot = findRunning(id);
+    return slot ? slot->job->getProgress() : 0.0f;
+}
+
+int ScanScheduler::getQueuePosition(uint64_t id) const {
+    int ahead = 0;
+    for (const auto& queue : queues) {
+        for (const auto& entry : queue) {
+            if (entry.request.id == id) {
+                return ahead;
+            }
+            ++ahead;
+        }
+    }
+    return -1;
+}
+
+ScanScheduler::Stats ScanScheduler::getStats() const {
+    int64_t now = nowMicros();
+
+    Stats stats;
+    stats.scannerCount = slots.size();
+    stats.running = 0;
+    stats.queueDepth = 0;
+    stats.oldestWaitUs = 0;
+    for (size_t p = 0; p < kPriorityCount; ++p) {
+        stats.queuedByPriority[p] = queues[p].size();
+        stats.queueDepth += queues[p].size();
+        for (const auto& entry : queues[p]) {
+            stats.oldestWaitUs = std::max(stats.oldestWaitUs, now - entry.request.submittedUs);
+        }
+    }
+
+    int64_t busyUs = retiredBusyUs;
+    for (const auto& slot : slots) {
+        busyUs += slot.busyUs;
+        if (slot.entry) {
+            ++stats.running;
+            busyUs += now - std::max(slot.entry->request.startedUs, statsSinceUs);
+        }
+    }
+
+    stats.submitted = submittedCount;
+    stats.completed = completedCount;
+    stats.failed = failedCount;
+    stats.cancelled = cancelledCount;
+    stats.preemptions = preemptionCount;
+    stats.averageWaitUs = startedCount ? static_cast<double>(totalWaitUs) / static_cast<double>(startedCount) : 0.0;
+    stats.maxWaitUs = maxWaitUs;
+
+    double available = static_cast<double>(now - statsSinceUs) * static_cast<double>(slots.size());
+    stats.utilization = available > 0.0 ? std::min(1.0, static_cast<double>(busyUs) / available) : 0.0;
+    return stats;
+}
+
+void ScanScheduler::resetStats() {
+    statsSinceUs = nowMicros();
+    retiredBusyUs = 0;
+    for (auto& slot : slots) {
+        slot.busyUs = 0;
+    }
+    submittedCount = 0;
+    completedCount = 0;
+    failedCount = 0;
+    cancelledCount = 0;
+    preemptionCount = 0;
+    startedCount = 0;
+    totalWaitUs = 0;
+    maxWaitUs = 0;
+}
+
+const char* ScanScheduler::getPriorityName(Priority priority) {
+    switch (priority) {
+        case Priority::EMERGENCY: return "emergency";
+        case Priority::URGENT: return "urgent";
+        case Priority::ROUTINE: return "routine";
+        default: return "unknown";
+    }
+}
+
+void ScanScheduler::schedule() {
+    for (size_t p = 0; p < kPriorityCount; ++p) {
+        auto& queue = queues[p];
+        while (!queue.empty()) {
+            Slot* slot = findFreeSlot();
+            if (!slot && static_cast<Priority>(p) == Priority::EMERGENCY) {
+                slot = findPreemptableSlot();
+                if (slot) {
+                    DEVICE_LOG_ALERT("🚨 Emergency scan preempts routine {} scan #{}",
+                                     slot->entry->request.scanType, slot->entry->request.id);
+                    ++slot->entry->request.preemptions;
+                    requeue(*slot);
+                    ++preemptionCount;
+                }
+            }
+            if (!slot) {
+                break;
+            }
+
+            Entry entry = std::move(queue.front());
+            queue.pop_front();
+            start(*slot, std::move(entry));
+        }
+    }
+}
+
+void ScanScheduler::start(Slot& slot, Entry&& entry) {
+    int64_t now = nowMicros();
+    if (entry.request.startedUs == 0) {
+        int64_t waited = now - entry.request.submittedUs;
+        totalWaitUs += waited;
+        maxWaitUs = std::max(maxWaitUs, waited);
+        ++startedCount;
+    }
+    entry.request.startedUs = now;
+
+    slot.entry = std::make_unique<Entry>(std::move(entry));
+    slot.job = std::make_shared<ScanJob>(workloadFactory(slot.entry->request));
+
+    std::shared_ptr<ScanJob> job = slot.job;
+    workers.submit([job]() { job->execute(); });
+    DEVICE_LOG_DEBUG("🔍 Started {} scan #{}", slot.entry->request.scanType, slot.entry->request.id);
+}
+
+void ScanScheduler::requeue(Slot& slot) {
+    slot.job->cancel();
+    closeBusySpan(slot, nowMicros());
+
+    Entry entry = std::move(*slot.entry);
+    queues[static_cast<size_t>(entry.request.priority)].push_front(std::move(entry));
+
+    slot.entry.reset();
+    slot.job.reset();
+}
+
+void ScanScheduler::closeBusySpan(Slot& slot, int64_t now) {
+    slot.busyUs += now - std::max(slot.entry->request.startedUs, statsSinceUs);
+}
+
+ScanScheduler::Slot* ScanScheduler::findFreeSlot() {
+    for (auto& slot : slots) {
+        if (!slot.entry) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+ScanScheduler::Slot* ScanScheduler::findPreemptableSlot() {
+    // The most recently started routine scan loses the least work
+    Slot* newest = nullptr;
+    for (auto& slot : slots) {
+        if (slot.entry && slot.entry->request.priority == Priority::ROUTINE &&
+            (!newest || slot.entry->request.startedUs > newest->entry->request.startedUs)) {
+            newest = &slot;
+        }
+    }
+    return newest;
+}
+
+const ScanScheduler::Slot* ScanScheduler::findRunning(uint64_t id) const {
+    for (const auto& slot : slots) {
+        if (slot.entry && slot.entry->request.id == id) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+int64_t ScanScheduler::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
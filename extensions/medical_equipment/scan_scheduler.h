@@ -0,0 +1,151 @@
+#ifndef SCAN_SCHEDULER_H
+#define SCAN_SCHEDULER_H
+
+#include "scan_job.h"
+#include "worker_pool.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class ScanScheduler
+ * @brief Priority queue of scan requests shared by a suite of scanners
+ *
+ * Requests wait in one FIFO per priority and start on the first free
+ * scanner, most urgent first. An emergency request that finds every
+ * scanner busy preempts the most recently started routine scan, which is
+ * cancelled and queued again at the front of the routine queue. Jobs run
+ * on the worker pool; submit(), cancel() and poll() belong to the main
+ * thread, and completion handlers are only ever called from poll().
+ */
+class ScanScheduler {
+public:
+    enum class Priority : uint8_t { EMERGENCY, URGENT, ROUTINE };
+    static constexpr size_t kPriorityCount = 3;
+
+    struct Request {
+        uint64_t id;
+        std::string scanType;
+        Priority priority;
+        int64_t submittedUs;   // steady clock
+        int64_t startedUs;     // steady clock at the latest start, 0 until the first one
+        uint32_t preemptions;  // times an emergency pushed this request off a scanner
+    };
+
+    // Called from poll() once a request finishes with COMPLETED or FAILED
+    using CompletionHandler = std::function<void(const Request& request, ScanJob::Status status, const ScanData& scan)>;
+
+    // Builds the job workload for a request; defaults to the volumetric acquisition
+    using WorkloadFactory = std::function<ScanJob::Workload(const Request& request)>;
+
+    struct Stats {
+        size_t scannerCount;
+        size_t running;
+        size_t queueDepth;
+        std::array<size_t, kPriorityCount> queuedByPriority;
+        uint64_t submitted;
+        uint64_t completed;
+        uint64_t failed;
+        uint64_t cancelled;
+        uint64_t preemptions;
+        double averageWaitUs;  // submit to first start, over started requests
+        int64_t maxWaitUs;
+        int64_t oldestWaitUs;  // longest wait among requests still queued
+        double utilization;    // busy scanner time / available scanner time, 0..1
+    };
+
+    explicit ScanScheduler(size_t scannerCount = 2, WorkerPool& workers = WorkerPool::shared());
+    ~ScanScheduler();
+
+    ScanScheduler(const ScanScheduler&) = delete;
+    ScanScheduler& operator=(const ScanScheduler&) = delete;
+
+    // Scan suite shared by every ScannerDevice
+    static ScanScheduler& shared();
+
+    /**
+     * Resizes the suite; scans running on removed scanners are queued again
+     * @param count Number of scanners, at least 1
+     */
+    void setScannerCount(size_t count);
+    size_t getScannerCount() const { return slots.size(); }
+
+    void setWorkloadFactory(WorkloadFactory factory);
+
+    /**
+     * Queues a scan and starts it straight away if a scanner is free, or
+     * can be freed by preemption
+     * @return Request id, never 0
+     */
+    uint64_t submit(const std::string& scanType, Priority priority, CompletionHandler onComplete);
+
+    /**
+     * Drops a queued request or cancels a running one; its handler is not called
+     * @return false if the id is not pending
+     */
+    bool cancel(uint64_t id);
+
+    /**
+     * Collects finished jobs, starts queued requests on freed scanners and
+     * then calls the completion handlers
+     * @return Number of handlers called
+     */
+    size_t poll();
+
+    bool isPending(uint64_t id) const;
+    bool isRunning(uint64_t id) const;
+    float getProgress(uint64_t id) const;
+
+    // Requests ahead of this one in the queue, or -1 if it is not queued
+    int getQueuePosition(uint64_t id) const;
+
+    Stats getStats() const;
+    void resetStats();
+
+    static const char* getPriorityName(Priority priority);
+
+private:
+    struct Entry {
+        Request request;
+        CompletionHandler onComplete;
+    };
+
+    struct Slot {
+        std::unique_ptr<Entry> entry;  // null while the scanner is free
+        std::shared_ptr<ScanJob> job;
+        int64_t busyUs = 0;            // finished busy time since the stats window opened
+    };
+
+    void schedule();
+    void start(Slot& slot, Entry&& entry);
+    void requeue(Slot& slot);
+    void closeBusySpan(Slot& slot, int64_t now);
+    Slot* findFreeSlot();
+    Slot* findPreemptableSlot();
+    const Slot* findRunning(uint64_t id) const;
+    static int64_t nowMicros();
+
+    WorkerPool& workers;
+    WorkloadFactory workloadFactory;
+    std::vector<Slot> slots;
+    std::array<std::deque<Entry>, kPriorityCount> queues;
+    uint64_t nextId;
+
+    int64_t statsSinceUs;
+    int64_t retiredBusyUs;  // busy time of scanners removed by setScannerCount
+    uint64_t submittedCount;
+    uint64_t completedCount;
+    uint64_t failedCount;
+    uint64_t cancelledCount;
+    uint64_t preemptionCount;
+    uint64_t startedCount;
+    int64_t totalWaitUs;
+    int64_t maxWaitUs;
+};
+
+#endif // SCAN_SCHEDULER_H
@@ -0,0 +1,477 @@
+#include "scan_tiles.h"
+#include "device_log.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+struct FileCloser {
+    void operator()(std::FILE* file) const { std::fclose(file); }
+};
+
+using FileHandle = std::unique_ptr<std::FILE, FileCloser>;
+
+struct MipLevel {
+    uint32_t width;
+    uint32_t height;
+    std::vector<uint16_t> pixels;
+};
+
+inline uint32_t tilesAlong(uint32_t pixels, uint32_t tileSize) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(pixels) + tileSize - 1) / tileSize);
+}
+
+// Whether a tile's stored bytes can decode to exactly pixelCount pixels
+bool isPlausibleTile(const ScanTileFormat::TileEntry& entry, uint64_t pixelCount) {
+    if ((entry.flags & ScanTileFormat::kTileRunLength) == 0) {
+        return entry.storedBytes == pixelCount * sizeof(uint16_t);
+    }
+    uint64_t runs = entry.storedBytes / (2 * sizeof(uint16_t));
+    return entry.storedBytes % (2 * sizeof(uint16_t)) == 0 && runs > 0 && runs <= pixelCount &&
+           runs * UINT16_MAX >= pixelCount;
+}
+
+// 2x2 box filter; odd edges repeat their last row or column
+MipLevel downsample(const MipLevel& source) {
+    MipLevel level;
+    level.width = std::max(1u, (source.width + 1) / 2);
+    level.height = std::max(1u, (source.height + 1) / 2);
+    level.pixels.resize(static_cast<size_t>(level.width) * level.height);
+
+    for (uint32_t y = 0; y < level.height; ++y) {
+        const uint16_t* row0 = &source.pixels[static_cast<size_t>(std::min(2 * y, source.height - 1)) * source.width];
+        const uint16_t* row1 = &source.pixels[static_cast<size_t>(std::min(2 * y + 1, source.height - 1)) * source.width];
+        uint16_t* out = &level.pixels[static_cast<size_t>(y) * level.width];
+        for (uint32_t x = 0; x < level.width; ++x) {
+            uint32_t x0 = std::min(2 * x, source.width - 1);
+            uint32_t x1 = std::min(2 * x + 1, source.width - 1);
+            uint32_t sum = static_cast<uint32_t>(row0[x0]) + row0[x1] + row1[x0] + row1[x1];
+            out[x] = static_cast<uint16_t>((sum + 2) / 4);
+        }
+    }
+    return level;
+}
+
+// (count, value) pairs over the tile in row-major order
+void encodeRunLength(const std::vector<uint16_t>& tile, std::vector<uint16_t>& out) {
+    out.clear();
+    size_t i = 0;
+    while (i < tile.size()) {
+        uint16_t value = tile[i];
+        size_t run = 1;
+        while (i + run < tile.size() && tile[i + run] == value && run < UINT16_MAX) {
+            ++run;
+        }
+        out.push_back(static_cast<uint16_t>(run));
+        out.push_back(value);
+        i += run;
+    }
+}
+
+} // namespace
+
+bool ScanTileFormat::write(const std::string& path, const ScanImage& image, uint32_t tileSize) {
+    if (image.getBytesPerPixel() != 2 || image.getWidth() == 0 || image.getHeight() == 0 || tileSize == 0 ||
+        tileSize > kMaxTileSize) {
+        DEVICE_LOG_INFO("❌ Only non-empty 16-bit scans can be tiled: {}", path);
+        return false;
+    }
+
+    std::vector<MipLevel> pyramid(1);
+    pyramid[0].width = image.getWidth();
+    pyramid[0].height = image.getHeight();
+    pyramid[0].pixels.resize(static_cast<size_t>(image.getWidth()) * image.getHeight());
+    std::memcpy(pyramid[0].pixels.data(), image.data(), image.getByteSize());
+    while ((pyramid.back().width > tileSize || pyramid.back().height > tileSize) && pyramid.size() < kMaxLevels) {
+        pyramid.push_back(downsample(pyramid.back()));
+    }
+    if (pyramid.back().width > tileSize || pyramid.back().height > tileSize) {
+        DEVICE_LOG_INFO("❌ Scan is too large for {} pixel tiles: {}", tileSize, path);
+        return false;
+    }
+
+    // Index order matches file order: coarsest level first
+    uint32_t levelCount = static_cast<uint32_t>(pyramid.size());
+    std::vector<LevelInfo> levels(levelCount);
+    uint32_t tileCount = 0;
+    for (uint32_t level = levelCount; level-- > 0;) {
+        LevelInfo& info = levels[level];
+        info = {};
+        info.width = pyramid[level].width;
+        info.height = pyramid[level].height;
+        info.tilesX = tilesAlong(info.width, tileSize);
+        info.tilesY = tilesAlong(info.height, tileSize);
+        info.firstTile = tileCount;
+        tileCount += info.tilesX * info.tilesY;
+    }
+
+    FileHandle file(std::fopen(path.c_str(), "wb"));
+    if (!file) {
+        DEVICE_LOG_INFO("❌ Cannot create tiled scan {}", path);
+        return false;
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.width = image.getWidth();
+    header.height = image.getHeight();
+    header.bytesPerPixel = 2;
+    header.tileSize = tileSize;
+    header.levelCount = levelCount;
+    header.tileCount = tileCount;
+
+    std::vector<TileEntry> index(tileCount);
+    uint64_t offset = sizeof(FileHeader) + sizeof(LevelInfo) * levelCount + sizeof(TileEntry) * tileCount;
+
+    bool written = std::fwrite(&header, sizeof(header), 1, file.get()) == 1 &&
+                   std::fwrite(levels.data(), sizeof(LevelInfo), levelCount, file.get()) == levelCount &&
+                   std::fwrite(index.data(), sizeof(TileEntry), tileCount, file.get()) == tileCount;
+
+    std::vector<uint16_t> tile;
+    std::vector<uint16_t> encoded;
+    for (uint32_t level = levelCount; written && level-- > 0;) {
+        const MipLevel& source = pyramid[level];
+        const LevelInfo& info = levels[level];
+        for (uint32_t ty = 0; written && ty < info.tilesY; ++ty) {
+            for (uint32_t tx = 0; written && tx < info.tilesX; ++tx) {
+                uint32_t x0 = tx * tileSize;
+                uint32_t y0 = ty * tileSize;
+                uint32_t tileWidth = std::min(tileSize, source.width - x0);
+                uint32_t tileHeight = std::min(tileSize, source.height - y0);
+
+                tile.resize(static_cast<size_t>(tileWidth) * tileHeight);
+                for (uint32_t row = 0; row < tileHeight; ++row) {
+                    const uint16_t* src = &source.pixels[static_cast<size_t>(y0 + row) * source.width + x0];
+                    std::copy(src, src + tileWidth, &tile[static_cast<size_t>(row) * tileWidth]);
+                }
+
+                // Run-length encoding only pays off on flat regions such as air around the body
+                encodeRunLength(tile, encoded);
+                bool useRunLength = encoded.size() < tile.size();
+                const std::vector<uint16_t>& payload = useRunLength ? encoded : tile;
+
+                TileEntry& entry = index[info.firstTile + ty * info.tilesX + tx];
+                entry.offset = offset;
+                entry.storedBytes = static_cast<uint32_t>(payload.size() * sizeof(uint16_t));
+                entry.flags = useRunLength ? kTileRunLength : 0;
+                offset += entry.storedBytes;
+
+                written = std::fwrite(payload.data(), sizeof(uint16_t), payload.size(), file.get()) == payload.size();
+            }
+        }
+    }
+
+    // The index is only known once every tile is encoded
+    written = written && std::fseek(file.get(), static_cast<long>(sizeof(FileHeader) + sizeof(LevelInfo) * levelCount),
+                                    SEEK_SET) == 0 &&
+              std::fwrite(index.data(), sizeof(TileEntry), tileCount, file.get()) == tileCount;
+    if (std::fclose(file.release()) != 0 || !written) {
+        DEVICE_LOG_INFO("❌ Failed to write tiled scan {}", path);
+        std::remove(path.c_str());
+        return false;
+    }
+
+    DEVICE_LOG_DEBUG("💾 Wrote tiled scan {} ({} levels, {} tiles)", path, levelCount, tileCount);
+    return true;
+}
+
+ScanTileReader::ScanTileReader() : file(nullptr), header() {}
+
+ScanTileReader::~ScanTileReader() {
+    close();
+}
+
+bool ScanTileReader::open(const std::string& path) {
+    close();
+
+    FileHandle handle(std::fopen(path.c_str(), "rb"));
+    if (!handle) {
+        DEVICE_LOG_INFO("❌ Cannot open tiled scan {}", path);
+        return false;
+    }
+
+    // Every count below is checked against the file length before it sizes an allocation
+    uint64_t fileSize = 0;
+    if (std::fseek(handle.get(), 0, SEEK_END) == 0) {
+        long end = std::ftell(handle.get());
+        fileSize = end > 0 ? static_cast<uint64_t>(end) : 0;
+    }
+    std::rewind(handle.get());
+
+    using namespace ScanTileFormat;
+    FileHeader fileHeader;
+    if (std::fread(&fileHeader, sizeof(fileHeader), 1, handle.get()) != 1 ||
+        std::memcmp(fileHeader.magic, kMagic, sizeof(fileHeader.magic)) != 0 || fileHeader.version != kVersion ||
+        fileHeader.bytesPerPixel != 2 || fileHeader.width == 0 || fileHeader.height == 0 ||
+        fileHeader.tileSize == 0 || fileHeader.tileSize > kMaxTileSize || fileHeader.levelCount == 0 ||
+        fileHeader.levelCount > kMaxLevels) {
+        DEVICE_LOG_INFO("❌ Not a tiled scan: {}", path);
+        return false;
+    }
+
+    uint64_t dataStart = sizeof(FileHeader) + sizeof(LevelInfo) * static_cast<uint64_t>(fileHeader.levelCount) +
+                         sizeof(TileEntry) * static_cast<uint64_t>(fileHeader.tileCount);
+    if (dataStart > fileSize) {
+        DEVICE_LOG_INFO("❌ Tiled scan index is truncated: {}", path);
+        return false;
+    }
+
+    std::vector<LevelInfo> levelInfo(fileHeader.levelCount);
+    std::vector<TileEntry> tileIndex(fileHeader.tileCount);
+    if (std::fread(levelInfo.data(), sizeof(LevelInfo), levelInfo.size(), handle.get()) != levelInfo.size() ||
+        std::fread(tileIndex.data(), sizeof(TileEntry), tileIndex.size(), handle.get()) != tileIndex.size()) {
+        DEVICE_LOG_INFO("❌ Tiled scan index is truncated: {}", path);
+        return false;
+    }
+
+    // Level 0 is the header size and each level halves the one before, as write() builds them;
+    // only the coarsest fits in a single tile
+    uint64_t indexedTiles = 0;
+    for (uint32_t level = 0; level < fileHeader.levelCount; ++level) {
+        const LevelInfo& info = levelInfo[level];
+        uint32_t expectedWidth = level == 0 ? fileHeader.width : std::max(1u, (levelInfo[level - 1].width + 1) / 2);
+        uint32_t expectedHeight = level == 0 ? fileHeader.height : std::max(1u, (levelInfo[level - 1].height + 1) / 2);
+        bool coarsest = level + 1 == fileHeader.levelCount;
+        bool singleTile = info.width <= fileHeader.tileSize && info.height <= fileHeader.tileSize;
+        uint64_t levelTiles = static_cast<uint64_t>(info.tilesX) * info.tilesY;
+        if (info.width != expectedWidth || info.height != expectedHeight || singleTile != coarsest ||
+            info.tilesX != tilesAlong(info.width, fileHeader.tileSize) ||
+            info.tilesY != tilesAlong(info.height, fileHeader.tileSize) ||
+            info.firstTile + levelTiles > fileHeader.tileCount) {
+            DEVICE_LOG_INFO("❌ Tiled scan index is corrupt: {}", path);
+            return false;
+        }
+        indexedTiles += levelTiles;
+
+        for (uint32_t tileY = 0; tileY < info.tilesY; ++tileY) {
+            for (uint32_t tileX = 0; tileX < info.tilesX; ++tileX) {
+                const TileEntry& entry = tileIndex[info.firstTile + static_cast<uint64_t>(tileY) * info.tilesX + tileX];
+                uint64_t pixelCount = static_cast<uint64_t>(std::min(fileHeader.tileSize, info.width - tileX * fileHeader.tileSize)) *
+                                      std::min(fileHeader.tileSize, info.height - tileY * fileHeader.tileSize);
+                if (entry.offset < dataStart || entry.offset + entry.storedBytes > fileSize ||
+                    !isPlausibleTile(entry, pixelCount)) {
+                    DEVICE_LOG_INFO("❌ Tiled scan index is corrupt: {}", path);
+                    return false;
+                }
+            }
+        }
+    }
+    if (indexedTiles != fileHeader.tileCount) {
+        DEVICE_LOG_INFO("❌ Tiled scan index is corrupt: {}", path);
+        return false;
+    }
+
+    file = handle.release();
+    header = fileHeader;
+    levels = std::move(levelInfo);
+    tiles = std::move(tileIndex);
+    return true;
+}
+
+void ScanTileReader::close() {
+    if (file) {
+        std::fclose(file);
+    }
+    file = nullptr;
+    header = {};
+    levels.clear();
+    tiles.clear();
+}
+
+const ScanTileFormat::TileEntry& ScanTileReader::getTile(uint32_t level, uint32_t tileX, uint32_t tileY) const {
+    const ScanTileFormat::LevelInfo& info = levels[level];
+    return tiles[info.firstTile + tileY * info.tilesX + tileX];
+}
+
+uint32_t ScanTileReader::getTileWidth(uint32_t level, uint32_t tileX) const {
+    return std::min(header.tileSize, levels[level].width - tileX * header.tileSize);
+}
+
+uint32_t ScanTileReader::getTileHeight(uint32_t level, uint32_t tileY) const {
+    return std::min(header.tileSize, levels[level].height - tileY * header.tileSize);
+}
+
+bool ScanTileReader::readTile(uint32_t level, uint32_t tileX, uint32_t tileY, uint16_t* out, size_t outStride) {
+    if (!file || level >= levels.size() || tileX >= levels[level].tilesX || tileY >= levels[level].tilesY) {
+        return false;
+    }
+
+    const ScanTileFormat::TileEntry& entry = getTile(level, tileX, tileY);
+    uint32_t tileWidth = getTileWidth(level, tileX);
+    uint32_t tileHeight = getTileHeight(level, tileY);
+    size_t pixelCount = static_cast<size_t>(tileWidth) * tileHeight;
+    bool runLength = (entry.flags & ScanTileFormat::kTileRunLength) != 0;
+    if (entry.storedBytes % sizeof(uint16_t) != 0 ||
+        (!runLength && entry.storedBytes != pixelCount * sizeof(uint16_t))) {
+        return false;
+    }
+
+    std::vector<uint16_t> payload(entry.storedBytes / sizeof(uint16_t));
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (std::fseek(file, static_cast<long>(entry.offset), SEEK_SET) != 0 ||
+            std::fread(payload.data(), sizeof(uint16_t), payload.size(), file) != payload.size()) {
+            return false;
+        }
+    }
+
+    if (!runLength) {
+        for (uint32_t row = 0; row < tileHeight; ++row) {
+            const uint16_t* src = &payload[static_cast<size_t>(row) * tileWidth];
+            std::copy(src, src + tileWidth, out + row * outStride);
+        }
+        return true;
+    }
+
+    if (payload.size() % 2 != 0) {
+        return false;
+    }
+    // Runs cross row ends, so the output is walked a row span at a time
+    size_t written = 0;
+    uint16_t* row = out;
+    size_t column = 0;
+    for (size_t i = 0; i < payload.size(); i += 2) {
+        size_t run = payload[i];
+        if (run == 0 || written + run > pixelCount) {
+            return false;
+        }
+        written += run;
+        while (run > 0) {
+            size_t span = std::min(run, tileWidth - column);
+            std::fill_n(row + column, span, payload[i + 1]);
+            column += span;
+            run -= span;
+            if (column == tileWidth) {
+                column = 0;
+                row += outStride;
+            }
+        }
+    }
+    return written == pixelCount;
+}
+
+ScanTileStream::ScanTileStream() : tilesTotal(0), tilesDelivered(0), tilesFailed(0) {}
+
+ScanTileStream::~ScanTileStream() {
+    cancel();
+}
+
+bool ScanTileStream::open(const std::string& path, ScanBufferPool& pool) {
+    cancel();
+    state.reset();
+    coarseImage.reset();
+    tilesTotal = 0;
+    tilesDelivered = 0;
+    tilesFailed = 0;
+
+    auto opened = std::make_shared<State>();
+    opened->pool = &pool;
+    if (!opened->reader.open(path)) {
+        return false;
+    }
+
+    // The coarsest level is a single tile by construction
+    uint32_t coarsest = opened->reader.getLevelCount() - 1;
+    const ScanTileFormat::LevelInfo& info = opened->reader.getLevel(coarsest);
+    ScanBufferPool::Buffer buffer = pool.acquire(info.width, info.height);
+    if (info.tilesX != 1 || info.tilesY != 1 || !opened->reader.readTile(coarsest, 0, 0, buffer.pixels16(), info.width)) {
+        DEVICE_LOG_INFO("❌ Tiled scan has an unreadable coarse level: {}", path);
+        return false;
+    }
+
+    state = std::move(opened);
+    coarseImage = pool.publish(std::move(buffer));
+    return true;
+}
+
+void ScanTileStream::start(uint32_t finestLevel, WorkerPool& workers) {
+    if (!state || state->decoding.load()) {
+        return;
+    }
+
+    uint32_t coarsest = getCoarseLevel();
+    finestLevel = std::min(finestLevel, coarsest);
+    tilesTotal = 0;
+    for (uint32_t level = finestLevel; level < coarsest; ++level) {
+        const ScanTileFormat::LevelInfo& info = state->reader.getLevel(level);
+        tilesTotal += static_cast<size_t>(info.tilesX) * info.tilesY;
+    }
+    if (tilesTotal == 0) {
+        return;
+    }
+
+    state->cancelled.store(false);
+    state->decoding.store(true);
+    std::shared_ptr<State> shared = state;
+    workers.submit([shared, coarsest, finestLevel, &workers]() {
+        decodeLevels(shared, coarsest, finestLevel, workers);
+    });
+}
+
+void ScanTileStream::cancel() {
+    if (state) {
+        state->cancelled.store(true);
+    }
+}
+
+uint32_t ScanTileStream::getCoarseLevel() const {
+    return state ? state->reader.getLevelCount() - 1 : 0;
+}
+
+uint32_t ScanTileStream::getWidth() const {
+    return state ? state->reader.getWidth() : 0;
+}
+
+uint32_t ScanTileStream::getHeight() const {
+    return state ? state->reader.getHeight() : 0;
+}
+
+uint32_t ScanTileStream::getLevelCount() const {
+    return state ? state->reader.getLevelCount() : 0;
+}
+
+bool ScanTileStream::isFinished() const {
+    if (!state) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(state->readyMutex);
+    return !state->decoding.load() && state->ready.empty();
+}
+
+void ScanTileStream::decodeLevels(const std::shared_ptr<State>& state, uint32_t coarsest, uint32_t finest,
+                                  WorkerPool& workers) {
+    ScanTileReader& reader = state->reader;
+    uint32_t tileSize = reader.getTileSize();
+
+    // Each level completes before the next finer one starts, so updates arrive coarse to fine
+    for (uint32_t level = coarsest; level-- > finest && !state->cancelled.load();) {
+        const ScanTileFormat::LevelInfo& info = reader.getLevel(level);
+        size_t levelTiles = static_cast<size_t>(info.tilesX) * info.tilesY;
+
+        workers.parallelFor(levelTiles, 1, [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end && !state->cancelled.load(); ++t) {
+                uint32_t tileX = static_cast<uint32_t>(t % info.tilesX);
+                uint32_t tileY = static_cast<uint32_t>(t / info.tilesX);
+                uint32_t tileWidth = reader.getTileWidth(level, tileX);
+
+                ScanBufferPool::Buffer buffer = state->pool->acquire(tileWidth, reader.getTileHeight(level, tileY));
+                // A corrupt tile is still queued, without pixels, so the delivered count reaches the total
+                ScanImageHandle pixels;
+                if (reader.readTile(level, tileX, tileY, buffer.pixels16(), tileWidth)) {
+                    pixels = state->pool->publish(std::move(buffer));
+                } else {
+                    DEVICE_LOG_INFO("❌ Skipping corrupt scan tile {} of level {}", t, level);
+                }
+
+                TileUpdate update{level, tileX * tileSize, tileY * tileSize, std::move(pixels)};
+                std::lock_guard<std::mutex> lock(state->readyMutex);
+                state->ready.push_back(std::move(update));
+            }
+        });
+    }
+
+    std::lock_guard<std::mutex> lock(state->readyMutex);
+    state->decoding.store(false);
+}
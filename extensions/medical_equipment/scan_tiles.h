@@ -0,0 +1,227 @@
+#ifndef SCAN_TILES_H
+#define SCAN_TILES_H
+
+#include "scan_buffer_pool.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// On-disk layout of a tiled scan. A 64-byte header is followed by one
+// LevelInfo per mip level, the tile index and then the tile payloads,
+// coarsest level first so a progressive reader streams forward through
+// the file. Level 0 is full resolution; each level halves the previous one
+// until the whole image fits in a single tile. Tiles hold little-endian
+// 16-bit pixels, either raw or run-length encoded.
+namespace ScanTileFormat {
+
+constexpr char kMagic[4] = {'S', 'C', 'N', 'T'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kDefaultTileSize = 128;
+constexpr uint32_t kMaxTileSize = 4096;  // bounds the buffer a single tile decodes into
+constexpr uint32_t kMaxLevels = 16;
+
+constexpr uint32_t kTileRunLength = 1u << 0;  // payload is (count, value) uint16 pairs
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesPerPixel;
+    uint32_t tileSize;
+    uint32_t levelCount;
+    uint32_t tileCount;
+    uint64_t reserved[4];
+};
+
+struct LevelInfo {
+    uint32_t width;
+    uint32_t height;
+    uint32_t tilesX;
+    uint32_t tilesY;
+    uint32_t firstTile;  // index of the level's first TileEntry; tiles are row-major
+    uint32_t reserved;
+};
+
+struct TileEntry {
+    uint64_t offset;       // from the start of the file
+    uint32_t storedBytes;
+    uint32_t flags;
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader must stay 64 bytes");
+static_assert(sizeof(LevelInfo) == 24, "LevelInfo must stay 24 bytes");
+static_assert(sizeof(TileEntry) == 16, "TileEntry must stay 16 bytes");
+
+/**
+ * Writes a scan image as a tiled mip pyramid
+ * @param image 16-bit scan pixels
+ * @param tileSize Edge of a square tile in pixels, at most kMaxTileSize
+ * @return false if the file cannot be written
+ */
+bool write(const std::string& path, const ScanImage& image, uint32_t tileSize = kDefaultTileSize);
+
+} // namespace ScanTileFormat
+
+/**
+ * @class ScanTileReader
+ * @brief Random access to the tiles of a tiled scan file
+ *
+ * open() reads only the header and tile index, and checks the level
+ * sizes, tile byte counts and offsets against the file length before
+ * anything is sized from them. readTile() may be called
+ * from several threads at once; file reads are serialized and decoding is
+ * not.
+ */
+class ScanTileReader {
+public:
+    ScanTileReader();
+    ~ScanTileReader();
+
+    ScanTileReader(const ScanTileReader&) = delete;
+    ScanTileReader& operator=(const ScanTileReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    uint32_t getWidth() const { return header.width; }
+    uint32_t getHeight() const { return header.height; }
+    uint32_t getTileSize() const { return header.tileSize; }
+    uint32_t getLevelCount() const { return header.levelCount; }
+    uint32_t getTileCount() const { return header.tileCount; }
+    const ScanTileFormat::LevelInfo& getLevel(uint32_t level) const { return levels[level]; }
+    const ScanTileFormat::TileEntry& getTile(uint32_t level, uint32_t tileX, uint32_t tileY) const;
+
+    // Pixel size of a tile; edge tiles are smaller than the tile size
+    uint32_t getTileWidth(uint32_t level, uint32_t tileX) const;
+    uint32_t getTileHeight(uint32_t level, uint32_t tileY) const;
+
+    /**
+     * Reads and decodes one tile
+     * @param out Destination for the tile's pixels, row-major
+     * @param outStride Pixels between rows of out
+     * @return false if the tile is truncated or corrupt
+     */
+    bool readTile(uint32_t level, uint32_t tileX, uint32_t tileY, uint16_t* out, size_t outStride);
+
+private:
+    std::FILE* file;
+    std::mutex fileMutex;
+    ScanTileFormat::FileHeader header;
+    std::vector<ScanTileFormat::LevelInfo> levels;
+    std::vector<ScanTileFormat::TileEntry> tiles;
+};
+
+/**
+ * @class ScanTileStream
+ * @brief Progressive load of a tiled scan: coarse image first, then finer tiles
+ *
+ * open() decodes the coarsest level, which always fits in one tile, so the
+ * first image is available after the same small amount of work whatever
+ * the scan resolution. start() then decodes the remaining levels on the
+ * worker pool, coarse to fine; the main thread collects finished tiles
+ * with poll().
+ */
+class ScanTileStream {
+public:
+    struct TileUpdate {
+        uint32_t level;
+        uint32_t x;             // pixel origin of the tile within its level
+        uint32_t y;
+        ScanImageHandle pixels;  // null if the tile was corrupt and skipped
+    };
+
+    ScanTileStream();
+    ~ScanTileStream();
+
+    ScanTileStream(const ScanTileStream&) = delete;
+    ScanTileStream& operator=(const ScanTileStream&) = delete;
+
+    /**
+     * Opens a tiled scan and decodes its coarsest level
+     * @return false if the file cannot be read
+     */
+    bool open(const std::string& path, ScanBufferPool& pool = ScanBufferPool::shared());
+
+    // Streams every level finer than the coarse one, down to finestLevel
+    void start(uint32_t finestLevel = 0, WorkerPool& workers = WorkerPool::shared());
+
+    // Stops decoding; tiles already decoded can still be polled
+    void cancel();
+
+    /**
+     * Hands decoded tiles to the caller, coarser levels first
+     * @param sink Called as sink(const TileUpdate&)
+     * @param maxTiles Upper bound per call, keeps a frame's work bounded
+     * @return Number of tiles delivered
+     */
+    template <typename Sink>
+    size_t poll(Sink&& sink, size_t maxTiles = SIZE_MAX);
+
+    const ScanImageHandle& getCoarseImage() const { return coarseImage; }
+    uint32_t getCoarseLevel() const;
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+    uint32_t getLevelCount() const;
+    size_t getTilesTotal() const { return tilesTotal; }
+    size_t getTilesDelivered() const { return tilesDelivered; }  // corrupt tiles included
+    size_t getTilesFailed() const { return tilesFailed; }
+    bool isFinished() const;
+
+private:
+    // Shared with the decode job, which can outlive a cancelled stream
+    struct State {
+        ScanTileReader reader;
+        ScanBufferPool* pool = nullptr;
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> decoding{false};
+        std::mutex readyMutex;
+        std::deque<TileUpdate> ready;
+    };
+
+    static void decodeLevels(const std::shared_ptr<State>& state, uint32_t coarsest, uint32_t finest,
+                             WorkerPool& workers);
+
+    std::shared_ptr<State> state;
+    ScanImageHandle coarseImage;
+    size_t tilesTotal;
+    size_t tilesDelivered;
+    size_t tilesFailed;
+};
+
+template <typename Sink>
+size_t ScanTileStream::poll(Sink&& sink, size_t maxTiles) {
+    if (!state) {
+        return 0;
+    }
+
+    std::deque<TileUpdate> batch;
+    {
+        std::lock_guard<std::mutex> lock(state->readyMutex);
+        size_t count = std::min(maxTiles, state->ready.size());
+        for (size_t i = 0; i < count; ++i) {
+            batch.push_back(std::move(state->ready.front()));
+            state->ready.pop_front();
+        }
+    }
+
+    for (const auto& update : batch) {
+        if (!update.pixels) {
+            ++tilesFailed;
+        }
+        sink(update);
+    }
+    tilesDelivered += batch.size();
+    return batch.size();
+}
+
+#endif // SCAN_TILES_H
@@ -0,0 +1,389 @@
+#include "scan_volume.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Tissue intensities on a 12-bit, CT-like scale
+constexpr float kAir = 0.0f;
+constexpr float kLung = 180.0f;
+constexpr float kCsf = 250.0f;
+constexpr float kFat = 850.0f;
+constexpr float kSoftTissue = 1080.0f;
+constexpr float kWhiteMatter = 1180.0f;
+constexpr float kGrayMatter = 1320.0f;
+constexpr float kOrgan = 1350.0f;
+constexpr float kMyocardium = 1450.0f;
+constexpr float kBlood = 1650.0f;
+constexpr float kBone = 3000.0f;
+
+constexpr size_t kRowGrain = 16;  // output rows per parallel tile
+
+inline uint32_t hash3(int32_t x, int32_t y, int32_t z, uint32_t seed) {
+    uint32_t h = seed * 0x9E3779B1u;
+    h ^= static_cast<uint32_t>(x) * 0x85EBCA6Bu;
+    h ^= static_cast<uint32_t>(y) * 0xC2B2AE35u;
+    h ^= static_cast<uint32_t>(z) * 0x27D4EB2Fu;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    h *= 0x297A2D39u;
+    h ^= h >> 15;
+    return h;
+}
+
+inline float latticeValue(int32_t x, int32_t y, int32_t z, uint32_t seed) {
+    return static_cast<float>(hash3(x, y, z, seed) & 0xFFFF) * (1.0f / 65535.0f);
+}
+
+inline float smooth(float t) {
+    return t * t * (3.0f - 2.0f * t);
+}
+
+// Trilinear value noise in [0, 1]
+float valueNoise(float x, float y, float z, uint32_t seed) {
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    float fz = std::floor(z);
+    int32_t ix = static_cast<int32_t>(fx);
+    int32_t iy = static_cast<int32_t>(fy);
+    int32_t iz = static_cast<int32_t>(fz);
+    float tx = smooth(x - fx);
+    float ty = smooth(y - fy);
+    float tz = smooth(z - fz);
+
+    float c00 = latticeValue(ix, iy, iz, seed) + tx * (latticeValue(ix + 1, iy, iz, seed) - latticeValue(ix, iy, iz, seed));
+    float c10 = latticeValue(ix, iy + 1, iz, seed) + tx * (latticeValue(ix + 1, iy + 1, iz, seed) - latticeValue(ix, iy + 1, iz, seed));
+    float c01 = latticeValue(ix, iy, iz + 1, seed) + tx * (latticeValue(ix + 1, iy, iz + 1, seed) - latticeValue(ix, iy, iz + 1, seed));
+    float c11 = latticeValue(ix, iy + 1, iz + 1, seed) + tx * (latticeValue(ix + 1, iy + 1, iz + 1, seed) - latticeValue(ix, iy + 1, iz + 1, seed));
+    float c0 = c00 + ty * (c10 - c00);
+    float c1 = c01 + ty * (c11 - c01);
+    return c0 + tz * (c1 - c0);
+}
+
+// Squared normalized distance; < 1 inside the ellipsoid
+inline float ellipsoid(float u, float v, float w, float cx, float cy, float cz, float rx, float ry, float rz) {
+    float a = (u - cx) / rx;
+    float b = (v - cy) / ry;
+    float c = (w - cz) / rz;
+    return a * a + b * b + c * c;
+}
+
+inline float cylinder(float u, float v, float cx, float cy, float rx, float ry) {
+    float a = (u - cx) / rx;
+    float b = (v - cy) / ry;
+    return a * a + b * b;
+}
+
+// Phantoms use normalized coordinates in [-1, 1]: u left to right,
+// v anterior to posterior, w inferior to superior
+
+float sampleHead(float u, float v, float w, uint32_t seed) {
+    float d = ellipsoid(u, v, w, 0.0f, 0.0f, 0.0f, 0.78f, 0.9f, 0.86f);
+    if (d >= 1.0f) {
+        return kAir;
+    }
+    if (d >= 0.88f) {
+        return kSoftTissue;
+    }
+    if (d >= 0.74f) {
+        return kBone + 300.0f * valueNoise(u * 12.0f, v * 12.0f, w * 12.0f, seed);
+    }
+
+    if (ellipsoid(std::fabs(u), v, w, 0.13f, -0.05f, 0.12f, 0.07f, 0.28f, 0.14f) < 1.0f) {
+        return kCsf;
+    }
+
+    // Folded gray/white matter boundary
+    float folds = valueNoise(u * 9.0f, v * 9.0f, w * 9.0f, seed ^ 0x5bd1e995u);
+    return folds > 0.55f ? kWhiteMatter : kGrayMatter;
+}
+
+float sampleChest(float u, float v, float w, uint32_t seed) {
+    float r2 = cylinder(u, v, 0.0f, 0.05f, 0.88f, 0.62f);
+    if (r2 >= 1.0f) {
+        return kAir;
+    }
+    if (r2 >= 0.86f) {
+        return kFat;
+    }
+    if (r2 >= 0.72f && r2 < 0.8f && std::sin(w * 25.0f) > 0.55f) {
+        return kBone; // ribs
+    }
+    if (cylinder(u, v, 0.0f, 0.42f, 0.09f, 0.09f) < 1.0f) {
+        return std::sin(w * 30.0f) > 0.85f ? kSoftTissue + 100.0f : kBone; // vertebrae and discs
+    }
+
+    float heart = ellipsoid(u, v, w, 0.12f, -0.12f, -0.1f, 0.3f, 0.3f, 0.35f);
+    if (heart < 1.0f) {
+        return heart < 0.45f ? kBlood : kMyocardium;
+    }
+    if (cylinder(u, v, -0.05f, 0.2f, 0.07f, 0.07f) < 1.0f && w > -0.3f) {
+        return kBlood; // aorta
+    }
+
+    if (ellipsoid(std::fabs(u), v, w, 0.42f, -0.02f, 0.15f, 0.32f, 0.45f, 0.8f) < 1.0f) {
+        float vessels = valueNoise(u * 14.0f, v * 14.0f, w * 14.0f, seed);
+        return vessels > 0.78f ? kSoftTissue - 200.0f : kLung;
+    }
+    return kSoftTissue;
+}
+
+float sampleBody(float u, float v, float w, uint32_t seed) {
+    if (w > 0.62f) {
+        return sampleHead(u / 0.2f, v / 0.22f, (w - 0.81f) / 0.19f, seed);
+    }
+    if (w > 0.55f) {
+        if (cylinder(u, v, 0.0f, 0.04f, 0.09f, 0.09f) >= 1.0f) {
+            return kAir;
+        }
+        return cylinder(u, v, 0.0f, 0.07f, 0.03f, 0.03f) < 1.0f ? kBone : kSoftTissue; // neck
+    }
+    if (w > 0.05f) {
+        return sampleChest(u / 0.42f, v / 0.42f, (w - 0.3f) / 0.25f, seed);
+    }
+    if (w > -0.48f) {
+        float r2 = cylinder(u, v, 0.0f, 0.02f, 0.38f, 0.27f);
+        if (r2 >= 1.0f) {
+            return kAir;
+        }
+        if (r2 >= 0.84f) {
+            return kFat;
+        }
+        if (cylinder(u, v, 0.0f, 0.19f, 0.04f, 0.04f) < 1.0f) {
+            return kBone;
+        }
+        if (w < -0.35f) {
+            return r2 >= 0.55f && r2 < 0.7f ? kBone : kSoftTissue; // pelvis
+        }
+        if (ellipsoid(u, v, w, -0.14f, -0.02f, -0.05f, 0.17f, 0.16f, 0.12f) < 1.0f) {
+            return kOrgan; // liver
+        }
+        if (ellipsoid(std::fabs(u), v, w, 0.15f, 0.14f, -0.2f, 0.05f, 0.04f, 0.08f) < 1.0f) {
+            return kOrgan - 50.0f; // kidneys
+        }
+        return kSoftTissue;
+    }
+
+    float leg = cylinder(std::fabs(u), v, 0.13f, 0.02f, 0.11f, 0.11f);
+    if (leg >= 1.0f) {
+        return kAir;
+    }
+    return leg < 0.1f ? kBone : kSoftTissue; // thigh around the femur
+}
+
+float samplePhantom(ScanVolume::Phantom phantom, float u, float v, float w, uint32_t seed) {
+    switch (phantom) {
+        case ScanVolume::Phantom::BRAIN: return sampleHead(u, v, w, seed);
+        // Field of view centred on the heart
+        case ScanVolume::Phantom::HEART: return sampleChest(0.12f + u * 0.5f, -0.12f + v * 0.5f, -0.1f + w * 0.5f, seed);
+        case ScanVolume::Phantom::LUNGS: return sampleChest(u, v, w, seed);
+        case ScanVolume::Phantom::FULL_BODY: return sampleBody(u, v, w, seed);
+    }
+    return kAir;
+}
+
+// dst[i] = max(dst[i], src[i])
+inline void maxInto(uint16_t* dst, const uint16_t* src, size_t count) {
+    size_t i = 0;
+#if defined(MEDICAL_SIMD_AVX2)
+    for (; i + 16 <= count; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_max_epu16(a, b));
+    }
+#endif
+#if defined(MEDICAL_SIMD_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+#if defined(MEDICAL_SIMD_SSE41)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_max_epu16(a, b));
+#else
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_max_epi16(a, b)); // exact below 0x8000
+#endif
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = std::max(dst[i], src[i]);
+    }
+}
+
+// Largest value in a row
+inline uint16_t maxOf(const uint16_t* src, size_t count) {
+    size_t i = 0;
+    uint16_t best = 0;
+#if defined(MEDICAL_SIMD_SSE2)
+    if (count >= 8) {
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 8 <= count; i += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+#if defined(MEDICAL_SIMD_SSE41)
+            acc = _mm_max_epu16(acc, v);
+#else
+            acc = _mm_max_epi16(acc, v);
+#endif
+        }
+        alignas(16) uint16_t lanes[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        best = *std::max_element(lanes, lanes + 8);
+    }
+#endif
+    for (; i < count; ++i) {
+        best = std::max(best, src[i]);
+    }
+    return best;
+}
+
+} // namespace
+
+ScanVolume::ScanVolume() : phantom(Phantom::FULL_BODY), size(0), seed(0) {}
+
+void ScanVolume::allocate(Phantom newPhantom, uint32_t newSize, uint32_t newSeed) {
+    phantom = newPhantom;
+    size = newSize;
+    seed = newSeed;
+    voxels.assign(static_cast<size_t>(newSize) * newSize * newSize, 0);
+}
+
+void ScanVolume::generateSlices(uint32_t zBegin, uint32_t zEnd, WorkerPool& workers) {
+    zEnd = std::min(zEnd, size);
+    if (zBegin >= zEnd) {
+        return;
+    }
+
+    const float scale = 2.0f / static_cast<float>(size);
+    workers.parallelFor(zEnd - zBegin, 1, [this, zBegin, scale](size_t begin, size_t end) {
+        for (size_t zi = begin; zi < end; ++zi) {
+            uint32_t z = zBegin + static_cast<uint32_t>(zi);
+            float w = (static_cast<float>(z) + 0.5f) * scale - 1.0f;
+            for (uint32_t y = 0; y < size; ++y) {
+                float v = (static_cast<float>(y) + 0.5f) * scale - 1.0f;
+                uint16_t* row = voxels.data() + (static_cast<size_t>(z) * size + y) * size;
+                for (uint32_t x = 0; x < size; ++x) {
+                    float u = (static_cast<float>(x) + 0.5f) * scale - 1.0f;
+                    float value = samplePhantom(phantom, u, v, w, seed);
+                    if (value > 0.0f) {
+                        // Acquisition noise on everything but air
+                        value += static_cast<float>(hash3(static_cast<int32_t>(x), static_cast<int32_t>(y),
+                                                          static_cast<int32_t>(z), seed) & 63) - 32.0f;
+                    }
+                    row[x] = static_cast<uint16_t>(std::min(std::max(value, 0.0f), static_cast<float>(kMaxIntensity)));
+                }
+            }
+        }
+    });
+}
+
+void ScanVolume::generate(Phantom newPhantom, uint32_t newSize, uint32_t newSeed, WorkerPool& workers) {
+    allocate(newPhantom, newSize, newSeed);
+    generateSlices(0, newSize, workers);
+}
+
+ScanImageHandle ScanVolume::renderSlice(Axis axis, uint32_t index, ScanBufferPool& pool, WorkerPool& workers) const {
+    if (size == 0) {
+        return nullptr;
+    }
+
+    index = std::min(index, size - 1);
+    ScanBufferPool::Buffer buffer = pool.acquire(size, size);
+    uint16_t* out = buffer.pixels16();
+    const size_t plane = static_cast<size_t>(size) * size;
+
+    switch (axis) {
+        case Axis::AXIAL:
+            // Rows are y, already contiguous in memory
+            std::memcpy(out, voxels.data() + index * plane, plane * sizeof(uint16_t));
+            break;
+
+        case Axis::CORONAL:
+            workers.parallelFor(size, kRowGrain, [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    size_t z = size - 1 - row;
+                    std::memcpy(out + row * size, voxels.data() + z * plane + static_cast<size_t>(index) * size,
+                                size * sizeof(uint16_t));
+                }
+            });
+            break;
+
+        case Axis::SAGITTAL:
+            // Columns are y, gathered with a stride of one voxel row
+            workers.parallelFor(size, kRowGrain, [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    const uint16_t* src = voxels.data() + (size - 1 - row) * plane + index;
+                    uint16_t* dst = out + row * size;
+                    for (uint32_t y = 0; y < size; ++y) {
+                        dst[y] = src[static_cast<size_t>(y) * size];
+                    }
+                }
+            });
+            break;
+    }
+
+    return pool.publish(std::move(buffer));
+}
+
+ScanImageHandle ScanVolume::renderMip(Axis axis, ScanBufferPool& pool, WorkerPool& workers) const {
+    if (size == 0) {
+        return nullptr;
+    }
+
+    ScanBufferPool::Buffer buffer = pool.acquire(size, size);
+    uint16_t* out = buffer.pixels16();
+    const size_t plane = static_cast<size_t>(size) * size;
+
+    switch (axis) {
+        case Axis::AXIAL:
+            // Each tile of output rows sweeps every slice; the rows it reads are contiguous
+            workers.parallelFor(size, kRowGrain, [&](size_t begin, size_t end) {
+                uint16_t* tile = out + begin * size;
+                size_t tileVoxels = (end - begin) * size;
+                std::memset(tile, 0, tileVoxels * sizeof(uint16_t));
+                for (size_t z = 0; z < size; ++z) {
+                    maxInto(tile, voxels.data() + z * plane + begin * size, tileVoxels);
+                }
+            });
+            break;
+
+        case Axis::CORONAL:
+            workers.parallelFor(size, kRowGrain, [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    uint16_t* dst = out + row * size;
+                    const uint16_t* slice = voxels.data() + (size - 1 - row) * plane;
+                    std::memset(dst, 0, size * sizeof(uint16_t));
+                    for (size_t y = 0; y < size; ++y) {
+                        maxInto(dst, slice + y * size, size);
+                    }
+                }
+            });
+            break;
+
+        case Axis::SAGITTAL:
+            workers.parallelFor(size, kRowGrain, [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    uint16_t* dst = out + row * size;
+                    const uint16_t* slice = voxels.data() + (size - 1 - row) * plane;
+                    for (size_t y = 0; y < size; ++y) {
+                        dst[y] = maxOf(slice + y * size, size);
+                    }
+                }
+            });
+            break;
+    }
+
+    return pool.publish(std::move(buffer));
+}
+
+ScanVolume::Phantom ScanVolume::phantomFromName(const std::string& scanType) {
+    if (scanType == "brain") {
+        return Phantom::BRAIN;
+    }
+    if (scanType == "heart") {
+        return Phantom::HEART;
+    }
+    if (scanType == "lungs") {
+        return Phantom::LUNGS;
+    }
+    return Phantom::FULL_BODY;
+}
@@ -0,0 +1,79 @@
+#ifndef SCAN_VOLUME_H
+#define SCAN_VOLUME_H
+
+#include "scan_buffer_pool.h"
+#include "simd_config.h"
+#include "worker_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class ScanVolume
+ * @brief Procedural voxel phantom for training scans, with slicing and MIP
+ *
+ * Voxels are 16-bit intensities on a cubic grid, x fastest and z slowest,
+ * so an axial slice is one contiguous plane. Phantoms combine analytic
+ * organ shapes with lattice noise and are deterministic for a given seed.
+ * Slices and maximum-intensity projections are rendered into pooled
+ * ScanImages in parallel tiles; rendered images are oriented with the head
+ * (highest z) at the top.
+ */
+class ScanVolume {
+public:
+    enum class Phantom : uint8_t { FULL_BODY, BRAIN, HEART, LUNGS };
+    enum class Axis : uint8_t { AXIAL, CORONAL, SAGITTAL };
+
+    // Intensities stay within 12 bits, so signed 16-bit SIMD max is exact
+    static constexpr uint16_t kMaxIntensity = 4095;
+    static constexpr uint32_t kDefaultSize = 256;
+
+    ScanVolume();
+
+    /**
+     * Sizes the grid and selects the phantom without filling any voxels
+     * @param size Voxels along each edge
+     * @param seed Varies the noise texture between scans
+     */
+    void allocate(Phantom phantom, uint32_t size, uint32_t seed);
+
+    /**
+     * Fills axial slices [zBegin, zEnd); lets a scan job report progress
+     * and stop between slabs
+     */
+    void generateSlices(uint32_t zBegin, uint32_t zEnd, WorkerPool& workers = WorkerPool::shared());
+
+    // allocate() followed by generateSlices() over the whole grid
+    void generate(Phantom phantom, uint32_t size, uint32_t seed, WorkerPool& workers = WorkerPool::shared());
+
+    /**
+     * Renders one plane of the volume
+     * @param index Slice position along the axis, clamped to the grid
+     */
+    ScanImageHandle renderSlice(Axis axis, uint32_t index, ScanBufferPool& pool = ScanBufferPool::shared(),
+                                WorkerPool& workers = WorkerPool::shared()) const;
+
+    // Maximum-intensity projection along an axis
+    ScanImageHandle renderMip(Axis axis, ScanBufferPool& pool = ScanBufferPool::shared(),
+                              WorkerPool& workers = WorkerPool::shared()) const;
+
+    Phantom getPhantom() const { return phantom; }
+    uint32_t getSize() const { return size; }
+    uint32_t getSeed() const { return seed; }
+    size_t getByteSize() const { return voxels.size() * sizeof(uint16_t); }
+    const uint16_t* data() const { return voxels.data(); }
+    uint16_t at(uint32_t x, uint32_t y, uint32_t z) const {
+        return voxels[(static_cast<size_t>(z) * size + y) * size + x];
+    }
+
+    // Maps a scan type name ("brain", "heart", ...) to its phantom; unknown names give FULL_BODY
+    static Phantom phantomFromName(const std::string& scanType);
+
+private:
+    Phantom phantom;
+    uint32_t size;
+    uint32_t seed;
+    SimdVector<uint16_t> voxels;
+};
+
+#endif // SCAN_VOLUME_H
@@ -0,0 +1,53 @@
+#ifndef SIMD_CONFIG_H
+#define SIMD_CONFIG_H
+
+// Instruction sets available to the vectorized medical kernels. AVX2 is
+// opt-in through the MEDICAL_ENABLE_AVX2 CMake option; SSE2 is baseline on
+// x86-64. Every kernel keeps a scalar path for other targets (e.g. arm64).
+#if defined(__AVX2__)
+#define MEDICAL_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MEDICAL_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSE4_1__) || defined(MEDICAL_SIMD_AVX2)
+#define MEDICAL_SIMD_SSE41 1
+#include <smmintrin.h>
+#endif
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Cache-line aligned allocator for structure-of-arrays lanes
+template <typename T>
+struct SimdAllocator {
+    using value_type = T;
+    static constexpr size_t kAlignment = 64;
+
+    SimdAllocator() = default;
+    template <typename U>
+    SimdAllocator(const SimdAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(kAlignment)));
+    }
+
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, std::align_val_t(kAlignment));
+    }
+
+    template <typename U>
+    bool operator==(const SimdAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const SimdAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using SimdVector = std::vector<T, SimdAllocator<T>>;
+
+#endif // SIMD_CONFIG_H
@@ -1,18 +1,25 @@
 #include "surgical_bed.h"
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 using namespace godot;
 
 SurgicalBed::SurgicalBed() : sterileMode(false), procedureInProgress(false), 
-                            maxSurgicalHeight(120.0f), minSurgicalHeight(70.0f), currentProcedure("") {
+                            maxSurgicalHeight(120.0f), minSurgicalHeight(70.0f), currentProcedure(""),
+                            scanWindowCenter((ScanVolume::kMaxIntensity + 1) / 2.0f),
+                            scanWindowWidth(ScanVolume::kMaxIntensity + 1.0f) {
     // Set surgical bed specific height ranges
     minHeight = 60.0f;   // Higher minimum for surgical procedures
     maxHeight = 120.0f;  // Higher maximum for surgeon access
-    currentHeight = 85.0f; // Optimal surgical default
+    heightActuator.setRange(minHeight, maxHeight);
+    heightActuator.reset(85.0f); // Optimal surgical default
     
     initializeSurgicalSystems();
     
-    UtilityFunctions::print("SurgicalBed created with advanced medical systems");
+    DEVICE_LOG_INFO("SurgicalBed created with advanced medical systems");
 }
 
 std::string SurgicalBed::getClassName() const {
@@ -22,30 +29,37 @@ std::string SurgicalBed::getClassName() const {
 void SurgicalBed::initializeSurgicalSystems() {
     // Initialize medical device
     medicalDevice = std::make_unique<ScannerDevice>();
+    medicalDevice->addVitalObserver(this);
+    medicalDevice->addScanObserver(this);
     
-    UtilityFunctions::print("🏥 Surgical systems initialized");
+    DEVICE_LOG_INFO("🏥 Surgical systems initialized");
 }
 
 void SurgicalBed::enterSterileMode() {
     if (!isPoweredOn) {
-        UtilityFunctions::print("Cannot enter sterile mode - bed is powered off");
+        DEVICE_LOG_DEBUG("Cannot enter sterile mode - bed is powered off");
         return;
     }
     
     sterileMode = true;
-    UtilityFunctions::print("🔬 STERILE MODE ACTIVATED");
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_DEVICE);
+    markChanged(BedChange::STERILE_MODE);
+    DEVICE_LOG_INFO("🔬 STERILE MODE ACTIVATED");
     
     setupSterileEnvironment();
 }
 
 void SurgicalBed::exitSterileMode() {
     sterileMode = false;
-    UtilityFunctions::print("🔬 Sterile mode deactivated");
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_DEVICE);
+    markChanged(BedChange::STERILE_MODE);
+    DEVICE_LOG_INFO("🔬 Sterile mode deactivated");
     
     // Return to normal settings
     if (lightStrip) {
         lightStrip->setBrightness(0.5f);
         lightStrip->setColor(LightColor(255, 255, 255));
+        markChanged(BedChange::LIGHTS);
     }
 }
 
@@ -54,28 +68,31 @@ void SurgicalBed::setupSterileEnvironment() {
     if (lightStrip) {
         lightStrip->setBrightness(0.9f); // Bright lighting for precision
         lightStrip->setColor(LightColor(255, 255, 255)); // Pure white light
+        markChanged(BedChange::LIGHTS);
     }
     
     // Set cool temperature for sterile environment
     setTemperature(TemperatureControl::Mode::COLD);
     
-    UtilityFunctions::print("✨ Sterile environment configured");
+    DEVICE_LOG_INFO("✨ Sterile environment configured");
 }
 
 void SurgicalBed::startProcedure(const String& procedureType) {
     if (!isPoweredOn) {
-        UtilityFunctions::print("Cannot start procedure - bed is powered off");
+        DEVICE_LOG_INFO("Cannot start procedure - bed is powered off");
         return;
     }
     
     if (!sterileMode) {
-        UtilityFunctions::print("⚠️  WARNING: Starting procedure without sterile mode!");
+        DEVICE_LOG_ALERT("⚠️  WARNING: Starting procedure without sterile mode!");
     }
     
     procedureInProgress = true;
     currentProcedure = std::string(procedureType.utf8().get_data());
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_DEVICE);
+    markChanged(BedChange::PROCEDURE);
     
-    UtilityFunctions::print("🏥 Starting surgical procedure: ", procedureType);
+    DEVICE_LOG_INFO("🏥 Starting surgical procedure: {}", procedureType.utf8().get_data());
     
     validateProcedureRequirements(procedureType);
     adjustForProcedure(procedureType);
@@ -83,24 +100,28 @@ void SurgicalBed::startProcedure(const String& procedureType) {
     // Start vital monitoring during procedure
     if (medicalDevice) {
         medicalDevice->startVitalMonitoring();
+        markChanged(BedChange::VITALS);
     }
 }
 
 void SurgicalBed::endProcedure() {
     if (!procedureInProgress) {
-        UtilityFunctions::print("No active procedure to end");
+        DEVICE_LOG_INFO("No active procedure to end");
         return;
     }
     
-    UtilityFunctions::print("✅ Ending surgical procedure: ", currentProcedure.c_str());
+    DEVICE_LOG_INFO("✅ Ending surgical procedure: {}", currentProcedure);
     
     procedureInProgress = false;
     currentProcedure = "";
+    markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_DEVICE);
+    markChanged(BedChange::PROCEDURE);
     
     // Stop monitoring
     if (medicalDevice) {
         medicalDevice->stopVitalMonitoring();
         medicalDevice->stopScan();
+        markChanged(BedChange::VITALS | BedChange::SCANNER);
     }
     
     // Return to default settings
@@ -111,33 +132,343 @@ void SurgicalBed::endProcedure() {
 // Medical device operations
 void SurgicalBed::startFullBodyScan() {
     if (medicalDevice) {
-        UtilityFunctions::print("🔍 Initiating full body scan...");
+        DEVICE_LOG_INFO("🔍 Initiating full body scan...");
         medicalDevice->startFullBodyScan();
+        set_process(medicalDevice->isScannerBusy());
+        markChanged(BedChange::SCANNER);
     }
 }
 
 void SurgicalBed::startBrainScan() {
     if (medicalDevice) {
-        UtilityFunctions::print("🧠 Initiating brain scan...");
+        DEVICE_LOG_INFO("🧠 Initiating brain scan...");
         medicalDevice->startBrainScan();
+        set_process(medicalDevice->isScannerBusy());
+        markChanged(BedChange::SCANNER);
     }
 }
 
+void SurgicalBed::startHeartScan() {
+    if (medicalDevice) {
+        DEVICE_LOG_INFO("🫀 Initiating heart scan...");
+        medicalDevice->startHeartScan();
+        set_process(medicalDevice->isScannerBusy());
+        markChanged(BedChange::SCANNER);
+    }
+}
+
+void SurgicalBed::startLungScan() {
+    if (medicalDevice) {
+        DEVICE_LOG_INFO("🫁 Initiating lung scan...");
+        medicalDevice->startLungScan();
+        set_process(medicalDevice->isScannerBusy());
+        markChanged(BedChange::SCANNER);
+    }
+}
+
+bool SurgicalBed::startEmergencyScan(const String& scanType) {
+    if (!medicalDevice) {
+        return false;
+    }
+    
+    Scanner::ScanType type;
+    if (!Scanner::getScanTypeFromName(scanType.utf8().get_data(), type)) {
+        DEVICE_LOG_ALERT("❌ Unknown scan type for emergency scan: {}", scanType.utf8().get_data());
+        return false;
+    }
+    
+    DEVICE_LOG_ALERT("🚨 Requesting emergency {} scan", scanType.utf8().get_data());
+    medicalDevice->startEmergencyScan(type);
+    set_process(true);
+    markChanged(BedChange::SCANNER);
+    return true;
+}
+
 void SurgicalBed::stopScanning() {
     if (medicalDevice) {
         medicalDevice->stopScan();
+        markChanged(BedChange::SCANNER);
+    }
+}
+
+int SurgicalBed::getScanQueuePosition() const {
+    return medicalDevice ? medicalDevice->getScanQueuePosition() : -1;
+}
+
+void SurgicalBed::setScanSuiteSize(int scanners) {
+    ScanScheduler::shared().setScannerCount(static_cast<size_t>(std::max(1, scanners)));
+}
+
+Dictionary SurgicalBed::getScanSchedulerStats() const {
+    ScanScheduler::Stats stats = ScanScheduler::shared().getStats();
+    Dictionary result;
+    result["scanner_count"] = static_cast<int64_t>(stats.scannerCount);
+    result["running"] = static_cast<int64_t>(stats.running);
+    result["queue_depth"] = static_cast<int64_t>(stats.queueDepth);
+    result["queued_emergency"] = static_cast<int64_t>(stats.queuedByPriority[static_cast<size_t>(ScanScheduler::Priority::EMERGENCY)]);
+    result["queued_urgent"] = static_cast<int64_t>(stats.queuedByPriority[static_cast<size_t>(ScanScheduler::Priority::URGENT)]);
+    result["queued_routine"] = static_cast<int64_t>(stats.queuedByPriority[static_cast<size_t>(ScanScheduler::Priority::ROUTINE)]);
+    result["submitted"] = static_cast<int64_t>(stats.submitted);
+    result["completed"] = static_cast<int64_t>(stats.completed);
+    result["failed"] = static_cast<int64_t>(stats.failed);
+    result["cancelled"] = static_cast<int64_t>(stats.cancelled);
+    result["preemptions"] = static_cast<int64_t>(stats.preemptions);
+    result["average_wait_usec"] = stats.averageWaitUs;
+    result["max_wait_usec"] = stats.maxWaitUs;
+    result["oldest_wait_usec"] = stats.oldestWaitUs;
+    result["utilization"] = stats.utilization;
+    return result;
+}
+
+float SurgicalBed::getScanProgress() const {
+    return medicalDevice ? medicalDevice->getScanProgress() : 0.0f;
+}
+
+bool SurgicalBed::isScanning() const {
+    return medicalDevice && medicalDevice->isScannerBusy();
+}
+
+PackedByteArray SurgicalBed::getScanPixels(const String& scanType) {
+    std::string key = scanType.utf8().get_data();
+    ScanImageHandle image = medicalDevice ? medicalDevice->getStoredScanImage(key) : nullptr;
+    if (!image) {
+        return PackedByteArray();
+    }
+    
+    // godot-cpp cannot wrap foreign memory, so copy once into Godot's buffer
+    // and hand out copy-on-write references to it afterwards
+    ExportedScan& exported = exportedScans[key];
+    if (exported.image != image) {
+        exported.pixels.resize(static_cast<int64_t>(image->getByteSize()));
+        std::memcpy(exported.pixels.ptrw(), image->data(), image->getByteSize());
+        ScanBufferPool::shared().recordCopy(image->getByteSize());
+        exported.image = image;
+    }
+    return exported.pixels;
+}
+
+Ref<Image> SurgicalBed::getScanImage(const String& scanType) {
+    return copyScanImage(medicalDevice ? medicalDevice->getStoredScanImage(scanType.utf8().get_data()) : nullptr);
+}
+
+void SurgicalBed::setScanWindow(float center, float width) {
+    if (!std::isfinite(center) || !std::isfinite(width) || width <= 0.0f) {
+        DEVICE_LOG_INFO("❌ Scan window needs a finite center and a positive width");
+        return;
+    }
+    scanWindowCenter = center;
+    scanWindowWidth = width;
+}
+
+Dictionary SurgicalBed::getScanBufferStats() const {
+    ScanBufferPool::Stats stats = ScanBufferPool::shared().getStats();
+    Dictionary result;
+    result["allocations"] = static_cast<int64_t>(stats.allocations);
+    result["reuses"] = static_cast<int64_t>(stats.reuses);
+    result["bytes_copied"] = static_cast<int64_t>(stats.bytesCopied);
+    result["pooled_bytes"] = static_cast<int64_t>(stats.pooledBytes);
+    return result;
+}
+
+void SurgicalBed::setPatientId(const String& id) {
+    if (medicalDevice) {
+        medicalDevice->setPatientId(id.utf8().get_data());
+        markChanged(BedChange::PROCEDURE);
+    }
+}
+
+String SurgicalBed::getPatientId() const {
+    return medicalDevice ? String(medicalDevice->getPatientId().c_str()) : String();
+}
+
+int64_t SurgicalBed::getLastScanTimestamp(const String& scanType) const {
+    int64_t timestampUs = 0;
+    if (medicalDevice) {
+        medicalDevice->getScanCache().getLatestTimestamp(medicalDevice->getPatientId(), scanType.utf8().get_data(),
+                                                         timestampUs);
+    }
+    return timestampUs;
+}
+
+Ref<Image> SurgicalBed::getScanImageAt(const String& scanType, int64_t timestampUsec) {
+    ScanImageHandle image = medicalDevice ? medicalDevice->getStoredScanImage(scanType.utf8().get_data(), timestampUsec)
+                                          : nullptr;
+    if (!image) {
+        return Ref<Image>();
+    }
+    
+    // Historical scans are fetched rarely, so they are copied on demand rather than kept exported
+    return copyScanImage(image);
+}
+
+Ref<Image> SurgicalBed::getScanSlice(const String& scanType, int axis, int index) {
+    std::shared_ptr<const ScanVolume> volume =
+        medicalDevice ? medicalDevice->getStoredScanVolume(scanType.utf8().get_data()) : nullptr;
+    if (!volume || axis < SCAN_AXIS_AXIAL || axis > SCAN_AXIS_SAGITTAL) {
+        return Ref<Image>();
+    }
+    return copyScanImage(volume->renderSlice(static_cast<ScanVolume::Axis>(axis),
+                                             static_cast<uint32_t>(std::max(0, index))));
+}
+
+Ref<Image> SurgicalBed::getScanMip(const String& scanType, int axis) {
+    std::shared_ptr<const ScanVolume> volume =
+        medicalDevice ? medicalDevice->getStoredScanVolume(scanType.utf8().get_data()) : nullptr;
+    if (!volume || axis < SCAN_AXIS_AXIAL || axis > SCAN_AXIS_SAGITTAL) {
+        return Ref<Image>();
+    }
+    return copyScanImage(volume->renderMip(static_cast<ScanVolume::Axis>(axis)));
+}
+
+int SurgicalBed::getScanVolumeSize(const String& scanType) {
+    std::shared_ptr<const ScanVolume> volume =
+        medicalDevice ? medicalDevice->getStoredScanVolume(scanType.utf8().get_data()) : nullptr;
+    return volume ? static_cast<int>(volume->getSize()) : 0;
+}
+
+Ref<Image> SurgicalBed::copyScanImage(const ScanImageHandle& image) const {
+    if (!image) {
+        return Ref<Image>();
+    }
+    
+    if (image->getBytesPerPixel() != 2) {
+        DEVICE_LOG_INFO("❌ Scan images must be 16-bit grayscale, got {} bytes per pixel", image->getBytesPerPixel());
+        return Ref<Image>();
+    }
+    
+    // Windowed down to 8-bit gray, so Godot shows intensities rather than the raw byte pairs
+    size_t pixelCount = static_cast<size_t>(image->getWidth()) * image->getHeight();
+    PackedByteArray gray;
+    gray.resize(static_cast<int64_t>(pixelCount));
+    image->windowToGray8(scanWindowCenter, scanWindowWidth, gray.ptrw());
+    ScanBufferPool::shared().recordCopy(pixelCount);
+    return Image::create_from_data(static_cast<int>(image->getWidth()), static_cast<int>(image->getHeight()),
+                                   false, Image::FORMAT_L8, gray);
+}
+
+void SurgicalBed::setScanCacheBudget(int64_t bytes) {
+    if (medicalDevice) {
+        medicalDevice->getScanCache().setByteBudget(static_cast<size_t>(std::max<int64_t>(0, bytes)));
+    }
+}
+
+void SurgicalBed::setScanSpillDirectory(const String& path) {
+    if (!medicalDevice) {
+        return;
+    }
+    
+    String directory = path.is_empty() ? String() : ProjectSettings::get_singleton()->globalize_path(path);
+    medicalDevice->getScanCache().setSpillDirectory(directory.utf8().get_data());
+}
+
+void SurgicalBed::clearScanCache() {
+    exportedScans.clear();
+    if (medicalDevice) {
+        medicalDevice->getScanCache().clear();
+    }
+}
+
+Dictionary SurgicalBed::getScanCacheStats() const {
+    Dictionary result;
+    if (!medicalDevice) {
+        return result;
+    }
+    
+    ScanCache::Stats stats = medicalDevice->getScanCache().getStats();
+    result["hits"] = static_cast<int64_t>(stats.hits);
+    result["misses"] = static_cast<int64_t>(stats.misses);
+    result["evictions"] = static_cast<int64_t>(stats.evictions);
+    result["spills"] = static_cast<int64_t>(stats.spills);
+    result["spill_reloads"] = static_cast<int64_t>(stats.spillReloads);
+    result["bytes_used"] = static_cast<int64_t>(stats.bytesUsed);
+    result["byte_budget"] = static_cast<int64_t>(stats.byteBudget);
+    result["entry_count"] = static_cast<int64_t>(stats.entryCount);
+    result["spilled_count"] = static_cast<int64_t>(stats.spilledCount);
+    return result;
+}
+
+bool SurgicalBed::saveScanTiles(const String& scanType, const String& path) {
+    if (!medicalDevice) {
+        return false;
+    }
+    
+    String filePath = ProjectSettings::get_singleton()->globalize_path(path);
+    return medicalDevice->saveScanTiles(scanType.utf8().get_data(), filePath.utf8().get_data());
+}
+
+Ref<Image> SurgicalBed::loadScanTiles(const String& path) {
+    if (!medicalDevice) {
+        return Ref<Image>();
+    }
+    
+    String filePath = ProjectSettings::get_singleton()->globalize_path(path);
+    Ref<Image> coarse = copyScanImage(medicalDevice->beginTiledLoad(filePath.utf8().get_data()));
+    if (coarse.is_valid()) {
+        set_process(true);
+    }
+    return coarse;
+}
+
+void SurgicalBed::cancelScanTileLoad() {
+    if (medicalDevice) {
+        medicalDevice->cancelTiledLoad();
+    }
+}
+
+Dictionary SurgicalBed::getScanTileLoadStatus() const {
+    Dictionary result;
+    if (!medicalDevice) {
+        return result;
+    }
+    
+    const ScanTileStream& stream = medicalDevice->getTileStream();
+    result["width"] = static_cast<int64_t>(stream.getWidth());
+    result["height"] = static_cast<int64_t>(stream.getHeight());
+    result["level_count"] = static_cast<int64_t>(stream.getLevelCount());
+    result["tiles_total"] = static_cast<int64_t>(stream.getTilesTotal());
+    result["tiles_loaded"] = static_cast<int64_t>(stream.getTilesDelivered() - stream.getTilesFailed());
+    result["tiles_failed"] = static_cast<int64_t>(stream.getTilesFailed());
+    result["loading"] = medicalDevice->isLoadingScanTiles();
+    return result;
+}
+
+void SurgicalBed::_process(double delta) {
+    // Scans and tile decodes run on worker threads; results are delivered here, on the main thread
+    if (medicalDevice) {
+        medicalDevice->pollScanner();
+        medicalDevice->pollScanTiles([this](const ScanTileStream::TileUpdate& tile) {
+            // Corrupt tiles are reported, so GDScript knows the region stays at the coarser level
+            if (!tile.pixels) {
+                emit_signal("scan_tile_failed", static_cast<int>(tile.level), static_cast<int>(tile.x),
+                            static_cast<int>(tile.y));
+                return;
+            }
+            emit_signal("scan_tile_loaded", static_cast<int>(tile.level), static_cast<int>(tile.x),
+                        static_cast<int>(tile.y), copyScanImage(tile.pixels));
+        }, kScanTilesPerFrame);
+        
+        // Progress moves every frame a scan runs
+        if (medicalDevice->isScannerBusy()) {
+            markChanged(BedChange::SCANNER);
+        }
+    }
+    processBedSystems(delta);
+    if (!isScanning() && !(medicalDevice && medicalDevice->isLoadingScanTiles()) && !needsBedProcessing()) {
+        set_process(false);
     }
 }
 
 void SurgicalBed::startVitalMonitoring() {
     if (medicalDevice) {
         medicalDevice->startVitalMonitoring();
+        markChanged(BedChange::VITALS);
     }
 }
 
 void SurgicalBed::stopVitalMonitoring() {
     if (medicalDevice) {
         medicalDevice->stopVitalMonitoring();
+        markChanged(BedChange::VITALS);
     }
 }
 
@@ -147,32 +478,118 @@ void SurgicalBed::updatePatientVitals() {
     }
 }
 
+Dictionary SurgicalBed::getVitalStatistics(int window) const {
+    Dictionary result;
+    if (!medicalDevice) {
+        return result;
+    }
+    
+    size_t samples = static_cast<size_t>(std::max(0, window));
+    int64_t sampleCount = 0;
+    for (size_t i = 0; i < VitalSignsHistory::kLaneCount; ++i) {
+        auto lane = static_cast<VitalSignsHistory::Lane>(i);
+        VitalSignsHistory::WindowStats stats = medicalDevice->getVitalStatistics(lane, samples);
+        
+        Dictionary laneStats;
+        laneStats["min"] = stats.min;
+        laneStats["max"] = stats.max;
+        laneStats["mean"] = stats.mean;
+        laneStats["stddev"] = stats.stddev;
+        result[VitalSignsHistory::getLaneName(lane)] = laneStats;
+        sampleCount = static_cast<int64_t>(stats.sampleCount);
+    }
+    result["sample_count"] = sampleCount;
+    return result;
+}
+
+bool SurgicalBed::startVitalRecording(const String& path) {
+    if (!medicalDevice) {
+        return false;
+    }
+    
+    // Accept res:// and user:// paths as well as plain file system paths
+    String filePath = ProjectSettings::get_singleton()->globalize_path(path);
+    return medicalDevice->startVitalRecording(filePath.utf8().get_data());
+}
+
+void SurgicalBed::stopVitalRecording() {
+    if (medicalDevice) {
+        medicalDevice->stopVitalRecording();
+    }
+}
+
+bool SurgicalBed::isRecordingVitals() const {
+    return medicalDevice && medicalDevice->isRecordingVitals();
+}
+
+bool SurgicalBed::startVitalReplay(const String& path, double speed) {
+    if (!medicalDevice) {
+        return false;
+    }
+    
+    String filePath = ProjectSettings::get_singleton()->globalize_path(path);
+    return medicalDevice->startVitalReplay(filePath.utf8().get_data(), speed);
+}
+
+void SurgicalBed::stopVitalReplay() {
+    if (medicalDevice) {
+        medicalDevice->stopVitalReplay();
+    }
+}
+
+bool SurgicalBed::seekVitalReplay(int64_t timestampUsec) {
+    VitalsReplaySource* replay = medicalDevice ? medicalDevice->getVitalReplay() : nullptr;
+    return replay && replay->getReplay().seek(timestampUsec);
+}
+
+Dictionary SurgicalBed::getVitalReplayStatus() const {
+    Dictionary result;
+    const VitalsReplaySource* replay = medicalDevice ? medicalDevice->getVitalReplay() : nullptr;
+    result["active"] = replay != nullptr;
+    if (!replay) {
+        return result;
+    }
+    
+    const VitalsReplay& cursor = replay->getReplay();
+    result["speed"] = cursor.getSpeed();
+    result["start_usec"] = cursor.getStartTimestamp();
+    result["playhead_usec"] = cursor.getPlayhead();
+    result["sample_index"] = static_cast<int64_t>(cursor.getSampleIndex());
+    result["sample_count"] = static_cast<int64_t>(cursor.getSampleCount());
+    result["finished"] = cursor.isFinished();
+    return result;
+}
+
 // Device positioning
 void SurgicalBed::swivelDeviceLeft(float angle) {
     if (medicalDevice) {
         medicalDevice->swivelLeft(angle);
+        markChanged(BedChange::DEVICE_POSITION);
     }
 }
 
 void SurgicalBed::swivelDeviceRight(float angle) {
     if (medicalDevice) {
         medicalDevice->swivelRight(angle);
+        markChanged(BedChange::DEVICE_POSITION);
     }
 }
 
 void SurgicalBed::centerDevice() {
     if (medicalDevice) {
         medicalDevice->centerDevice();
-        UtilityFunctions::print("Medical device centered for procedure");
+        markChanged(BedChange::DEVICE_POSITION);
+        DEVICE_LOG_DEBUG("Medical device centered for procedure");
     }
 }
 
 void SurgicalBed::positionForPatientAccess() {
-    UtilityFunctions::print("🚶 Positioning for patient access...");
+    DEVICE_LOG_INFO("🚶 Positioning for patient access...");
     
     // Move device out of the way
     if (medicalDevice) {
         medicalDevice->swivelRight(90.0f);
+        markChanged(BedChange::DEVICE_POSITION);
     }
     
     // Lower bed for easy access
@@ -180,7 +597,7 @@ void SurgicalBed::positionForPatientAccess() {
 }
 
 void SurgicalBed::positionForProcedure() {
-    UtilityFunctions::print("🏥 Positioning for surgical procedure...");
+    DEVICE_LOG_INFO("🏥 Positioning for surgical procedure...");
     
     // Center device over patient
     centerDevice();
@@ -193,17 +610,17 @@ void SurgicalBed::positionForProcedure() {
 void SurgicalBed::setToSurgicalHeight() {
     float optimalHeight = 100.0f; // Optimal height for surgeon access
     setHeight(optimalHeight);
-    UtilityFunctions::print("⚕️  Set to surgical height: ", optimalHeight, " cm");
+    DEVICE_LOG_DEBUG("⚕️  Set to surgical height: {} cm", optimalHeight);
 }
 
 void SurgicalBed::setToTransferHeight() {
     float transferHeight = 75.0f; // Height for patient transfer
     setHeight(transferHeight);
-    UtilityFunctions::print("🏨 Set to transfer height: ", transferHeight, " cm");
+    DEVICE_LOG_DEBUG("🏨 Set to transfer height: {} cm", transferHeight);
 }
 
 void SurgicalBed::adjustForProcedure(const String& procedureType) {
-    UtilityFunctions::print("⚙️  Adjusting bed configuration for: ", procedureType);
+    DEVICE_LOG_DEBUG("⚙️  Adjusting bed configuration for: {}", procedureType.utf8().get_data());
     
     std::string procedure = std::string(procedureType.utf8().get_data());
     
@@ -216,7 +633,7 @@ void SurgicalBed::adjustForProcedure(const String& procedureType) {
     } else if (procedure == "general_surgery") {
         setHeight(100.0f);
     } else {
-        UtilityFunctions::print("Using default surgical configuration");
+        DEVICE_LOG_DEBUG("Using default surgical configuration");
         setToSurgicalHeight();
     }
     
@@ -225,7 +642,7 @@ void SurgicalBed::adjustForProcedure(const String& procedureType) {
 
 // Emergency procedures
 void SurgicalBed::triggerSurgicalEmergency() {
-    UtilityFunctions::print("🚨 SURGICAL EMERGENCY TRIGGERED!");
+    DEVICE_LOG_ALERT("🚨 SURGICAL EMERGENCY TRIGGERED!");
     
     // Activate emergency lighting
     triggerEmergency();
@@ -235,7 +652,7 @@ void SurgicalBed::triggerSurgicalEmergency() {
 }
 
 void SurgicalBed::activateEmergencyProtocols() {
-    UtilityFunctions::print("🚨 Activating emergency protocols...");
+    DEVICE_LOG_ALERT("🚨 Activating emergency protocols...");
     
     // Position for emergency access
     positionForPatientAccess();
@@ -243,66 +660,118 @@ void SurgicalBed::activateEmergencyProtocols() {
     // Start continuous vital monitoring
     if (medicalDevice) {
         medicalDevice->startVitalMonitoring();
+        markChanged(BedChange::VITALS);
     }
     
+    // Emergency trauma scan, ahead of (and if need be preempting) routine scans
+    startEmergencyScan("full_body");
+    
     // Set emergency lighting
     if (lightStrip) {
         lightStrip->activateEmergencyMode();
     }
     
-    UtilityFunctions::print("🚨 Emergency protocols active - all systems ready");
+    DEVICE_LOG_ALERT("🚨 Emergency protocols active - all systems ready");
 }
 
 // DeviceObserver implementation
 void SurgicalBed::onScanCompleted(const ScanData& data) {
-    UtilityFunctions::print("📊 Scan completed on surgical bed: ", data.scanType.c_str());
-    UtilityFunctions::print("📈 Scan quality: ", data.quality * 100, "%");
+    DEVICE_LOG_DEBUG("📊 Scan completed on surgical bed: {}", data.scanType);
+    DEVICE_LOG_DEBUG("📈 Scan quality: {}%", data.quality * 100);
+    markChanged(BedChange::SCANNER);
+    emit_signal("scan_completed", String(data.scanType.c_str()), data.quality);
 }
 
 void SurgicalBed::onVitalSignsUpdated(const VitalSigns& vitals) {
+    markChanged(BedChange::VITALS);
+    
     // Monitor for critical changes during procedures
     if (procedureInProgress) {
-        if (vitals.oxygenLevel < 95.0f || vitals.heartRate > 110.0f) {
-            UtilityFunctions::print("⚠️  ALERT: Vital signs require attention during procedure!");
+        static const VitalThresholds thresholds = VitalThresholds::defaults();
+        if (thresholds.evaluate(vitals) & VitalThresholds::ALERT_PROCEDURE) {
+            DEVICE_LOG_ALERT("⚠️  ALERT: Vital signs require attention during procedure!");
         }
     }
 }
 
 void SurgicalBed::onDeviceError(const String& error) {
-    UtilityFunctions::print("❌ Medical device error on surgical bed: ", error);
+    DEVICE_LOG_ALERT("❌ Medical device error on surgical bed: {}", error.utf8().get_data());
     
     if (procedureInProgress) {
-        UtilityFunctions::print("🚨 Device error during procedure - consider emergency protocols");
+        DEVICE_LOG_ALERT("🚨 Device error during procedure - consider emergency protocols");
     }
 }
 
 // Hook method implementations
-void SurgicalBed::performSpecificChecks() {
-    UtilityFunctions::print("Checking surgical systems...");
-    
-    // Check medical device
-    bool deviceOK = medicalDevice != nullptr;
-    UtilityFunctions::print("Medical device: ", deviceOK ? "OK" : "ERROR");
+// Positioning depends on the lift, so it is rechecked with the height subsystem
+void SurgicalBed::checkHeightMechanism(MaintenanceRecord& record) const {
+    Bed::checkHeightMechanism(record);
+    if (!isSurgicalPositioningValid()) {
+        record.faults |= MaintenanceRecord::FAULT_POSITIONING;
+    }
+}
+
+void SurgicalBed::performSpecificChecks(MaintenanceRecord& record) const {
+    // Surgical systems
+    if (!medicalDevice) {
+        record.faults |= MaintenanceRecord::FAULT_MEDICAL_DEVICE;
+    }
+    if (sterileMode) {
+        record.status |= MaintenanceRecord::STATUS_STERILE;
+    }
+    if (procedureInProgress) {
+        record.status |= MaintenanceRecord::STATUS_PROCEDURE;
+    }
+}
+
+void SurgicalBed::captureSnapshot(BedSnapshot& snapshot) const {
+    snapshot.set(BedSnapshot::STERILE, sterileMode);
+    snapshot.set(BedSnapshot::PROCEDURE, procedureInProgress);
+    BedSnapshot::setText(snapshot.procedure, sizeof(snapshot.procedure), currentProcedure);
     
-    // Check sterile mode capability
-    UtilityFunctions::print("Sterile mode: ", sterileMode ? "ACTIVE" : "INACTIVE");
+    if (medicalDevice) {
+        snapshot.set(BedSnapshot::MONITORING_VITALS, medicalDevice->isMonitoringVitals());
+        snapshot.set(BedSnapshot::SCANNING, medicalDevice->isScannerBusy());
+        snapshot.scanType = static_cast<uint8_t>(medicalDevice->getCurrentScanType());
+        snapshot.swivelAngle = medicalDevice->getSwivelAngle();
+        BedSnapshot::setText(snapshot.patientId, sizeof(snapshot.patientId), medicalDevice->getPatientId());
+    }
+}
+
+void SurgicalBed::applySnapshot(const BedSnapshot& snapshot) {
+    // Flags only: the saved lights and temperature already reflect sterile mode and the procedure
+    sterileMode = snapshot.has(BedSnapshot::STERILE);
+    procedureInProgress = snapshot.has(BedSnapshot::PROCEDURE);
+    currentProcedure = procedureInProgress ? BedSnapshot::getText(snapshot.procedure, sizeof(snapshot.procedure)) : "";
+    if (!medicalDevice) {
+        return;
+    }
     
-    // Check procedure status
-    if (procedureInProgress) {
-        UtilityFunctions::print("Active procedure: ", currentProcedure.c_str());
+    medicalDevice->setSwivelAngle(snapshot.swivelAngle);
+    medicalDevice->setPatientId(BedSnapshot::getText(snapshot.patientId, sizeof(snapshot.patientId)));
+    if (snapshot.has(BedSnapshot::MONITORING_VITALS)) {
+        medicalDevice->startVitalMonitoring();
+    } else {
+        medicalDevice->stopVitalMonitoring();
     }
     
-    // Check positioning system
-    bool positioningOK = isSurgicalPositioningValid();
-    UtilityFunctions::print("Positioning system: ", positioningOK ? "OK" : "ERROR");
+    // A scan in flight cannot resume where it was, so it is requested again
+    bool scanning = snapshot.has(BedSnapshot::SCANNING) &&
+                    snapshot.scanType <= static_cast<uint8_t>(Scanner::ScanType::LUNGS);
+    if (scanning && !medicalDevice->isScannerBusy()) {
+        medicalDevice->startScan(static_cast<Scanner::ScanType>(snapshot.scanType));
+        set_process(true);
+    } else if (!scanning && medicalDevice->isScannerBusy()) {
+        medicalDevice->stopScan();
+    }
 }
 
 void SurgicalBed::onPowerOn() {
-    UtilityFunctions::print("SurgicalBed advanced systems initializing...");
+    DEVICE_LOG_INFO("SurgicalBed advanced systems initializing...");
     
     // Initialize medical device
     if (medicalDevice) {
-        UtilityFunctions::print("Medical scanner and monitoring system online");
+        DEVICE_LOG_INFO("Medical scanner and monitoring system online");
     }
     
     // Set surgical defaults
@@ -314,17 +783,18 @@ void SurgicalBed::onPowerOn() {
 }
 
 void SurgicalBed::onPowerOff() {
-    UtilityFunctions::print("SurgicalBed systems shutting down...");
+    DEVICE_LOG_INFO("SurgicalBed systems shutting down...");
     
     // Safety checks before shutdown
     if (procedureInProgress) {
-        UtilityFunctions::print("⚠️  WARNING: Procedure in progress during shutdown!");
+        DEVICE_LOG_ALERT("⚠️  WARNING: Procedure in progress during shutdown!");
         endProcedure();
     }
     
     if (medicalDevice) {
         medicalDevice->stopVitalMonitoring();
         medicalDevice->stopScan();
+        markChanged(BedChange::VITALS | BedChange::SCANNER);
     }
     
     exitSterileMode();
@@ -334,6 +804,7 @@ void SurgicalBed::adjustLightingForProcedure() {
     if (lightStrip) {
         lightStrip->setBrightness(1.0f); // Maximum brightness for precision
         lightStrip->setColor(LightColor(255, 255, 255)); // Pure white light
+        markChanged(BedChange::LIGHTS);
     }
 }
 
@@ -343,24 +814,26 @@ void SurgicalBed::adjustTemperatureForProcedure() {
 }
 
 void SurgicalBed::validateProcedureRequirements(const String& procedureType) {
-    UtilityFunctions::print("✅ Validating requirements for: ", procedureType);
+    DEVICE_LOG_INFO("✅ Validating requirements for: {}", procedureType.utf8().get_data());
     
     // Check if bed is in sterile mode for surgery
     if (!sterileMode) {
-        UtilityFunctions::print("⚠️  Recommendation: Activate sterile mode for surgery");
+        DEVICE_LOG_ALERT("⚠️  Recommendation: Activate sterile mode for surgery");
     }
     
     // Check height is appropriate
     if (!isSurgicalPositioningValid()) {
-        UtilityFunctions::print("⚠️  Adjusting to optimal surgical height");
+        DEVICE_LOG_DEBUG("⚠️  Adjusting to optimal surgical height");
         setToSurgicalHeight();
     }
     
-    UtilityFunctions::print("✅ Procedure requirements validated");
+    DEVICE_LOG_INFO("✅ Procedure requirements validated");
 }
 
 bool SurgicalBed::isSurgicalPositioningValid() const {
-    return currentHeight >= minSurgicalHeight && currentHeight <= maxSurgicalHeight;
+    // Judged by where the lift is headed, so a bed already on its way is left alone
+    float height = getTargetHeight();
+    return height >= minSurgicalHeight && height <= maxSurgicalHeight;
 }
 
 void SurgicalBed::_bind_methods() {
@@ -373,10 +846,47 @@ void SurgicalBed::_bind_methods() {
     ClassDB::bind_method(D_METHOD("is_procedure_active"), &SurgicalBed::isProcedureActive);
     ClassDB::bind_method(D_METHOD("start_full_body_scan"), &SurgicalBed::startFullBodyScan);
     ClassDB::bind_method(D_METHOD("start_brain_scan"), &SurgicalBed::startBrainScan);
+    ClassDB::bind_method(D_METHOD("start_heart_scan"), &SurgicalBed::startHeartScan);
+    ClassDB::bind_method(D_METHOD("start_lung_scan"), &SurgicalBed::startLungScan);
+    ClassDB::bind_method(D_METHOD("start_emergency_scan", "scan_type"), &SurgicalBed::startEmergencyScan);
     ClassDB::bind_method(D_METHOD("stop_scanning"), &SurgicalBed::stopScanning);
+    ClassDB::bind_method(D_METHOD("get_scan_queue_position"), &SurgicalBed::getScanQueuePosition);
+    ClassDB::bind_method(D_METHOD("set_scan_suite_size", "scanners"), &SurgicalBed::setScanSuiteSize);
+    ClassDB::bind_method(D_METHOD("get_scan_scheduler_stats"), &SurgicalBed::getScanSchedulerStats);
+    ClassDB::bind_method(D_METHOD("get_scan_progress"), &SurgicalBed::getScanProgress);
+    ClassDB::bind_method(D_METHOD("is_scanning"), &SurgicalBed::isScanning);
+    ClassDB::bind_method(D_METHOD("get_scan_pixels", "scan_type"), &SurgicalBed::getScanPixels);
+    ClassDB::bind_method(D_METHOD("get_scan_image", "scan_type"), &SurgicalBed::getScanImage);
+    ClassDB::bind_method(D_METHOD("set_scan_window", "center", "width"), &SurgicalBed::setScanWindow);
+    ClassDB::bind_method(D_METHOD("get_scan_window_center"), &SurgicalBed::getScanWindowCenter);
+    ClassDB::bind_method(D_METHOD("get_scan_window_width"), &SurgicalBed::getScanWindowWidth);
+    ClassDB::bind_method(D_METHOD("get_scan_buffer_stats"), &SurgicalBed::getScanBufferStats);
+    ClassDB::bind_method(D_METHOD("set_patient_id", "patient_id"), &SurgicalBed::setPatientId);
+    ClassDB::bind_method(D_METHOD("get_patient_id"), &SurgicalBed::getPatientId);
+    ClassDB::bind_method(D_METHOD("get_last_scan_timestamp", "scan_type"), &SurgicalBed::getLastScanTimestamp);
+    ClassDB::bind_method(D_METHOD("get_scan_image_at", "scan_type", "timestamp_usec"), &SurgicalBed::getScanImageAt);
+    ClassDB::bind_method(D_METHOD("set_scan_cache_budget", "bytes"), &SurgicalBed::setScanCacheBudget);
+    ClassDB::bind_method(D_METHOD("set_scan_spill_directory", "path"), &SurgicalBed::setScanSpillDirectory);
+    ClassDB::bind_method(D_METHOD("clear_scan_cache"), &SurgicalBed::clearScanCache);
+    ClassDB::bind_method(D_METHOD("get_scan_cache_stats"), &SurgicalBed::getScanCacheStats);
+    ClassDB::bind_method(D_METHOD("get_scan_slice", "scan_type", "axis", "index"), &SurgicalBed::getScanSlice);
+    ClassDB::bind_method(D_METHOD("get_scan_mip", "scan_type", "axis"), &SurgicalBed::getScanMip);
+    ClassDB::bind_method(D_METHOD("get_scan_volume_size", "scan_type"), &SurgicalBed::getScanVolumeSize);
+    ClassDB::bind_method(D_METHOD("save_scan_tiles", "scan_type", "path"), &SurgicalBed::saveScanTiles);
+    ClassDB::bind_method(D_METHOD("load_scan_tiles", "path"), &SurgicalBed::loadScanTiles);
+    ClassDB::bind_method(D_METHOD("cancel_scan_tile_load"), &SurgicalBed::cancelScanTileLoad);
+    ClassDB::bind_method(D_METHOD("get_scan_tile_load_status"), &SurgicalBed::getScanTileLoadStatus);
     ClassDB::bind_method(D_METHOD("start_vital_monitoring"), &SurgicalBed::startVitalMonitoring);
     ClassDB::bind_method(D_METHOD("stop_vital_monitoring"), &SurgicalBed::stopVitalMonitoring);
     ClassDB::bind_method(D_METHOD("update_patient_vitals"), &SurgicalBed::updatePatientVitals);
+    ClassDB::bind_method(D_METHOD("get_vital_statistics", "window"), &SurgicalBed::getVitalStatistics, DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("start_vital_recording", "path"), &SurgicalBed::startVitalRecording);
+    ClassDB::bind_method(D_METHOD("stop_vital_recording"), &SurgicalBed::stopVitalRecording);
+    ClassDB::bind_method(D_METHOD("is_recording_vitals"), &SurgicalBed::isRecordingVitals);
+    ClassDB::bind_method(D_METHOD("start_vital_replay", "path", "speed"), &SurgicalBed::startVitalReplay, DEFVAL(1.0));
+    ClassDB::bind_method(D_METHOD("stop_vital_replay"), &SurgicalBed::stopVitalReplay);
+    ClassDB::bind_method(D_METHOD("seek_vital_replay", "timestamp_usec"), &SurgicalBed::seekVitalReplay);
+    ClassDB::bind_method(D_METHOD("get_vital_replay_status"), &SurgicalBed::getVitalReplayStatus);
     ClassDB::bind_method(D_METHOD("swivel_device_left", "angle"), &SurgicalBed::swivelDeviceLeft);
     ClassDB::bind_method(D_METHOD("swivel_device_right", "angle"), &SurgicalBed::swivelDeviceRight);
     ClassDB::bind_method(D_METHOD("center_device"), &SurgicalBed::centerDevice);
@@ -384,4 +894,14 @@ void SurgicalBed::_bind_methods() {
     ClassDB::bind_method(D_METHOD("position_for_procedure"), &SurgicalBed::positionForProcedure);
     ClassDB::bind_method(D_METHOD("set_to_surgical_height"), &SurgicalBed::setToSurgicalHeight);
     ClassDB::bind_method(D_METHOD("trigger_surgical_emergency"), &SurgicalBed::triggerSurgicalEmergency);
+    
+    BIND_CONSTANT(SCAN_AXIS_AXIAL);
+    BIND_CONSTANT(SCAN_AXIS_CORONAL);
+    BIND_CONSTANT(SCAN_AXIS_SAGITTAL);
+    
+    ADD_SIGNAL(MethodInfo("scan_completed", PropertyInfo(Variant::STRING, "scan_type"), PropertyInfo(Variant::FLOAT, "quality")));
+    ADD_SIGNAL(MethodInfo("scan_tile_loaded", PropertyInfo(Variant::INT, "level"), PropertyInfo(Variant::INT, "x"),
+                          PropertyInfo(Variant::INT, "y"), PropertyInfo(Variant::OBJECT, "image")));
+    ADD_SIGNAL(MethodInfo("scan_tile_failed", PropertyInfo(Variant::INT, "level"), PropertyInfo(Variant::INT, "x"),
+                          PropertyInfo(Variant::INT, "y")));
 }
\ No newline at end of file
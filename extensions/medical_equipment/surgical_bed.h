@@ -3,6 +3,9 @@
 
 #include "bed.h"
 #include "medical_devices.h"
+#include <godot_cpp/classes/image.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <memory>
 
@@ -19,6 +22,20 @@ private:
     float maxSurgicalHeight;
     float minSurgicalHeight;
     std::string currentProcedure;
+    
+    // Scan pixels already copied into Godot memory, reused until a newer scan arrives
+    struct ExportedScan {
+        ScanImageHandle image;
+        PackedByteArray pixels;
+    };
+    std::map<std::string, ExportedScan> exportedScans;
+    
+    // Display window that maps 16-bit scan intensities to the gray levels of scan Images
+    float scanWindowCenter;
+    float scanWindowWidth;
+    
+    // Tiles copied into Images per frame, so a large scan streams in without a frame spike
+    static constexpr size_t kScanTilesPerFrame = 16;
 
 public:
     SurgicalBed();
@@ -40,10 +57,66 @@ public:
     // Medical device operations
     void startFullBodyScan();
     void startBrainScan();
+    void startHeartScan();
+    void startLungScan();
+    bool startEmergencyScan(const String& scanType);
     void stopScanning();
+    
+    // Scans queue on a suite of scanners shared by every bed
+    int getScanQueuePosition() const;
+    void setScanSuiteSize(int scanners);
+    Dictionary getScanSchedulerStats() const;
+    float getScanProgress() const;
+    bool isScanning() const;
+    
+    // Scan images as raw little-endian 16-bit pixels, or an L8 Image windowed for display
+    PackedByteArray getScanPixels(const String& scanType);
+    Ref<Image> getScanImage(const String& scanType);
+    void setScanWindow(float center, float width);
+    float getScanWindowCenter() const { return scanWindowCenter; }
+    float getScanWindowWidth() const { return scanWindowWidth; }
+    Dictionary getScanBufferStats() const;
+    
+    // Scan history, cached per patient with a byte budget and optional spill to disk
+    void setPatientId(const String& id);
+    String getPatientId() const;
+    int64_t getLastScanTimestamp(const String& scanType) const;
+    Ref<Image> getScanImageAt(const String& scanType, int64_t timestampUsec);
+    void setScanCacheBudget(int64_t bytes);
+    void setScanSpillDirectory(const String& path);
+    void clearScanCache();
+    Dictionary getScanCacheStats() const;
+    
+    // Views of the most recent scan volume of a type; axis is one of SCAN_AXIS_*
+    static const int SCAN_AXIS_AXIAL = static_cast<int>(ScanVolume::Axis::AXIAL);
+    static const int SCAN_AXIS_CORONAL = static_cast<int>(ScanVolume::Axis::CORONAL);
+    static const int SCAN_AXIS_SAGITTAL = static_cast<int>(ScanVolume::Axis::SAGITTAL);
+    Ref<Image> getScanSlice(const String& scanType, int axis, int index);
+    Ref<Image> getScanMip(const String& scanType, int axis);
+    int getScanVolumeSize(const String& scanType);
+    
+    // Tiled scan files load progressively: the coarse image is returned at
+    // once and finer tiles arrive through scan_tile_loaded, or scan_tile_failed if corrupt
+    bool saveScanTiles(const String& scanType, const String& path);
+    Ref<Image> loadScanTiles(const String& path);
+    void cancelScanTileLoad();
+    Dictionary getScanTileLoadStatus() const;
+    
+    // Delivers completed scans and decoded scan tiles while either is pending
+    void _process(double delta) override;
     void startVitalMonitoring();
     void stopVitalMonitoring();
     void updatePatientVitals();
+    Dictionary getVitalStatistics(int window) const;
+    bool startVitalRecording(const String& path);
+    void stopVitalRecording();
+    bool isRecordingVitals() const;
+    
+    // Replay of recorded vitals; speed <= 0 replays as fast as possible
+    bool startVitalReplay(const String& path, double speed);
+    void stopVitalReplay();
+    bool seekVitalReplay(int64_t timestampUsec);
+    Dictionary getVitalReplayStatus() const;
     
     // Device positioning
     void swivelDeviceLeft(float angle = 45.0f);
@@ -67,7 +140,11 @@ public:
 
 protected:
     // Override hook methods from base class
-    void performSpecificChecks() override;
+    void checkHeightMechanism(MaintenanceRecord& record) const override;
+    void performSpecificChecks(MaintenanceRecord& record) const override;
+    BedSnapshot::Kind getSnapshotKind() const override { return BedSnapshot::SURGICAL; }
+    void captureSnapshot(BedSnapshot& snapshot) const override;
+    void applySnapshot(const BedSnapshot& snapshot) override;
     void onPowerOn() override;
     void onPowerOff() override;
     
@@ -81,6 +158,7 @@ private:
     void adjustLightingForProcedure();
     void adjustTemperatureForProcedure();
     bool isSurgicalPositioningValid() const;
+    Ref<Image> copyScanImage(const ScanImageHandle& image) const;
 };
 
 #endif // SURGICAL_BED_H
\ No newline at end of file
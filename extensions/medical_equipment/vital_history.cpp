@@ -0,0 +1,158 @@
+#include "vital_history.h"
+#include "simd_config.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Running min/max/sum over one contiguous segment of a lane
+struct LaneAccumulator {
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+    double sum = 0.0;
+};
+
+void accumulateSegment(const float* data, size_t n, LaneAccumulator& acc) {
+    size_t i = 0;
+
+#if defined(MEDICAL_SIMD_AVX2)
+    if (n >= 8) {
+        __m256 vmin = _mm256_set1_ps(acc.min);
+        __m256 vmax = _mm256_set1_ps(acc.max);
+        __m256 vsum = _mm256_setzero_ps();
+        for (; i + 8 <= n; i += 8) {
+            __m256 v = _mm256_loadu_ps(data + i);
+            vmin = _mm256_min_ps(vmin, v);
+            vmax = _mm256_max_ps(vmax, v);
+            vsum = _mm256_add_ps(vsum, v);
+        }
+        alignas(32) float mins[8], maxs[8], sums[8];
+        _mm256_store_ps(mins, vmin);
+        _mm256_store_ps(maxs, vmax);
+        _mm256_store_ps(sums, vsum);
+        for (int k = 0; k < 8; ++k) {
+            acc.min = std::min(acc.min, mins[k]);
+            acc.max = std::max(acc.max, maxs[k]);
+            acc.sum += sums[k];
+        }
+    }
+#endif
+
+#if defined(MEDICAL_SIMD_SSE2)
+    if (n - i >= 4) {
+        __m128 vmin = _mm_set1_ps(acc.min);
+        __m128 vmax = _mm_set1_ps(acc.max);
+        __m128 vsum = _mm_setzero_ps();
+        for (; i + 4 <= n; i += 4) {
+            __m128 v = _mm_loadu_ps(data + i);
+            vmin = _mm_min_ps(vmin, v);
+            vmax = _mm_max_ps(vmax, v);
+            vsum = _mm_add_ps(vsum, v);
+        }
+        alignas(16) float mins[4], maxs[4], sums[4];
+        _mm_store_ps(mins, vmin);
+        _mm_store_ps(maxs, vmax);
+        _mm_store_ps(sums, vsum);
+        for (int k = 0; k < 4; ++k) {
+            acc.min = std::min(acc.min, mins[k]);
+            acc.max = std::max(acc.max, maxs[k]);
+            acc.sum += sums[k];
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        acc.min = std::min(acc.min, data[i]);
+        acc.max = std::max(acc.max, data[i]);
+        acc.sum += data[i];
+    }
+}
+
+// Sum of squared deviations from the mean; a second pass keeps the
+// variance stable for lanes like blood pressure with a large offset
+double squaredDeviation(const float* data, size_t n, float mean) {
+    size_t i = 0;
+    double total = 0.0;
+
+#if defined(MEDICAL_SIMD_AVX2)
+    if (n >= 8) {
+        __m256 vmean = _mm256_set1_ps(mean);
+        __m256 vsum = _mm256_setzero_ps();
+        for (; i + 8 <= n; i += 8) {
+            __m256 d = _mm256_sub_ps(_mm256_loadu_ps(data + i), vmean);
+            vsum = _mm256_add_ps(vsum, _mm256_mul_ps(d, d));
+        }
+        alignas(32) float sums[8];
+        _mm256_store_ps(sums, vsum);
+        for (int k = 0; k < 8; ++k) {
+            total += sums[k];
+        }
+    }
+#endif
+
+#if defined(MEDICAL_SIMD_SSE2)
+    if (n - i >= 4) {
+        __m128 vmean = _mm_set1_ps(mean);
+        __m128 vsum = _mm_setzero_ps();
+        for (; i + 4 <= n; i += 4) {
+            __m128 d = _mm_sub_ps(_mm_loadu_ps(data + i), vmean);
+            vsum = _mm_add_ps(vsum, _mm_mul_ps(d, d));
+        }
+        alignas(16) float sums[4];
+        _mm_store_ps(sums, vsum);
+        for (int k = 0; k < 4; ++k) {
+            total += sums[k];
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        float d = data[i] - mean;
+        total += d * d;
+    }
+    return total;
+}
+
+} // namespace
+
+void VitalSignsHistory::push(const VitalSigns& vitals) {
+    lanes[static_cast<size_t>(Lane::OXYGEN_LEVEL)][head] = vitals.oxygenLevel;
+    lanes[static_cast<size_t>(Lane::HEART_RATE)][head] = vitals.heartRate;
+    lanes[static_cast<size_t>(Lane::BLOOD_PRESSURE)][head] = vitals.bloodPressure;
+    lanes[static_cast<size_t>(Lane::TEMPERATURE)][head] = vitals.temperature;
+    lanes[static_cast<size_t>(Lane::RESPIRATION_RATE)][head] = vitals.respirationRate;
+
+    head = (head + 1) % kCapacity;
+    count = std::min(count + 1, kCapacity);
+}
+
+VitalSignsHistory::WindowStats VitalSignsHistory::computeStats(Lane lane, size_t window) const {
+    WindowStats stats{0.0f, 0.0f, 0.0f, 0.0f, 0};
+    if (count == 0) {
+        return stats;
+    }
+
+    size_t samples = (window == 0 || window > count) ? count : window;
+    const float* data = lanes[static_cast<size_t>(lane)];
+
+    // The trailing window is at most two contiguous segments of the ring
+    size_t start = (head + kCapacity - samples) % kCapacity;
+    size_t firstLength = std::min(samples, kCapacity - start);
+    size_t secondLength = samples - firstLength;
+
+    LaneAccumulator acc;
+    accumulateSegment(data + start, firstLength, acc);
+    accumulateSegment(data, secondLength, acc);
+
+    float mean = static_cast<float>(acc.sum / static_cast<double>(samples));
+    double deviation = squaredDeviation(data + start, firstLength, mean) +
+                       squaredDeviation(data, secondLength, mean);
+
+    stats.min = acc.min;
+    stats.max = acc.max;
+    stats.mean = mean;
+    stats.stddev = static_cast<float>(std::sqrt(deviation / static_cast<double>(samples)));
+    stats.sampleCount = samples;
+    return stats;
+}
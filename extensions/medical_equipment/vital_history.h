@@ -0,0 +1,56 @@
+#ifndef VITAL_HISTORY_H
+#define VITAL_HISTORY_H
+
+#include "medical_data.h"
+#include <cstddef>
+
+/**
+ * @class VitalSignsHistory
+ * @brief Fixed-capacity structure-of-arrays ring buffer of vital sign samples
+ *
+ * Every vital lives in its own contiguous, cache-aligned float lane so that
+ * window statistics can stream through one lane with SIMD loads.
+ */
+class VitalSignsHistory {
+public:
+    using Lane = VitalLane;
+
+    static constexpr size_t kLaneCount = kVitalLaneCount;
+    static constexpr size_t kCapacity = 1024; // samples per lane
+
+    struct WindowStats {
+        float min;
+        float max;
+        float mean;
+        float stddev;
+        size_t sampleCount;
+    };
+
+    VitalSignsHistory() : head(0), count(0) {}
+
+    /**
+     * Appends a sample, overwriting the oldest one when full
+     * @param vitals The sample to record
+     */
+    void push(const VitalSigns& vitals);
+
+    void clear() { head = 0; count = 0; }
+    size_t size() const { return count; }
+
+    /**
+     * Computes statistics over the most recent samples of one lane
+     * @param lane The vital to summarise
+     * @param window Number of trailing samples; 0 or more than size() uses all
+     * @return Min, max, mean and population standard deviation
+     */
+    WindowStats computeStats(Lane lane, size_t window) const;
+
+    static const char* getLaneName(Lane lane) { return getVitalLaneName(lane); }
+
+private:
+    alignas(64) float lanes[kLaneCount][kCapacity];
+    size_t head;  // next slot to write
+    size_t count;
+};
+
+#endif // VITAL_HISTORY_H
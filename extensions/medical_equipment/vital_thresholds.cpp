@@ -0,0 +1,88 @@
+#include "vital_thresholds.h"
+#include "simd_config.h"
+#include <limits>
+
+VitalThresholds VitalThresholds::defaults() {
+    const float unbounded = std::numeric_limits<float>::max();
+
+    VitalThresholds table;
+    table.addRule({VitalLane::OXYGEN_LEVEL, 90.0f, unbounded, ALERT_LOW_OXYGEN});
+    table.addRule({VitalLane::HEART_RATE, 50.0f, 120.0f, ALERT_ABNORMAL_HEART_RATE});
+    table.addRule({VitalLane::TEMPERATURE, 36.0f, 38.5f, ALERT_TEMPERATURE_WARNING});
+
+    // Tighter limits that need attention while a procedure is running
+    table.addRule({VitalLane::OXYGEN_LEVEL, 95.0f, unbounded, ALERT_PROCEDURE});
+    table.addRule({VitalLane::HEART_RATE, -unbounded, 110.0f, ALERT_PROCEDURE});
+    return table;
+}
+
+bool VitalThresholds::addRule(const Rule& rule) {
+    if (ruleCount >= kMaxRules) {
+        return false;
+    }
+    rules[ruleCount++] = rule;
+    return true;
+}
+
+void VitalThresholds::evaluate(const LanePointers& lanes, size_t count, int32_t* masks) const {
+    size_t i = 0;
+
+#if defined(MEDICAL_SIMD_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        __m256 mask = _mm256_setzero_ps();
+        for (size_t r = 0; r < ruleCount; ++r) {
+            const Rule& rule = rules[r];
+            __m256 v = _mm256_loadu_ps(lanes[static_cast<size_t>(rule.lane)] + i);
+            __m256 outside = _mm256_or_ps(_mm256_cmp_ps(v, _mm256_set1_ps(rule.low), _CMP_LT_OQ),
+                                          _mm256_cmp_ps(v, _mm256_set1_ps(rule.high), _CMP_GT_OQ));
+            __m256 bit = _mm256_castsi256_ps(_mm256_set1_epi32(rule.alertBit));
+            mask = _mm256_or_ps(mask, _mm256_and_ps(outside, bit));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(masks + i), _mm256_castps_si256(mask));
+    }
+#endif
+
+#if defined(MEDICAL_SIMD_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 mask = _mm_setzero_ps();
+        for (size_t r = 0; r < ruleCount; ++r) {
+            const Rule& rule = rules[r];
+            __m128 v = _mm_loadu_ps(lanes[static_cast<size_t>(rule.lane)] + i);
+            __m128 outside = _mm_or_ps(_mm_cmplt_ps(v, _mm_set1_ps(rule.low)),
+                                       _mm_cmpgt_ps(v, _mm_set1_ps(rule.high)));
+            __m128 bit = _mm_castsi128_ps(_mm_set1_epi32(rule.alertBit));
+            mask = _mm_or_ps(mask, _mm_and_ps(outside, bit));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(masks + i), _mm_castps_si128(mask));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        int32_t mask = 0;
+        for (size_t r = 0; r < ruleCount; ++r) {
+            const Rule& rule = rules[r];
+            float v = lanes[static_cast<size_t>(rule.lane)][i];
+            int32_t outside = static_cast<int32_t>((v < rule.low) | (v > rule.high));
+            mask |= -outside & rule.alertBit;
+        }
+        masks[i] = mask;
+    }
+}
+
+int32_t VitalThresholds::evaluate(const VitalSigns& vitals) const {
+    float values[kVitalLaneCount];
+    values[static_cast<size_t>(VitalLane::OXYGEN_LEVEL)] = vitals.oxygenLevel;
+    values[static_cast<size_t>(VitalLane::HEART_RATE)] = vitals.heartRate;
+    values[static_cast<size_t>(VitalLane::BLOOD_PRESSURE)] = vitals.bloodPressure;
+    values[static_cast<size_t>(VitalLane::TEMPERATURE)] = vitals.temperature;
+    values[static_cast<size_t>(VitalLane::RESPIRATION_RATE)] = vitals.respirationRate;
+
+    LanePointers lanes;
+    for (size_t lane = 0; lane < kVitalLaneCount; ++lane) {
+        lanes[lane] = &values[lane];
+    }
+
+    int32_t mask = 0;
+    evaluate(lanes, 1, &mask);
+    return mask;
+}
@@ -0,0 +1,69 @@
+#ifndef VITAL_THRESHOLDS_H
+#define VITAL_THRESHOLDS_H
+
+#include "medical_data.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class VitalThresholds
+ * @brief Table of critical-value rules evaluated into per-patient alert bitmasks
+ *
+ * Each rule flags one alert bit when a vital leaves its [low, high] band.
+ * Several rules may share a bit. Evaluation streams the structure-of-arrays
+ * lanes with SIMD compares and no per-patient branches.
+ */
+class VitalThresholds {
+public:
+    // Alert bits, shared with GDScript through VitalsFleet
+    static constexpr int32_t ALERT_LOW_OXYGEN = 1 << 0;
+    static constexpr int32_t ALERT_ABNORMAL_HEART_RATE = 1 << 1;
+    static constexpr int32_t ALERT_TEMPERATURE_WARNING = 1 << 2;
+    static constexpr int32_t ALERT_PROCEDURE = 1 << 3;
+
+    static constexpr size_t kMaxRules = 16;
+
+    struct Rule {
+        VitalLane lane;
+        float low;
+        float high;
+        int32_t alertBit;
+    };
+
+    // One read pointer per vital lane, indexed by VitalLane
+    using LanePointers = std::array<const float*, kVitalLaneCount>;
+
+    VitalThresholds() : ruleCount(0) {}
+
+    /**
+     * Clinical defaults used by ScannerDevice and SurgicalBed
+     */
+    static VitalThresholds defaults();
+
+    /**
+     * Adds a rule
+     * @return false when the table is full
+     */
+    bool addRule(const Rule& rule);
+    void clear() { ruleCount = 0; }
+    size_t getRuleCount() const { return ruleCount; }
+    const Rule& getRule(size_t index) const { return rules[index]; }
+
+    /**
+     * Evaluates every patient in one pass
+     * @param lanes Lane pointers for the first patient
+     * @param count Number of patients
+     * @param masks Output, one alert bitmask per patient
+     */
+    void evaluate(const LanePointers& lanes, size_t count, int32_t* masks) const;
+
+    // Single-patient convenience for device callbacks
+    int32_t evaluate(const VitalSigns& vitals) const;
+
+private:
+    std::array<Rule, kMaxRules> rules;
+    size_t ruleCount;
+};
+
+#endif // VITAL_THRESHOLDS_H
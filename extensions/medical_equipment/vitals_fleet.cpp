@@ -0,0 +1,178 @@
+#include "vitals_fleet.h"
+#include "worker_pool.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+
+using namespace godot;
+
+VitalsFleet::VitalsFleet() {
+    DEVICE_LOG_INFO("💓 VitalsFleet created");
+}
+
+void VitalsFleet::setPatientCount(int count) {
+    simulator.resize(static_cast<size_t>(std::max(0, count)));
+    DEVICE_LOG_INFO("💓 VitalsFleet simulating {} patients", simulator.size());
+}
+
+int VitalsFleet::getPatientCount() const {
+    return static_cast<int>(simulator.size());
+}
+
+void VitalsFleet::setSeed(int seed) {
+    simulator.setSeed(static_cast<uint32_t>(seed));
+}
+
+void VitalsFleet::setLaneLimits(int lane, float minValue, float maxValue, float step) {
+    if (!isValidLane(lane)) {
+        DEVICE_LOG_INFO("❌ Unknown vital lane: {}", lane);
+        return;
+    }
+    simulator.setLimits(static_cast<VitalLane>(lane), {minValue, maxValue, step});
+}
+
+bool VitalsFleet::addThresholdRule(int lane, float low, float high, int alertBit) {
+    if (!isValidLane(lane)) {
+        DEVICE_LOG_INFO("❌ Unknown vital lane: {}", lane);
+        return false;
+    }
+    
+    VitalThresholds table = simulator.getThresholds();
+    if (!table.addRule({static_cast<VitalLane>(lane), low, high, static_cast<int32_t>(alertBit)})) {
+        DEVICE_LOG_INFO("❌ Threshold table full ({} rules)", VitalThresholds::kMaxRules);
+        return false;
+    }
+    simulator.setThresholds(table);
+    return true;
+}
+
+void VitalsFleet::clearThresholdRules() {
+    simulator.setThresholds(VitalThresholds());
+}
+
+void VitalsFleet::resetThresholdRules() {
+    simulator.setThresholds(VitalThresholds::defaults());
+}
+
+int VitalsFleet::step(int ticks) {
+    int crossings = 0;
+    for (int i = 0; i < ticks; ++i) {
+        crossings += static_cast<int>(simulator.step(&WorkerPool::shared()));
+        dispatchCrossings();
+    }
+    return crossings;
+}
+
+PackedFloat32Array VitalsFleet::getLane(int lane) const {
+    PackedFloat32Array values;
+    if (!isValidLane(lane)) {
+        return values;
+    }
+    
+    values.resize(static_cast<int64_t>(simulator.size()));
+    const float* source = simulator.getLane(static_cast<VitalLane>(lane));
+    std::copy(source, source + simulator.size(), values.ptrw());
+    return values;
+}
+
+Dictionary VitalsFleet::getPatientVitals(int patient) const {
+    Dictionary result;
+    if (patient < 0 || static_cast<size_t>(patient) >= simulator.size()) {
+        return result;
+    }
+    
+    VitalSigns vitals = simulator.getVitals(static_cast<size_t>(patient));
+    result["oxygen_level"] = vitals.oxygenLevel;
+    result["heart_rate"] = vitals.heartRate;
+    result["blood_pressure"] = vitals.bloodPressure;
+    result["temperature"] = vitals.temperature;
+    result["respiration_rate"] = vitals.respirationRate;
+    return result;
+}
+
+PackedInt32Array VitalsFleet::getAlertMasks() const {
+    PackedInt32Array masks;
+    masks.resize(static_cast<int64_t>(simulator.size()));
+    const int32_t* source = simulator.getAlertMasks();
+    std::copy(source, source + simulator.size(), masks.ptrw());
+    return masks;
+}
+
+void VitalsFleet::addObserver(uint32_t patient, DeviceObserver* observer) {
+    observers[patient].push_back(observer);
+}
+
+void VitalsFleet::removeObserver(uint32_t patient, DeviceObserver* observer) {
+    auto it = observers.find(patient);
+    if (it == observers.end()) {
+        return;
+    }
+    
+    it->second.erase(
+        std::remove(it->second.begin(), it->second.end(), observer),
+        it->second.end()
+    );
+    if (it->second.empty()) {
+        observers.erase(it);
+    }
+}
+
+bool VitalsFleet::isValidLane(int lane) const {
+    return lane >= 0 && lane < static_cast<int>(kVitalLaneCount);
+}
+
+void VitalsFleet::dispatchCrossings() {
+    const std::vector<uint32_t>& crossed = simulator.getCrossedPatients();
+    if (crossed.empty()) {
+        return;
+    }
+    
+    // Observers only hear about the patients that changed alert state
+    if (!observers.empty()) {
+        for (uint32_t patient : crossed) {
+            auto it = observers.find(patient);
+            if (it == observers.end()) {
+                continue;
+            }
+            VitalSigns vitals = simulator.getVitals(patient);
+            for (auto* observer : it->second) {
+                if (observer) {
+                    observer->onVitalSignsUpdated(vitals);
+                }
+            }
+        }
+    }
+    
+    PackedInt32Array patients;
+    patients.resize(static_cast<int64_t>(crossed.size()));
+    std::copy(crossed.begin(), crossed.end(), patients.ptrw());
+    emit_signal("thresholds_crossed", patients);
+}
+
+void VitalsFleet::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_patient_count", "count"), &VitalsFleet::setPatientCount);
+    ClassDB::bind_method(D_METHOD("get_patient_count"), &VitalsFleet::getPatientCount);
+    ClassDB::bind_method(D_METHOD("set_seed", "seed"), &VitalsFleet::setSeed);
+    ClassDB::bind_method(D_METHOD("set_lane_limits", "lane", "min_value", "max_value", "step"), &VitalsFleet::setLaneLimits);
+    ClassDB::bind_method(D_METHOD("add_threshold_rule", "lane", "low", "high", "alert_bit"), &VitalsFleet::addThresholdRule);
+    ClassDB::bind_method(D_METHOD("clear_threshold_rules"), &VitalsFleet::clearThresholdRules);
+    ClassDB::bind_method(D_METHOD("reset_threshold_rules"), &VitalsFleet::resetThresholdRules);
+    ClassDB::bind_method(D_METHOD("step", "ticks"), &VitalsFleet::step, DEFVAL(1));
+    ClassDB::bind_method(D_METHOD("get_lane", "lane"), &VitalsFleet::getLane);
+    ClassDB::bind_method(D_METHOD("get_patient_vitals", "patient"), &VitalsFleet::getPatientVitals);
+    ClassDB::bind_method(D_METHOD("get_alert_masks"), &VitalsFleet::getAlertMasks);
+    
+    ADD_SIGNAL(MethodInfo("thresholds_crossed", PropertyInfo(Variant::PACKED_INT32_ARRAY, "patients")));
+    
+    // Vital lane constants
+    BIND_CONSTANT(LANE_OXYGEN_LEVEL);
+    BIND_CONSTANT(LANE_HEART_RATE);
+    BIND_CONSTANT(LANE_BLOOD_PRESSURE);
+    BIND_CONSTANT(LANE_TEMPERATURE);
+    BIND_CONSTANT(LANE_RESPIRATION_RATE);
+    
+    // Alert bit constants
+    BIND_CONSTANT(ALERT_LOW_OXYGEN);
+    BIND_CONSTANT(ALERT_ABNORMAL_HEART_RATE);
+    BIND_CONSTANT(ALERT_TEMPERATURE_WARNING);
+    BIND_CONSTANT(ALERT_PROCEDURE);
+}
@@ -0,0 +1,79 @@
+#ifndef VITALS_FLEET_H
+#define VITALS_FLEET_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include "medical_devices.h"
+#include "vitals_fleet_simulator.h"
+#include <unordered_map>
+#include <vector>
+
+using namespace godot;
+
+/**
+ * @class VitalsFleet
+ * @brief Godot node driving a VitalsFleetSimulator for ward digital twins
+ *
+ * Steps every simulated patient in one call and reports only the patients
+ * whose vitals crossed an alert threshold, both to registered C++
+ * DeviceObservers and through the thresholds_crossed signal.
+ */
+class VitalsFleet : public Node {
+    GDCLASS(VitalsFleet, Node)
+
+public:
+    // Vital lane constants for GDScript binding
+    static const int LANE_OXYGEN_LEVEL = 0;
+    static const int LANE_HEART_RATE = 1;
+    static const int LANE_BLOOD_PRESSURE = 2;
+    static const int LANE_TEMPERATURE = 3;
+    static const int LANE_RESPIRATION_RATE = 4;
+
+    // Alert bit constants for GDScript binding
+    static const int ALERT_LOW_OXYGEN = VitalThresholds::ALERT_LOW_OXYGEN;
+    static const int ALERT_ABNORMAL_HEART_RATE = VitalThresholds::ALERT_ABNORMAL_HEART_RATE;
+    static const int ALERT_TEMPERATURE_WARNING = VitalThresholds::ALERT_TEMPERATURE_WARNING;
+    static const int ALERT_PROCEDURE = VitalThresholds::ALERT_PROCEDURE;
+
+private:
+    VitalsFleetSimulator simulator;
+    std::unordered_map<uint32_t, std::vector<DeviceObserver*>> observers;
+
+public:
+    VitalsFleet();
+    ~VitalsFleet() = default;
+
+    // Fleet configuration
+    void setPatientCount(int count);
+    int getPatientCount() const;
+    void setSeed(int seed);
+    void setLaneLimits(int lane, float minValue, float maxValue, float step);
+
+    // Threshold table
+    bool addThresholdRule(int lane, float low, float high, int alertBit);
+    void clearThresholdRules();
+    void resetThresholdRules();
+
+    // Simulation
+    int step(int ticks);
+    PackedFloat32Array getLane(int lane) const;
+    Dictionary getPatientVitals(int patient) const;
+    PackedInt32Array getAlertMasks() const;
+
+    // C++ observers notified only when their patient crosses a threshold
+    void addObserver(uint32_t patient, DeviceObserver* observer);
+    void removeObserver(uint32_t patient, DeviceObserver* observer);
+
+    const VitalsFleetSimulator& getSimulator() const { return simulator; }
+
+protected:
+    static void _bind_methods();
+
+private:
+    bool isValidLane(int lane) const;
+    void dispatchCrossings();
+};
+
+#endif // VITALS_FLEET_H
@@ -0,0 +1,209 @@
+#include "vitals_fleet_simulator.h"
+#include "worker_pool.h"
+#include <algorithm>
+
+namespace {
+
+constexpr size_t kBlockSize = 4096; // patients per parallel work item
+constexpr uint32_t kPatientStride = 0x85EBCA6Bu;
+constexpr float kUnitScale = 1.0f / 8388608.0f; // 2^-23
+
+// Integer hash with full avalanche (lowbias32)
+inline uint32_t mix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// Per-(seed, tick, lane) key; every patient's draw is mix32(key + patient * stride)
+inline uint32_t streamKey(uint32_t seed, uint64_t tick, uint32_t lane) {
+    uint32_t folded = static_cast<uint32_t>(tick) ^ mix32(static_cast<uint32_t>(tick >> 32));
+    return mix32(seed ^ mix32(folded + lane * 0x9E3779B9u));
+}
+
+inline float toUnit(uint32_t bits) {
+    return static_cast<float>(bits >> 8) * kUnitScale - 1.0f;
+}
+
+#if defined(MEDICAL_SIMD_AVX2)
+inline __m256i mix32x8(__m256i x) {
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(0x7FEB352Du)));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(0x846CA68Bu)));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    return x;
+}
+#endif
+
+#if defined(MEDICAL_SIMD_SSE41)
+inline __m128i mix32x4(__m128i x) {
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    x = _mm_mullo_epi32(x, _mm_set1_epi32(static_cast<int>(0x7FEB352Du)));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+    x = _mm_mullo_epi32(x, _mm_set1_epi32(static_cast<int>(0x846CA68Bu)));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    return x;
+}
+#endif
+
+// value = clamp(value + noise * step, min, max) for patients [begin, end)
+void randomWalkLane(float* values, size_t begin, size_t end, uint32_t key,
+                    const VitalsFleetSimulator::LaneLimits& limits) {
+    size_t i = begin;
+
+#if defined(MEDICAL_SIMD_AVX2)
+    {
+        const __m256i stride = _mm256_set1_epi32(static_cast<int>(kPatientStride));
+        const __m256i offsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256 scale = _mm256_set1_ps(kUnitScale);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 step = _mm256_set1_ps(limits.step);
+        const __m256 lo = _mm256_set1_ps(limits.min);
+        const __m256 hi = _mm256_set1_ps(limits.max);
+        const __m256i vkey = _mm256_set1_epi32(static_cast<int>(key));
+        for (; i + 8 <= end; i += 8) {
+            __m256i index = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), offsets);
+            __m256i bits = mix32x8(_mm256_add_epi32(vkey, _mm256_mullo_epi32(index, stride)));
+            __m256 noise = _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(bits, 8)), scale), one);
+            __m256 v = _mm256_add_ps(_mm256_loadu_ps(values + i), _mm256_mul_ps(noise, step));
+            _mm256_storeu_ps(values + i, _mm256_min_ps(hi, _mm256_max_ps(lo, v)));
+        }
+    }
+#endif
+
+#if defined(MEDICAL_SIMD_SSE41)
+    {
+        const __m128i stride = _mm_set1_epi32(static_cast<int>(kPatientStride));
+        const __m128i offsets = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128 scale = _mm_set1_ps(kUnitScale);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 step = _mm_set1_ps(limits.step);
+        const __m128 lo = _mm_set1_ps(limits.min);
+        const __m128 hi = _mm_set1_ps(limits.max);
+        const __m128i vkey = _mm_set1_epi32(static_cast<int>(key));
+        for (; i + 4 <= end; i += 4) {
+            __m128i index = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(i)), offsets);
+            __m128i bits = mix32x4(_mm_add_epi32(vkey, _mm_mullo_epi32(index, stride)));
+            __m128 noise = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(bits, 8)), scale), one);
+            __m128 v = _mm_add_ps(_mm_loadu_ps(values + i), _mm_mul_ps(noise, step));
+            _mm_storeu_ps(values + i, _mm_min_ps(hi, _mm_max_ps(lo, v)));
+        }
+    }
+#endif
+
+    for (; i < end; ++i) {
+        float noise = toUnit(mix32(key + static_cast<uint32_t>(i) * kPatientStride));
+        float v = values[i] + noise * limits.step;
+        values[i] = std::min(limits.max, std::max(limits.min, v));
+    }
+}
+
+} // namespace
+
+VitalsFleetSimulator::VitalsFleetSimulator(uint32_t initialSeed)
+    : seed(initialSeed), tick(0), patientCount(0), thresholds(VitalThresholds::defaults()) {
+    // Same ranges and per-tick variation as VitalSignMonitor::simulateVitalSigns
+    limits[static_cast<size_t>(VitalLane::OXYGEN_LEVEL)] = {95.0f, 100.0f, 0.2f};
+    limits[static_cast<size_t>(VitalLane::HEART_RATE)] = {60.0f, 100.0f, 5.0f};
+    limits[static_cast<size_t>(VitalLane::BLOOD_PRESSURE)] = {110.0f, 140.0f, 3.0f};
+    limits[static_cast<size_t>(VitalLane::TEMPERATURE)] = {36.5f, 37.5f, 0.1f};
+    limits[static_cast<size_t>(VitalLane::RESPIRATION_RATE)] = {12.0f, 20.0f, 2.0f};
+}
+
+void VitalsFleetSimulator::resize(size_t newCount) {
+    VitalSigns defaults;
+    lanes[static_cast<size_t>(VitalLane::OXYGEN_LEVEL)].resize(newCount, defaults.oxygenLevel);
+    lanes[static_cast<size_t>(VitalLane::HEART_RATE)].resize(newCount, defaults.heartRate);
+    lanes[static_cast<size_t>(VitalLane::BLOOD_PRESSURE)].resize(newCount, defaults.bloodPressure);
+    lanes[static_cast<size_t>(VitalLane::TEMPERATURE)].resize(newCount, defaults.temperature);
+    lanes[static_cast<size_t>(VitalLane::RESPIRATION_RATE)].resize(newCount, defaults.respirationRate);
+    alertState.resize(newCount, 0);
+    patientCount = newCount;
+    crossedPatients.clear();
+}
+
+void VitalsFleetSimulator::setLimits(VitalLane lane, const LaneLimits& laneLimits) {
+    limits[static_cast<size_t>(lane)] = laneLimits;
+}
+
+size_t VitalsFleetSimulator::step(WorkerPool* pool) {
+    crossedPatients.clear();
+    if (patientCount == 0) {
+        ++tick;
+        return 0;
+    }
+
+    size_t blockCount = (patientCount + kBlockSize - 1) / kBlockSize;
+    std::vector<std::vector<uint32_t>> crossedPerBlock(blockCount);
+
+    auto runBlocks = [this, &crossedPerBlock](size_t firstBlock, size_t lastBlock) {
+        for (size_t block = firstBlock; block < lastBlock; ++block) {
+            size_t begin = block * kBlockSize;
+            size_t end = std::min(patientCount, begin + kBlockSize);
+            stepRange(begin, end, crossedPerBlock[block]);
+        }
+    };
+
+    if (pool && blockCount > 1) {
+        pool->parallelFor(blockCount, 1, runBlocks);
+    } else {
+        runBlocks(0, blockCount);
+    }
+
+    // Blocks are visited in order, so the merged list stays sorted
+    for (auto& crossed : crossedPerBlock) {
+        crossedPatients.insert(crossedPatients.end(), crossed.begin(), crossed.end());
+    }
+
+    ++tick;
+    return crossedPatients.size();
+}
+
+void VitalsFleetSimulator::stepRange(size_t begin, size_t end, std::vector<uint32_t>& crossed) {
+    for (size_t lane = 0; lane < kVitalLaneCount; ++lane) {
+        uint32_t key = streamKey(seed, tick, static_cast<uint32_t>(lane));
+        randomWalkLane(lanes[lane].data(), begin, end, key, limits[lane]);
+    }
+
+    VitalThresholds::LanePointers blockLanes;
+    for (size_t lane = 0; lane < kVitalLaneCount; ++lane) {
+        blockLanes[lane] = lanes[lane].data() + begin;
+    }
+
+    alignas(64) int32_t masks[kBlockSize];
+    thresholds.evaluate(blockLanes, end - begin, masks);
+
+    for (size_t i = begin; i < end; ++i) {
+        int32_t mask = masks[i - begin];
+        if (mask != alertState[i]) {
+            alertState[i] = mask;
+            crossed.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+VitalSigns VitalsFleetSimulator::getVitals(size_t patient) const {
+    VitalSigns vitals;
+    vitals.oxygenLevel = lanes[static_cast<size_t>(VitalLane::OXYGEN_LEVEL)][patient];
+    vitals.heartRate = lanes[static_cast<size_t>(VitalLane::HEART_RATE)][patient];
+    vitals.bloodPressure = lanes[static_cast<size_t>(VitalLane::BLOOD_PRESSURE)][patient];
+    vitals.temperature = lanes[static_cast<size_t>(VitalLane::TEMPERATURE)][patient];
+    vitals.respirationRate = lanes[static_cast<size_t>(VitalLane::RESPIRATION_RATE)][patient];
+    return vitals;
+}
+
+void VitalsFleetSimulator::setVitals(size_t patient, const VitalSigns& vitals) {
+    lanes[static_cast<size_t>(VitalLane::OXYGEN_LEVEL)][patient] = vitals.oxygenLevel;
+    lanes[static_cast<size_t>(VitalLane::HEART_RATE)][patient] = vitals.heartRate;
+    lanes[static_cast<size_t>(VitalLane::BLOOD_PRESSURE)][patient] = vitals.bloodPressure;
+    lanes[static_cast<size_t>(VitalLane::TEMPERATURE)][patient] = vitals.temperature;
+    lanes[static_cast<size_t>(VitalLane::RESPIRATION_RATE)][patient] = vitals.respirationRate;
+}
+
+float VitalsFleetSimulator::randomUnit(uint32_t seed, uint64_t tick, uint32_t lane, uint32_t patient) {
+    return toUnit(mix32(streamKey(seed, tick, lane) + patient * kPatientStride));
+}
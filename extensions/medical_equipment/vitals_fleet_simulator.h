@@ -0,0 +1,83 @@
+#ifndef VITALS_FLEET_SIMULATOR_H
+#define VITALS_FLEET_SIMULATOR_H
+
+#include "medical_data.h"
+#include "simd_config.h"
+#include "vital_thresholds.h"
+#include <cstdint>
+#include <vector>
+
+class WorkerPool;
+
+/**
+ * @class VitalsFleetSimulator
+ * @brief Batch random-walk simulation of vital signs for thousands of patients
+ *
+ * Vitals are stored as one aligned float lane per vital. Each tick draws its
+ * noise from a counter-based generator keyed by (seed, tick, lane, patient),
+ * so results are reproducible regardless of how the fleet is split across
+ * worker threads. Only patients whose alert state changed are reported.
+ */
+class VitalsFleetSimulator {
+public:
+    // Random-walk bounds for one vital
+    struct LaneLimits {
+        float min;
+        float max;
+        float step;  // maximum change per tick
+    };
+
+    explicit VitalsFleetSimulator(uint32_t initialSeed = 0x5EEDu);
+
+    /**
+     * Resizes the fleet; new patients start at default vitals
+     * @param patientCount Number of simulated patients
+     */
+    void resize(size_t patientCount);
+    size_t size() const { return patientCount; }
+
+    void setSeed(uint32_t newSeed) { seed = newSeed; }
+    void setLimits(VitalLane lane, const LaneLimits& limits);
+    const LaneLimits& getLimits(VitalLane lane) const { return limits[static_cast<size_t>(lane)]; }
+    void setThresholds(const VitalThresholds& table) { thresholds = table; }
+    const VitalThresholds& getThresholds() const { return thresholds; }
+
+    /**
+     * Advances every patient by one tick
+     * @param pool Pool used to split the fleet; nullptr runs on the caller
+     * @return Number of patients whose alert state changed
+     */
+    size_t step(WorkerPool* pool = nullptr);
+
+    uint64_t getTick() const { return tick; }
+
+    // Patients whose alert state changed during the last step, ascending
+    const std::vector<uint32_t>& getCrossedPatients() const { return crossedPatients; }
+
+    // VitalThresholds::ALERT_* bits raised by each patient after the last step
+    int32_t getAlertState(size_t patient) const { return alertState[patient]; }
+    const int32_t* getAlertMasks() const { return alertState.data(); }
+
+    const float* getLane(VitalLane lane) const { return lanes[static_cast<size_t>(lane)].data(); }
+    VitalSigns getVitals(size_t patient) const;
+    void setVitals(size_t patient, const VitalSigns& vitals);
+
+    /**
+     * Counter-based generator: uniform value in [-1, 1) for one draw
+     */
+    static float randomUnit(uint32_t seed, uint64_t tick, uint32_t lane, uint32_t patient);
+
+private:
+    void stepRange(size_t begin, size_t end, std::vector<uint32_t>& crossed);
+
+    uint32_t seed;
+    uint64_t tick;
+    size_t patientCount;
+    LaneLimits limits[kVitalLaneCount];
+    VitalThresholds thresholds;
+    SimdVector<float> lanes[kVitalLaneCount];
+    SimdVector<int32_t> alertState;
+    std::vector<uint32_t> crossedPatients;
+};
+
+#endif // VITALS_FLEET_SIMULATOR_H
@@ -0,0 +1,524 @@
+#include "vitals_recorder.h"
+#include "device_log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Format = VitalsRecordingFormat;
+
+namespace {
+
+constexpr size_t kGrowBlocks = 16;  // file grows this many blocks at a time
+constexpr auto kWriterInterval = std::chrono::milliseconds(1);
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "committed count is shared through the mapping and must be lock-free");
+
+inline std::atomic<uint64_t>* committedField(uint8_t* mapping) {
+    return reinterpret_cast<std::atomic<uint64_t>*>(mapping + offsetof(Format::FileHeader, committedSamples));
+}
+
+inline const std::atomic<uint64_t>* committedField(const uint8_t* mapping) {
+    return reinterpret_cast<const std::atomic<uint64_t>*>(mapping + offsetof(Format::FileHeader, committedSamples));
+}
+
+inline size_t writeVarint(uint8_t* out, int64_t delta) {
+    uint64_t value = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63); // zigzag
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    out[length++] = static_cast<uint8_t>(value);
+    return length;
+}
+
+inline float laneValue(const VitalSigns& vitals, size_t lane) {
+    switch (static_cast<VitalLane>(lane)) {
+        case VitalLane::OXYGEN_LEVEL: return vitals.oxygenLevel;
+        case VitalLane::HEART_RATE: return vitals.heartRate;
+        case VitalLane::BLOOD_PRESSURE: return vitals.bloodPressure;
+        case VitalLane::TEMPERATURE: return vitals.temperature;
+        case VitalLane::RESPIRATION_RATE: return vitals.respirationRate;
+    }
+    return 0.0f;
+}
+
+} // namespace
+
+// VitalsRecorder
+
+VitalsRecorder::VitalsRecorder()
+    : ring(new Sample[kRingCapacity]), stopRequested(false), fd(-1), mapping(nullptr), mappedBytes(0),
+      currentBlock(0), samplesInBlock(0), timestampBytes(0), previousTimestampUs(0), totalSamples(0) {}
+
+VitalsRecorder::~VitalsRecorder() {
+    close();
+}
+
+int64_t VitalsRecorder::nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+#if defined(_WIN32)
+
+bool VitalsRecorder::open(const std::string& filePath) {
+    DEVICE_LOG_INFO("❌ Vitals recording is not supported on this platform: {}", filePath);
+    return false;
+}
+
+void VitalsRecorder::close() {}
+bool VitalsRecorder::ensureBlockMapped(size_t) { return false; }
+
+#else
+
+bool VitalsRecorder::open(const std::string& filePath) {
+    if (isOpen()) {
+        DEVICE_LOG_INFO("❌ Vitals recorder already writing {}", path);
+        return false;
+    }
+
+    fd = ::open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        DEVICE_LOG_INFO("❌ Cannot create vitals recording {}", filePath);
+        return false;
+    }
+
+    path = filePath;
+    mapping = nullptr;
+    mappedBytes = 0;
+    if (!ensureBlockMapped(0)) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+
+    Format::FileHeader header{};
+    std::memcpy(header.magic, Format::kMagic, sizeof(header.magic));
+    header.version = Format::kVersion;
+    header.blockCapacity = Format::kBlockCapacity;
+    header.laneCount = static_cast<uint32_t>(kVitalLaneCount);
+    header.blockBytes = Format::kBlockBytes;
+    std::memcpy(mapping, &header, sizeof(header));
+
+    currentBlock = 0;
+    samplesInBlock = 0;
+    totalSamples = 0;
+    committedSamples.store(0, std::memory_order_relaxed);
+    droppedSamples.store(0, std::memory_order_relaxed);
+    ringHead.store(0, std::memory_order_relaxed);
+    ringTail.store(0, std::memory_order_relaxed);
+    stopRequested = false;
+
+    writer = std::thread(&VitalsRecorder::writerLoop, this);
+    DEVICE_LOG_INFO("⏺️  Recording vitals to {}", path);
+    return true;
+}
+
+void VitalsRecorder::close() {
+    if (!isOpen()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stopRequested = true;
+    }
+    writerWake.notify_one();
+    writer.join();
+
+    // The writer has exited, so the mapping is ours again
+    if (samplesInBlock > 0) {
+        sealBlock();
+    }
+    publish();
+
+    size_t usedBlocks = currentBlock + (samplesInBlock > 0 ? 1 : 0);
+    munmap(mapping, mappedBytes);
+    if (ftruncate(fd, static_cast<off_t>(Format::blockOffset(usedBlocks))) != 0) {
+        DEVICE_LOG_INFO("❌ Could not trim vitals recording {}", path);
+    }
+    ::close(fd);
+
+    mapping = nullptr;
+    mappedBytes = 0;
+    fd = -1;
+    DEVICE_LOG_INFO("⏹️  Vitals recording closed: {} samples, {} dropped", totalSamples, getDroppedCount());
+}
+
+bool VitalsRecorder::ensureBlockMapped(size_t block) {
+    size_t needed = Format::blockOffset(block + 1);
+    if (needed <= mappedBytes) {
+        return true;
+    }
+
+    size_t newBytes = Format::blockOffset(block + kGrowBlocks);
+    if (ftruncate(fd, static_cast<off_t>(newBytes)) != 0) {
+        DEVICE_LOG_INFO("❌ Cannot grow vitals recording {}", path);
+        return false;
+    }
+
+    if (mapping) {
+        munmap(mapping, mappedBytes);
+    }
+    void* mapped = mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        mapping = nullptr;
+        mappedBytes = 0;
+        DEVICE_LOG_INFO("❌ Cannot map vitals recording {}", path);
+        return false;
+    }
+
+    mapping = static_cast<uint8_t*>(mapped);
+    mappedBytes = newBytes;
+    return true;
+}
+
+#endif
+
+bool VitalsRecorder::record(int64_t timestampUs, const VitalSigns& vitals) {
+    if (!isOpen()) {
+        return false;
+    }
+
+    uint32_t head = ringHead.load(std::memory_order_relaxed);
+    uint32_t tail = ringTail.load(std::memory_order_acquire);
+    if (head - tail >= kRingCapacity) {
+        droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    ring[head & kRingMask] = {timestampUs, vitals};
+    ringHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool VitalsRecorder::record(const VitalSigns& vitals) {
+    return record(nowMicros(), vitals);
+}
+
+void VitalsRecorder::flush() {
+    if (!isOpen()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(writerMutex);
+    writerWake.notify_one();
+    drained.wait(lock, [this]() {
+        return ringTail.load(std::memory_order_acquire) == ringHead.load(std::memory_order_acquire);
+    });
+}
+
+void VitalsRecorder::writerLoop() {
+    while (true) {
+        bool worked = drainRing();
+
+        std::unique_lock<std::mutex> lock(writerMutex);
+        if (worked) {
+            drained.notify_all();
+        }
+        if (stopRequested && ringTail.load(std::memory_order_relaxed) == ringHead.load(std::memory_order_acquire)) {
+            drained.notify_all();
+            return;
+        }
+        if (!worked && !stopRequested) {
+            writerWake.wait_for(lock, kWriterInterval);
+        }
+    }
+}
+
+bool VitalsRecorder::drainRing() {
+    uint32_t tail = ringTail.load(std::memory_order_relaxed);
+    uint32_t head = ringHead.load(std::memory_order_acquire);
+    if (tail == head) {
+        return false;
+    }
+
+    for (; tail != head; ++tail) {
+        if (!appendSample(ring[tail & kRingMask])) {
+            droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Column and timestamp bytes must be visible before the new count
+    publish();
+    ringTail.store(tail, std::memory_order_release);
+    return true;
+}
+
+bool VitalsRecorder::appendSample(const Sample& sample) {
+    if (samplesInBlock == 0) {
+        if (!ensureBlockMapped(currentBlock)) {
+            return false;
+        }
+        openBlock(sample.timestampUs);
+    }
+
+    uint8_t* block = mapping + Format::blockOffset(currentBlock);
+    for (size_t lane = 0; lane < kVitalLaneCount; ++lane) {
+        float value = laneValue(sample.vitals, lane);
+        std::memcpy(block + sizeof(Format::BlockHeader) + lane * Format::kColumnBytes + samplesInBlock * sizeof(float),
+                    &value, sizeof(float));
+        blockMin[lane] = std::min(blockMin[lane], value);
+        blockMax[lane] = std::max(blockMax[lane], value);
+    }
+
+    timestampBytes += static_cast<uint32_t>(
+        writeVarint(block + Format::kTimestampOffset + timestampBytes, sample.timestampUs - previousTimestampUs));
+    previousTimestampUs = sample.timestampUs;
+
+    ++samplesInBlock;
+    ++totalSamples;
+
+    if (samplesInBlock == Format::kBlockCapacity) {
+        sealBlock();
+        ++currentBlock;
+        samplesInBlock = 0;
+    }
+    return true;
+}
+
+void VitalsRecorder::openBlock(int64_t timestampUs) {
+    auto* header = reinterpret_cast<Format::BlockHeader*>(mapping + Format::blockOffset(currentBlock));
+    header->firstTimestampUs = timestampUs;
+
+    previousTimestampUs = timestampUs;
+    timestampBytes = 0;
+    std::fill(std::begin(blockMin), std::end(blockMin), std::numeric_limits<float>::max());
+    std::fill(std::begin(blockMax), std::end(blockMax), std::numeric_limits<float>::lowest());
+}
+
+void VitalsRecorder::sealBlock() {
+    auto* header = reinterpret_cast<Format::BlockHeader*>(mapping + Format::blockOffset(currentBlock));
+    header->lastTimestampUs = previousTimestampUs;
+    header->sampleCount = samplesInBlock;
+    header->timestampBytes = timestampBytes;
+    std::copy(std::begin(blockMin), std::end(blockMin), header->min);
+    std::copy(std::begin(blockMax), std::end(blockMax), header->max);
+}
+
+void VitalsRecorder::publish() {
+    if (mapping) {
+        committedField(mapping)->store(totalSamples, std::memory_order_release);
+    }
+    committedSamples.store(totalSamples, std::memory_order_release);
+}
+
+// VitalsRecordingReader
+
+VitalsRecordingReader::VitalsRecordingReader() : fd(-1), mapping(nullptr), mappedBytes(0), sampleCount(0) {}
+
+VitalsRecordingReader::~VitalsRecordingReader() {
+    close();
+}
+
+#if defined(_WIN32)
+
+bool VitalsRecordingReader::open(const std::string& filePath) {
+    DEVICE_LOG_INFO("❌ Vitals recording is not supported on this platform: {}", filePath);
+    return false;
+}
+
+void VitalsRecordingReader::close() {}
+bool VitalsRecordingReader::mapFile() { return false; }
+
+#else
+
+bool VitalsRecordingReader::open(const std::string& filePath) {
+    close();
+
+    fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        DEVICE_LOG_INFO("❌ Cannot open vitals recording {}", filePath);
+        return false;
+    }
+
+    if (!mapFile()) {
+        close();
+        return false;
+    }
+
+    Format::FileHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    if (std::memcmp(header.magic, Format::kMagic, sizeof(header.magic)) != 0 ||
+        header.version != Format::kVersion || header.blockCapacity != Format::kBlockCapacity ||
+        header.laneCount != kVitalLaneCount || header.blockBytes != Format::kBlockBytes) {
+        DEVICE_LOG_INFO("❌ Not a vitals recording: {}", filePath);
+        close();
+        return false;
+    }
+
+    refresh();
+    return true;
+}
+
+void VitalsRecordingReader::close() {
+    if (mapping) {
+        munmap(const_cast<uint8_t*>(mapping), mappedBytes);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    fd = -1;
+    mapping = nullptr;
+    mappedBytes = 0;
+    sampleCount = 0;
+}
+
+bool VitalsRecordingReader::mapFile() {
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Format::FileHeader)) {
+        return false;
+    }
+
+    size_t newBytes = static_cast<size_t>(info.st_size);
+    if (newBytes == mappedBytes) {
+        return true;
+    }
+
+    void* mapped = mmap(nullptr, newBytes, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    if (mapping) {
+        munmap(const_cast<uint8_t*>(mapping), mappedBytes);
+    }
+    mapping = static_cast<const uint8_t*>(mapped);
+    mappedBytes = newBytes;
+    return true;
+}
+
+#endif
+
+bool VitalsRecordingReader::refresh() {
+    if (!mapping) {
+        return false;
+    }
+
+    uint64_t committed = committedField(mapping)->load(std::memory_order_acquire);
+    if (committed == sampleCount) {
+        return false;
+    }
+
+    // The writer grows the file ahead of its samples; follow it if needed
+    size_t blocks = static_cast<size_t>((committed + Format::kBlockCapacity - 1) / Format::kBlockCapacity);
+    if (Format::blockOffset(blocks) > mappedBytes) {
+        mapFile();
+    }
+
+    size_t mappedBlocks = mappedBytes < sizeof(Format::FileHeader)
+        ? 0 : (mappedBytes - sizeof(Format::FileHeader)) / Format::kBlockBytes;
+    uint64_t visible = std::min<uint64_t>(committed, static_cast<uint64_t>(mappedBlocks) * Format::kBlockCapacity);
+
+    bool grew = visible > sampleCount;
+    sampleCount = visible;
+    return grew;
+}
+
+size_t VitalsRecordingReader::getBlockCount() const {
+    return static_cast<size_t>((sampleCount + Format::kBlockCapacity - 1) / Format::kBlockCapacity);
+}
+
+uint32_t VitalsRecordingReader::getBlockSampleCount(size_t block) const {
+    uint64_t first = static_cast<uint64_t>(block) * Format::kBlockCapacity;
+    if (first >= sampleCount) {
+        return 0;
+    }
+    return static_cast<uint32_t>(std::min<uint64_t>(Format::kBlockCapacity, sampleCount - first));
+}
+
+const Format::BlockHeader& VitalsRecordingReader::blockHeader(size_t block) const {
+    return *reinterpret_cast<const Format::BlockHeader*>(mapping + Format::blockOffset(block));
+}
+
+const float* VitalsRecordingReader::getColumn(size_t block, VitalLane lane) const {
+    return reinterpret_cast<const float*>(mapping + Format::blockOffset(block) + sizeof(Format::BlockHeader) +
+                                          static_cast<size_t>(lane) * Format::kColumnBytes);
+}
+
+const uint8_t* VitalsRecordingReader::getTimestampStream(size_t block) const {
+    return mapping + Format::blockOffset(block) + Format::kTimestampOffset;
+}
+
+int64_t VitalsRecordingReader::getBlockFirstTimestamp(size_t block) const {
+    return blockHeader(block).firstTimestampUs;
+}
+
+size_t VitalsRecordingReader::decodeTimestamps(size_t block, int64_t* out) const {
+    uint32_t count = getBlockSampleCount(block);
+    const uint8_t* cursor = getTimestampStream(block);
+    int64_t timestamp = blockHeader(block).firstTimestampUs;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        timestamp += Format::readTimestampDelta(cursor);
+        out[i] = timestamp;
+    }
+    return count;
+}
+
+VitalsRecordingReader::BlockSummary VitalsRecordingReader::getBlockSummary(size_t block) const {
+    BlockSummary summary{};
+    uint32_t count = getBlockSampleCount(block);
+    if (count == 0) {
+        return summary;
+    }
+
+    const Format::BlockHeader& header = blockHeader(block);
+    summary.firstTimestampUs = header.firstTimestampUs;
+    summary.sampleCount = count;
+
+    // Sealed blocks carry their summary; the open block is summarised here
+    if (count == Format::kBlockCapacity) {
+        summary.lastTimestampUs = header.lastTimestampUs;
+        std::copy(std::begin(header.min), std::end(header.min), summary.min);
+        std::copy(std::begin(header.max), std::end(header.max), summary.max);
+        return summary;
+    }
+
+    const uint8_t* cursor = getTimestampStream(block);
+    int64_t timestamp = header.firstTimestampUs;
+    for (uint32_t i = 0; i < count; ++i) {
+        timestamp += Format::readTimestampDelta(cursor);
+    }
+    summary.lastTimestampUs = timestamp;
+
+    for (size_t lane = 0; lane < kVitalLaneCount; ++lane) {
+        const float* column = getColumn(block, static_cast<VitalLane>(lane));
+        auto range = std::minmax_element(column, column + count);
+        summary.min[lane] = *range.first;
+        summary.max[lane] = *range.second;
+    }
+    return summary;
+}
+
+bool VitalsRecordingReader::readSample(uint64_t index, int64_t& timestampUs, VitalSigns& vitals) const {
+    if (index >= sampleCount) {
+        return false;
+    }
+
+    size_t block = static_cast<size_t>(index / Format::kBlockCapacity);
+    uint32_t offset = static_cast<uint32_t>(index % Format::kBlockCapacity);
+
+    const uint8_t* cursor = getTimestampStream(block);
+    timestampUs = blockHeader(block).firstTimestampUs;
+    for (uint32_t i = 0; i <= offset; ++i) {
+        timestampUs += Format::readTimestampDelta(cursor);
+    }
+
+    vitals.oxygenLevel = getColumn(block, VitalLane::OXYGEN_LEVEL)[offset];
+    vitals.heartRate = getColumn(block, VitalLane::HEART_RATE)[offset];
+    vitals.bloodPressure = getColumn(block, VitalLane::BLOOD_PRESSURE)[offset];
+    vitals.temperature = getColumn(block, VitalLane::TEMPERATURE)[offset];
+    vitals.respirationRate = getColumn(block, VitalLane::RESPIRATION_RATE)[offset];
+    return true;
+}
@@ -0,0 +1,226 @@
+#ifndef VITALS_RECORDER_H
+#define VITALS_RECORDER_H
+
+#include "medical_data.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// On-disk layout of a vitals recording. The file is a 64-byte header
+// followed by fixed-size blocks; each block holds one float column per
+// vital and zigzag-varint timestamp deltas after its own summary header.
+namespace VitalsRecordingFormat {
+
+constexpr char kMagic[4] = {'V', 'T', 'L', 'R'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kBlockCapacity = 4096;  // samples per block
+constexpr size_t kMaxVarintBytes = 10;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t blockCapacity;
+    uint32_t laneCount;
+    uint64_t blockBytes;
+    uint64_t committedSamples;  // release-published by the writer
+    uint64_t reserved[4];
+};
+
+// Summary written when a block is opened (timestamps) and sealed (the rest)
+struct BlockHeader {
+    int64_t firstTimestampUs;
+    int64_t lastTimestampUs;
+    uint32_t sampleCount;
+    uint32_t timestampBytes;
+    float min[kVitalLaneCount];
+    float max[kVitalLaneCount];
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader must stay 64 bytes");
+static_assert(sizeof(BlockHeader) == 64, "BlockHeader must stay 64 bytes");
+
+constexpr size_t kColumnBytes = kBlockCapacity * sizeof(float);
+constexpr size_t kTimestampOffset = sizeof(BlockHeader) + kVitalLaneCount * kColumnBytes;
+constexpr size_t kBlockBytes = (kTimestampOffset + kBlockCapacity * kMaxVarintBytes + 4095) & ~size_t(4095);
+
+inline size_t blockOffset(size_t block) { return sizeof(FileHeader) + block * kBlockBytes; }
+
+// Decodes one zigzag-varint timestamp delta and advances the cursor
+inline int64_t readTimestampDelta(const uint8_t*& cursor) {
+    uint64_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        byte = *cursor++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        shift += 7;
+    } while ((byte & 0x80) && shift < 64);
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace VitalsRecordingFormat
+
+/**
+ * @class VitalsRecorder
+ * @brief Append-only, memory-mapped columnar recorder for one vitals stream
+ *
+ * record() only copies the sample into a lock-free single-producer ring, so
+ * the calling (main) thread never waits on disk. A writer thread drains the
+ * ring into the mapped file and publishes the committed sample count with a
+ * release store, which lets a VitalsRecordingReader follow the file while
+ * it is still growing. Samples are dropped, never blocked on, if the ring
+ * fills up.
+ */
+class VitalsRecorder {
+public:
+    VitalsRecorder();
+    ~VitalsRecorder();
+
+    VitalsRecorder(const VitalsRecorder&) = delete;
+    VitalsRecorder& operator=(const VitalsRecorder&) = delete;
+
+    /**
+     * Creates (truncates) the file and starts the writer thread
+     * @param path Destination file
+     * @return false if the file cannot be created or mapped
+     */
+    bool open(const std::string& path);
+
+    // Drains pending samples, seals the last block and trims the file
+    void close();
+
+    bool isOpen() const { return writer.joinable(); }
+
+    /**
+     * Queues one sample; must be called from a single producer thread
+     * @return false if the sample was dropped because the ring is full
+     */
+    bool record(int64_t timestampUs, const VitalSigns& vitals);
+    bool record(const VitalSigns& vitals);
+
+    // Blocks until every queued sample is committed to the mapping
+    void flush();
+
+    uint64_t getCommittedCount() const { return committedSamples.load(std::memory_order_acquire); }
+    uint64_t getDroppedCount() const { return droppedSamples.load(std::memory_order_relaxed); }
+    const std::string& getPath() const { return path; }
+
+    // Wall-clock microseconds used by record(vitals)
+    static int64_t nowMicros();
+
+private:
+    struct Sample {
+        int64_t timestampUs;
+        VitalSigns vitals;
+    };
+
+    static constexpr uint32_t kRingCapacity = 1u << 16; // Must be a power of two
+    static constexpr uint32_t kRingMask = kRingCapacity - 1;
+
+    void writerLoop();
+    bool drainRing();
+    bool appendSample(const Sample& sample);
+    bool ensureBlockMapped(size_t block);
+    void openBlock(int64_t timestampUs);
+    void sealBlock();
+    void publish();
+
+    // Producer/consumer ring
+    alignas(64) std::atomic<uint32_t> ringHead{0};
+    alignas(64) std::atomic<uint32_t> ringTail{0};
+    std::unique_ptr<Sample[]> ring;
+
+    // Writer thread control
+    std::thread writer;
+    std::mutex writerMutex;
+    std::condition_variable writerWake;
+    std::condition_variable drained;
+    bool stopRequested;
+
+    // Mapping, touched only by the writer thread while it runs
+    std::string path;
+    int fd;
+    uint8_t* mapping;
+    size_t mappedBytes;
+    size_t currentBlock;
+    uint32_t samplesInBlock;
+    uint32_t timestampBytes;
+    int64_t previousTimestampUs;
+    float blockMin[kVitalLaneCount];
+    float blockMax[kVitalLaneCount];
+    uint64_t totalSamples;
+
+    std::atomic<uint64_t> committedSamples{0};
+    std::atomic<uint64_t> droppedSamples{0};
+};
+
+/**
+ * @class VitalsRecordingReader
+ * @brief Read-only view of a vitals recording, safe to use during recording
+ *
+ * Only samples below the committed count observed by the last refresh()
+ * are visible. Block summaries of the still-open block are computed from
+ * its committed samples.
+ */
+class VitalsRecordingReader {
+public:
+    struct BlockSummary {
+        int64_t firstTimestampUs;
+        int64_t lastTimestampUs;
+        uint32_t sampleCount;
+        float min[kVitalLaneCount];
+        float max[kVitalLaneCount];
+    };
+
+    VitalsRecordingReader();
+    ~VitalsRecordingReader();
+
+    VitalsRecordingReader(const VitalsRecordingReader&) = delete;
+    VitalsRecordingReader& operator=(const VitalsRecordingReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+
+    /**
+     * Picks up samples committed since the last call, remapping if the file grew
+     * @return true if new samples became visible
+     */
+    bool refresh();
+
+    uint64_t getSampleCount() const { return sampleCount; }
+    size_t getBlockCount() const;
+    uint32_t getBlockSampleCount(size_t block) const;
+
+    // Column of one vital in a block; valid for getBlockSampleCount(block) samples
+    const float* getColumn(size_t block, VitalLane lane) const;
+
+    // Raw timestamp deltas of a block, decoded from its first timestamp
+    const uint8_t* getTimestampStream(size_t block) const;
+    int64_t getBlockFirstTimestamp(size_t block) const;
+
+    /**
+     * Decodes a block's timestamps
+     * @return Number of timestamps written to out
+     */
+    size_t decodeTimestamps(size_t block, int64_t* out) const;
+
+    BlockSummary getBlockSummary(size_t block) const;
+    bool readSample(uint64_t index, int64_t& timestampUs, VitalSigns& vitals) const;
+
+private:
+    bool mapFile();
+    const VitalsRecordingFormat::BlockHeader& blockHeader(size_t block) const;
+
+    int fd;
+    const uint8_t* mapping;
+    size_t mappedBytes;
+    uint64_t sampleCount;
+};
+
+#endif // VITALS_RECORDER_H
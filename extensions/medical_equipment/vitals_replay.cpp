@@ -0,0 +1,100 @@
+#include "vitals_replay.h"
+#include <algorithm>
+
+namespace Format = VitalsRecordingFormat;
+
+VitalsReplay::VitalsReplay()
+    : speed(1.0), playhead(0), position(0), block(0), offset(0), blockSamples(0), nextTimestamp(0),
+      timestampCursor(nullptr), columns{} {}
+
+bool VitalsReplay::open(const std::string& path) {
+    close();
+    if (!reader.open(path)) {
+        return false;
+    }
+
+    refresh();
+    rewind();
+    return true;
+}
+
+void VitalsReplay::close() {
+    reader.close();
+    blockStartTimes.clear();
+    position = 0;
+    playhead = 0;
+}
+
+bool VitalsReplay::refresh() {
+    if (!reader.refresh() && blockStartTimes.size() == reader.getBlockCount()) {
+        return false;
+    }
+
+    // Index blocks that appeared since the last refresh
+    for (size_t b = blockStartTimes.size(); b < reader.getBlockCount(); ++b) {
+        blockStartTimes.push_back(reader.getBlockFirstTimestamp(b));
+    }
+
+    // The reader may have remapped the file, so the cursor's column and timestamp
+    // pointers are rebuilt from its position; a cursor parked at the old end
+    // picks up where the new samples start
+    uint64_t resume = std::min(position, reader.getSampleCount());
+    enterBlock(static_cast<size_t>(resume / Format::kBlockCapacity));
+    while (position < resume) {
+        step();
+    }
+    return true;
+}
+
+int64_t VitalsReplay::getStartTimestamp() const {
+    return blockStartTimes.empty() ? 0 : blockStartTimes.front();
+}
+
+bool VitalsReplay::seek(int64_t timestampUs) {
+    if (!isOpen()) {
+        return false;
+    }
+
+    // Last block starting at or before the target, then scan inside it
+    auto it = std::upper_bound(blockStartTimes.begin(), blockStartTimes.end(), timestampUs);
+    size_t target = it == blockStartTimes.begin() ? 0 : static_cast<size_t>(it - blockStartTimes.begin()) - 1;
+
+    enterBlock(target);
+    while (!isFinished() && nextTimestamp < timestampUs) {
+        step();
+    }
+    playhead = timestampUs;
+    return true;
+}
+
+void VitalsReplay::rewind() {
+    enterBlock(0);
+    playhead = isFinished() ? 0 : nextTimestamp;
+}
+
+void VitalsReplay::enterBlock(size_t newBlock) {
+    block = newBlock;
+    offset = 0;
+    position = static_cast<uint64_t>(newBlock) * Format::kBlockCapacity;
+    blockSamples = reader.getBlockSampleCount(newBlock);
+    if (blockSamples == 0) {
+        position = std::min<uint64_t>(position, reader.getSampleCount());
+        return;
+    }
+
+    for (size_t lane = 0; lane < kVitalLaneCount; ++lane) {
+        columns[lane] = reader.getColumn(newBlock, static_cast<VitalLane>(lane));
+    }
+    timestampCursor = reader.getTimestampStream(newBlock);
+    nextTimestamp = reader.getBlockFirstTimestamp(newBlock) + Format::readTimestampDelta(timestampCursor);
+}
+
+void VitalsReplay::step() {
+    ++position;
+    ++offset;
+    if (offset < blockSamples) {
+        nextTimestamp += Format::readTimestampDelta(timestampCursor);
+    } else if (blockSamples == Format::kBlockCapacity && position < reader.getSampleCount()) {
+        enterBlock(block + 1);
+    }
+}
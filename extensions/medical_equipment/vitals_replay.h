@@ -0,0 +1,121 @@
+#ifndef VITALS_REPLAY_H
+#define VITALS_REPLAY_H
+
+#include "medical_data.h"
+#include "vitals_recorder.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * @class VitalsReplay
+ * @brief Plays a vitals recording back in recorded time, straight from the mapping
+ *
+ * The cursor walks the mapped float columns and decodes one timestamp delta
+ * per sample, so no block is ever copied out of the file. A per-block index
+ * of first timestamps makes seek() a binary search plus a scan within one
+ * block. Recordings are expected to be ordered by timestamp.
+ */
+class VitalsReplay {
+public:
+    VitalsReplay();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return reader.isOpen(); }
+
+    /**
+     * Picks up samples appended since open() when replaying a live recording
+     * @return true if new samples became available
+     */
+    bool refresh();
+
+    // Playback rate: 1.0 is real time, N plays N times faster, <= 0 plays as fast as possible
+    void setSpeed(double newSpeed) { speed = newSpeed; }
+    double getSpeed() const { return speed; }
+
+    uint64_t getSampleCount() const { return reader.getSampleCount(); }
+    uint64_t getSampleIndex() const { return position; }
+    bool isFinished() const { return position >= reader.getSampleCount(); }
+    int64_t getStartTimestamp() const;
+    int64_t getPlayhead() const { return playhead; }
+
+    /**
+     * Moves the cursor to the first sample at or after a timestamp
+     * @param timestampUs Recorded time to seek to
+     * @return false if no recording is open
+     */
+    bool seek(int64_t timestampUs);
+    void rewind();
+
+    /**
+     * Dispatches every sample recorded at or before a timestamp
+     * @param sink Called as sink(timestampUs, vitals) for each sample
+     * @return Number of samples dispatched
+     */
+    template <typename Sink>
+    size_t playUntil(int64_t timestampUs, Sink&& sink);
+
+    /**
+     * Advances the playhead by wall-clock time scaled by the speed
+     * @param elapsedUs Wall-clock microseconds since the previous call
+     * @return Number of samples dispatched
+     */
+    template <typename Sink>
+    size_t advance(int64_t elapsedUs, Sink&& sink);
+
+private:
+    void enterBlock(size_t block);
+    void step();
+
+    VitalsRecordingReader reader;
+    std::vector<int64_t> blockStartTimes;  // seek index, one entry per block
+    double speed;
+    int64_t playhead;
+
+    // Cursor: the sample at `position`, its timestamp and its block columns
+    uint64_t position;
+    size_t block;
+    uint32_t offset;
+    uint32_t blockSamples;
+    int64_t nextTimestamp;
+    const uint8_t* timestampCursor;
+    const float* columns[kVitalLaneCount];
+};
+
+template <typename Sink>
+size_t VitalsReplay::playUntil(int64_t timestampUs, Sink&& sink) {
+    size_t played = 0;
+    while (!isFinished() && nextTimestamp <= timestampUs) {
+        VitalSigns vitals;
+        vitals.oxygenLevel = columns[static_cast<size_t>(VitalLane::OXYGEN_LEVEL)][offset];
+        vitals.heartRate = columns[static_cast<size_t>(VitalLane::HEART_RATE)][offset];
+        vitals.bloodPressure = columns[static_cast<size_t>(VitalLane::BLOOD_PRESSURE)][offset];
+        vitals.temperature = columns[static_cast<size_t>(VitalLane::TEMPERATURE)][offset];
+        vitals.respirationRate = columns[static_cast<size_t>(VitalLane::RESPIRATION_RATE)][offset];
+        sink(nextTimestamp, vitals);
+        step();
+        ++played;
+    }
+    playhead = std::max(playhead, timestampUs);
+    return played;
+}
+
+template <typename Sink>
+size_t VitalsReplay::advance(int64_t elapsedUs, Sink&& sink) {
+    if (speed <= 0.0) {
+        // Leave the playhead on the last sample so a later speed change resumes from there
+        int64_t last = playhead;
+        size_t played = playUntil(std::numeric_limits<int64_t>::max(), [&](int64_t timestampUs, const VitalSigns& vitals) {
+            last = timestampUs;
+            sink(timestampUs, vitals);
+        });
+        playhead = last;
+        return played;
+    }
+    return playUntil(playhead + static_cast<int64_t>(static_cast<double>(elapsedUs) * speed), sink);
+}
+
+#endif // VITALS_REPLAY_H
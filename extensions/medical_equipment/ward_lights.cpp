@@ -0,0 +1,153 @@
+#include "ward_lights.h"
+#include "worker_pool.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace godot;
+
+namespace {
+
+// Strips per worker chunk; a 300-LED strip is only a few microseconds of work
+constexpr size_t kStripsPerChunk = 16;
+
+} // namespace
+
+WardLights::WardLights() : frameWidth(0) {
+    DEVICE_LOG_INFO("💡 WardLights created");
+}
+
+bool WardLights::addBed(Node* bed) {
+    Bed* target = Object::cast_to<Bed>(bed);
+    if (!target) {
+        DEVICE_LOG_INFO("❌ WardLights only accepts Bed nodes");
+        return false;
+    }
+    
+    uint64_t id = target->get_instance_id();
+    if (std::find(bedIds.begin(), bedIds.end(), id) != bedIds.end()) {
+        return false;
+    }
+    bedIds.push_back(id);
+    return true;
+}
+
+bool WardLights::removeBed(Node* bed) {
+    if (!bed) {
+        return false;
+    }
+    
+    auto it = std::find(bedIds.begin(), bedIds.end(), bed->get_instance_id());
+    if (it == bedIds.end()) {
+        return false;
+    }
+    bedIds.erase(it);
+    return true;
+}
+
+void WardLights::clearBeds() {
+    bedIds.clear();
+    strips.clear();
+    frameWidth = 0;
+}
+
+int WardLights::getBedCount() const {
+    return static_cast<int>(bedIds.size());
+}
+
+int WardLights::playAnimation(const Ref<LightAnimation>& animation, double phaseStep) {
+    if (animation.is_null()) {
+        DEVICE_LOG_INFO("❌ No light animation to play");
+        return 0;
+    }
+    if (!animation->isCompiled() && !animation->compile()) {
+        return 0;
+    }
+    
+    // Every strip shares the one lookup table; only the offsets differ
+    collectStrips();
+    std::shared_ptr<const LightTimeline> timeline = animation->getTimeline();
+    for (size_t i = 0; i < strips.size(); ++i) {
+        strips[i]->playTimeline(timeline, static_cast<double>(i) * phaseStep);
+    }
+    return static_cast<int>(strips.size());
+}
+
+void WardLights::stopAnimation() {
+    collectStrips();
+    for (LightStrip* strip : strips) {
+        strip->stopTimeline();
+    }
+}
+
+void WardLights::setGamma(float gamma) {
+    gammaTable = LedGammaTable(std::max(0.1f, gamma));
+}
+
+float WardLights::getGamma() const {
+    return gammaTable.getGamma();
+}
+
+PackedByteArray WardLights::renderFrame(double timeSeconds) {
+    PackedByteArray frame;
+    if (!std::isfinite(timeSeconds)) {
+        DEVICE_LOG_INFO("❌ Ward light frame time must be finite");
+        return frame;
+    }
+    collectStrips();
+    
+    size_t stride = static_cast<size_t>(frameWidth) * 3;
+    frame.resize(static_cast<int64_t>(stride * strips.size()));
+    if (frame.is_empty()) {
+        return frame;
+    }
+    
+    uint8_t* pixels = frame.ptrw();
+    WorkerPool::shared().parallelFor(strips.size(), kStripsPerChunk, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uint8_t* row = pixels + i * stride;
+            size_t used = strips[i]->getLedCount() * 3;
+            strips[i]->renderFrame(timeSeconds);
+            strips[i]->encodeFrame(row, gammaTable);
+            std::memset(row + used, 0, stride - used);
+        }
+    });
+    return frame;
+}
+
+void WardLights::collectStrips() {
+    // Beds freed since the last frame drop out of the ward
+    strips.clear();
+    size_t width = 0;
+    auto live = bedIds.begin();
+    for (uint64_t id : bedIds) {
+        Bed* bed = Object::cast_to<Bed>(ObjectDB::get_instance(id));
+        if (!bed) {
+            continue;
+        }
+        *live++ = id;
+        
+        LightStrip* strip = bed->getLightStrip();
+        if (strip) {
+            strips.push_back(strip);
+            width = std::max(width, strip->getLedCount());
+        }
+    }
+    bedIds.erase(live, bedIds.end());
+    frameWidth = static_cast<int>(width);
+}
+
+void WardLights::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("add_bed", "bed"), &WardLights::addBed);
+    ClassDB::bind_method(D_METHOD("remove_bed", "bed"), &WardLights::removeBed);
+    ClassDB::bind_method(D_METHOD("clear_beds"), &WardLights::clearBeds);
+    ClassDB::bind_method(D_METHOD("get_bed_count"), &WardLights::getBedCount);
+    ClassDB::bind_method(D_METHOD("play_animation", "animation", "phase_step"), &WardLights::playAnimation, DEFVAL(0.0));
+    ClassDB::bind_method(D_METHOD("stop_animation"), &WardLights::stopAnimation);
+    ClassDB::bind_method(D_METHOD("set_gamma", "gamma"), &WardLights::setGamma);
+    ClassDB::bind_method(D_METHOD("get_gamma"), &WardLights::getGamma);
+    ClassDB::bind_method(D_METHOD("render_frame", "time_sec"), &WardLights::renderFrame);
+    ClassDB::bind_method(D_METHOD("get_frame_width"), &WardLights::getFrameWidth);
+    ClassDB::bind_method(D_METHOD("get_frame_height"), &WardLights::getFrameHeight);
+}
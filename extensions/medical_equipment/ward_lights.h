@@ -0,0 +1,60 @@
+#ifndef WARD_LIGHTS_H
+#define WARD_LIGHTS_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include "bed.h"
+#include "led_framebuffer.h"
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+/**
+ * @class WardLights
+ * @brief Godot node rendering the light strips of every bed in a ward at once
+ *
+ * render_frame() evaluates each bed's current LED effect on the worker pool
+ * and returns one RGB8 image: a row per bed, get_frame_width() pixels wide,
+ * with strips shorter than the widest padded black. The bytes can be
+ * uploaded as a texture without touching individual bed nodes.
+ */
+class WardLights : public Node {
+    GDCLASS(WardLights, Node)
+
+private:
+    std::vector<uint64_t> bedIds;  // instance ids, so freed beds are skipped rather than dangling
+    std::vector<LightStrip*> strips;
+    LedGammaTable gammaTable;
+    int frameWidth;
+
+public:
+    WardLights();
+    ~WardLights() = default;
+
+    // Ward membership
+    bool addBed(Node* bed);
+    bool removeBed(Node* bed);
+    void clearBeds();
+    int getBedCount() const;
+
+    // Plays one compiled animation on every bed, bed i offset by i * phaseStep seconds
+    int playAnimation(const Ref<LightAnimation>& animation, double phaseStep);
+    void stopAnimation();
+
+    void setGamma(float gamma);
+    float getGamma() const;
+
+    // Frame of every live bed, in the order they were added
+    PackedByteArray renderFrame(double timeSeconds);
+    int getFrameWidth() const { return frameWidth; }
+    int getFrameHeight() const { return static_cast<int>(strips.size()); }
+
+protected:
+    static void _bind_methods();
+
+private:
+    void collectStrips();
+};
+
+#endif // WARD_LIGHTS_H
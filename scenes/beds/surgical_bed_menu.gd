@@ -99,6 +99,8 @@ func initialize_cpp_extension():
 			if cpp_surgical_bed:
 				print("✅ C++ SurgicalBed created successfully")
 				cpp_surgical_bed.set_name("SurgicalBedMenu_CPP")
+				# The bed steps its lift from _process, which only runs inside the scene tree
+				add_child(cpp_surgical_bed)
 				
 				# Power on the bed for testing
 				cpp_surgical_bed.power_on()
@@ -320,7 +322,7 @@ func set_bed_height(height: BedHeight):
 	if cpp_surgical_bed:
 		cpp_surgical_bed.set_height(target_height)
 		var actual_height = cpp_surgical_bed.get_height()
-		print("🔧 C++ Bed height set to: ", actual_height, " cm (", BedHeight.keys()[height], ")")
+		print("🔧 C++ Bed height: ", actual_height, " cm, moving to ", cpp_surgical_bed.get_target_height(), " cm (", BedHeight.keys()[height], ")")
 	else:
 		print("🎭 Simulated bed height set to: ", target_height, " cm (", BedHeight.keys()[height], ")")
 	
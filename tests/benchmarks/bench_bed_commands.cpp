@@ -0,0 +1,123 @@
+// Bed command benchmark: one command stream vs one call per operation
+//
+// Drives a ward of beds through a frame of per-bed commands (height, light
+// brightness, temperature) two ways: one BedWardState call per operation,
+// as a script calling a bound method per bed does, and one command stream
+// run by executeCommands(), as BedWard.execute_commands() does. Reports
+// the mean time per frame and per command, and the stream's size. Only the
+// native side is timed: from GDScript the per-call path also pays one
+// script-to-native crossing per operation, which the stream pays once.
+// Run by hand:
+//     ./bed_commands_benchmark [beds] [repeats]
+
+#include "bed_commands.h"
+#include "bed_ward_state.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+// Commands per bed per frame, not counting the selection
+constexpr size_t kCommandsPerBed = 3;
+
+float targetHeight(size_t bed, int frame) {
+    return 50.0f + static_cast<float>((bed + static_cast<size_t>(frame)) % 30);
+}
+
+float targetBrightness(size_t bed, int frame) {
+    return static_cast<float>((bed * 7 + static_cast<size_t>(frame)) % 100) / 100.0f;
+}
+
+uint8_t targetMode(size_t bed, int frame) {
+    return static_cast<uint8_t>((bed + static_cast<size_t>(frame)) % 3);
+}
+
+void encodeFrame(BedCommandWriter& writer, size_t beds, int frame) {
+    writer.clear();
+    for (size_t i = 0; i < beds; ++i) {
+        writer.selectBed(static_cast<uint32_t>(i))
+            .setHeight(targetHeight(i, frame))
+            .setLightBrightness(targetBrightness(i, frame))
+            .setTemperature(targetMode(i, frame));
+    }
+}
+
+void fillWard(BedWardState& ward, size_t beds) {
+    ward.addBeds(beds, BedWardState::BedKind::PATIENT);
+    ward.powerOnMasked(nullptr);
+}
+
+void report(const char* name, double ms, size_t commands) {
+    std::printf("%-16s %12.3f %12.1f\n", name, ms, ms * 1e6 / static_cast<double>(commands));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t beds = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 500;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 2000;
+    if (beds == 0 || repeats <= 0) {
+        std::printf("usage: bed_commands_benchmark [beds] [repeats]\n");
+        return 1;
+    }
+
+    const size_t commands = beds * kCommandsPerBed;
+    std::printf("%zu beds, %zu commands per frame\n\n", beds, commands);
+    std::printf("%-16s %12s %12s\n", "path", "frame ms", "ns / cmd");
+
+    // One call per operation
+    {
+        BedWardState ward;
+        fillWard(ward, beds);
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            for (size_t i = 0; i < beds; ++i) {
+                ward.setHeight(i, targetHeight(i, r));
+                ward.setBrightness(i, targetBrightness(i, r));
+                ward.setTemperature(i, static_cast<BedWardState::TemperatureMode>(targetMode(i, r)));
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+        report("per call", ms, commands);
+    }
+
+    // The stream is built once per frame here, as a script would
+    BedCommandWriter writer;
+    std::vector<uint8_t> statuses;
+    {
+        BedWardState ward;
+        fillWard(ward, beds);
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            encodeFrame(writer, beds, r);
+            statuses.resize(writer.getBytes().size());
+            ward.executeCommands(writer.getBytes().data(), writer.getBytes().size(), statuses.data());
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+        report("encode + stream", ms, commands);
+    }
+
+    // Execution alone, against streams encoded up front
+    {
+        BedWardState ward;
+        fillWard(ward, beds);
+        std::vector<std::vector<uint8_t>> frames(2);
+        for (int f = 0; f < 2; ++f) {
+            encodeFrame(writer, beds, f);
+            frames[static_cast<size_t>(f)] = writer.getBytes();
+        }
+        statuses.resize(frames[0].size());
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            const std::vector<uint8_t>& frame = frames[static_cast<size_t>(r % 2)];
+            ward.executeCommands(frame.data(), frame.size(), statuses.data());
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+        report("stream", ms, commands);
+        std::printf("\nstream: %zu bytes per frame, %.1f bytes per command\n", frames[0].size(),
+                    static_cast<double>(frames[0].size()) / static_cast<double>(commands));
+    }
+    return 0;
+}
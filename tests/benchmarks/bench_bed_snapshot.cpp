@@ -0,0 +1,68 @@
+// Bed snapshot benchmark: saving and restoring a whole ward
+//
+// Fills a ward, saves it as a column snapshot and restores it into a fresh
+// BedWardState, as BedWard.save_snapshot() and load_snapshot() do. Reports
+// the mean save and load times, the load time per bed and the file size.
+// Loading maps the file and copies each column in one block; the file is
+// warm in the page cache after the first save, so this is the restore cost
+// without disk latency. Run by hand:
+//     ./bed_snapshot_benchmark [beds] [repeats] [path]
+
+#include "bed_snapshot.h"
+#include "bed_ward_state.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+void fillWard(BedWardState& ward, size_t beds) {
+    ward.addBeds(beds / 2, BedWardState::BedKind::PATIENT);
+    ward.addBeds(beds - beds / 2, BedWardState::BedKind::SURGICAL);
+    ward.powerOnMasked(nullptr);
+    for (size_t i = 0; i < beds; ++i) {
+        ward.setHeight(i, 60.0f + static_cast<float>(i % 40));
+        ward.setBrightness(i, static_cast<float>(i % 100) / 100.0f);
+    }
+    ward.step(0.25);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t beds = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 10000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 200;
+    std::string path = argc > 3 ? argv[3] : "bed_snapshot_benchmark.beds";
+    if (beds == 0 || repeats <= 0) {
+        std::printf("usage: bed_snapshot_benchmark [beds] [repeats] [path]\n");
+        return 1;
+    }
+
+    BedWardState saved;
+    fillWard(saved, beds);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        if (!saved.saveSnapshot(path)) {
+            return 1;
+        }
+    }
+    double saveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+
+    BedWardState restored;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        if (!restored.loadSnapshot(path)) {
+            return 1;
+        }
+    }
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+
+    std::printf("%zu beds, %zu bytes per snapshot\n\n", beds,
+                sizeof(BedSnapshotFormat::FileHeader) + BedSnapshotFormat::getWardPayloadBytes(beds));
+    std::printf("save %10.3f ms\n", saveMs);
+    std::printf("load %10.3f ms  (%.1f ns / bed)\n", loadMs, loadMs * 1e6 / static_cast<double>(beds));
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,64 @@
+// LED frame benchmark: time to render and encode every strip in a ward
+//
+// Renders each effect on a ward of strips, the same way WardLights does,
+// and reports the mean time per ward frame and per LED. A 500-bed ward of
+// 300-LED strips should fit comfortably inside one 60 Hz frame. Run by hand:
+//     ./led_frame_benchmark [beds] [leds_per_strip] [repeats]
+
+#include "led_framebuffer.h"
+#include "worker_pool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const char* effectName(LedEffect::Type type) {
+    switch (type) {
+        case LedEffect::Type::SOLID: return "solid";
+        case LedEffect::Type::GRADIENT: return "gradient";
+        case LedEffect::Type::PULSE: return "pulse";
+        case LedEffect::Type::CHASE: return "chase";
+        case LedEffect::Type::STROBE: return "strobe";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t beds = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 500;
+    size_t leds = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 300;
+    int repeats = argc > 3 ? std::atoi(argv[3]) : 200;
+    if (beds == 0 || leds == 0 || repeats <= 0) {
+        std::printf("usage: led_frame_benchmark [beds] [leds_per_strip] [repeats]\n");
+        return 1;
+    }
+
+    std::vector<LedFramebuffer> strips(beds, LedFramebuffer(leds));
+    std::vector<uint8_t> frame(beds * leds * 3);
+    LedColor warm = {1.0f, 0.9f, 0.7f};
+    LedColor dark = {0.02f, 0.02f, 0.05f};
+
+    std::printf("%zu strips x %zu LEDs, %zu worker threads\n\n", beds, leds, WorkerPool::shared().getThreadCount());
+    std::printf("%-10s %12s %12s\n", "effect", "frame ms", "ns / LED");
+
+    for (const LedEffect& effect : {LedEffect::solid(warm), LedEffect::gradient(warm, dark),
+                                    LedEffect::pulse(warm, 0.5f, 0.2f), LedEffect::chase(warm, dark, 60.0f, 12.0f),
+                                    LedEffect::strobe({1.0f, 0.0f, 0.0f}, 2.0f, 0.5f)}) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            double time = r / 60.0;
+            WorkerPool::shared().parallelFor(beds, 16, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    strips[i].render(effect, time);
+                    strips[i].encodeRgb8(frame.data() + i * leds * 3, 0.8f);
+                }
+            });
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+        std::printf("%-10s %12.3f %12.2f\n", effectName(effect.type), ms, ms * 1e6 / static_cast<double>(beds * leds));
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Scan pixel hand-off benchmark: bytes copied and allocated per completed scan
+//
+// Replays the path a finished scan takes from the worker thread to Godot
+// (job result -> Scanner::currentScan -> ScannerDevice::storedScans -> the
+// exported PackedByteArray) with the old std::string payload and with
+// pooled, shared ScanImage handles. Run by hand:
+//     ./scan_buffer_benchmark [scans]
+
+#include "scan_buffer_pool.h"
+#include "scan_job.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> allocatedBytes{0};
+
+} // namespace
+
+// Counts every heap allocation made while the benchmark runs
+void* operator new(std::size_t size) {
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+
+constexpr size_t kSliceBytes = static_cast<size_t>(ScanJob::kSliceWidth) * ScanJob::kSliceHeight * 2;
+
+struct Result {
+    double bytesCopied;
+    double bytesAllocated;
+    double microseconds;
+};
+
+// Same phantom for both paths so only the hand-off differs
+void renderSlice(uint16_t* pixels) {
+    for (uint32_t y = 0; y < ScanJob::kSliceHeight; ++y) {
+        for (uint32_t x = 0; x < ScanJob::kSliceWidth; ++x) {
+            pixels[static_cast<size_t>(y) * ScanJob::kSliceWidth + x] = static_cast<uint16_t>(1000 + ((x ^ y) & 63));
+        }
+    }
+}
+
+// The pre-pool layout: ScanData carried its pixels in a std::string
+struct LegacyScanData {
+    std::string scanType;
+    std::string imageData;
+};
+
+Result runLegacy(int scans) {
+    LegacyScanData currentScan;
+    std::map<std::string, LegacyScanData> storedScans;
+    std::vector<uint8_t> exported;
+    uint64_t copied = 0;
+
+    uint64_t allocatedBefore = allocatedBytes.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < scans; ++i) {
+        // Worker: fresh payload per scan
+        LegacyScanData result;
+        result.scanType = "brain";
+        result.imageData.resize(kSliceBytes);
+        renderSlice(reinterpret_cast<uint16_t*>(&result.imageData[0]));
+
+        // Scanner::poll copies the job result, the device stores another copy
+        currentScan = result;
+        copied += kSliceBytes;
+        storedScans[result.scanType] = currentScan;
+        copied += kSliceBytes;
+
+        // Godot export copies again
+        exported.assign(currentScan.imageData.begin(), currentScan.imageData.end());
+        copied += kSliceBytes;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocated = allocatedBytes.load() - allocatedBefore;
+
+    return {static_cast<double>(copied) / scans, static_cast<double>(allocated) / scans,
+            std::chrono::duration<double, std::micro>(elapsed).count() / scans};
+}
+
+Result runPooled(int scans) {
+    ScanBufferPool pool;
+    ScanData currentScan;
+    std::map<std::string, ScanData> storedScans;
+    std::vector<uint8_t> exported;
+    ScanImageHandle exportedImage;
+
+    uint64_t allocatedBefore = allocatedBytes.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < scans; ++i) {
+        // Worker: fills a recycled buffer and publishes it
+        ScanBufferPool::Buffer buffer = pool.acquire(ScanJob::kSliceWidth, ScanJob::kSliceHeight);
+        renderSlice(buffer.pixels16());
+        ScanData result("brain");
+        result.image = pool.publish(std::move(buffer));
+
+        // Scanner and device share the handle
+        currentScan = result;
+        storedScans[result.scanType] = currentScan;
+
+        // Godot export: one copy per new image, as SurgicalBed::getScanPixels does
+        if (exportedImage != currentScan.image) {
+            exportedImage = currentScan.image;
+            exported.assign(exportedImage->data(), exportedImage->data() + exportedImage->getByteSize());
+            pool.recordCopy(exportedImage->getByteSize());
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocated = allocatedBytes.load() - allocatedBefore;
+
+    return {static_cast<double>(pool.getStats().bytesCopied) / scans, static_cast<double>(allocated) / scans,
+            std::chrono::duration<double, std::micro>(elapsed).count() / scans};
+}
+
+void report(const char* name, const Result& result) {
+    std::printf("%-8s %14.0f %16.0f %12.1f\n", name, result.bytesCopied, result.bytesAllocated, result.microseconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int scans = argc > 1 ? std::atoi(argv[1]) : 200;
+    if (scans <= 0) {
+        scans = 200;
+    }
+
+    // Warm both paths so steady-state numbers are compared
+    runLegacy(4);
+    runPooled(4);
+
+    Result legacy = runLegacy(scans);
+    Result pooled = runPooled(scans);
+
+    std::printf("%d scans of %ux%u 16-bit slices (%zu bytes each)\n\n", scans, ScanJob::kSliceWidth,
+                ScanJob::kSliceHeight, kSliceBytes);
+    std::printf("%-8s %14s %16s %12s\n", "path", "copied/scan", "allocated/scan", "us/scan");
+    report("legacy", legacy);
+    report("pooled", pooled);
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Tiled scan benchmark: time to first pixel and full-resolution load time
+//
+// Writes square scans of growing size as tiled files, then measures how
+// long ScanTileStream::open() takes to produce the coarse image and how long
+// streaming every finer tile takes. Time to first pixel should stay flat as
+// the resolution grows. Run by hand:
+//     ./scan_tiles_benchmark [directory] [repeats]
+
+#include "scan_tiles.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace {
+
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Body-like content: air around an ellipse of textured tissue
+ScanImageHandle makeScan(uint32_t size) {
+    ScanBufferPool::Buffer buffer = ScanBufferPool::shared().acquire(size, size);
+    uint16_t* pixels = buffer.pixels16();
+    double half = size / 2.0;
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            double dx = (x - half) / (half * 0.8);
+            double dy = (y - half) / (half * 0.6);
+            bool inside = dx * dx + dy * dy < 1.0;
+            pixels[static_cast<size_t>(y) * size + x] = inside ? static_cast<uint16_t>(800 + (x * 31 + y * 17) % 400) : 0;
+        }
+    }
+    return ScanBufferPool::shared().publish(std::move(buffer));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string directory = argc > 1 ? argv[1] : "/tmp";
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 10;
+    if (repeats <= 0) {
+        repeats = 10;
+    }
+
+    std::printf("%zu worker threads, %u pixel tiles\n\n", WorkerPool::shared().getThreadCount(),
+                ScanTileFormat::kDefaultTileSize);
+    std::printf("%-8s %8s %10s %14s %14s\n", "size", "levels", "file MB", "first px ms", "full load ms");
+
+    for (uint32_t size : {512u, 1024u, 2048u, 4096u}) {
+        std::string path = directory + "/scan_tiles_benchmark_" + std::to_string(size) + ".bin";
+        if (!ScanTileFormat::write(path, *makeScan(size))) {
+            std::printf("cannot write %s\n", path.c_str());
+            return 1;
+        }
+
+        double firstPixelMs = 0.0;
+        double fullLoadMs = 0.0;
+        uint32_t levels = 0;
+        for (int i = 0; i < repeats; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            ScanTileStream stream;
+            if (!stream.open(path)) {
+                std::printf("cannot read %s\n", path.c_str());
+                return 1;
+            }
+            firstPixelMs += elapsedMilliseconds(start);
+            levels = stream.getLevelCount();
+
+            stream.start();
+            while (!stream.isFinished()) {
+                stream.poll([](const ScanTileStream::TileUpdate&) {});
+                std::this_thread::yield();
+            }
+            fullLoadMs += elapsedMilliseconds(start);
+        }
+
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        std::fseek(file, 0, SEEK_END);
+        double fileMb = static_cast<double>(std::ftell(file)) / (1024.0 * 1024.0);
+        std::fclose(file);
+        std::remove(path.c_str());
+
+        std::printf("%-8u %8u %10.2f %14.3f %14.3f\n", size, levels, fileMb, firstPixelMs / repeats,
+                    fullLoadMs / repeats);
+    }
+    return 0;
+}
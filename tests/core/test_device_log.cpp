@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// DeviceLog is Godot-free, so the real implementation is tested directly
+#include "device_log.h"
+
+namespace {
+
+// Collects every line handed to the sink
+struct CapturedLines {
+    std::mutex mutex;
+    std::vector<std::string> lines;
+
+    DeviceLog::Sink sink() {
+        return [this](const std::string& batch) {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t start = 0;
+            while (start <= batch.size()) {
+                size_t end = batch.find('\n', start);
+                if (end == std::string::npos) {
+                    end = batch.size();
+                }
+                lines.push_back(batch.substr(start, end - start));
+                start = end + 1;
+            }
+        };
+    }
+};
+
+std::string format(const LogRecord& record) {
+    std::string out;
+    DeviceLog::formatRecord(record, out);
+    return out;
+}
+
+} // namespace
+
+class DeviceLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        DeviceLog::setLevel(LogLevel::TRACE);
+    }
+
+    void TearDown() override {
+        DeviceLog::stop();
+        DeviceLog::setLevel(LogLevel::INFO);
+    }
+};
+
+// Test placeholder expansion for every argument kind
+TEST_F(DeviceLogTest, FormatsPlaceholders) {
+    LogRecord record{};
+    record.format = "Height {} cm on {} ({} beds)";
+    record.argCount = 3;
+    record.args[0] = LogArg(85.5f);
+    record.args[1] = LogArg("SurgicalBed");
+    record.args[2] = LogArg(12);
+
+    EXPECT_EQ(format(record), "Height 85.5 cm on SurgicalBed (12 beds)");
+}
+
+// Test that missing arguments leave the placeholder untouched
+TEST_F(DeviceLogTest, ExtraPlaceholdersAreKept) {
+    LogRecord record{};
+    record.format = "{} and {}";
+    record.argCount = 1;
+    record.args[0] = LogArg(true);
+
+    EXPECT_EQ(format(record), "true and {}");
+}
+
+// Test that long text arguments are truncated to the fixed slot
+TEST_F(DeviceLogTest, TruncatesLongText) {
+    std::string longText(100, 'x');
+    LogArg arg(longText);
+
+    EXPECT_EQ(std::string(arg.text).size(), LogArg::kTextCapacity - 1);
+}
+
+// Test that disabled levels skip argument evaluation entirely
+TEST_F(DeviceLogTest, DisabledLevelSkipsArguments) {
+    DeviceLog::setLevel(LogLevel::ALERT);
+
+    int evaluations = 0;
+    auto expensive = [&evaluations]() { return ++evaluations; };
+    DEVICE_LOG_DEBUG("value {}", expensive());
+
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_FALSE(DeviceLog::isEnabled(LogLevel::INFO));
+    EXPECT_TRUE(DeviceLog::isEnabled(LogLevel::ALERT));
+}
+
+// Test asynchronous delivery preserves order from one thread
+TEST_F(DeviceLogTest, AsyncDeliveryPreservesOrder) {
+    CapturedLines captured;
+    DeviceLog::start(captured.sink(), std::chrono::milliseconds(1));
+
+    for (int i = 0; i < 100; ++i) {
+        DeviceLog::write(LogLevel::INFO, "record {}", i);
+    }
+    DeviceLog::stop();
+
+    ASSERT_EQ(captured.lines.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(captured.lines[i], "record " + std::to_string(i));
+    }
+}
+
+// Test that records from several producer threads are all delivered
+TEST_F(DeviceLogTest, MultipleProducersAreDrained) {
+    CapturedLines captured;
+    uint64_t droppedBefore = DeviceLog::getDroppedCount();
+    DeviceLog::start(captured.sink(), std::chrono::milliseconds(1));
+
+    const int kThreads = 4;
+    const int kRecordsPerThread = 200;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([t]() {
+            for (int i = 0; i < kRecordsPerThread; ++i) {
+                DeviceLog::write(LogLevel::INFO, "thread {} record {}", t, i);
+                if (i % 50 == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    DeviceLog::stop();
+
+    EXPECT_EQ(captured.lines.size() + (DeviceLog::getDroppedCount() - droppedBefore),
+              static_cast<size_t>(kThreads * kRecordsPerThread));
+}
+
+// Test compile-time tiers: ALERT survives any minimum tier
+TEST_F(DeviceLogTest, CompiledTiers) {
+    static_assert(LogTier<LogLevel::ALERT>::compiled, "ALERT must always be compiled in");
+    EXPECT_EQ(LogTier<LogLevel::TRACE>::compiled, DEVICE_LOG_MIN_TIER <= 0);
+    EXPECT_EQ(LogTier<LogLevel::INFO>::compiled, DEVICE_LOG_MIN_TIER <= 2);
+}
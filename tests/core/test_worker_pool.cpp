@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <vector>
+
+// WorkerPool is Godot-free, so the real implementation is tested directly
+#include "worker_pool.h"
+
+// Test that every index is visited exactly once
+TEST(WorkerPoolTest, ParallelForCoversRange) {
+    WorkerPool pool(3);
+    std::vector<std::atomic<int>> visits(10000);
+
+    pool.parallelFor(visits.size(), 64, [&visits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            visits[i].fetch_add(1);
+        }
+    });
+
+    for (auto& count : visits) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+// Test that small and empty ranges run inline
+TEST(WorkerPoolTest, SmallRanges) {
+    WorkerPool pool(2);
+    int calls = 0;
+    pool.parallelFor(0, 16, [&calls](size_t, size_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+
+    pool.parallelFor(10, 16, [&calls](size_t begin, size_t end) {
+        EXPECT_EQ(begin, 0u);
+        EXPECT_EQ(end, 10u);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 1);
+}
+
+// Test asynchronous job submission
+TEST(WorkerPoolTest, SubmitRunsJobs) {
+    WorkerPool pool(2);
+    std::promise<int> result;
+    auto future = result.get_future();
+
+    pool.submit([&result]() { result.set_value(42); });
+
+    EXPECT_EQ(future.get(), 42);
+    EXPECT_EQ(pool.getThreadCount(), 2u);
+}
+
+// Test that parallelFor called from a worker cannot deadlock the pool
+TEST(WorkerPoolTest, NestedParallelFor) {
+    WorkerPool pool(1);
+    std::promise<size_t> result;
+    auto future = result.get_future();
+
+    pool.submit([&pool, &result]() {
+        std::atomic<size_t> total{0};
+        pool.parallelFor(1000, 10, [&total](size_t begin, size_t end) {
+            total.fetch_add(end - begin);
+        });
+        result.set_value(total.load());
+    });
+
+    EXPECT_EQ(future.get(), 1000u);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// BedCommand streams and BedWardState are Godot-free, so the real implementation is tested directly
+#include "bed_commands.h"
+#include "bed_ward_state.h"
+
+class BedCommandsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ward.addBeds(3, BedWardState::BedKind::PATIENT);
+        ward.addBeds(1, BedWardState::BedKind::SURGICAL);
+    }
+
+    std::vector<uint8_t> run(const std::vector<uint8_t>& stream) {
+        std::vector<uint8_t> statuses(stream.size());
+        statuses.resize(ward.executeCommands(stream.data(), stream.size(), statuses.data()));
+        return statuses;
+    }
+
+    BedWardState ward;
+    BedCommandWriter writer;
+};
+
+// Test that written commands decode back with their arguments, little-endian
+TEST_F(BedCommandsTest, RoundTripsThroughTheReader) {
+    writer.setHeight(72.5f).setTemperature(2).setLightColor(PackedColor(10, 20, 30, 40)).selectBed(0x01020304u).powerOff();
+    const std::vector<uint8_t>& bytes = writer.getBytes();
+    EXPECT_EQ(bytes.size(), 5u + 2u + 5u + 5u + 1u);
+    EXPECT_EQ(bytes[13], 0x04);  // low byte of the slot first
+
+    BedCommandReader reader(bytes.data(), bytes.size());
+    BedCommand command;
+    BedCommand::Status status;
+    ASSERT_TRUE(reader.next(command, status));
+    EXPECT_EQ(command.opcode, BedCommand::SET_HEIGHT);
+    EXPECT_FLOAT_EQ(command.value, 72.5f);
+    ASSERT_TRUE(reader.next(command, status));
+    EXPECT_EQ(command.mode, 2);
+    ASSERT_TRUE(reader.next(command, status));
+    EXPECT_EQ(command.color, PackedColor(10, 20, 30, 40));
+    ASSERT_TRUE(reader.next(command, status));
+    EXPECT_EQ(command.slot, 0x01020304u);
+    ASSERT_TRUE(reader.next(command, status));
+    EXPECT_EQ(command.opcode, BedCommand::POWER_OFF);
+    EXPECT_EQ(status, BedCommand::OK);
+    EXPECT_FALSE(reader.next(command, status));
+}
+
+// Test that an unknown opcode or truncated arguments end the stream with one status
+TEST_F(BedCommandsTest, MalformedStreamsStop) {
+    std::vector<uint8_t> unknown = {BedCommand::POWER_ON, 0xEE, BedCommand::POWER_OFF};
+    EXPECT_EQ(run(unknown), (std::vector<uint8_t>{BedCommand::OK, BedCommand::UNKNOWN_OPCODE}));
+    EXPECT_EQ(ward.countPowered(), 4u);
+
+    std::vector<uint8_t> truncated = {BedCommand::POWER_OFF, BedCommand::SET_HEIGHT, 0x00, 0x00};
+    EXPECT_EQ(run(truncated), (std::vector<uint8_t>{BedCommand::OK, BedCommand::TRUNCATED}));
+    EXPECT_TRUE(run({}).empty());
+}
+
+// Test that commands apply to the whole ward until a bed is selected
+TEST_F(BedCommandsTest, SelectsBeds) {
+    writer.powerOn().setLightBrightness(0.25f).selectBed(2).setLightBrightness(0.75f).setTemperature(0)
+        .selectAll().setLightColor(PackedColor(1, 2, 3));
+    std::vector<uint8_t> statuses = run(writer.getBytes());
+    EXPECT_EQ(statuses, std::vector<uint8_t>(7, BedCommand::OK));
+
+    EXPECT_EQ(ward.countPowered(), 4u);
+    EXPECT_FLOAT_EQ(ward.getBrightness()[0], 0.25f);
+    EXPECT_FLOAT_EQ(ward.getBrightness()[2], 0.75f);
+    EXPECT_EQ(ward.getTemperatureModes()[1], static_cast<uint8_t>(BedWardState::TemperatureMode::NEUTRAL));
+    EXPECT_EQ(ward.getTemperatureModes()[2], static_cast<uint8_t>(BedWardState::TemperatureMode::COLD));
+    EXPECT_EQ(ward.getColors()[3], PackedColor(1, 2, 3));
+}
+
+// Test the per-command statuses for state and argument errors
+TEST_F(BedCommandsTest, ReportsPerCommandStatus) {
+    writer.setHeight(60.0f)                                      // every bed is off
+        .setTemperature(2)
+        .selectBed(0).powerOn().setHeight(60.0f).queueHeight(80.0f)
+        .setHeight(200.0f)                                       // above a patient bed's range
+        .setHeight(std::numeric_limits<float>::quiet_NaN())
+        .raiseHeight(5.0f)                                       // from the 80 cm queued target
+        .setTemperature(9)
+        .selectBed(42).powerOn()                                 // bad slot selects nothing
+        .selectAll().setHeight(100.0f);                          // only the surgical bed reaches 100 cm, and it is off
+    std::vector<uint8_t> expected = {BedCommand::REJECTED, BedCommand::REJECTED,
+                                     BedCommand::OK, BedCommand::OK, BedCommand::OK, BedCommand::OK,
+                                     BedCommand::INVALID_ARGUMENT, BedCommand::INVALID_ARGUMENT, BedCommand::OK,
+                                     BedCommand::INVALID_ARGUMENT,
+                                     BedCommand::INVALID_ARGUMENT, BedCommand::NO_TARGET,
+                                     BedCommand::OK, BedCommand::REJECTED};
+    EXPECT_EQ(run(writer.getBytes()), expected);
+
+    EXPECT_FLOAT_EQ(ward.getTargetHeight(0), 85.0f);
+    EXPECT_EQ(ward.countPowered(), 1u);
+    EXPECT_EQ(ward.getTemperatureModes()[0], static_cast<uint8_t>(BedWardState::TemperatureMode::NEUTRAL));
+}
+
+// Test that a stream moves lifts and sets temperatures the same way the slot operations do
+TEST_F(BedCommandsTest, MatchesPerCallPath) {
+    BedWardState direct;
+    direct.addBeds(3, BedWardState::BedKind::PATIENT);
+    direct.addBeds(1, BedWardState::BedKind::SURGICAL);
+    direct.powerOnMasked(nullptr);
+    for (size_t i = 0; i < direct.size(); ++i) {
+        direct.setHeight(i, 70.0f + static_cast<float>(i));
+        direct.setEmergency(i, i % 2 == 0);
+    }
+    direct.powerOff(1);
+    EXPECT_EQ(direct.setTemperatureMasked(nullptr, BedWardState::TemperatureMode::WARM), direct.size() - 1);
+
+    writer.powerOn();
+    for (uint32_t i = 0; i < ward.size(); ++i) {
+        writer.selectBed(i).setHeight(70.0f + static_cast<float>(i));
+        if (i % 2 == 0) {
+            writer.triggerEmergency();
+        }
+    }
+    writer.selectBed(1).powerOff().setTemperature(2).selectAll().setTemperature(2);
+    std::vector<uint8_t> statuses = run(writer.getBytes());
+    ASSERT_GE(statuses.size(), 3u);
+    EXPECT_EQ(statuses[statuses.size() - 3], BedCommand::REJECTED);  // the powered-off bed alone
+    EXPECT_EQ(statuses.back(), BedCommand::OK);
+
+    for (int frame = 0; frame < 600; ++frame) {
+        direct.step(1.0 / 60.0);
+        ward.step(1.0 / 60.0);
+    }
+    for (size_t i = 0; i < ward.size(); ++i) {
+        EXPECT_FLOAT_EQ(ward.getHeights()[i], direct.getHeights()[i]) << i;
+        EXPECT_EQ(ward.getEmergency()[i], direct.getEmergency()[i]) << i;
+        EXPECT_EQ(ward.getTemperatureModes()[i], direct.getTemperatureModes()[i]) << i;
+    }
+    EXPECT_FLOAT_EQ(ward.getHeights()[3], 73.0f);
+    EXPECT_EQ(ward.getTemperatureModes()[1], static_cast<uint8_t>(BedWardState::TemperatureMode::NEUTRAL));
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Bed snapshots and BedWardState are Godot-free, so the real implementation is tested directly
+#include "bed_snapshot.h"
+#include "bed_ward_state.h"
+
+namespace Format = BedSnapshotFormat;
+
+class BedSnapshotTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    static BedSnapshot surgicalRecord(float height) {
+        BedSnapshot snapshot;
+        snapshot.kind = BedSnapshot::SURGICAL;
+        snapshot.set(BedSnapshot::POWERED, true);
+        snapshot.set(BedSnapshot::STERILE, true);
+        snapshot.minHeight = 60.0f;
+        snapshot.maxHeight = 120.0f;
+        snapshot.height = height;
+        snapshot.targetHeight = height + 10.0f;
+        snapshot.maxVelocity = 4.0f;
+        snapshot.maxAcceleration = 8.0f;
+        snapshot.maxJerk = 40.0f;
+        snapshot.lightBrightness = 0.9f;
+        snapshot.lightColor = PackedColor(255, 248, 220);
+        BedSnapshot::setText(snapshot.procedure, sizeof(snapshot.procedure), "cardiac");
+        return snapshot;
+    }
+
+    std::string path = ::testing::TempDir() + "bed_snapshot_test.beds";
+};
+
+// Test that flags and text fields round-trip, and text longer than its field is cut
+TEST_F(BedSnapshotTest, FlagsAndText) {
+    BedSnapshot snapshot = surgicalRecord(80.0f);
+    EXPECT_TRUE(snapshot.has(BedSnapshot::STERILE));
+    EXPECT_FALSE(snapshot.has(BedSnapshot::PROCEDURE));
+    snapshot.set(BedSnapshot::STERILE, false);
+    EXPECT_FALSE(snapshot.has(BedSnapshot::STERILE));
+    EXPECT_TRUE(snapshot.has(BedSnapshot::POWERED));
+
+    EXPECT_EQ(BedSnapshot::getText(snapshot.procedure, sizeof(snapshot.procedure)), "cardiac");
+    std::string longId(100, 'x');
+    BedSnapshot::setText(snapshot.patientId, sizeof(snapshot.patientId), longId);
+    EXPECT_EQ(BedSnapshot::getText(snapshot.patientId, sizeof(snapshot.patientId)),
+              std::string(BedSnapshot::kPatientIdBytes - 1, 'x'));
+}
+
+// Test that encoded records decode in place and foreign or damaged buffers are refused
+TEST_F(BedSnapshotTest, EncodesAndValidatesRecords) {
+    std::vector<BedSnapshot> records = {surgicalRecord(70.0f), surgicalRecord(90.0f)};
+    std::vector<uint8_t> bytes = Format::encodeRecords(records.data(), records.size());
+    ASSERT_EQ(bytes.size(), sizeof(Format::FileHeader) + 2 * sizeof(BedSnapshot));
+
+    size_t count = 0;
+    const BedSnapshot* decoded = Format::decodeRecords(bytes.data(), bytes.size(), count);
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(count, 2u);
+    EXPECT_EQ(std::memcmp(decoded, records.data(), 2 * sizeof(BedSnapshot)), 0);
+
+    EXPECT_EQ(Format::decodeRecords(bytes.data(), bytes.size() - 1, count), nullptr);
+
+    std::vector<uint8_t> newer = bytes;
+    newer[offsetof(Format::FileHeader, version)] = 2;
+    EXPECT_EQ(Format::decodeRecords(newer.data(), newer.size(), count), nullptr);
+
+    std::vector<uint8_t> huge = bytes;
+    uint64_t bogus = ~0ull;
+    std::memcpy(huge.data() + offsetof(Format::FileHeader, count), &bogus, sizeof(bogus));
+    EXPECT_EQ(Format::decodeRecords(huge.data(), huge.size(), count), nullptr);
+
+    // A ward file is not a record file
+    Format::FileHeader header;
+    EXPECT_FALSE(Format::validate(bytes.data(), bytes.size(), Format::Payload::WARD_COLUMNS, header));
+}
+
+// Test that a record file maps back with its records in place
+TEST_F(BedSnapshotTest, MapsRecordFile) {
+    std::vector<BedSnapshot> records;
+    for (int i = 0; i < 100; ++i) {
+        records.push_back(surgicalRecord(60.0f + static_cast<float>(i % 50)));
+    }
+    ASSERT_TRUE(Format::writeRecords(path, records.data(), records.size()));
+
+    BedSnapshotMapping mapping;
+    ASSERT_TRUE(mapping.open(path, Format::Payload::BED_RECORDS));
+    EXPECT_EQ(mapping.getCount(), records.size());
+    ASSERT_NE(mapping.getRecords(), nullptr);
+    EXPECT_EQ(mapping.getColumn(Format::Column::HEIGHT), nullptr);
+    EXPECT_FLOAT_EQ(mapping.getRecords()[42].height, records[42].height);
+    EXPECT_EQ(std::memcmp(mapping.getRecords(), records.data(), records.size() * sizeof(BedSnapshot)), 0);
+
+    BedSnapshotMapping wrongKind;
+    EXPECT_FALSE(wrongKind.open(path, Format::Payload::WARD_COLUMNS));
+    EXPECT_FALSE(wrongKind.open(path + ".missing", Format::Payload::BED_RECORDS));
+}
+
+// Test that a ward restores every column and its lifts carry on to their targets
+TEST_F(BedSnapshotTest, RestoresWard) {
+    BedWardState saved;
+    saved.addBeds(5, BedWardState::BedKind::PATIENT);
+    saved.addBeds(3, BedWardState::BedKind::SURGICAL);
+    saved.powerOn(1);
+    saved.powerOn(6);
+    saved.powerOn(2);
+    saved.setHeight(1, 80.0f);
+    saved.setHeight(6, 110.0f);
+    saved.step(0.5);
+    saved.setTemperature(2, BedWardState::TemperatureMode::WARM);
+    saved.setBrightness(3, 0.4f);
+    saved.setColor(4, PackedColor(1, 2, 3, 4));
+    saved.setEmergency(7, true);
+    ASSERT_TRUE(saved.saveSnapshot(path));
+
+    BedWardState restored;
+    restored.addBeds(2, BedWardState::BedKind::SURGICAL);
+    ASSERT_TRUE(restored.loadSnapshot(path));
+    ASSERT_EQ(restored.size(), saved.size());
+    for (size_t i = 0; i < saved.size(); ++i) {
+        EXPECT_FLOAT_EQ(restored.getHeights()[i], saved.getHeights()[i]) << i;
+        EXPECT_EQ(restored.getPowered()[i], saved.getPowered()[i]) << i;
+        EXPECT_EQ(restored.getTemperatureModes()[i], saved.getTemperatureModes()[i]) << i;
+        EXPECT_FLOAT_EQ(restored.getBrightness()[i], saved.getBrightness()[i]) << i;
+        EXPECT_EQ(restored.getColors()[i], saved.getColors()[i]) << i;
+        EXPECT_EQ(restored.getEmergency()[i], saved.getEmergency()[i]) << i;
+        EXPECT_EQ(restored.getKind(i), saved.getKind(i)) << i;
+    }
+    EXPECT_TRUE(restored.isHeightMoving(1));
+    EXPECT_FLOAT_EQ(restored.getTargetHeight(6), 110.0f);
+
+    for (int frame = 0; frame < 1200; ++frame) {
+        restored.step(1.0 / 60.0);
+    }
+    EXPECT_FLOAT_EQ(restored.getHeights()[1], 80.0f);
+    EXPECT_FLOAT_EQ(restored.getHeights()[6], 110.0f);
+}
+
+// Test that a large ward survives the round trip and a record file is refused as a ward
+TEST_F(BedSnapshotTest, LargeWardRoundTrip) {
+    BedWardState saved;
+    saved.addBeds(10000, BedWardState::BedKind::PATIENT);
+    saved.powerOnMasked(nullptr);
+    for (size_t i = 0; i < saved.size(); i += 7) {
+        saved.setEmergency(i, true);
+    }
+    ASSERT_TRUE(saved.saveSnapshot(path));
+
+    BedWardState restored;
+    ASSERT_TRUE(restored.loadSnapshot(path));
+    EXPECT_EQ(restored.size(), 10000u);
+    EXPECT_EQ(restored.countPowered(), 10000u);
+    EXPECT_EQ(restored.countEmergencies(), saved.countEmergencies());
+
+    BedSnapshot record = surgicalRecord(80.0f);
+    ASSERT_TRUE(Format::writeRecords(path, &record, 1));
+    EXPECT_FALSE(restored.loadSnapshot(path));
+    EXPECT_EQ(restored.size(), 10000u);  // a refused file leaves the ward as it was
+}
+
+// Test that records and ward columns with NaN or out-of-range values are refused
+TEST_F(BedSnapshotTest, RefusesCorruptValues) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    BedSnapshot record = surgicalRecord(80.0f);
+    EXPECT_TRUE(record.isValid());
+    std::vector<BedSnapshot> corrupt(6, record);
+    corrupt[0].targetHeight = nan;
+    corrupt[1].targetHeight = 130.0f;
+    corrupt[2].temperatureMode = 3;
+    corrupt[3].maxJerk = nan;
+    corrupt[4].lightBrightness = 2.0f;
+    corrupt[5].swivelAngle = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < corrupt.size(); ++i) {
+        EXPECT_FALSE(corrupt[i].isValid()) << i;
+    }
+
+    BedWardState saved;
+    saved.addBeds(4, BedWardState::BedKind::PATIENT);
+    saved.powerOnMasked(nullptr);
+    saved.setHeight(2, 70.0f);
+    ASSERT_TRUE(saved.saveSnapshot(path));
+
+    // Edits the file in place: one value of one column
+    auto patch = [this](BedSnapshotFormat::Column column, size_t slot, const void* value, size_t bytes) {
+        std::FILE* file = std::fopen(path.c_str(), "r+b");
+        ASSERT_NE(file, nullptr);
+        std::fseek(file, static_cast<long>(Format::getColumnOffset(column, 4) + slot * bytes), SEEK_SET);
+        std::fwrite(value, 1, bytes, file);
+        std::fclose(file);
+    };
+
+    BedWardState restored;
+    restored.addBeds(1, BedWardState::BedKind::SURGICAL);
+    patch(Format::Column::TARGET_HEIGHT, 2, &nan, sizeof(nan));
+    EXPECT_FALSE(restored.loadSnapshot(path));
+    EXPECT_EQ(restored.size(), 1u);
+
+    ASSERT_TRUE(saved.saveSnapshot(path));
+    uint8_t mode = 7;
+    patch(Format::Column::TEMPERATURE, 1, &mode, sizeof(mode));
+    EXPECT_FALSE(restored.loadSnapshot(path));
+
+    ASSERT_TRUE(saved.saveSnapshot(path));
+    float level = -0.5f;
+    patch(Format::Column::BRIGHTNESS, 3, &level, sizeof(level));
+    EXPECT_FALSE(restored.loadSnapshot(path));
+
+    ASSERT_TRUE(saved.saveSnapshot(path));
+    EXPECT_TRUE(restored.loadSnapshot(path));
+    EXPECT_EQ(restored.size(), 4u);
+}
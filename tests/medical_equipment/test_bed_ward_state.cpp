@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+// BedWardState is Godot-free, so the real implementation is tested directly
+#include "bed_ward_state.h"
+
+using BedKind = BedWardState::BedKind;
+using TemperatureMode = BedWardState::TemperatureMode;
+
+class BedWardStateTest : public ::testing::Test {
+protected:
+    static constexpr size_t kPatients = 300;
+    static constexpr size_t kSurgical = 200;
+
+    void SetUp() override {
+        ward.addBeds(kPatients, BedKind::PATIENT);
+        ward.addBeds(kSurgical, BedKind::SURGICAL);
+    }
+
+    // Every other bed
+    std::vector<uint8_t> evenMask() const {
+        std::vector<uint8_t> mask(ward.size(), 0);
+        for (size_t i = 0; i < mask.size(); i += 2) {
+            mask[i] = 1;
+        }
+        return mask;
+    }
+
+    void settle() {
+        for (int frame = 0; frame < 60 * 60; ++frame) {
+            ward.step(1.0 / 60.0);
+        }
+    }
+
+    BedWardState ward;
+};
+
+// Test that new beds start at their kind's defaults, powered off
+TEST_F(BedWardStateTest, StartsAtKindDefaults) {
+    EXPECT_EQ(ward.size(), kPatients + kSurgical);
+    EXPECT_FLOAT_EQ(ward.getHeights()[0], 55.0f);
+    EXPECT_FLOAT_EQ(ward.getHeights()[kPatients], 85.0f);
+    EXPECT_EQ(ward.getKind(kPatients), BedKind::SURGICAL);
+    EXPECT_EQ(ward.countPowered(), 0u);
+    EXPECT_EQ(ward.getTemperatureModes()[3], static_cast<uint8_t>(TemperatureMode::NEUTRAL));
+    EXPECT_EQ(ward.addBeds(1, BedKind::PATIENT), kPatients + kSurgical);
+}
+
+// Test that powering on by mask touches only the selected beds and counts real changes
+TEST_F(BedWardStateTest, PowersOnByMask) {
+    std::vector<uint8_t> mask = evenMask();
+    EXPECT_EQ(ward.powerOnMasked(mask.data()), ward.size() / 2);
+    EXPECT_EQ(ward.powerOnMasked(mask.data()), 0u);  // already on
+    EXPECT_TRUE(ward.getPowered()[0]);
+    EXPECT_FALSE(ward.getPowered()[1]);
+    EXPECT_TRUE(ward.getLightsOn()[0]);
+    EXPECT_FALSE(ward.getLightsOn()[1]);
+
+    EXPECT_EQ(ward.powerOnMasked(nullptr), ward.size() / 2);
+    EXPECT_EQ(ward.countPowered(), ward.size());
+    EXPECT_EQ(ward.powerOffMasked(mask.data()), ward.size() / 2);
+    EXPECT_FALSE(ward.getLightsOn()[0]);
+}
+
+// Test that batch heights move only powered beds, within each kind's range, and land after stepping
+TEST_F(BedWardStateTest, SetsHeightsInBatch) {
+    std::vector<uint8_t> mask = evenMask();
+    ward.powerOnMasked(mask.data());
+
+    std::vector<float> targets(ward.size(), 80.0f);
+    targets[2] = 130.0f;  // out of range for a patient bed
+    EXPECT_EQ(ward.setHeights(targets.data(), targets.size()), ward.size() / 2 - 1);
+    EXPECT_FLOAT_EQ(ward.getTargetHeight(0), 80.0f);
+    EXPECT_FLOAT_EQ(ward.getTargetHeight(1), 55.0f);
+    EXPECT_TRUE(ward.isHeightMoving(0));
+
+    settle();
+    EXPECT_FLOAT_EQ(ward.getHeights()[0], 80.0f);
+    EXPECT_FLOAT_EQ(ward.getHeights()[1], 55.0f);
+    EXPECT_FLOAT_EQ(ward.getHeights()[2], 55.0f);
+    EXPECT_FLOAT_EQ(ward.getHeights()[kPatients], 80.0f);
+    EXPECT_FALSE(ward.isHeightMoving(0));
+    EXPECT_EQ(ward.step(1.0), 0);  // idle lifts cost nothing
+
+    // One height for a masked subset; surgical beds reject a patient-only height
+    ward.powerOnMasked(nullptr);
+    EXPECT_EQ(ward.setHeightMasked(nullptr, 45.0f), kPatients);
+    settle();
+    EXPECT_FLOAT_EQ(ward.getHeights()[1], 45.0f);
+    EXPECT_FLOAT_EQ(ward.getHeights()[kPatients + 1], 85.0f);
+}
+
+// Test temperature, light and emergency columns under masks
+TEST_F(BedWardStateTest, UpdatesColumnsByMask) {
+    std::vector<uint8_t> mask = evenMask();
+    ward.powerOnMasked(nullptr);
+    EXPECT_EQ(ward.setTemperatureMasked(mask.data(), TemperatureMode::WARM), ward.size() / 2);
+    EXPECT_EQ(ward.getTemperatureModes()[0], static_cast<uint8_t>(TemperatureMode::WARM));
+    EXPECT_EQ(ward.getTemperatureModes()[1], static_cast<uint8_t>(TemperatureMode::NEUTRAL));
+    EXPECT_FLOAT_EQ(BedWardState::getTemperatureValue(TemperatureMode::WARM), 26.0f);
+
+    ward.setBrightnessMasked(mask.data(), 2.0f);
+    ward.setColorMasked(nullptr, PackedColor(255, 0, 0));
+    EXPECT_FLOAT_EQ(ward.getBrightness()[0], 1.0f);
+    EXPECT_EQ(ward.getColors()[7], PackedColor(255, 0, 0));
+
+    // NaN is refused rather than stored, infinities clamp like any other value
+    EXPECT_EQ(ward.setBrightnessMasked(nullptr, std::nanf("")), 0u);
+    EXPECT_FALSE(ward.setBrightness(0, std::nanf("")));
+    EXPECT_FLOAT_EQ(ward.getBrightness()[0], 1.0f);
+    EXPECT_TRUE(ward.setBrightness(1, -INFINITY));
+    EXPECT_FLOAT_EQ(ward.getBrightness()[1], 0.0f);
+
+    EXPECT_EQ(ward.setEmergencyMasked(mask.data(), true), ward.size() / 2);
+    EXPECT_EQ(ward.setEmergencyMasked(nullptr, true), ward.size() / 2);  // only the newly raised ones
+    EXPECT_EQ(ward.countEmergencies(), ward.size());
+    EXPECT_TRUE(ward.setEmergency(5, false));
+    EXPECT_FALSE(ward.setEmergency(5, false));
+    EXPECT_EQ(ward.countEmergencies(), ward.size() - 1);
+}
+
+// Test that single-slot operations reject out-of-range slots and clear empties the ward
+TEST_F(BedWardStateTest, GuardsSlotsAndClears) {
+    EXPECT_FALSE(ward.powerOn(ward.size()));
+    EXPECT_FALSE(ward.setHeight(0, 70.0f));  // powered off
+    EXPECT_FALSE(ward.setTemperature(0, TemperatureMode::WARM));
+    EXPECT_TRUE(ward.powerOn(0));
+    EXPECT_TRUE(ward.setHeight(0, 70.0f));
+    EXPECT_TRUE(ward.setTemperature(0, TemperatureMode::WARM));
+
+    ward.clear();
+    EXPECT_EQ(ward.size(), 0u);
+    EXPECT_EQ(ward.step(1.0), 0);
+    EXPECT_EQ(ward.powerOnMasked(nullptr), 0u);
+}
+
+// Test that powered-off beds ignore temperature changes, singly and under a mask
+TEST_F(BedWardStateTest, PoweredOffBedsKeepTemperature) {
+    std::vector<uint8_t> mask = evenMask();
+    ward.powerOnMasked(mask.data());
+    EXPECT_EQ(ward.setTemperatureMasked(nullptr, TemperatureMode::COLD), ward.size() / 2);
+    EXPECT_FALSE(ward.setTemperature(1, TemperatureMode::WARM));
+    EXPECT_EQ(ward.getTemperatureModes()[0], static_cast<uint8_t>(TemperatureMode::COLD));
+    EXPECT_EQ(ward.getTemperatureModes()[1], static_cast<uint8_t>(TemperatureMode::NEUTRAL));
+
+    // The maintenance check reports what the bed holds
+    EXPECT_EQ(ward.inspect(1).temperatureMode, static_cast<uint8_t>(TemperatureMode::NEUTRAL));
+    EXPECT_EQ(ward.inspect(0).status, MaintenanceRecord::STATUS_POWERED);
+}
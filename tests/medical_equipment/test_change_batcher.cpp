@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+// ChangeBatcher is Godot-free, so the real implementation is tested directly
+#include "change_batcher.h"
+
+class ChangeBatcherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 4; ++i) {
+            trackers.push_back(std::make_unique<ChangeTracker>());
+            ASSERT_TRUE(batcher.add(trackers.back().get()));
+        }
+    }
+
+    ChangeBatcher batcher;
+    std::vector<std::unique_ptr<ChangeTracker>> trackers;
+};
+
+// Test that repeated changes to one tracker coalesce into one entry, in first-change order
+TEST_F(ChangeBatcherTest, CoalescesPerTracker) {
+    trackers[2]->markChanged(BedChange::HEIGHT);
+    trackers[0]->markChanged(BedChange::LIGHTS);
+    for (int frame = 0; frame < 10; ++frame) {
+        trackers[2]->markChanged(BedChange::HEIGHT);
+    }
+    trackers[2]->markChanged(BedChange::TARGET_HEIGHT);
+
+    const std::vector<ChangeBatcher::Change>& changes = batcher.flush();
+    ASSERT_EQ(changes.size(), 2u);
+    EXPECT_EQ(changes[0].tracker, trackers[2].get());
+    EXPECT_EQ(changes[0].properties, BedChange::HEIGHT | BedChange::TARGET_HEIGHT);
+    EXPECT_EQ(changes[1].tracker, trackers[0].get());
+    EXPECT_EQ(changes[1].properties, static_cast<uint32_t>(BedChange::LIGHTS));
+
+    EXPECT_EQ(batcher.getStats().totalMarks, 13u);
+    EXPECT_EQ(batcher.getStats().totalChanges, 2u);
+    EXPECT_EQ(trackers[2]->getPendingChanges(), 0u);
+}
+
+// Test that an unchanged frame flushes nothing and empty or unknown bits are ignored
+TEST_F(ChangeBatcherTest, QuietFramesAreEmpty) {
+    EXPECT_TRUE(batcher.flush().empty());
+    trackers[1]->markChanged(0);
+    trackers[1]->markChanged(1u << 31);
+    EXPECT_TRUE(batcher.flush().empty());
+    EXPECT_EQ(batcher.getStats().flushes, 2u);
+    EXPECT_EQ(batcher.getStats().totalMarks, 0u);
+}
+
+// Test that changes made while a batch is handled go into the next batch
+TEST_F(ChangeBatcherTest, ChangesDuringFlushWaitForNextFrame) {
+    trackers[0]->markChanged(BedChange::POWER);
+    const std::vector<ChangeBatcher::Change>& first = batcher.flush();
+    ASSERT_EQ(first.size(), 1u);
+
+    // A handler reacting to the power change
+    first[0].tracker->markChanged(BedChange::TEMPERATURE);
+    EXPECT_EQ(batcher.getStats().pending, 1u);
+
+    const std::vector<ChangeBatcher::Change>& second = batcher.flush();
+    ASSERT_EQ(second.size(), 1u);
+    EXPECT_EQ(second[0].properties, static_cast<uint32_t>(BedChange::TEMPERATURE));
+}
+
+// Test that removed and destroyed trackers drop out of pending changes
+TEST_F(ChangeBatcherTest, RemovedTrackersDropOut) {
+    trackers[0]->markChanged(BedChange::POWER);
+    trackers[1]->markChanged(BedChange::POWER);
+    trackers[3]->markChanged(BedChange::POWER);
+    EXPECT_TRUE(batcher.remove(trackers[1].get()));
+    EXPECT_FALSE(batcher.remove(trackers[1].get()));
+    trackers[3].reset();
+    EXPECT_EQ(batcher.size(), 2u);
+
+    const std::vector<ChangeBatcher::Change>& changes = batcher.flush();
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].tracker, trackers[0].get());
+
+    // Unregistered trackers keep their bits but report nowhere; rejoining starts clean
+    trackers[1]->markChanged(BedChange::LIGHTS);
+    EXPECT_EQ(trackers[1]->getPendingChanges(), static_cast<uint32_t>(BedChange::LIGHTS));
+    EXPECT_TRUE(batcher.add(trackers[1].get()));
+    EXPECT_EQ(trackers[1]->getPendingChanges(), 0u);
+    EXPECT_TRUE(batcher.flush().empty());
+
+    // One batcher per tracker
+    ChangeBatcher other;
+    EXPECT_FALSE(other.add(trackers[0].get()));
+}
+
+// Test that a batch scales with changed trackers, not with all of them
+TEST_F(ChangeBatcherTest, LargeFleetFlushesOnlyChanges) {
+    ChangeBatcher fleet;
+    std::vector<std::unique_ptr<ChangeTracker>> beds;
+    for (int i = 0; i < 10000; ++i) {
+        beds.push_back(std::make_unique<ChangeTracker>());
+        fleet.add(beds.back().get());
+    }
+    for (size_t i = 0; i < beds.size(); i += 100) {
+        beds[i]->markChanged(BedChange::HEIGHT);
+        beds[i]->markChanged(BedChange::SCANNER);
+    }
+
+    const std::vector<ChangeBatcher::Change>& changes = fleet.flush();
+    ASSERT_EQ(changes.size(), 100u);
+    for (size_t i = 0; i < changes.size(); ++i) {
+        EXPECT_EQ(changes[i].tracker, beds[i * 100].get());
+        EXPECT_EQ(changes[i].properties, BedChange::HEIGHT | BedChange::SCANNER);
+    }
+    fleet.clear();
+    beds.clear();
+}
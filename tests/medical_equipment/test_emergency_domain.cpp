@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+// EmergencyDomainTree is Godot-free, so the real implementation is tested directly
+#include "emergency_domain.h"
+
+using Level = EmergencyDomainTree::Level;
+
+class EmergencyDomainTest : public ::testing::Test {
+protected:
+    EmergencyDomainTree tree;
+    int32_t floor1 = 0;
+    int32_t floor2 = 0;
+    int32_t icu = 0;
+    int32_t room101 = 0;
+    int32_t room102 = 0;
+
+    void SetUp() override {
+        floor1 = tree.addDomain(EmergencyDomainTree::kRootDomain, "Floor 1");
+        floor2 = tree.addDomain(EmergencyDomainTree::kRootDomain, "Floor 2");
+        icu = tree.addDomain(floor1, "ICU");
+        room101 = tree.addDomain(icu, "101");
+        room102 = tree.addDomain(icu, "102");
+    }
+
+    bool poll(EmergencyDomainTree::Subscription& subscription) {
+        EmergencyDomainTree::Update update;
+        return tree.poll(subscription, update);
+    }
+};
+
+// Test that domains take the level below their parent and rooms cannot have children
+TEST_F(EmergencyDomainTest, BuildsHierarchy) {
+    EXPECT_EQ(tree.getDomainCount(), 6u);
+    EXPECT_EQ(tree.getLevel(EmergencyDomainTree::kRootDomain), Level::HOSPITAL);
+    EXPECT_EQ(tree.getLevel(floor2), Level::FLOOR);
+    EXPECT_EQ(tree.getLevel(icu), Level::WARD);
+    EXPECT_EQ(tree.getLevel(room102), Level::ROOM);
+    EXPECT_EQ(tree.getParent(room102), icu);
+    EXPECT_EQ(tree.getParent(EmergencyDomainTree::kRootDomain), EmergencyDomainTree::kNoDomain);
+    EXPECT_EQ(tree.getName(icu), "ICU");
+
+    EXPECT_EQ(tree.addDomain(room101, "Closet"), EmergencyDomainTree::kNoDomain);
+    EXPECT_EQ(tree.addDomain(99, "Nowhere"), EmergencyDomainTree::kNoDomain);
+    EXPECT_FALSE(tree.broadcast(99));
+}
+
+// Test that one broadcast reaches every subscriber below it and nothing outside the subtree
+TEST_F(EmergencyDomainTest, BroadcastMarksSubtree) {
+    std::vector<EmergencyDomainTree::Subscription> beds;
+    for (int i = 0; i < 50; ++i) {
+        beds.push_back(tree.subscribe(i % 2 ? room101 : room102));
+    }
+    EmergencyDomainTree::Subscription elsewhere = tree.subscribe(floor2);
+
+    uint64_t before = tree.getEpoch();
+    EXPECT_TRUE(tree.broadcast(floor1));
+    EXPECT_EQ(tree.getEpoch(), before + 1);  // one stamp, however many beds
+
+    for (auto& bed : beds) {
+        EXPECT_TRUE(poll(bed));
+        EXPECT_TRUE(bed.active);
+    }
+    EXPECT_FALSE(poll(elsewhere));
+    EXPECT_FALSE(elsewhere.active);
+    EXPECT_TRUE(tree.isActive(room101));
+    EXPECT_FALSE(tree.isActive(floor2));
+}
+
+// Test that an unchanged epoch is a no-op and a repeated poll reports nothing new
+TEST_F(EmergencyDomainTest, PollIsLazy) {
+    EmergencyDomainTree::Subscription bed = tree.subscribe(room101);
+    EXPECT_FALSE(poll(bed));
+
+    tree.broadcast(room101);
+    EXPECT_TRUE(poll(bed));
+    EXPECT_EQ(bed.seenEpoch, tree.getEpoch());
+    EXPECT_FALSE(poll(bed));
+
+    // Another floor's event moves the epoch but not this bed's state
+    tree.broadcast(floor2);
+    EXPECT_FALSE(poll(bed));
+    EXPECT_TRUE(bed.active);
+}
+
+// Test that the newest event on the path wins in both directions
+TEST_F(EmergencyDomainTest, NewestEventOnPathWins) {
+    EmergencyDomainTree::Subscription in101 = tree.subscribe(room101);
+    EmergencyDomainTree::Subscription in102 = tree.subscribe(room102);
+
+    tree.broadcast(floor1);
+    tree.clear(room101);
+    poll(in101);
+    poll(in102);
+    EXPECT_FALSE(in101.active);
+    EXPECT_TRUE(in102.active);
+
+    // A newer broadcast above overrides the room's clear
+    tree.broadcast(EmergencyDomainTree::kRootDomain);
+    EXPECT_TRUE(poll(in101));
+    EXPECT_TRUE(in101.active);
+
+    tree.clear(EmergencyDomainTree::kRootDomain);
+    EXPECT_TRUE(poll(in101));
+    EXPECT_TRUE(poll(in102));
+    EXPECT_FALSE(in101.active);
+    EXPECT_FALSE(in102.active);
+}
+
+// Test that a late subscriber catches up and a subscriber of a removed domain goes inactive
+TEST_F(EmergencyDomainTest, SubscribersCatchUpAndSurviveReset) {
+    tree.broadcast(icu);
+
+    EmergencyDomainTree::Subscription late = tree.subscribe(room102);
+    EXPECT_TRUE(poll(late));
+    EXPECT_TRUE(late.active);
+
+    tree.reset();
+    EXPECT_EQ(tree.getDomainCount(), 1u);
+    EXPECT_TRUE(poll(late));
+    EXPECT_FALSE(late.active);
+    EXPECT_EQ(late.domain, EmergencyDomainTree::kNoDomain);
+}
+
+// Test that a subscription from before a reset does not bind to a domain that reuses its id
+TEST_F(EmergencyDomainTest, ResetInvalidatesSubscriptions) {
+    EmergencyDomainTree::Subscription old = tree.subscribe(room101);
+    tree.broadcast(room101);
+    EXPECT_TRUE(poll(old));
+    EXPECT_TRUE(old.active);
+
+    // Rebuilt without broadcasts: room101's id now names a quiet domain
+    tree.reset();
+    SetUp();
+    ASSERT_TRUE(tree.isValid(room101));
+    EXPECT_TRUE(poll(old));
+    EXPECT_FALSE(old.active);
+    EXPECT_EQ(old.domain, EmergencyDomainTree::kNoDomain);
+
+    // Never-subscribed defaults are dropped too, and fresh subscriptions work
+    EmergencyDomainTree::Subscription unbound;
+    unbound.domain = room101;
+    EXPECT_FALSE(poll(unbound));
+    EXPECT_EQ(unbound.domain, EmergencyDomainTree::kNoDomain);
+
+    EmergencyDomainTree::Subscription fresh = tree.subscribe(room101);
+    tree.broadcast(icu);
+    EXPECT_TRUE(poll(fresh));
+    EXPECT_TRUE(fresh.active);
+    EXPECT_FALSE(poll(old));
+}
+
+// Test that a subscriber moved from an active domain to one with no events goes inactive
+TEST_F(EmergencyDomainTest, MovingToQuietDomainClears) {
+    EmergencyDomainTree::Subscription bed = tree.subscribe(room101);
+    tree.broadcast(room101);
+    EXPECT_TRUE(poll(bed));
+    EXPECT_TRUE(bed.active);
+
+    // Re-assigned the way Bed::setEmergencyDomain does it, carrying the old state over
+    bool wasActive = bed.active;
+    bed = tree.subscribe(floor2);
+    bed.active = wasActive;
+    EXPECT_TRUE(poll(bed));
+    EXPECT_FALSE(bed.active);
+    EXPECT_EQ(bed.active, tree.isActive(floor2));
+    EXPECT_FALSE(poll(bed));
+}
+
+// Test that latency and delivery counts are recorded against the level that raised the event
+TEST_F(EmergencyDomainTest, RecordsLatencyPerLevel) {
+    std::vector<EmergencyDomainTree::Subscription> beds(10, tree.subscribe(room101));
+
+    tree.broadcast(icu);
+    for (auto& bed : beds) {
+        poll(bed);
+    }
+    tree.clear(floor1);
+    poll(beds[0]);
+
+    EmergencyDomainTree::LevelStats ward = tree.getLevelStats(Level::WARD);
+    EXPECT_EQ(ward.broadcasts, 1u);
+    EXPECT_EQ(ward.deliveries, 10u);
+    EXPECT_GE(ward.maxLatencyUs, ward.lastLatencyUs);
+    EXPECT_GE(ward.averageLatencyUs, 0.0);
+
+    EmergencyDomainTree::LevelStats floor = tree.getLevelStats(Level::FLOOR);
+    EXPECT_EQ(floor.clears, 1u);
+    EXPECT_EQ(floor.deliveries, 1u);
+    EXPECT_EQ(tree.getLevelStats(Level::HOSPITAL).deliveries, 0u);
+
+    tree.resetStats();
+    EXPECT_EQ(tree.getLevelStats(Level::WARD).deliveries, 0u);
+}
+
+// Test that subscribers joining after a broadcast catch up without counting as deliveries
+TEST_F(EmergencyDomainTest, LateSubscribersAreNotDeliveries) {
+    tree.broadcast(icu);
+
+    EmergencyDomainTree::Subscription late = tree.subscribe(room101);
+    EXPECT_TRUE(poll(late));
+    EXPECT_TRUE(late.active);
+    EXPECT_EQ(tree.getLevelStats(Level::WARD).deliveries, 0u);
+    EXPECT_EQ(tree.getLevelStats(Level::WARD).maxLatencyUs, 0);
+
+    // The next event raised after it joined is counted as usual
+    tree.clear(icu);
+    EXPECT_TRUE(poll(late));
+    EXPECT_EQ(tree.getLevelStats(Level::WARD).deliveries, 1u);
+}
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// HeightActuator is Godot-free, so the real implementation is tested directly
+#include "height_actuator.h"
+
+using Profile = MotionLimits::Profile;
+
+class HeightActuatorTest : public ::testing::Test {
+protected:
+    static constexpr double kDt = 1.0 / 1000.0;
+
+    static MotionLimits limits(Profile profile) {
+        MotionLimits motion;
+        motion.profile = profile;
+        motion.maxVelocity = 4.0f;
+        motion.maxAcceleration = 8.0f;
+        motion.maxJerk = 40.0f;
+        return motion;
+    }
+
+    // Steps until the lift is at rest, recording the velocity after every step
+    static std::vector<float> run(HeightActuator& actuator, double limitSeconds = 60.0) {
+        std::vector<float> velocities{actuator.getVelocity()};
+        for (double t = 0.0; actuator.isMoving() && t < limitSeconds; t += kDt) {
+            actuator.step(kDt);
+            velocities.push_back(actuator.getVelocity());
+        }
+        return velocities;
+    }
+
+    // Largest finite-difference acceleration over a velocity trace
+    static float peakAcceleration(const std::vector<float>& velocities) {
+        float peak = 0.0f;
+        for (size_t i = 1; i < velocities.size(); ++i) {
+            peak = std::max(peak, std::fabs(velocities[i] - velocities[i - 1]) / static_cast<float>(kDt));
+        }
+        return peak;
+    }
+};
+
+// Test that both profiles land exactly on the target and keep speed and acceleration within the limits
+TEST_F(HeightActuatorTest, RespectsLimitsAndLandsExactly) {
+    for (Profile profile : {Profile::TRAPEZOIDAL, Profile::S_CURVE}) {
+        HeightActuator actuator(40.0f, 30.0f, 100.0f);
+        actuator.setLimits(limits(profile));
+        ASSERT_TRUE(actuator.moveTo(75.0f));
+        EXPECT_TRUE(actuator.isMoving());
+        EXPECT_FLOAT_EQ(actuator.getFinalTarget(), 75.0f);
+
+        std::vector<float> velocities = run(actuator);
+        EXPECT_FALSE(actuator.isMoving());
+        EXPECT_EQ(actuator.getPosition(), 75.0f);
+        EXPECT_EQ(actuator.getVelocity(), 0.0f);
+
+        float topSpeed = 0.0f;
+        for (float velocity : velocities) {
+            topSpeed = std::max(topSpeed, std::fabs(velocity));
+        }
+        EXPECT_NEAR(topSpeed, 4.0f, 1e-3f);
+        EXPECT_LE(peakAcceleration(velocities), 8.0f * 1.01f);
+    }
+}
+
+// Test that a move too short to reach full speed peaks below it and still arrives on time
+TEST_F(HeightActuatorTest, ShortMovesAreTriangular) {
+    HeightActuator actuator(50.0f);
+    actuator.setLimits(limits(Profile::TRAPEZOIDAL));
+    actuator.moveTo(51.0f);
+
+    std::vector<float> velocities = run(actuator);
+    float topSpeed = *std::max_element(velocities.begin(), velocities.end());
+    EXPECT_NEAR(topSpeed, std::sqrt(8.0f), 0.02f);  // sqrt(distance * acceleration)
+    EXPECT_NEAR(static_cast<double>(velocities.size() - 1) * kDt, 2.0 / std::sqrt(8.0), 2.0 * kDt);
+    EXPECT_EQ(actuator.getPosition(), 51.0f);
+}
+
+// Test that the S-curve starts and ends every ramp without an acceleration step and keeps jerk bounded
+TEST_F(HeightActuatorTest, SCurveAccelerationIsContinuous) {
+    HeightActuator actuator(30.0f);
+    actuator.setLimits(limits(Profile::S_CURVE));
+    actuator.moveTo(90.0f);
+    std::vector<float> velocities = run(actuator);
+
+    // Acceleration in the first and last steps is close to zero
+    EXPECT_LT(std::fabs(velocities[1] - velocities[0]) / kDt, 0.1f);
+    EXPECT_LT(std::fabs(velocities.back() - velocities[velocities.size() - 2]) / kDt, 0.1f);
+
+    float peakJerk = 0.0f;
+    for (size_t i = 2; i < velocities.size(); ++i) {
+        double jerk = (velocities[i] - 2.0 * velocities[i - 1] + velocities[i - 2]) / (kDt * kDt);
+        peakJerk = std::max(peakJerk, static_cast<float>(std::fabs(jerk)));
+    }
+    EXPECT_LE(peakJerk, 40.0f * 1.05f);
+}
+
+// Test that queued targets run in order, each one reached before the next begins
+TEST_F(HeightActuatorTest, RunsQueuedTargetsInOrder) {
+    HeightActuator actuator(50.0f);
+    EXPECT_TRUE(actuator.enqueue(60.0f));
+    EXPECT_TRUE(actuator.enqueue(40.0f));
+    EXPECT_TRUE(actuator.enqueue(45.0f));
+    EXPECT_EQ(actuator.getQueuedCount(), 2u);  // the first one is already running
+    EXPECT_FLOAT_EQ(actuator.getFinalTarget(), 45.0f);
+
+    float highest = 0.0f;
+    float lowest = 100.0f;
+    while (actuator.isMoving()) {
+        actuator.step(kDt);
+        highest = std::max(highest, actuator.getPosition());
+        lowest = std::min(lowest, actuator.getPosition());
+    }
+    EXPECT_EQ(highest, 60.0f);
+    EXPECT_EQ(lowest, 40.0f);
+    EXPECT_EQ(actuator.getPosition(), 45.0f);
+
+    for (size_t i = 0; i <= HeightActuator::kQueueCapacity; ++i) {
+        EXPECT_TRUE(actuator.enqueue(50.0f + static_cast<float>(i)));
+    }
+    EXPECT_FALSE(actuator.enqueue(90.0f));  // one running, the queue full
+}
+
+// Test that retargeting mid-move and stopping slow down within the limits rather than jumping
+TEST_F(HeightActuatorTest, RetargetsAndStopsSmoothly) {
+    HeightActuator actuator(40.0f);
+    actuator.setLimits(limits(Profile::TRAPEZOIDAL));
+    actuator.moveTo(90.0f);
+    for (int i = 0; i < 2000; ++i) {
+        actuator.step(kDt);
+    }
+    ASSERT_GT(actuator.getVelocity(), 3.9f);
+
+    // Reversing passes through rest instead of flipping the velocity
+    actuator.moveTo(45.0f);
+    std::vector<float> velocities = run(actuator);
+    EXPECT_LE(peakAcceleration(velocities), 8.0f * 1.01f);
+    EXPECT_EQ(actuator.getPosition(), 45.0f);
+
+    actuator.moveTo(80.0f);
+    for (int i = 0; i < 1500; ++i) {
+        actuator.step(kDt);
+    }
+    float before = actuator.getPosition();
+    actuator.stop();
+    velocities = run(actuator);
+    EXPECT_LE(peakAcceleration(velocities), 8.0f * 1.01f);
+    EXPECT_GT(actuator.getPosition(), before);
+    EXPECT_LT(actuator.getPosition(), 80.0f);
+}
+
+// Test that targets outside the range are refused and leave the lift where it was
+TEST_F(HeightActuatorTest, RejectsTargetsOutOfRange) {
+    HeightActuator actuator(50.0f, 30.0f, 100.0f);
+    EXPECT_FALSE(actuator.moveTo(120.0f));
+    EXPECT_FALSE(actuator.enqueue(10.0f));
+    EXPECT_FALSE(actuator.isMoving());
+
+    actuator.setRange(60.0f, 120.0f);
+    EXPECT_EQ(actuator.getPosition(), 60.0f);
+    EXPECT_TRUE(actuator.moveTo(120.0f));
+}
+
+// Test that non-finite targets, ranges and limits are refused and change nothing
+TEST_F(HeightActuatorTest, RejectsNonFiniteInput) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    HeightActuator actuator(50.0f, 30.0f, 100.0f);
+    ASSERT_TRUE(actuator.setLimits(limits(Profile::TRAPEZOIDAL)));
+    EXPECT_FALSE(actuator.moveTo(nan));
+    EXPECT_FALSE(actuator.enqueue(nan));
+    EXPECT_FALSE(actuator.moveTo(inf));
+    EXPECT_FALSE(actuator.isMoving());
+    EXPECT_EQ(actuator.getPosition(), 50.0f);
+
+    MotionLimits bad = limits(Profile::S_CURVE);
+    bad.maxJerk = nan;
+    EXPECT_FALSE(actuator.setLimits(bad));
+    bad = limits(Profile::S_CURVE);
+    bad.maxVelocity = inf;
+    EXPECT_FALSE(actuator.setLimits(bad));
+    EXPECT_EQ(actuator.getLimits().profile, Profile::TRAPEZOIDAL);
+    EXPECT_FLOAT_EQ(actuator.getLimits().maxVelocity, 4.0f);
+
+    EXPECT_FALSE(actuator.setRange(nan, 100.0f));
+    EXPECT_EQ(actuator.getMinPosition(), 30.0f);
+    actuator.reset(nan);
+    EXPECT_EQ(actuator.getPosition(), 30.0f);
+
+    EXPECT_TRUE(actuator.moveTo(80.0f));
+    run(actuator);
+    EXPECT_EQ(actuator.getPosition(), 80.0f);
+}
+
+// Test that frame deltas are consumed in fixed steps, with the remainder carried to the next frame
+TEST_F(HeightActuatorTest, AdvancesAtFixedTimestep) {
+    HeightActuator actuator(50.0f);
+    actuator.moveTo(70.0f);
+    EXPECT_EQ(actuator.advance(0.025, 0.01), 2);
+    EXPECT_EQ(actuator.advance(0.005, 0.01), 1);
+    EXPECT_EQ(actuator.advance(10.0, 0.01), HeightActuator::kMaxSubsteps);
+}
+
+// Test that a fleet steps every actuator exactly as stepping each one alone would
+TEST_F(HeightActuatorTest, FleetMatchesIndividualStepping) {
+    const size_t count = 3000;  // enough for several worker chunks
+    std::vector<HeightActuator> fleetMembers(count, HeightActuator(50.0f));
+    std::vector<HeightActuator> alone(count, HeightActuator(50.0f));
+    std::vector<HeightActuator*> pointers;
+    for (size_t i = 0; i < count; ++i) {
+        float target = 30.0f + static_cast<float>(i % 70);
+        fleetMembers[i].moveTo(target);
+        alone[i].moveTo(target);
+        pointers.push_back(&fleetMembers[i]);
+    }
+
+    ActuatorFleet fleet(0.01);
+    fleet.setActuators(pointers);
+    for (int frame = 0; frame < 100; ++frame) {
+        EXPECT_LE(fleet.advance(0.016), 2);
+    }
+    HeightActuator reference(50.0f);
+    int steps = 0;
+    for (int frame = 0; frame < 100; ++frame) {
+        steps += reference.advance(0.016, 0.01);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        for (int s = 0; s < steps; ++s) {
+            alone[i].step(0.01);
+        }
+        ASSERT_EQ(fleetMembers[i].getPosition(), alone[i].getPosition()) << i;
+    }
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+// LedFramebuffer is Godot-free, so the real implementation is tested directly
+#include "led_framebuffer.h"
+
+class LedFramebufferTest : public ::testing::Test {
+protected:
+    // Odd length so the SIMD loops also run their scalar tails
+    static constexpr size_t kLeds = 61;
+
+    // LEDs are stored as 8-bit sRGB; half a code step in linear light at the bright end
+    static constexpr float kTolerance = 0.005f;
+
+    LedFramebuffer framebuffer{kLeds};
+
+    std::vector<uint8_t> encode(float brightness, const LedGammaTable& gamma = LedGammaTable::standard()) {
+        std::vector<uint8_t> bytes(framebuffer.size() * 3, 0xAB);
+        framebuffer.encodeRgb8(bytes.data(), brightness, gamma);
+        return bytes;
+    }
+};
+
+// Test that a solid fill sets every LED
+TEST_F(LedFramebufferTest, SolidFill) {
+    framebuffer.fillSolid({0.25f, 0.5f, 1.0f});
+    for (size_t i = 0; i < kLeds; ++i) {
+        LedColor led = framebuffer.getLed(i);
+        EXPECT_NEAR(led.r, 0.25f, kTolerance);
+        EXPECT_NEAR(led.g, 0.5f, kTolerance);
+        EXPECT_FLOAT_EQ(led.b, 1.0f);
+    }
+}
+
+// Test that a gradient runs linearly in light from the first to the last LED
+TEST_F(LedFramebufferTest, GradientEndpoints) {
+    framebuffer.fillGradient({0.0f, 1.0f, 0.2f}, {1.0f, 0.0f, 0.2f});
+    EXPECT_FLOAT_EQ(framebuffer.getLed(0).r, 0.0f);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(kLeds - 1).r, 1.0f);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(kLeds - 1).g, 0.0f);
+    EXPECT_NEAR(framebuffer.getLed(30).r, 0.5f, kTolerance);
+    for (size_t i = 0; i < kLeds; ++i) {
+        EXPECT_NEAR(framebuffer.getLed(i).r + framebuffer.getLed(i).g, 1.0f, 2 * kTolerance) << i;
+        EXPECT_NEAR(framebuffer.getLed(i).b, 0.2f, kTolerance);
+    }
+
+    // The packed midpoint of red to green is the bright sRGB code, not 128
+    EXPECT_EQ(framebuffer.data()[30].r, 188);
+}
+
+// Test that a pulse breathes between its floor and full intensity
+TEST_F(LedFramebufferTest, PulseRange) {
+    framebuffer.fillPulse({1.0f, 0.0f, 0.0f}, 0.0, 1.0f, 0.2f);
+    EXPECT_NEAR(framebuffer.getLed(5).r, 0.2f, kTolerance);
+
+    framebuffer.fillPulse({1.0f, 0.0f, 0.0f}, 0.5, 1.0f, 0.2f);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(5).r, 1.0f);
+
+    // Far into the run the phase is still exact
+    framebuffer.fillPulse({1.0f, 0.0f, 0.0f}, 86400.5, 1.0f, 0.2f);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(5).r, 1.0f);
+}
+
+// Test that the chase head moves with time, fades over its tail and wraps
+TEST_F(LedFramebufferTest, ChaseHeadAndTail) {
+    LedColor white = {1.0f, 1.0f, 1.0f};
+    LedColor black = {0.0f, 0.0f, 0.0f};
+
+    framebuffer.fillChase(white, black, 1.0, 10.0f, 4.0f);  // head at LED 10
+    EXPECT_FLOAT_EQ(framebuffer.getLed(10).r, 1.0f);
+    EXPECT_NEAR(framebuffer.getLed(8).r, 0.5f, kTolerance);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(6).r, 0.0f);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(11).r, 0.0f);
+
+    framebuffer.fillChase(white, black, 0.1, 10.0f, 4.0f);  // head at LED 1, tail wraps to the end
+    EXPECT_FLOAT_EQ(framebuffer.getLed(1).r, 1.0f);
+    EXPECT_NEAR(framebuffer.getLed(kLeds - 1).r, 0.5f, kTolerance);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(30).r, 0.0f);
+}
+
+// Test that a strobe is lit for its duty cycle and dark otherwise
+TEST_F(LedFramebufferTest, StrobeDutyCycle) {
+    LedEffect effect = LedEffect::strobe({1.0f, 0.0f, 0.0f}, 2.0f, 0.25f);
+
+    framebuffer.render(effect, 0.1);  // 20% into the period
+    EXPECT_FLOAT_EQ(framebuffer.getLed(0).r, 1.0f);
+
+    framebuffer.render(effect, 0.2);  // 40% into the period
+    EXPECT_FLOAT_EQ(framebuffer.getLed(0).r, 0.0f);
+
+    framebuffer.render(effect, 0.55);  // next period
+    EXPECT_FLOAT_EQ(framebuffer.getLed(kLeds - 1).r, 1.0f);
+}
+
+// Test that encoding scales linear light before gamma and writes every byte
+TEST_F(LedFramebufferTest, EncodeAppliesBrightnessAndGamma) {
+    framebuffer.fillSolid({1.0f, 0.5f, 0.0f});
+
+    std::vector<uint8_t> full = encode(1.0f);
+    EXPECT_EQ(full[0], 255);
+    EXPECT_NEAR(full[1], 255.0 * std::pow(0.5, 1.0 / 2.2), 1.0);  // within one stored code
+    EXPECT_EQ(full[2], 0);
+    EXPECT_EQ(full[(kLeds - 1) * 3], 255);
+
+    // Half brightness is half the light: the same output as a half-intensity color
+    std::vector<uint8_t> half = encode(0.5f);
+    EXPECT_NEAR(half[0], full[1], 1.0);
+
+    LedGammaTable linear(1.0f);
+    std::vector<uint8_t> raw = encode(1.0f, linear);
+    EXPECT_EQ(raw[1], 128);
+
+    // Out-of-range intensities clamp rather than wrap
+    framebuffer.fillSolid({2.0f, -1.0f, 0.0f});
+    std::vector<uint8_t> clamped = encode(3.0f);
+    EXPECT_EQ(clamped[0], 255);
+    EXPECT_EQ(clamped[1], 0);
+
+    // NaN brightness encodes as off instead of indexing past the gamma table
+    std::vector<uint8_t> dark = encode(std::nanf(""));
+    EXPECT_EQ(dark[0], 0);
+}
+
+// Test that NaN timing parameters render black rather than crashing the encoder
+TEST_F(LedFramebufferTest, NanParametersStayInRange) {
+    const float nan = std::nanf("");
+    framebuffer.fillPulse({1.0f, 1.0f, 1.0f}, 0.5, nan, 0.0f);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(0).r, 0.0f);
+    framebuffer.fillPulse({1.0f, 1.0f, 1.0f}, nan, 2.0f, 0.0f);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(kLeds - 1).g, 0.0f);
+
+    framebuffer.fillChase({1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, nan, 10.0f, 3.0f);
+    EXPECT_EQ(encode(1.0f).size(), kLeds * 3);
+}
+
+// Test that resizing keeps existing LEDs, darkens new ones and respects the cap
+TEST_F(LedFramebufferTest, Resize) {
+    framebuffer.fillSolid({1.0f, 1.0f, 1.0f});
+    framebuffer.resize(kLeds + 5);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(kLeds - 1).r, 1.0f);
+    EXPECT_FLOAT_EQ(framebuffer.getLed(kLeds + 4).r, 0.0f);
+
+    framebuffer.resize(LedFramebuffer::kMaxLedCount * 2);
+    EXPECT_EQ(framebuffer.size(), LedFramebuffer::kMaxLedCount);
+
+    framebuffer.resize(0);
+    framebuffer.fillChase({1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, 1.0, 10.0f, 3.0f);
+    EXPECT_TRUE(encode(1.0f).empty());
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+// LightStrip is Godot-free, so the real implementation is tested directly
+#include "light_strip.h"
+
+namespace {
+
+class CountingObserver : public EmergencyObserver {
+public:
+    int activations = 0;
+    int deactivations = 0;
+
+    void onEmergencyActivated() override { ++activations; }
+    void onEmergencyDeactivated() override { ++deactivations; }
+};
+
+class NightLightBehavior : public LightBehavior {
+public:
+    void activate() override {}
+    void deactivate() override {}
+    void setBrightness(float /*intensity*/) override {}
+    void setColor(const LightColor& /*color*/) override {}
+    void setEffect(const LedEffect& /*effect*/) override {}
+    bool isEmergencyMode() const override { return false; }
+    std::string getBehaviorType() const override { return "Night"; }
+    LedEffect getEffect() const override { return LedEffect::solid({0.2f, 0.1f, 0.0f}); }
+    float getBrightness() const override { return 0.05f; }
+};
+
+} // namespace
+
+class LightStripTest : public ::testing::Test {
+protected:
+    LightStrip strip;
+    CountingObserver observer;
+
+    void SetUp() override {
+        strip.addObserver(&observer);
+    }
+};
+
+// Test that the normal behavior's settings survive a round trip through emergency mode
+TEST_F(LightStripTest, EmergencyRoundTripKeepsNormalState) {
+    strip.activate();
+    strip.setBrightness(0.8f);
+    strip.setColor(LightColor(255, 0, 255));
+    strip.setEffect(LedEffect::pulse({}, 0.5f, 0.3f));
+
+    strip.activateEmergencyMode();
+    EXPECT_TRUE(strip.isEmergencyMode());
+    EXPECT_EQ(strip.getCurrentMode(), "Emergency");
+    EXPECT_EQ(strip.getBehavior().getEffect().type, LedEffect::Type::STROBE);
+    EXPECT_FLOAT_EQ(strip.getBehavior().getBrightness(), 1.0f);
+
+    // Emergency mode locks the lights; the normal settings are untouched
+    strip.setBrightness(0.1f);
+    strip.setColor(LightColor(0, 255, 0));
+
+    strip.deactivateEmergencyMode();
+    EXPECT_FALSE(strip.isEmergencyMode());
+    EXPECT_EQ(strip.getCurrentMode(), "Normal");
+    EXPECT_FLOAT_EQ(strip.getBehavior().getBrightness(), 0.8f);
+
+    LedEffect effect = strip.getBehavior().getEffect();
+    EXPECT_EQ(effect.type, LedEffect::Type::PULSE);
+    EXPECT_FLOAT_EQ(effect.rateHz, 0.5f);
+    EXPECT_FLOAT_EQ(effect.primary.r, 1.0f);
+    EXPECT_FLOAT_EQ(effect.primary.g, 0.0f);
+    EXPECT_FLOAT_EQ(effect.primary.b, 1.0f);
+}
+
+// Test that toggling modes reuses the same inline behaviors instead of allocating new ones
+TEST_F(LightStripTest, SwitchingReusesInlineBehaviors) {
+    const LightBehavior* normal = &strip.getBehavior();
+    strip.activateEmergencyMode();
+    const LightBehavior* emergency = &strip.getBehavior();
+    EXPECT_NE(normal, emergency);
+    strip.deactivateEmergencyMode();
+
+    for (int i = 0; i < 1000; ++i) {
+        strip.activateEmergencyMode();
+        ASSERT_EQ(&strip.getBehavior(), emergency);
+        strip.deactivateEmergencyMode();
+        ASSERT_EQ(&strip.getBehavior(), normal);
+    }
+    EXPECT_EQ(observer.activations, 1001);
+    EXPECT_EQ(observer.deactivations, 1001);
+}
+
+// Test that a repeated emergency still returns to the mode active before the first one
+TEST_F(LightStripTest, RepeatedEmergencyResumesOriginalMode) {
+    strip.activateEmergencyMode();
+    strip.activateEmergencyMode();
+    EXPECT_EQ(observer.activations, 2);
+
+    strip.deactivateEmergencyMode();
+    EXPECT_EQ(strip.getMode(), LightStrip::Mode::NORMAL);
+
+    // Clearing an emergency that is not active only notifies
+    strip.deactivateEmergencyMode();
+    EXPECT_EQ(strip.getMode(), LightStrip::Mode::NORMAL);
+    EXPECT_EQ(observer.deactivations, 2);
+}
+
+// Test that a custom behavior is resumed after an emergency and can be removed
+TEST_F(LightStripTest, CustomBehaviorResumesAfterEmergency) {
+    strip.setBehavior(std::make_unique<NightLightBehavior>());
+    EXPECT_EQ(strip.getMode(), LightStrip::Mode::CUSTOM);
+    EXPECT_EQ(strip.getCurrentMode(), "Night");
+
+    strip.activateEmergencyMode();
+    EXPECT_EQ(strip.getCurrentMode(), "Emergency");
+    strip.deactivateEmergencyMode();
+    EXPECT_EQ(strip.getCurrentMode(), "Night");
+    EXPECT_FLOAT_EQ(strip.getBehavior().getBrightness(), 0.05f);
+
+    strip.setBehavior(nullptr);
+    EXPECT_EQ(strip.getMode(), LightStrip::Mode::NORMAL);
+    EXPECT_EQ(strip.getCurrentMode(), "Normal");
+}
+
+// Test that the strip renders whichever behavior is active
+TEST_F(LightStripTest, RendersActiveBehavior) {
+    strip.setLedCount(8);
+    strip.activate();
+    strip.setBrightness(1.0f);
+    strip.setColor(LightColor(0, 0, 255));
+    strip.renderFrame(0.0);
+
+    uint8_t bytes[8 * 3];
+    strip.encodeFrame(bytes);
+    EXPECT_EQ(bytes[0], 0);
+    EXPECT_EQ(bytes[2], 255);
+
+    strip.activateEmergencyMode();
+    strip.renderFrame(0.1);  // inside the strobe's lit half
+    strip.encodeFrame(bytes);
+    EXPECT_EQ(bytes[0], 255);
+    EXPECT_EQ(bytes[2], 0);
+}
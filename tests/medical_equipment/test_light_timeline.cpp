@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// LightTimeline is Godot-free, so the real implementation is tested directly
+#include "light_strip.h"
+#include "light_timeline.h"
+
+using Easing = LightKeyframe::Easing;
+
+class LightTimelineTest : public ::testing::Test {
+protected:
+    static LightKeyframe key(double time, LedColor color, float brightness, Easing easing = Easing::LINEAR) {
+        LightKeyframe keyframe;
+        keyframe.timeSeconds = time;
+        keyframe.color = color;
+        keyframe.brightness = brightness;
+        keyframe.easing = easing;
+        return keyframe;
+    }
+
+    // One-second fade from black to white and back
+    std::shared_ptr<const LightTimeline> fade(bool loop, Easing easing = Easing::LINEAR) {
+        return LightTimeline::compile({key(0.0, {0.0f, 0.0f, 0.0f}, 0.0f, easing),
+                                       key(0.5, {1.0f, 1.0f, 1.0f}, 1.0f, easing),
+                                       key(1.0, {0.0f, 0.0f, 0.0f}, 0.0f, easing)}, loop, 100.0f);
+    }
+};
+
+// Test that compiling bakes one frame per tick and rejects empty input
+TEST_F(LightTimelineTest, CompilesFrames) {
+    EXPECT_EQ(LightTimeline::compile({}, true), nullptr);
+
+    auto timeline = fade(true);
+    ASSERT_NE(timeline, nullptr);
+    EXPECT_DOUBLE_EQ(timeline->getDuration(), 1.0);
+    EXPECT_EQ(timeline->getFrameCount(), 101u);
+    EXPECT_TRUE(timeline->isLooping());
+
+    // A single keyframe is a constant
+    auto constant = LightTimeline::compile({key(2.0, {0.5f, 0.0f, 0.0f}, 0.3f)}, false);
+    EXPECT_FLOAT_EQ(constant->sample(0.0).color.r, 0.5f);
+    EXPECT_FLOAT_EQ(constant->sample(10.0).brightness, 0.3f);
+}
+
+// Test that linear segments interpolate and keyframes given out of order are sorted
+TEST_F(LightTimelineTest, InterpolatesLinearly) {
+    auto timeline = LightTimeline::compile({key(1.0, {1.0f, 0.0f, 0.0f}, 1.0f),
+                                            key(0.0, {0.0f, 0.0f, 1.0f}, 0.0f)}, false, 100.0f);
+    EXPECT_NEAR(timeline->sample(0.25).color.r, 0.25f, 1e-5f);
+    EXPECT_NEAR(timeline->sample(0.25).color.b, 0.75f, 1e-5f);
+    EXPECT_NEAR(timeline->sample(0.5).brightness, 0.5f, 1e-5f);
+}
+
+// Test the easing curves at their midpoints and endpoints
+TEST_F(LightTimelineTest, EasingCurves) {
+    EXPECT_FLOAT_EQ(LightTimeline::ease(Easing::LINEAR, 0.5f), 0.5f);
+    EXPECT_FLOAT_EQ(LightTimeline::ease(Easing::STEP, 0.99f), 0.0f);
+    EXPECT_FLOAT_EQ(LightTimeline::ease(Easing::EASE_IN, 0.5f), 0.125f);
+    EXPECT_FLOAT_EQ(LightTimeline::ease(Easing::EASE_OUT, 0.5f), 0.875f);
+    EXPECT_FLOAT_EQ(LightTimeline::ease(Easing::EASE_IN_OUT, 0.5f), 0.5f);
+    EXPECT_FLOAT_EQ(LightTimeline::ease(Easing::EASE_IN_OUT, 1.5f), 1.0f);
+
+    auto stepped = fade(false, Easing::STEP);
+    EXPECT_FLOAT_EQ(stepped->sample(0.49).brightness, 0.0f);
+    EXPECT_FLOAT_EQ(stepped->sample(0.5).brightness, 1.0f);
+
+    auto easedIn = fade(false, Easing::EASE_IN);
+    EXPECT_NEAR(easedIn->sample(0.25).brightness, 0.125f, 1e-5f);
+}
+
+// Test that looping wraps in both directions and a one-shot holds its ends
+TEST_F(LightTimelineTest, LoopsAndHolds) {
+    auto looping = fade(true);
+    EXPECT_NEAR(looping->sample(3.25).brightness, 0.5f, 1e-5f);
+    EXPECT_NEAR(looping->sample(-0.75).brightness, 0.5f, 1e-5f);
+    EXPECT_NEAR(looping->sample(86400.5).brightness, 1.0f, 1e-3f);
+
+    auto once = fade(false);
+    EXPECT_FLOAT_EQ(once->sample(-1.0).brightness, 0.0f);
+    EXPECT_FLOAT_EQ(once->sample(5.0).brightness, 0.0f);
+    EXPECT_NEAR(once->sample(0.5).brightness, 1.0f, 1e-5f);
+}
+
+// Test that very long animations are baked at a reduced rate to stay bounded
+TEST_F(LightTimelineTest, CapsFrameCount) {
+    auto timeline = LightTimeline::compile({key(0.0, {0.0f, 0.0f, 0.0f}, 0.0f),
+                                            key(36000.0, {1.0f, 1.0f, 1.0f}, 1.0f)}, false);
+    EXPECT_LE(timeline->getFrameCount(), LightTimeline::kMaxFrames);
+    EXPECT_LT(timeline->getFrameRate(), LightTimeline::kDefaultFrameRate);
+    EXPECT_NEAR(timeline->sample(18000.0).brightness, 0.5f, 1e-3f);
+}
+
+// Test that non-finite keyframe times and frame rates are refused instead of sizing the table
+TEST_F(LightTimelineTest, RejectsNonFiniteInput) {
+    const double inf = std::numeric_limits<double>::infinity();
+    EXPECT_EQ(LightTimeline::compile({key(0.0, {0.0f, 0.0f, 0.0f}, 0.0f), key(inf, {1.0f, 1.0f, 1.0f}, 1.0f)}, false),
+              nullptr);
+    EXPECT_EQ(LightTimeline::compile({key(std::nan(""), {1.0f, 1.0f, 1.0f}, 1.0f)}, true), nullptr);
+    EXPECT_EQ(LightTimeline::compile({key(-inf, {1.0f, 1.0f, 1.0f}, 1.0f)}, true), nullptr);
+    EXPECT_EQ(LightTimeline::compile({key(0.0, {1.0f, 1.0f, 1.0f}, 1.0f)}, true, std::numeric_limits<float>::infinity()),
+              nullptr);
+}
+
+// Test that strips share one compiled timeline at their own phase, and emergencies override it
+TEST_F(LightTimelineTest, StripsShareTimelineWithPhaseOffsets) {
+    auto timeline = fade(true);
+    LightStrip first;
+    LightStrip second;
+    for (LightStrip* strip : {&first, &second}) {
+        strip->setLedCount(4);
+        strip->activate();
+        strip->setBrightness(1.0f);
+    }
+    first.playTimeline(timeline);
+    second.playTimeline(timeline, 0.5);
+    EXPECT_EQ(first.getTimeline(), second.getTimeline());
+
+    uint8_t bytesFirst[4 * 3];
+    uint8_t bytesSecond[4 * 3];
+    LedGammaTable linear(1.0f);
+    first.renderFrame(0.0);
+    second.renderFrame(0.0);
+    first.encodeFrame(bytesFirst, linear);
+    second.encodeFrame(bytesSecond, linear);
+    EXPECT_EQ(bytesFirst[0], 0);
+    EXPECT_EQ(bytesSecond[0], 255);
+
+    // Emergency red ignores the timeline; leaving it resumes the animation
+    second.activateEmergencyMode();
+    second.renderFrame(0.1);
+    second.encodeFrame(bytesSecond, linear);
+    EXPECT_EQ(bytesSecond[0], 255);
+    EXPECT_EQ(bytesSecond[1], 0);
+    second.deactivateEmergencyMode();
+    EXPECT_TRUE(second.isTimelinePlaying());
+
+    second.stopTimeline();
+    second.renderFrame(0.0);
+    second.encodeFrame(bytesSecond, linear);
+    EXPECT_EQ(bytesSecond[1], 255);  // back to the behavior's own white
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// MaintenanceScheduler is Godot-free, so the real implementation is tested directly
+#include "maintenance_scheduler.h"
+
+namespace {
+
+// Stand-in bed whose checks report a fault flag and take a fixed time
+class FakeBed : public MaintenanceTarget {
+public:
+    bool heightFault = false;
+    int64_t checkCostUs = 0;
+    mutable int inspections = 0;
+    mutable uint8_t lastSubsystems = 0;
+
+protected:
+    MaintenanceRecord inspectSubsystems(uint8_t subsystems, MaintenanceRecord record) const override {
+        ++inspections;
+        lastSubsystems = subsystems;
+        record.clearSubsystems(subsystems);
+        if (subsystems & MaintenanceRecord::SUBSYSTEM_HEIGHT) {
+            record.recordHeight(heightFault ? 10.0f : 50.0f, 30.0f, 100.0f);
+        }
+        if (subsystems & MaintenanceRecord::SUBSYSTEM_POWER) {
+            record.status |= MaintenanceRecord::STATUS_POWERED;
+        }
+
+        auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(checkCostUs);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+        return record;
+    }
+};
+
+} // namespace
+
+class MaintenanceSchedulerTest : public ::testing::Test {
+protected:
+    void addBeds(size_t count, int64_t costUs = 0) {
+        for (size_t i = 0; i < count; ++i) {
+            beds.push_back(std::make_unique<FakeBed>());
+            beds.back()->checkCostUs = costUs;
+            scheduler.add(beds.back().get());
+        }
+    }
+
+    MaintenanceScheduler scheduler{1000000};
+    std::vector<std::unique_ptr<FakeBed>> beds;
+};
+
+// Test that only dirty subsystems are rechecked and the rest of the record is kept
+TEST_F(MaintenanceSchedulerTest, RechecksOnlyDirtySubsystems) {
+    addBeds(3);
+    EXPECT_EQ(scheduler.runFrame(0.016), 3u);  // everything starts dirty
+    EXPECT_EQ(beds[0]->lastSubsystems, MaintenanceRecord::SUBSYSTEM_ALL);
+    EXPECT_TRUE(beds[0]->getLastMaintenance().status & MaintenanceRecord::STATUS_POWERED);
+
+    // Clean beds cost nothing
+    EXPECT_EQ(scheduler.runFrame(0.016), 0u);
+    EXPECT_EQ(beds[0]->inspections, 1);
+
+    beds[1]->heightFault = true;
+    beds[1]->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_HEIGHT);
+    EXPECT_EQ(scheduler.getStats().backlog, 1u);
+    EXPECT_EQ(scheduler.runFrame(0.016), 1u);
+    EXPECT_EQ(beds[1]->lastSubsystems, MaintenanceRecord::SUBSYSTEM_HEIGHT);
+    EXPECT_EQ(beds[1]->getLastMaintenance().faults, MaintenanceRecord::FAULT_HEIGHT);
+    EXPECT_TRUE(beds[1]->getLastMaintenance().status & MaintenanceRecord::STATUS_POWERED);  // kept
+    ASSERT_EQ(scheduler.getFaultChanges().size(), 1u);
+    EXPECT_EQ(scheduler.getFaultChanges()[0], beds[1].get());
+
+    EXPECT_EQ(scheduler.getStats().subsystemsChecked, 3u * MaintenanceRecord::kSubsystemCount + 1u);
+    EXPECT_EQ(scheduler.getStats().subsystemsSkipped, MaintenanceRecord::kSubsystemCount - 1u);
+}
+
+// Test that a bed marked dirty several times is queued once
+TEST_F(MaintenanceSchedulerTest, QueuesEachBedOnce) {
+    addBeds(2);
+    scheduler.runFrame(0.016);
+    beds[0]->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_LIGHTS);
+    beds[0]->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_TEMPERATURE);
+    EXPECT_EQ(scheduler.getStats().backlog, 1u);
+    scheduler.runFrame(0.016);
+    EXPECT_EQ(beds[0]->inspections, 2);
+    EXPECT_EQ(beds[0]->lastSubsystems, MaintenanceRecord::SUBSYSTEM_LIGHTS | MaintenanceRecord::SUBSYSTEM_TEMPERATURE);
+}
+
+// Test that a frame stops once its budget is spent and the backlog drains over later frames
+TEST_F(MaintenanceSchedulerTest, SpreadsChecksWithinBudget) {
+    addBeds(40, 200);
+    scheduler.setBudgetUs(1000);
+
+    size_t first = scheduler.runFrame(0.016);
+    EXPECT_GE(first, 1u);
+    EXPECT_LT(first, 40u);
+    EXPECT_EQ(scheduler.getStats().backlog, 40u - first);
+    EXPECT_LE(first, 5u);  // each check takes at least 200 us, so five spend the budget however slow the host
+
+    int frames = 1;
+    while (scheduler.getStats().backlog > 0 && frames < 100) {
+        scheduler.runFrame(0.016);
+        ++frames;
+    }
+    EXPECT_EQ(scheduler.getStats().backlog, 0u);
+    EXPECT_EQ(scheduler.getStats().totalChecks, 40u);
+    EXPECT_GT(frames, 2);
+
+    // A budget too small for one check still makes progress
+    scheduler.setBudgetUs(1);
+    beds[0]->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_ALL);
+    beds[1]->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_ALL);
+    EXPECT_EQ(scheduler.runFrame(0.016), 1u);
+}
+
+// Test that coverage per second is the share of the fleet rechecked over a one-second window
+TEST_F(MaintenanceSchedulerTest, ReportsCoveragePerSecond) {
+    addBeds(10);
+    scheduler.runFrame(0.5);
+    EXPECT_DOUBLE_EQ(scheduler.getStats().coveragePerSecond, 0.0);  // window still open
+
+    for (size_t i = 0; i < 5; ++i) {
+        beds[i]->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_POWER);
+    }
+    scheduler.runFrame(0.5);
+    EXPECT_DOUBLE_EQ(scheduler.getStats().checksPerSecond, 15.0);
+    EXPECT_DOUBLE_EQ(scheduler.getStats().coveragePerSecond, 1.5);
+}
+
+// Test that removed and destroyed beds leave the scheduler and its backlog
+TEST_F(MaintenanceSchedulerTest, ForgetsRemovedBeds) {
+    addBeds(3);
+    EXPECT_FALSE(scheduler.add(beds[0].get()));  // already registered
+    EXPECT_TRUE(scheduler.remove(beds[0].get()));
+    EXPECT_EQ(scheduler.getStats().backlog, 2u);
+
+    beds[1].reset();
+    EXPECT_EQ(scheduler.size(), 1u);
+    EXPECT_EQ(scheduler.runFrame(0.016), 1u);
+
+    // A bed outliving its scheduler is simply detached
+    auto survivor = std::make_unique<FakeBed>();
+    {
+        MaintenanceScheduler local;
+        local.add(survivor.get());
+    }
+    survivor->markMaintenanceDirty(MaintenanceRecord::SUBSYSTEM_HEIGHT);
+    EXPECT_EQ(survivor->refreshMaintenance().heightCm, 50);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+// MaintenanceSweep is Godot-free, so the real implementation is tested directly
+#include "bed_ward_state.h"
+#include "maintenance_sweep.h"
+#include "worker_pool.h"
+
+class MaintenanceSweepTest : public ::testing::Test {
+protected:
+    // Every seventh bed out of range, every fifth without lights
+    static MaintenanceRecord syntheticRecord(size_t i) {
+        MaintenanceRecord record;
+        record.recordHeight(i % 7 == 0 ? 20.0f : 60.0f, 30.0f, 100.0f);
+        if (i % 5 == 0) {
+            record.faults |= MaintenanceRecord::FAULT_LIGHTS;
+        }
+        record.status |= MaintenanceRecord::STATUS_POWERED;
+        return record;
+    }
+
+    static size_t expectedHealthy(size_t count) {
+        size_t healthy = 0;
+        for (size_t i = 0; i < count; ++i) {
+            healthy += (i % 7 != 0 && i % 5 != 0) ? 1 : 0;
+        }
+        return healthy;
+    }
+};
+
+// Test that a record packs into one integer and back without loss
+TEST_F(MaintenanceSweepTest, PacksRecords) {
+    MaintenanceRecord record;
+    record.recordHeight(112.4f, 60.0f, 110.0f);
+    record.status = MaintenanceRecord::STATUS_STERILE | MaintenanceRecord::STATUS_PROCEDURE;
+    record.temperatureMode = 2;
+    EXPECT_EQ(record.faults, MaintenanceRecord::FAULT_HEIGHT);
+    EXPECT_EQ(record.heightCode, MaintenanceRecord::HeightCode::ABOVE_RANGE);
+    EXPECT_EQ(record.heightCm, 112);
+
+    uint64_t packed = record.pack();
+    EXPECT_EQ(packed & 0xFFFF, MaintenanceRecord::FAULT_HEIGHT);
+    EXPECT_EQ((packed >> 40) & 0xFF, 112u);
+
+    MaintenanceRecord back = MaintenanceRecord::unpack(packed);
+    EXPECT_EQ(back.faults, record.faults);
+    EXPECT_EQ(back.status, record.status);
+    EXPECT_EQ(back.heightCode, record.heightCode);
+    EXPECT_EQ(back.temperatureMode, 2);
+    EXPECT_FALSE(back.isHealthy());
+}
+
+// Test that a parallel sweep inspects every bed once, in order, and tallies faults per check
+TEST_F(MaintenanceSweepTest, SweepsFleetInParallel) {
+    const size_t count = 1000;
+    std::vector<std::atomic<int>> visits(count);
+    std::vector<MaintenanceRecord> records;
+    MaintenanceSweep::Summary summary = MaintenanceSweep::run(count, [&visits](size_t i) {
+        visits[i].fetch_add(1);
+        return syntheticRecord(i);
+    }, records, &WorkerPool::shared());
+
+    ASSERT_EQ(records.size(), count);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(visits[i].load(), 1) << i;
+        EXPECT_EQ(records[i].pack(), syntheticRecord(i).pack()) << i;
+    }
+    EXPECT_EQ(summary.checked, count);
+    EXPECT_EQ(summary.healthy, expectedHealthy(count));
+    EXPECT_EQ(summary.faulty(), count - expectedHealthy(count));
+    EXPECT_EQ(summary.faultCounts[0], (count + 6) / 7);  // height
+    EXPECT_EQ(summary.faultCounts[1], count / 5);        // lights
+    EXPECT_EQ(summary.faultCounts[2], 0u);
+    EXPECT_STREQ(MaintenanceSweep::getFaultName(1), "lights");
+}
+
+// Test that running inline gives the same records as the worker pool
+TEST_F(MaintenanceSweepTest, InlineMatchesPool) {
+    std::vector<MaintenanceRecord> pooled;
+    std::vector<MaintenanceRecord> inlined;
+    MaintenanceSweep::run(333, syntheticRecord, pooled, &WorkerPool::shared());
+    MaintenanceSweep::Summary summary = MaintenanceSweep::run(333, syntheticRecord, inlined, nullptr);
+    ASSERT_EQ(pooled.size(), inlined.size());
+    for (size_t i = 0; i < pooled.size(); ++i) {
+        EXPECT_EQ(pooled[i].pack(), inlined[i].pack());
+    }
+    EXPECT_EQ(summary.healthy, expectedHealthy(333));
+
+    MaintenanceSweep::Summary empty = MaintenanceSweep::run(0, syntheticRecord, inlined, nullptr);
+    EXPECT_EQ(empty.checked, 0u);
+    EXPECT_TRUE(inlined.empty());
+}
+
+// Test that ward slots report their power, motion, emergency and temperature state
+TEST_F(MaintenanceSweepTest, InspectsWardSlots) {
+    BedWardState ward;
+    ward.addBeds(4, BedWardState::BedKind::SURGICAL);
+    ward.powerOn(1);
+    ward.setHeight(1, 100.0f);
+    ward.setEmergency(2, true);
+    ward.powerOn(3);
+    ward.setTemperature(3, BedWardState::TemperatureMode::COLD);
+
+    std::vector<MaintenanceRecord> records;
+    MaintenanceSweep::Summary summary = MaintenanceSweep::run(
+        ward.size(), [&ward](size_t slot) { return ward.inspect(slot); }, records, &WorkerPool::shared());
+    EXPECT_EQ(summary.healthy, 4u);
+    EXPECT_EQ(records[0].status, 0);
+    EXPECT_EQ(records[0].heightCm, 85);
+    EXPECT_EQ(records[1].status, MaintenanceRecord::STATUS_POWERED | MaintenanceRecord::STATUS_HEIGHT_MOVING);
+    EXPECT_EQ(records[2].status, MaintenanceRecord::STATUS_EMERGENCY);
+    EXPECT_EQ(records[3].temperatureMode, static_cast<uint8_t>(BedWardState::TemperatureMode::COLD));
+}
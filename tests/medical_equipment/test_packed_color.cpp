@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+// PackedColor and ColorSpace are Godot-free, so the real implementation is tested directly
+#include "packed_color.h"
+
+class PackedColorTest : public ::testing::Test {
+protected:
+    // Odd count so the SIMD loops also run their scalar tails
+    static constexpr size_t kColors = 37;
+
+    std::vector<PackedColor> palette() const {
+        std::vector<PackedColor> colors;
+        for (size_t i = 0; i < kColors; ++i) {
+            colors.emplace_back(static_cast<int>(i * 7), static_cast<int>(255 - i * 5), static_cast<int>(i * 3 + 40),
+                                static_cast<int>(i * 6));
+        }
+        return colors;
+    }
+};
+
+// Test that a color is four bytes and out-of-range channels clamp
+TEST_F(PackedColorTest, PacksAndClamps) {
+    EXPECT_EQ(sizeof(PackedColor), 4u);
+
+    PackedColor color(300, -20, 128);
+    EXPECT_EQ(color.r, 255);
+    EXPECT_EQ(color.g, 0);
+    EXPECT_EQ(color.b, 128);
+    EXPECT_EQ(color.a, 255);
+
+    EXPECT_EQ(PackedColor::fromFloat(1.5f, 0.5f, -1.0f, 0.0f), PackedColor(255, 128, 0, 0));
+}
+
+// Test the sRGB transfer curve against known points and that every code survives a round trip
+TEST_F(PackedColorTest, SrgbRoundTrip) {
+    EXPECT_FLOAT_EQ(ColorSpace::toLinear(0), 0.0f);
+    EXPECT_FLOAT_EQ(ColorSpace::toLinear(255), 1.0f);
+    EXPECT_NEAR(ColorSpace::toLinear(188), 0.5f, 0.005f);
+    EXPECT_EQ(ColorSpace::toSrgb(0.5f), 188);
+    EXPECT_EQ(ColorSpace::toSrgb(2.0f), 255);
+
+    for (int code = 0; code < 256; ++code) {
+        EXPECT_NEAR(ColorSpace::toSrgb(ColorSpace::toLinear(static_cast<uint8_t>(code))), code, 1) << code;
+    }
+}
+
+// Test that brightness halves emitted light rather than the code
+TEST_F(PackedColorTest, BrightnessInLinearLight) {
+    PackedColor white(255, 255, 255, 200);
+    PackedColor half = ColorSpace::scaleBrightness(white, 0.5f);
+    EXPECT_EQ(half.r, 188);
+    EXPECT_EQ(half.a, 200);
+
+    std::vector<PackedColor> colors = palette();
+    std::vector<PackedColor> expected;
+    for (const PackedColor& color : colors) {
+        expected.push_back(ColorSpace::scaleBrightness(color, 0.3f));
+    }
+    ColorSpace::scaleBrightness(colors.data(), colors.size(), 0.3f);
+    EXPECT_EQ(colors, expected);
+}
+
+// Test that blends mix light, so red to green passes through a bright yellow
+TEST_F(PackedColorTest, BlendsInLinearLight) {
+    PackedColor mid = ColorSpace::blend(PackedColor(255, 0, 0), PackedColor(0, 255, 0), 0.5f);
+    EXPECT_EQ(mid.r, 188);
+    EXPECT_EQ(mid.g, 188);
+    EXPECT_EQ(ColorSpace::blend(PackedColor(10, 20, 30), PackedColor(200, 100, 0), 0.0f), PackedColor(10, 20, 30));
+
+    PackedColor covered = ColorSpace::over(PackedColor(0, 0, 255), PackedColor(255, 0, 0, 255));
+    EXPECT_EQ(covered, PackedColor(255, 0, 0));
+    PackedColor clear = ColorSpace::over(PackedColor(0, 0, 255), PackedColor(255, 0, 0, 0));
+    EXPECT_EQ(clear, PackedColor(0, 0, 255));
+}
+
+// Test that the bulk Godot Color conversions match the single-color path
+TEST_F(PackedColorTest, BulkFloatConversions) {
+    std::vector<PackedColor> colors = palette();
+    std::vector<float> rgba(colors.size() * 4);
+    ColorSpace::unpackFloats(colors.data(), colors.size(), rgba.data());
+    EXPECT_FLOAT_EQ(rgba[4 * 3 + 0], colors[3].r / 255.0f);
+    EXPECT_FLOAT_EQ(rgba[4 * 36 + 3], colors[36].a / 255.0f);
+
+    std::vector<PackedColor> packed(colors.size());
+    ColorSpace::packFloats(rgba.data(), rgba.size() / 4, packed.data());
+    EXPECT_EQ(packed, colors);
+
+    // Out-of-range floats saturate in the SIMD path too
+    std::vector<float> wild(16, 4.0f);
+    wild[1] = -3.0f;
+    std::vector<PackedColor> saturated(4);
+    ColorSpace::packFloats(wild.data(), 4, saturated.data());
+    EXPECT_EQ(saturated[0], PackedColor(255, 0, 255, 255));
+}
+
+// Test that linear planes encode and decode in bulk like the single-color path
+TEST_F(PackedColorTest, BulkLinearConversions) {
+    std::vector<PackedColor> colors = palette();
+    std::vector<float> red(kColors), green(kColors), blue(kColors);
+    ColorSpace::decodeLinear(colors.data(), kColors, red.data(), green.data(), blue.data());
+    for (size_t i = 0; i < kColors; ++i) {
+        LedColor linear = colors[i].toLinear();
+        EXPECT_FLOAT_EQ(red[i], linear.r);
+        EXPECT_FLOAT_EQ(green[i], linear.g);
+        EXPECT_FLOAT_EQ(blue[i], linear.b);
+    }
+
+    std::vector<PackedColor> encoded(kColors);
+    ColorSpace::encodeLinear(red.data(), green.data(), blue.data(), kColors, 77, encoded.data());
+    for (size_t i = 0; i < kColors; ++i) {
+        EXPECT_NEAR(encoded[i].r, colors[i].r, 1) << i;
+        EXPECT_NEAR(encoded[i].g, colors[i].g, 1) << i;
+        EXPECT_NEAR(encoded[i].b, colors[i].b, 1) << i;
+        EXPECT_EQ(encoded[i].a, 77);
+    }
+}
+
+// Test that NaN encodes as black on both the scalar and SIMD paths instead of indexing past the tables
+TEST_F(PackedColorTest, NanEncodesAsZero) {
+    const float nan = std::nanf("");
+    EXPECT_EQ(ColorSpace::toSrgb(nan), 0);
+    EXPECT_EQ(PackedColor::fromFloat(nan, 1.0f, nan, nan), PackedColor(0, 255, 0, 0));
+    EXPECT_EQ(ColorSpace::fromLinear({nan, 0.5f, nan}), PackedColor(0, 188, 0));
+    EXPECT_EQ(ColorSpace::blend(PackedColor(10, 20, 30), PackedColor(200, 100, 0), nan), PackedColor(10, 20, 30));
+
+    std::vector<float> red(kColors, nan), green(kColors, 1.0f), blue(kColors, nan);
+    std::vector<PackedColor> encoded(kColors);
+    ColorSpace::encodeLinear(red.data(), green.data(), blue.data(), kColors, 255, encoded.data());
+    for (size_t i = 0; i < kColors; ++i) {
+        EXPECT_EQ(encoded[i], PackedColor(0, 255, 0)) << i;
+    }
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+// ScanBufferPool is Godot-free, so the real implementation is tested directly
+#include "scan_buffer_pool.h"
+#include "scan_job.h"
+
+// Test that released pixels are handed out again instead of reallocated
+TEST(ScanBufferPoolTest, ReusesReleasedStorage) {
+    ScanBufferPool pool;
+
+    ScanBufferPool::Buffer first = pool.acquire(64, 64);
+    ASSERT_TRUE(first.isValid());
+    EXPECT_EQ(first.getByteSize(), 64u * 64u * 2u);
+    const uint8_t* firstStorage = first.data();
+
+    ScanImageHandle image = pool.publish(std::move(first));
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->data(), firstStorage);
+    image.reset();
+
+    ScanBufferPool::Buffer second = pool.acquire(64, 64);
+    EXPECT_EQ(second.data(), firstStorage);
+
+    ScanBufferPool::Stats stats = pool.getStats();
+    EXPECT_EQ(stats.allocations, 1u);
+    EXPECT_EQ(stats.reuses, 1u);
+    EXPECT_EQ(stats.pooledBytes, 0u);
+}
+
+// Test that storage is only recycled into buffers of the same size
+TEST(ScanBufferPoolTest, KeepsSizesApart) {
+    ScanBufferPool pool;
+    pool.publish(pool.acquire(32, 32)).reset();
+
+    ScanBufferPool::Buffer larger = pool.acquire(64, 64);
+    EXPECT_EQ(larger.getByteSize(), 64u * 64u * 2u);
+    EXPECT_EQ(pool.getStats().allocations, 2u);
+    EXPECT_EQ(pool.getStats().pooledBytes, 32u * 32u * 2u);
+}
+
+// Test that a buffer dropped before publishing (a cancelled scan) is recycled
+TEST(ScanBufferPoolTest, UnpublishedBufferReturns) {
+    ScanBufferPool pool;
+    {
+        ScanBufferPool::Buffer abandoned = pool.acquire(16, 16);
+    }
+    EXPECT_EQ(pool.getStats().pooledBytes, 16u * 16u * 2u);
+
+    ScanBufferPool::Buffer reused = pool.acquire(16, 16);
+    EXPECT_EQ(pool.getStats().reuses, 1u);
+}
+
+// Test that copies of a handle share pixels and the storage outlives the pool
+TEST(ScanBufferPoolTest, HandlesSharePixels) {
+    ScanImageHandle kept;
+    {
+        ScanBufferPool pool;
+        ScanBufferPool::Buffer buffer = pool.acquire(8, 4);
+        std::memset(buffer.data(), 0x5A, buffer.getByteSize());
+        kept = pool.publish(std::move(buffer));
+
+        ScanImageHandle copy = kept;
+        EXPECT_EQ(copy->data(), kept->data());
+        EXPECT_EQ(pool.getStats().bytesCopied, 0u);
+        EXPECT_EQ(pool.getStats().pooledBytes, 0u); // still referenced
+    }
+
+    ASSERT_NE(kept, nullptr);
+    EXPECT_EQ(kept->getWidth(), 8u);
+    EXPECT_EQ(kept->getHeight(), 4u);
+    EXPECT_EQ(kept->data()[kept->getByteSize() - 1], 0x5A);
+}
+
+// Test that retention stops at the budget and trim() releases everything
+TEST(ScanBufferPoolTest, RetentionBudget) {
+    ScanBufferPool pool(2 * 1024 + 512);
+    ScanImageHandle a = pool.publish(pool.acquire(32, 16));
+    ScanImageHandle b = pool.publish(pool.acquire(32, 16));
+    ScanImageHandle c = pool.publish(pool.acquire(32, 16));
+    a.reset();
+    b.reset();
+    c.reset();
+
+    EXPECT_EQ(pool.getStats().pooledBytes, 2u * 1024u);
+
+    pool.trim();
+    EXPECT_EQ(pool.getStats().pooledBytes, 0u);
+}
+
+// Test that consumers forced to copy are accounted for
+TEST(ScanBufferPoolTest, RecordsCopies) {
+    ScanBufferPool pool;
+    pool.recordCopy(1024);
+    pool.recordCopy(512);
+    EXPECT_EQ(pool.getStats().bytesCopied, 1536u);
+}
+
+// Test that 16-bit pixels map through the display window to 8-bit gray
+TEST(ScanBufferPoolTest, WindowsToGray8) {
+    ScanBufferPool pool;
+    ScanBufferPool::Buffer buffer = pool.acquire(4, 1);
+    const uint16_t values[4] = {0, 1000, 2000, 4095};
+    std::memcpy(buffer.data(), values, sizeof(values));
+    ScanImageHandle image = pool.publish(std::move(buffer));
+
+    uint8_t gray[4] = {};
+    ASSERT_TRUE(image->windowToGray8(2048.0f, 4096.0f, gray));
+    EXPECT_EQ(gray[0], 0);
+    EXPECT_EQ(gray[1], 62);
+    EXPECT_EQ(gray[2], 125);
+    EXPECT_EQ(gray[3], 255);
+
+    // A narrow window saturates either side of it
+    ASSERT_TRUE(image->windowToGray8(1500.0f, 1000.0f, gray));
+    EXPECT_EQ(gray[0], 0);
+    EXPECT_EQ(gray[1], 0);
+    EXPECT_EQ(gray[2], 255);
+    EXPECT_EQ(gray[3], 255);
+
+    EXPECT_FALSE(image->windowToGray8(2048.0f, 0.0f, gray));
+    EXPECT_FALSE(image->windowToGray8(std::nanf(""), 4096.0f, gray));
+
+    // Only 16-bit grayscale is windowed
+    ScanImageHandle rgba = pool.publish(pool.acquire(2, 2, 4));
+    EXPECT_FALSE(rgba->windowToGray8(2048.0f, 4096.0f, gray));
+}
+
+// Test that back-to-back acquisitions settle into reuse
+TEST(ScanBufferPoolTest, SteadyStateScansDoNotAllocate) {
+    ScanBufferPool pool;
+    for (int i = 0; i < 5; ++i) {
+        ScanJob job(ScanJob::simulatedAcquisition("brain", 1, pool));
+        job.execute();
+        ASSERT_EQ(job.getStatus(), ScanJob::Status::COMPLETED);
+    }
+
+    ScanBufferPool::Stats stats = pool.getStats();
+    EXPECT_EQ(stats.allocations, 1u);
+    EXPECT_EQ(stats.reuses, 4u);
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// ScanCache is Godot-free, so the real implementation is tested directly
+#include "scan_cache.h"
+
+class ScanCacheTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t kSide = 32;
+    static constexpr size_t kScanBytes = kSide * kSide * 2;
+
+    // A small scan whose pixels are all one byte value
+    ScanData makeScan(const std::string& type, int64_t timestampUs, uint8_t fill) {
+        ScanBufferPool::Buffer buffer = pool.acquire(kSide, kSide);
+        std::memset(buffer.data(), fill, buffer.getByteSize());
+        ScanData scan(type);
+        scan.timestampUs = timestampUs;
+        scan.quality = 0.5f + fill / 512.0f;
+        scan.image = pool.publish(std::move(buffer));
+        return scan;
+    }
+
+    static ScanCache::Key key(const std::string& type, int64_t timestampUs, const std::string& patient = "p1") {
+        return ScanCache::Key{patient, type, timestampUs};
+    }
+
+    ScanBufferPool pool;
+};
+
+// Test that scans of the same type are kept side by side, not overwritten
+TEST_F(ScanCacheTest, KeepsHistoryPerType) {
+    ScanCache cache(16 * kScanBytes, pool);
+    cache.put(key("brain", 100), makeScan("brain", 100, 1));
+    cache.put(key("brain", 200), makeScan("brain", 200, 2));
+    cache.put(key("brain", 100, "p2"), makeScan("brain", 100, 3));
+
+    ScanData scan;
+    ASSERT_TRUE(cache.get(key("brain", 100), scan));
+    EXPECT_EQ(scan.image->data()[0], 1);
+    ASSERT_TRUE(cache.get(key("brain", 200), scan));
+    EXPECT_EQ(scan.image->data()[0], 2);
+    ASSERT_TRUE(cache.get(key("brain", 100, "p2"), scan));
+    EXPECT_EQ(scan.image->data()[0], 3);
+    EXPECT_FALSE(cache.get(key("brain", 300), scan));
+
+    ScanCache::Stats stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 3u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entryCount, 3u);
+    EXPECT_EQ(stats.bytesUsed, 3 * kScanBytes);
+}
+
+// Test that the newest scan is found by patient and type
+TEST_F(ScanCacheTest, LatestByTimestamp) {
+    ScanCache cache(16 * kScanBytes, pool);
+    cache.put(key("full_body", 500), makeScan("full_body", 500, 5));
+    cache.put(key("full_body", 300), makeScan("full_body", 300, 3));
+
+    int64_t newest = 0;
+    ASSERT_TRUE(cache.getLatestTimestamp("p1", "full_body", newest));
+    EXPECT_EQ(newest, 500);
+
+    ScanData scan;
+    ASSERT_TRUE(cache.getLatest("p1", "full_body", scan));
+    EXPECT_EQ(scan.timestampUs, 500);
+    EXPECT_FALSE(cache.getLatest("p2", "full_body", scan));
+}
+
+// Test that the least recently used scan is evicted first
+TEST_F(ScanCacheTest, EvictsLeastRecentlyUsed) {
+    ScanCache cache(2 * kScanBytes, pool);
+    cache.put(key("brain", 1), makeScan("brain", 1, 1));
+    cache.put(key("brain", 2), makeScan("brain", 2, 2));
+
+    ScanData scan;
+    ASSERT_TRUE(cache.get(key("brain", 1), scan)); // 2 is now the oldest
+    cache.put(key("brain", 3), makeScan("brain", 3, 3));
+
+    EXPECT_TRUE(cache.contains(key("brain", 1)));
+    EXPECT_FALSE(cache.contains(key("brain", 2)));
+    EXPECT_TRUE(cache.contains(key("brain", 3)));
+
+    ScanCache::Stats stats = cache.getStats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.spills, 0u);
+    EXPECT_LE(stats.bytesUsed, stats.byteBudget);
+}
+
+// Test that replacing a key does not double count its bytes
+TEST_F(ScanCacheTest, ReplacingKeepsAccounting) {
+    ScanCache cache(4 * kScanBytes, pool);
+    cache.put(key("brain", 1), makeScan("brain", 1, 1));
+    cache.put(key("brain", 1), makeScan("brain", 1, 9));
+
+    ScanData scan;
+    ASSERT_TRUE(cache.get(key("brain", 1), scan));
+    EXPECT_EQ(scan.image->data()[0], 9);
+    EXPECT_EQ(cache.getStats().bytesUsed, kScanBytes);
+    EXPECT_EQ(cache.getStats().entryCount, 1u);
+}
+
+// Test that shrinking the budget evicts straight away
+TEST_F(ScanCacheTest, ShrinkingBudgetEvicts) {
+    ScanCache cache(4 * kScanBytes, pool);
+    for (int64_t t = 0; t < 4; ++t) {
+        cache.put(key("brain", t), makeScan("brain", t, static_cast<uint8_t>(t)));
+    }
+
+    cache.setByteBudget(kScanBytes);
+    EXPECT_EQ(cache.getStats().entryCount, 1u);
+    EXPECT_TRUE(cache.contains(key("brain", 3)));
+}
+
+// Test that evicted scans spill to disk and come back intact
+TEST_F(ScanCacheTest, SpillsAndReloads) {
+    ScanCache cache(kScanBytes, pool);
+    cache.setSpillDirectory(::testing::TempDir());
+
+    cache.put(key("brain", 1), makeScan("brain", 1, 0x11));
+    cache.put(key("brain", 2), makeScan("brain", 2, 0x22));
+    EXPECT_EQ(cache.getStats().spills, 1u);
+    EXPECT_EQ(cache.getStats().spilledCount, 1u);
+    EXPECT_TRUE(cache.contains(key("brain", 1)));
+
+    ScanData scan;
+    ASSERT_TRUE(cache.get(key("brain", 1), scan));
+    ASSERT_NE(scan.image, nullptr);
+    EXPECT_EQ(scan.timestampUs, 1);
+    EXPECT_EQ(scan.scanType, "brain");
+    EXPECT_FLOAT_EQ(scan.quality, 0.5f + 0x11 / 512.0f);
+    EXPECT_EQ(scan.image->getWidth(), kSide);
+    EXPECT_EQ(scan.image->data()[kScanBytes - 1], 0x11);
+
+    // Reloading pushed the other scan out to disk in turn
+    ScanCache::Stats stats = cache.getStats();
+    EXPECT_EQ(stats.spillReloads, 1u);
+    EXPECT_EQ(stats.spills, 2u);
+    EXPECT_EQ(stats.entryCount, 1u);
+    EXPECT_EQ(stats.spilledCount, 1u);
+
+    cache.clear();
+    EXPECT_FALSE(cache.contains(key("brain", 2)));
+    EXPECT_EQ(cache.getStats().spilledCount, 0u);
+}
+
+// Test that a spill header whose image size disagrees with the file is refused before allocating
+TEST_F(ScanCacheTest, RejectsCorruptSpillHeader) {
+    ScanCache cache(kScanBytes, pool);
+    cache.setSpillDirectory(::testing::TempDir());
+    cache.put(key("brain", 1), makeScan("brain", 1, 1));
+    cache.put(key("brain", 2), makeScan("brain", 2, 2));
+    ASSERT_EQ(cache.getStats().spilledCount, 1u);
+
+    // The first spill of this cache; width sits after the magic and version
+    std::string path = ::testing::TempDir() + "/scan_" + std::to_string(reinterpret_cast<uintptr_t>(&cache)) + "_0.bin";
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    const uint32_t hugeWidth = 0x40000000;
+    std::fseek(file, 8, SEEK_SET);
+    std::fwrite(&hugeWidth, sizeof(hugeWidth), 1, file);
+    std::fclose(file);
+
+    ScanData scan;
+    EXPECT_FALSE(cache.get(key("brain", 1), scan));
+    EXPECT_EQ(cache.getStats().spillReloads, 0u);
+    EXPECT_FALSE(cache.contains(key("brain", 1)));
+
+    // The corrupt file is removed rather than retried
+    file = std::fopen(path.c_str(), "rb");
+    EXPECT_EQ(file, nullptr);
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+// Test that a spill directory that cannot be written degrades to plain eviction
+TEST_F(ScanCacheTest, UnwritableSpillDirectory) {
+    ScanCache cache(kScanBytes, pool);
+    cache.setSpillDirectory(::testing::TempDir() + "missing_scan_cache_dir");
+
+    cache.put(key("brain", 1), makeScan("brain", 1, 1));
+    cache.put(key("brain", 2), makeScan("brain", 2, 2));
+
+    EXPECT_EQ(cache.getStats().evictions, 1u);
+    EXPECT_EQ(cache.getStats().spills, 0u);
+    EXPECT_FALSE(cache.contains(key("brain", 1)));
+}
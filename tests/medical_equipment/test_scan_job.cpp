@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+// ScanJob is Godot-free, so the real implementation is tested directly
+#include "scan_job.h"
+#include "worker_pool.h"
+
+namespace {
+
+// Polls like the main thread does, with a generous timeout
+bool waitUntilDone(const ScanJob& job) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!job.isDone()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+// Test a simulated acquisition running on the pool
+TEST(ScanJobTest, CompletesOnWorker) {
+    WorkerPool pool(1);
+    auto job = std::make_shared<ScanJob>(ScanJob::simulatedAcquisition("brain"));
+    EXPECT_EQ(job->getStatus(), ScanJob::Status::QUEUED);
+
+    pool.submit([job]() { job->execute(); });
+
+    ASSERT_TRUE(waitUntilDone(*job));
+    EXPECT_EQ(job->getStatus(), ScanJob::Status::COMPLETED);
+    EXPECT_FLOAT_EQ(job->getProgress(), 1.0f);
+    EXPECT_EQ(job->getResult().scanType, "brain");
+    ASSERT_NE(job->getResult().image, nullptr);
+    EXPECT_EQ(job->getResult().image->getWidth(), ScanJob::kSliceWidth);
+    EXPECT_EQ(job->getResult().image->getByteSize(), ScanJob::kSliceWidth * ScanJob::kSliceHeight * 2u);
+}
+
+// Test that submitting does not wait for the workload
+TEST(ScanJobTest, SubmitDoesNotBlock) {
+    WorkerPool pool(1);
+    std::atomic<bool> release{false};
+    auto job = std::make_shared<ScanJob>([&release](ScanJob& self, ScanData& /*result*/) {
+        while (!release.load() && !self.isCancelled()) {
+            self.setProgress(0.5f);
+            std::this_thread::yield();
+        }
+        return !self.isCancelled();
+    });
+
+    pool.submit([job]() { job->execute(); });
+    EXPECT_FALSE(job->isDone());
+
+    release.store(true);
+    ASSERT_TRUE(waitUntilDone(*job));
+    EXPECT_EQ(job->getStatus(), ScanJob::Status::COMPLETED);
+}
+
+// Test cooperative cancellation of a running workload
+TEST(ScanJobTest, CancelStopsWorkload) {
+    WorkerPool pool(1);
+    std::atomic<bool> started{false};
+    auto job = std::make_shared<ScanJob>([&started](ScanJob& self, ScanData& /*result*/) {
+        started.store(true);
+        while (!self.isCancelled()) {
+            std::this_thread::yield();
+        }
+        return false;
+    });
+
+    pool.submit([job]() { job->execute(); });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+    job->cancel();
+
+    ASSERT_TRUE(waitUntilDone(*job));
+    EXPECT_EQ(job->getStatus(), ScanJob::Status::CANCELLED);
+}
+
+// Test that a job cancelled before it runs never starts its workload
+TEST(ScanJobTest, CancelBeforeStart) {
+    bool ran = false;
+    ScanJob job([&ran](ScanJob&, ScanData&) {
+        ran = true;
+        return true;
+    });
+
+    job.cancel();
+    job.execute();
+
+    EXPECT_FALSE(ran);
+    EXPECT_EQ(job.getStatus(), ScanJob::Status::CANCELLED);
+}
+
+// Test that a workload reporting failure is not mistaken for cancellation
+TEST(ScanJobTest, FailedWorkload) {
+    ScanJob job([](ScanJob&, ScanData&) { return false; });
+    job.execute();
+    EXPECT_EQ(job.getStatus(), ScanJob::Status::FAILED);
+    EXPECT_TRUE(job.isDone());
+}
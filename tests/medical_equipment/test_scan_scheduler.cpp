@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ScanScheduler is Godot-free, so the real implementation is tested directly
+#include "scan_scheduler.h"
+#include "worker_pool.h"
+
+class ScanSchedulerTest : public ::testing::Test {
+protected:
+    using Priority = ScanScheduler::Priority;
+
+    // Jobs hold their scanner until released (or cancelled), so tests decide when scans finish
+    void useGatedWorkloads(ScanScheduler& scheduler) {
+        scheduler.setWorkloadFactory([this](const ScanScheduler::Request& request) {
+            std::string type = request.scanType;
+            return ScanJob::Workload([this, type](ScanJob& job, ScanData& result) {
+                while (!released.load()) {
+                    if (job.isCancelled()) {
+                        return false;
+                    }
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+                result = ScanData(type);
+                return type != "broken";
+            });
+        });
+    }
+
+    // Records the order in which requests finish
+    ScanScheduler::CompletionHandler recordInto(std::vector<uint64_t>& order) {
+        return [&order](const ScanScheduler::Request& request, ScanJob::Status, const ScanData&) {
+            order.push_back(request.id);
+        };
+    }
+
+    // Polls like the main thread until a condition holds, with a generous timeout
+    bool pollUntil(ScanScheduler& scheduler, const std::function<bool()>& condition) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            scheduler.poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    std::atomic<bool> released{false};
+    WorkerPool workers{4}; // joined first, while the jobs can still read released
+};
+
+// Test that requests start straight away while scanners are free
+TEST_F(ScanSchedulerTest, StartsOnFreeScanners) {
+    ScanScheduler scheduler(2, workers);
+    useGatedWorkloads(scheduler);
+
+    std::vector<uint32_t> preemptions;
+    auto recordPreemptions = [&preemptions](const ScanScheduler::Request& request, ScanJob::Status, const ScanData&) {
+        preemptions.push_back(request.preemptions);
+    };
+    uint64_t a = scheduler.submit("brain", Priority::ROUTINE, recordPreemptions);
+    uint64_t b = scheduler.submit("heart", Priority::ROUTINE, recordPreemptions);
+    uint64_t c = scheduler.submit("lungs", Priority::ROUTINE, nullptr);
+
+    EXPECT_NE(a, 0u);
+    EXPECT_TRUE(scheduler.isRunning(a));
+    EXPECT_TRUE(scheduler.isRunning(b));
+    EXPECT_FALSE(scheduler.isRunning(c));
+    EXPECT_EQ(scheduler.getQueuePosition(c), 0);
+
+    ScanScheduler::Stats stats = scheduler.getStats();
+    EXPECT_EQ(stats.running, 2u);
+    EXPECT_EQ(stats.queueDepth, 1u);
+    EXPECT_EQ(stats.queuedByPriority[static_cast<size_t>(Priority::ROUTINE)], 1u);
+    released = true;
+}
+
+// Test first-in first-out order within one priority
+TEST_F(ScanSchedulerTest, RoutineRequestsRunInOrder) {
+    ScanScheduler scheduler(1, workers);
+    useGatedWorkloads(scheduler);
+
+    std::vector<uint64_t> order;
+    uint64_t a = scheduler.submit("brain", Priority::ROUTINE, recordInto(order));
+    uint64_t b = scheduler.submit("heart", Priority::ROUTINE, recordInto(order));
+    uint64_t c = scheduler.submit("lungs", Priority::ROUTINE, recordInto(order));
+    EXPECT_EQ(scheduler.getQueuePosition(b), 0);
+    EXPECT_EQ(scheduler.getQueuePosition(c), 1);
+
+    released = true;
+    ASSERT_TRUE(pollUntil(scheduler, [&]() { return order.size() == 3; }));
+    EXPECT_EQ(order, (std::vector<uint64_t>{a, b, c}));
+    EXPECT_EQ(scheduler.getStats().completed, 3u);
+    EXPECT_FALSE(scheduler.isPending(c));
+}
+
+// Test that more urgent requests jump the queue
+TEST_F(ScanSchedulerTest, UrgentQueuesAheadOfRoutine) {
+    ScanScheduler scheduler(1, workers);
+    useGatedWorkloads(scheduler);
+
+    scheduler.submit("full_body", Priority::ROUTINE, nullptr);
+    uint64_t routine = scheduler.submit("brain", Priority::ROUTINE, nullptr);
+    uint64_t urgent = scheduler.submit("heart", Priority::URGENT, nullptr);
+
+    EXPECT_EQ(scheduler.getQueuePosition(urgent), 0);
+    EXPECT_EQ(scheduler.getQueuePosition(routine), 1);
+    EXPECT_EQ(scheduler.getStats().preemptions, 0u);
+    released = true;
+}
+
+// Test that an emergency takes the scanner from a routine scan, which runs again afterwards
+TEST_F(ScanSchedulerTest, EmergencyPreemptsRoutine) {
+    ScanScheduler scheduler(1, workers);
+    useGatedWorkloads(scheduler);
+
+    std::vector<uint64_t> order;
+    uint32_t routinePreemptions = 0;
+    uint64_t routine = scheduler.submit("full_body", Priority::ROUTINE,
+        [&](const ScanScheduler::Request& request, ScanJob::Status, const ScanData&) {
+            routinePreemptions = request.preemptions;
+            order.push_back(request.id);
+        });
+    ASSERT_TRUE(scheduler.isRunning(routine));
+
+    uint64_t emergency = scheduler.submit("brain", Priority::EMERGENCY, recordInto(order));
+    EXPECT_TRUE(scheduler.isRunning(emergency));
+    EXPECT_FALSE(scheduler.isRunning(routine));
+    EXPECT_EQ(scheduler.getQueuePosition(routine), 0);
+    EXPECT_EQ(scheduler.getStats().preemptions, 1u);
+
+    released = true;
+    ASSERT_TRUE(pollUntil(scheduler, [&]() { return order.size() == 2; }));
+    EXPECT_EQ(order, (std::vector<uint64_t>{emergency, routine}));
+    EXPECT_EQ(routinePreemptions, 1u);
+}
+
+// Test that an emergency waits rather than interrupt an urgent scan
+TEST_F(ScanSchedulerTest, EmergencyDoesNotPreemptUrgent) {
+    ScanScheduler scheduler(1, workers);
+    useGatedWorkloads(scheduler);
+
+    uint64_t urgent = scheduler.submit("heart", Priority::URGENT, nullptr);
+    uint64_t emergency = scheduler.submit("brain", Priority::EMERGENCY, nullptr);
+
+    EXPECT_TRUE(scheduler.isRunning(urgent));
+    EXPECT_EQ(scheduler.getQueuePosition(emergency), 0);
+    EXPECT_EQ(scheduler.getStats().preemptions, 0u);
+    released = true;
+}
+
+// Test that cancelled requests never report and free their scanner
+TEST_F(ScanSchedulerTest, CancelQueuedAndRunning) {
+    ScanScheduler scheduler(1, workers);
+    useGatedWorkloads(scheduler);
+
+    std::vector<uint64_t> order;
+    uint64_t running = scheduler.submit("brain", Priority::ROUTINE, recordInto(order));
+    uint64_t queued = scheduler.submit("heart", Priority::ROUTINE, recordInto(order));
+    uint64_t last = scheduler.submit("lungs", Priority::ROUTINE, recordInto(order));
+
+    EXPECT_TRUE(scheduler.cancel(queued));
+    EXPECT_TRUE(scheduler.cancel(running));
+    EXPECT_FALSE(scheduler.cancel(running));
+    EXPECT_TRUE(scheduler.isRunning(last));
+
+    released = true;
+    ASSERT_TRUE(pollUntil(scheduler, [&]() { return !order.empty(); }));
+    EXPECT_EQ(order, (std::vector<uint64_t>{last}));
+    EXPECT_EQ(scheduler.getStats().cancelled, 2u);
+}
+
+// Test that failed scans are reported with their status
+TEST_F(ScanSchedulerTest, ReportsFailures) {
+    ScanScheduler scheduler(1, workers);
+    useGatedWorkloads(scheduler);
+    released = true;
+
+    ScanJob::Status reported = ScanJob::Status::QUEUED;
+    scheduler.submit("broken", Priority::ROUTINE,
+        [&](const ScanScheduler::Request&, ScanJob::Status status, const ScanData&) { reported = status; });
+
+    ASSERT_TRUE(pollUntil(scheduler, [&]() { return reported != ScanJob::Status::QUEUED; }));
+    EXPECT_EQ(reported, ScanJob::Status::FAILED);
+    EXPECT_EQ(scheduler.getStats().failed, 1u);
+}
+
+// Test wait time and utilization accounting
+TEST_F(ScanSchedulerTest, WaitAndUtilization) {
+    ScanScheduler scheduler(1, workers);
+    useGatedWorkloads(scheduler);
+
+    std::vector<uint64_t> order;
+    scheduler.submit("brain", Priority::ROUTINE, recordInto(order));
+    scheduler.submit("heart", Priority::ROUTINE, recordInto(order));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    ScanScheduler::Stats busy = scheduler.getStats();
+    EXPECT_GE(busy.oldestWaitUs, 15000);
+    EXPECT_GT(busy.utilization, 0.5);
+    EXPECT_LE(busy.utilization, 1.0);
+
+    released = true;
+    ASSERT_TRUE(pollUntil(scheduler, [&]() { return order.size() == 2; }));
+
+    ScanScheduler::Stats done = scheduler.getStats();
+    EXPECT_GE(done.maxWaitUs, 15000);
+    EXPECT_GT(done.averageWaitUs, 0.0);
+    EXPECT_EQ(done.queueDepth, 0u);
+    EXPECT_EQ(done.running, 0u);
+
+    scheduler.resetStats();
+    EXPECT_EQ(scheduler.getStats().completed, 0u);
+    EXPECT_EQ(scheduler.getStats().maxWaitUs, 0);
+}
+
+// Test that resizing the suite starts or requeues work
+TEST_F(ScanSchedulerTest, ResizeSuite) {
+    ScanScheduler scheduler(1, workers);
+    useGatedWorkloads(scheduler);
+
+    std::vector<uint32_t> preemptions;
+    auto recordPreemptions = [&preemptions](const ScanScheduler::Request& request, ScanJob::Status, const ScanData&) {
+        preemptions.push_back(request.preemptions);
+    };
+    uint64_t a = scheduler.submit("brain", Priority::ROUTINE, recordPreemptions);
+    uint64_t b = scheduler.submit("heart", Priority::ROUTINE, recordPreemptions);
+    EXPECT_FALSE(scheduler.isRunning(b));
+
+    scheduler.setScannerCount(2);
+    EXPECT_TRUE(scheduler.isRunning(a));
+    EXPECT_TRUE(scheduler.isRunning(b));
+
+    scheduler.setScannerCount(0); // clamps to one scanner
+    EXPECT_EQ(scheduler.getScannerCount(), 1u);
+    EXPECT_EQ(scheduler.getStats().running, 1u);
+    EXPECT_EQ(scheduler.getStats().queueDepth, 1u);
+
+    // Shrinking the suite displaces a scan but is not a preemption
+    released = true;
+    ASSERT_TRUE(pollUntil(scheduler, [&]() { return preemptions.size() == 2; }));
+    EXPECT_EQ(preemptions, std::vector<uint32_t>({0u, 0u}));
+    EXPECT_EQ(scheduler.getStats().preemptions, 0u);
+}
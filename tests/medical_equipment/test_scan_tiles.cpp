@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ScanTileStream is Godot-free, so the real implementation is tested directly
+#include "scan_tiles.h"
+#include "worker_pool.h"
+
+class ScanTilesTest : public ::testing::Test {
+protected:
+    WorkerPool workers{3};
+    ScanBufferPool pool;
+    std::string path;
+
+    void SetUp() override {
+        const ::testing::TestInfo* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path = ::testing::TempDir() + "scan_tiles_" + info->name() + ".bin";
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    // Air on the left half, a textured gradient on the right
+    ScanImageHandle makeImage(uint32_t width, uint32_t height) {
+        ScanBufferPool::Buffer buffer = pool.acquire(width, height);
+        uint16_t* pixels = buffer.pixels16();
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                pixels[y * width + x] = x < width / 2 ? 0 : static_cast<uint16_t>((x * 7 + y * 13 + (x ^ y)) % 4096);
+            }
+        }
+        return pool.publish(std::move(buffer));
+    }
+
+    // Polls until the stream has decoded and delivered everything
+    std::vector<ScanTileStream::TileUpdate> drain(ScanTileStream& stream) {
+        std::vector<ScanTileStream::TileUpdate> updates;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!stream.isFinished() && std::chrono::steady_clock::now() < deadline) {
+            stream.poll([&](const ScanTileStream::TileUpdate& update) { updates.push_back(update); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        stream.poll([&](const ScanTileStream::TileUpdate& update) { updates.push_back(update); });
+        EXPECT_TRUE(stream.isFinished());
+        return updates;
+    }
+};
+
+// Test that level 0 tiles reassemble into the original pixels, edge tiles included
+TEST_F(ScanTilesTest, FullResolutionRoundTrip) {
+    ScanImageHandle image = makeImage(300, 200);
+    ASSERT_TRUE(ScanTileFormat::write(path, *image, 64));
+
+    ScanTileReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.getWidth(), 300u);
+    EXPECT_EQ(reader.getHeight(), 200u);
+    ASSERT_EQ(reader.getLevelCount(), 4u);  // 300x200, 150x100, 75x50, 38x25
+    EXPECT_EQ(reader.getLevel(3).width, 38u);
+    EXPECT_EQ(reader.getLevel(3).height, 25u);
+
+    const ScanTileFormat::LevelInfo& level0 = reader.getLevel(0);
+    EXPECT_EQ(level0.tilesX, 5u);
+    EXPECT_EQ(level0.tilesY, 4u);
+    EXPECT_EQ(reader.getTileWidth(0, 4), 300u - 4 * 64);
+    EXPECT_EQ(reader.getTileHeight(0, 3), 200u - 3 * 64);
+
+    std::vector<uint16_t> assembled(300 * 200, 0xFFFF);
+    for (uint32_t ty = 0; ty < level0.tilesY; ++ty) {
+        for (uint32_t tx = 0; tx < level0.tilesX; ++tx) {
+            ASSERT_TRUE(reader.readTile(0, tx, ty, &assembled[ty * 64 * 300 + tx * 64], 300));
+        }
+    }
+    const uint16_t* original = reinterpret_cast<const uint16_t*>(image->data());
+    EXPECT_TRUE(std::equal(assembled.begin(), assembled.end(), original));
+}
+
+// Test that each mip level is a 2x2 average of the level below
+TEST_F(ScanTilesTest, MipLevelsAreBoxFiltered) {
+    ScanImageHandle image = makeImage(100, 60);
+    ASSERT_TRUE(ScanTileFormat::write(path, *image, 32));
+
+    ScanTileReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ASSERT_GE(reader.getLevelCount(), 2u);
+
+    std::vector<uint16_t> tile(32 * 32);
+    ASSERT_TRUE(reader.readTile(1, 1, 0, tile.data(), 32));
+
+    const uint16_t* original = reinterpret_cast<const uint16_t*>(image->data());
+    for (uint32_t y = 0; y < 30; ++y) {
+        for (uint32_t x = 0; x < 18; ++x) {
+            uint32_t sx = 2 * (32 + x);
+            uint32_t sy = 2 * y;
+            uint32_t sum = original[sy * 100 + sx] + original[sy * 100 + sx + 1] + original[(sy + 1) * 100 + sx] +
+                           original[(sy + 1) * 100 + sx + 1];
+            ASSERT_EQ(tile[y * 32 + x], (sum + 2) / 4) << x << "," << y;
+        }
+    }
+}
+
+// Test that flat tiles are run-length encoded and textured tiles stay raw
+TEST_F(ScanTilesTest, FlatTilesAreRunLengthEncoded) {
+    ScanImageHandle image = makeImage(256, 64);
+    ASSERT_TRUE(ScanTileFormat::write(path, *image, 64));
+
+    ScanTileReader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    const ScanTileFormat::TileEntry& air = reader.getTile(0, 0, 0);
+    EXPECT_TRUE(air.flags & ScanTileFormat::kTileRunLength);
+    EXPECT_LT(air.storedBytes, 64u);
+
+    const ScanTileFormat::TileEntry& tissue = reader.getTile(0, 3, 0);
+    EXPECT_FALSE(tissue.flags & ScanTileFormat::kTileRunLength);
+    EXPECT_EQ(tissue.storedBytes, 64u * 64u * 2u);
+
+    std::vector<uint16_t> tile(64 * 64, 0xFFFF);
+    ASSERT_TRUE(reader.readTile(0, 0, 0, tile.data(), 64));
+    EXPECT_TRUE(std::all_of(tile.begin(), tile.end(), [](uint16_t v) { return v == 0; }));
+}
+
+// Test that the coarse image is one small tile however large the scan is
+TEST_F(ScanTilesTest, CoarseImageSizeIsIndependentOfResolution) {
+    for (uint32_t size : {128u, 1024u, 2048u}) {
+        ScanImageHandle image = makeImage(size, size);
+        ASSERT_TRUE(ScanTileFormat::write(path, *image, 128));
+
+        ScanTileStream stream;
+        ASSERT_TRUE(stream.open(path, pool));
+        ASSERT_TRUE(stream.getCoarseImage());
+        EXPECT_LE(stream.getCoarseImage()->getWidth(), 128u) << size;
+        EXPECT_LE(stream.getCoarseImage()->getHeight(), 128u) << size;
+        EXPECT_EQ(stream.getWidth(), size);
+    }
+}
+
+// Test that streamed tiles arrive coarse to fine and rebuild the full image
+TEST_F(ScanTilesTest, StreamsCoarseToFine) {
+    ScanImageHandle image = makeImage(300, 200);
+    ASSERT_TRUE(ScanTileFormat::write(path, *image, 64));
+
+    ScanTileStream stream;
+    ASSERT_TRUE(stream.open(path, pool));
+    EXPECT_EQ(stream.getCoarseLevel(), 3u);
+    stream.start(0, workers);
+    std::vector<ScanTileStream::TileUpdate> updates = drain(stream);
+
+    ASSERT_EQ(updates.size(), stream.getTilesTotal());
+    EXPECT_EQ(stream.getTilesDelivered(), stream.getTilesTotal());
+    EXPECT_EQ(updates.front().level, 2u);
+
+    std::vector<uint16_t> assembled(300 * 200, 0xFFFF);
+    uint32_t previousLevel = updates.front().level;
+    for (const auto& update : updates) {
+        EXPECT_LE(update.level, previousLevel);
+        previousLevel = update.level;
+        if (update.level != 0) {
+            continue;
+        }
+        const uint16_t* tile = reinterpret_cast<const uint16_t*>(update.pixels->data());
+        for (uint32_t row = 0; row < update.pixels->getHeight(); ++row) {
+            std::copy(tile + row * update.pixels->getWidth(), tile + (row + 1) * update.pixels->getWidth(),
+                      &assembled[(update.y + row) * 300 + update.x]);
+        }
+    }
+    const uint16_t* original = reinterpret_cast<const uint16_t*>(image->data());
+    EXPECT_TRUE(std::equal(assembled.begin(), assembled.end(), original));
+}
+
+// Test that a corrupt tile is delivered without pixels, so the load still completes
+TEST_F(ScanTilesTest, CorruptTileStillCounts) {
+    ScanImageHandle image = makeImage(300, 200);
+    ASSERT_TRUE(ScanTileFormat::write(path, *image, 64));
+
+    // The top-left level 0 tile is all air, one (count, value) run; shorten the run
+    uint64_t offset = 0;
+    {
+        ScanTileReader reader;
+        ASSERT_TRUE(reader.open(path));
+        const ScanTileFormat::TileEntry& entry = reader.getTile(0, 0, 0);
+        ASSERT_NE(entry.flags & ScanTileFormat::kTileRunLength, 0u);
+        offset = entry.offset;
+    }
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    const uint16_t shortRun = 64 * 64 - 1;
+    std::fseek(file, static_cast<long>(offset), SEEK_SET);
+    std::fwrite(&shortRun, sizeof(shortRun), 1, file);
+    std::fclose(file);
+
+    ScanTileStream stream;
+    ASSERT_TRUE(stream.open(path, pool));
+    stream.start(0, workers);
+    std::vector<ScanTileStream::TileUpdate> updates = drain(stream);
+
+    ASSERT_EQ(updates.size(), stream.getTilesTotal());
+    EXPECT_EQ(stream.getTilesDelivered(), stream.getTilesTotal());
+    size_t missing = 0;
+    for (const auto& update : updates) {
+        if (!update.pixels) {
+            ++missing;
+            EXPECT_EQ(update.level, 0u);
+            EXPECT_EQ(update.x, 0u);
+            EXPECT_EQ(update.y, 0u);
+        }
+    }
+    EXPECT_EQ(missing, 1u);
+    EXPECT_EQ(stream.getTilesFailed(), 1u);
+}
+
+// Test that poll respects its per-call limit
+TEST_F(ScanTilesTest, PollIsBounded) {
+    ScanImageHandle image = makeImage(256, 256);
+    ASSERT_TRUE(ScanTileFormat::write(path, *image, 32));
+
+    ScanTileStream stream;
+    ASSERT_TRUE(stream.open(path, pool));
+    stream.start(0, workers);
+    while (stream.getTilesDelivered() < stream.getTilesTotal()) {
+        size_t delivered = stream.poll([](const ScanTileStream::TileUpdate&) {}, 3);
+        EXPECT_LE(delivered, 3u);
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(drain(stream).empty());
+}
+
+// Test that a cancelled stream stops and never delivers more than it decoded
+TEST_F(ScanTilesTest, CancelStopsDecoding) {
+    ScanImageHandle image = makeImage(1024, 1024);
+    ASSERT_TRUE(ScanTileFormat::write(path, *image, 16));
+
+    ScanTileStream stream;
+    ASSERT_TRUE(stream.open(path, pool));
+    stream.start(0, workers);
+    stream.cancel();
+
+    std::vector<ScanTileStream::TileUpdate> updates = drain(stream);
+    EXPECT_LT(updates.size(), stream.getTilesTotal());
+}
+
+// Test that files which are not tiled scans are rejected
+TEST_F(ScanTilesTest, RejectsInvalidFiles) {
+    ScanTileReader reader;
+    EXPECT_FALSE(reader.open(path));
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("definitely not a scan", file);
+    std::fclose(file);
+    EXPECT_FALSE(reader.open(path));
+
+    ScanTileStream stream;
+    EXPECT_FALSE(stream.open(path, pool));
+    EXPECT_FALSE(stream.getCoarseImage());
+    EXPECT_TRUE(stream.isFinished());
+}
+
+// Test that header and index fields are checked against the file before anything is sized from them
+TEST_F(ScanTilesTest, RejectsCorruptIndex) {
+    ScanImageHandle image = makeImage(300, 200);
+    ASSERT_TRUE(ScanTileFormat::write(path, *image, 64));
+    ScanTileReader reader;
+    ASSERT_TRUE(reader.open(path));
+    uint32_t levelCount = reader.getLevelCount();
+    reader.close();
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    std::vector<char> original;
+    for (int c; (c = std::fgetc(file)) != EOF;) {
+        original.push_back(static_cast<char>(c));
+    }
+    std::fclose(file);
+
+    // Overwrites one field of the valid file and tries to open it
+    auto openPatched = [&](size_t offset, const void* value, size_t size) {
+        std::vector<char> bytes = original;
+        std::memcpy(&bytes[offset], value, size);
+        std::FILE* patched = std::fopen(path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), patched);
+        std::fclose(patched);
+        ScanTileReader corrupt;
+        return corrupt.open(path);
+    };
+
+    using namespace ScanTileFormat;
+    const uint32_t hugeCount = 0x10000000;
+    const uint32_t hugeTile = 1u << 20;
+    const uint32_t wrongWidth = 301;
+    const uint64_t pastEnd = original.size();
+    const uint32_t hugeBytes = 0x40000000;
+    size_t firstEntry = sizeof(FileHeader) + sizeof(LevelInfo) * levelCount;
+
+    EXPECT_FALSE(openPatched(offsetof(FileHeader, tileCount), &hugeCount, sizeof(hugeCount)));
+    EXPECT_FALSE(openPatched(offsetof(FileHeader, tileSize), &hugeTile, sizeof(hugeTile)));
+    EXPECT_FALSE(openPatched(sizeof(FileHeader) + offsetof(LevelInfo, width), &wrongWidth, sizeof(wrongWidth)));
+    EXPECT_FALSE(openPatched(sizeof(FileHeader) + sizeof(LevelInfo) + offsetof(LevelInfo, width), &wrongWidth,
+                             sizeof(wrongWidth)));
+    EXPECT_FALSE(openPatched(firstEntry + offsetof(TileEntry, offset), &pastEnd, sizeof(pastEnd)));
+    EXPECT_FALSE(openPatched(firstEntry + offsetof(TileEntry, storedBytes), &hugeBytes, sizeof(hugeBytes)));
+
+    // The untouched file still opens
+    EXPECT_TRUE(openPatched(0, original.data(), 0));
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+
+// ScanVolume is Godot-free, so the real implementation is tested directly
+#include "scan_job.h"
+#include "scan_volume.h"
+#include "worker_pool.h"
+
+class ScanVolumeTest : public ::testing::Test {
+protected:
+    // Odd size so the SIMD loops also run their scalar tails
+    static constexpr uint32_t kSize = 37;
+
+    WorkerPool workers{3};
+    ScanBufferPool pool;
+};
+
+// Test that a phantom is deterministic per seed and varies between seeds
+TEST_F(ScanVolumeTest, GenerationIsSeeded) {
+    ScanVolume a, b, c;
+    a.generate(ScanVolume::Phantom::BRAIN, kSize, 7, workers);
+    b.generate(ScanVolume::Phantom::BRAIN, kSize, 7, workers);
+    c.generate(ScanVolume::Phantom::BRAIN, kSize, 8, workers);
+
+    ASSERT_EQ(a.getByteSize(), static_cast<size_t>(kSize) * kSize * kSize * 2);
+    EXPECT_TRUE(std::equal(a.data(), a.data() + kSize * kSize * kSize, b.data()));
+    EXPECT_FALSE(std::equal(a.data(), a.data() + kSize * kSize * kSize, c.data()));
+}
+
+// Test the broad anatomy of the brain phantom
+TEST_F(ScanVolumeTest, BrainAnatomy) {
+    ScanVolume volume;
+    volume.generate(ScanVolume::Phantom::BRAIN, 64, 1, workers);
+
+    EXPECT_EQ(volume.at(0, 0, 0), 0);                // air in the corner
+    EXPECT_GT(volume.at(32, 32, 32), 150);           // tissue in the middle
+    EXPECT_LT(volume.at(32, 32, 32), 2000);
+
+    // Walking in from the side passes through bone before reaching brain
+    uint16_t brightest = 0;
+    for (uint32_t x = 0; x < 32; ++x) {
+        brightest = std::max(brightest, volume.at(x, 32, 32));
+    }
+    EXPECT_GT(brightest, 2500);
+
+    uint16_t peak = *std::max_element(volume.data(), volume.data() + 64 * 64 * 64);
+    EXPECT_LE(peak, ScanVolume::kMaxIntensity);
+}
+
+// Test that every phantom fills the grid with something other than air
+TEST_F(ScanVolumeTest, AllPhantomsHaveTissue) {
+    for (auto phantom : {ScanVolume::Phantom::FULL_BODY, ScanVolume::Phantom::BRAIN, ScanVolume::Phantom::HEART,
+                         ScanVolume::Phantom::LUNGS}) {
+        ScanVolume volume;
+        volume.generate(phantom, 32, 1, workers);
+        size_t voxels = 32 * 32 * 32;
+        size_t solid = static_cast<size_t>(std::count_if(volume.data(), volume.data() + voxels,
+                                                         [](uint16_t v) { return v > 0; }));
+        EXPECT_GT(solid, voxels / 50) << static_cast<int>(phantom);
+    }
+}
+
+// Test slices against direct voxel reads, with the head at the top
+TEST_F(ScanVolumeTest, SlicesMatchVoxels) {
+    ScanVolume volume;
+    volume.generate(ScanVolume::Phantom::FULL_BODY, kSize, 3, workers);
+    const uint32_t last = kSize - 1;
+
+    ScanImageHandle axial = volume.renderSlice(ScanVolume::Axis::AXIAL, 11, pool, workers);
+    ScanImageHandle coronal = volume.renderSlice(ScanVolume::Axis::CORONAL, 19, pool, workers);
+    ScanImageHandle sagittal = volume.renderSlice(ScanVolume::Axis::SAGITTAL, 5, pool, workers);
+    ASSERT_NE(axial, nullptr);
+    ASSERT_NE(coronal, nullptr);
+    ASSERT_NE(sagittal, nullptr);
+    EXPECT_EQ(axial->getWidth(), kSize);
+    EXPECT_EQ(axial->getHeight(), kSize);
+
+    auto pixel = [](const ScanImageHandle& image, uint32_t col, uint32_t row) {
+        return reinterpret_cast<const uint16_t*>(image->data())[row * image->getWidth() + col];
+    };
+    for (uint32_t row = 0; row < kSize; ++row) {
+        for (uint32_t col = 0; col < kSize; ++col) {
+            ASSERT_EQ(pixel(axial, col, row), volume.at(col, row, 11));
+            ASSERT_EQ(pixel(coronal, col, row), volume.at(col, 19, last - row));
+            ASSERT_EQ(pixel(sagittal, col, row), volume.at(5, col, last - row));
+        }
+    }
+
+    // Out-of-range indices clamp to the last slice
+    ScanImageHandle clamped = volume.renderSlice(ScanVolume::Axis::AXIAL, 1000, pool, workers);
+    EXPECT_EQ(pixel(clamped, 3, 4), volume.at(3, 4, last));
+}
+
+// Test the SIMD projections against a brute force maximum
+TEST_F(ScanVolumeTest, MipMatchesBruteForce) {
+    ScanVolume volume;
+    volume.generate(ScanVolume::Phantom::LUNGS, kSize, 5, workers);
+    const uint32_t last = kSize - 1;
+
+    ScanImageHandle axial = volume.renderMip(ScanVolume::Axis::AXIAL, pool, workers);
+    ScanImageHandle coronal = volume.renderMip(ScanVolume::Axis::CORONAL, pool, workers);
+    ScanImageHandle sagittal = volume.renderMip(ScanVolume::Axis::SAGITTAL, pool, workers);
+
+    auto pixel = [](const ScanImageHandle& image, uint32_t col, uint32_t row) {
+        return reinterpret_cast<const uint16_t*>(image->data())[row * image->getWidth() + col];
+    };
+    for (uint32_t row = 0; row < kSize; ++row) {
+        for (uint32_t col = 0; col < kSize; ++col) {
+            uint16_t overZ = 0, overY = 0, overX = 0;
+            for (uint32_t i = 0; i < kSize; ++i) {
+                overZ = std::max(overZ, volume.at(col, row, i));
+                overY = std::max(overY, volume.at(col, i, last - row));
+                overX = std::max(overX, volume.at(i, col, last - row));
+            }
+            ASSERT_EQ(pixel(axial, col, row), overZ);
+            ASSERT_EQ(pixel(coronal, col, row), overY);
+            ASSERT_EQ(pixel(sagittal, col, row), overX);
+        }
+    }
+}
+
+// Test that an empty volume renders nothing
+TEST_F(ScanVolumeTest, EmptyVolume) {
+    ScanVolume volume;
+    EXPECT_EQ(volume.renderSlice(ScanVolume::Axis::AXIAL, 0, pool, workers), nullptr);
+    EXPECT_EQ(volume.renderMip(ScanVolume::Axis::SAGITTAL, pool, workers), nullptr);
+}
+
+// Test scan type names used by Scanner
+TEST_F(ScanVolumeTest, PhantomFromName) {
+    EXPECT_EQ(ScanVolume::phantomFromName("brain"), ScanVolume::Phantom::BRAIN);
+    EXPECT_EQ(ScanVolume::phantomFromName("heart"), ScanVolume::Phantom::HEART);
+    EXPECT_EQ(ScanVolume::phantomFromName("lungs"), ScanVolume::Phantom::LUNGS);
+    EXPECT_EQ(ScanVolume::phantomFromName("full_body"), ScanVolume::Phantom::FULL_BODY);
+    EXPECT_EQ(ScanVolume::phantomFromName("unknown"), ScanVolume::Phantom::FULL_BODY);
+}
+
+// Test the volumetric scan workload end to end
+TEST_F(ScanVolumeTest, VolumetricAcquisition) {
+    ScanJob job(ScanJob::volumetricAcquisition("heart", 32, 9, 4));
+    job.execute();
+
+    ASSERT_EQ(job.getStatus(), ScanJob::Status::COMPLETED);
+    const ScanData& scan = job.getResult();
+    ASSERT_NE(scan.volume, nullptr);
+    ASSERT_NE(scan.image, nullptr);
+    EXPECT_EQ(scan.volume->getPhantom(), ScanVolume::Phantom::HEART);
+    EXPECT_EQ(scan.volume->getSize(), 32u);
+    EXPECT_EQ(scan.image->getWidth(), 32u);
+    EXPECT_EQ(reinterpret_cast<const uint16_t*>(scan.image->data())[5 * 32 + 7], scan.volume->at(7, 5, 16));
+}
+
+// Test that a cancelled volumetric scan stops without a result
+TEST_F(ScanVolumeTest, VolumetricAcquisitionCancelled) {
+    ScanJob job(ScanJob::volumetricAcquisition("brain", 32, 1, 4));
+    job.cancel();
+    job.execute();
+    EXPECT_EQ(job.getStatus(), ScanJob::Status::CANCELLED);
+    EXPECT_EQ(job.getResult().volume, nullptr);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// VitalSignsHistory is Godot-free, so the real implementation is tested directly
+#include "vital_history.h"
+
+namespace {
+
+VitalSigns makeVitals(float base) {
+    VitalSigns vitals;
+    vitals.oxygenLevel = 90.0f + base * 0.01f;
+    vitals.heartRate = 60.0f + base;
+    vitals.bloodPressure = 110.0f + base * 0.5f;
+    vitals.temperature = 36.5f + base * 0.001f;
+    vitals.respirationRate = 12.0f + base * 0.1f;
+    return vitals;
+}
+
+// Reference statistics computed the slow way
+VitalSignsHistory::WindowStats naiveStats(const std::vector<float>& values) {
+    VitalSignsHistory::WindowStats stats{values[0], values[0], 0.0f, 0.0f, values.size()};
+    double sum = 0.0;
+    for (float v : values) {
+        stats.min = std::min(stats.min, v);
+        stats.max = std::max(stats.max, v);
+        sum += v;
+    }
+    double mean = sum / values.size();
+    double deviation = 0.0;
+    for (float v : values) {
+        deviation += (v - mean) * (v - mean);
+    }
+    stats.mean = static_cast<float>(mean);
+    stats.stddev = static_cast<float>(std::sqrt(deviation / values.size()));
+    return stats;
+}
+
+} // namespace
+
+class VitalHistoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        history = std::make_unique<VitalSignsHistory>();
+    }
+
+    std::unique_ptr<VitalSignsHistory> history;
+};
+
+// Test that an empty history reports no samples
+TEST_F(VitalHistoryTest, EmptyHistory) {
+    auto stats = history->computeStats(VitalSignsHistory::Lane::HEART_RATE, 10);
+    EXPECT_EQ(stats.sampleCount, 0u);
+    EXPECT_EQ(history->size(), 0u);
+}
+
+// Test statistics over a window against a scalar reference
+TEST_F(VitalHistoryTest, WindowMatchesReference) {
+    std::vector<float> heartRates;
+    for (int i = 0; i < 100; ++i) {
+        float base = static_cast<float>((i * 37) % 41);
+        history->push(makeVitals(base));
+        heartRates.push_back(60.0f + base);
+    }
+
+    std::vector<float> window(heartRates.end() - 30, heartRates.end());
+    auto expected = naiveStats(window);
+    auto stats = history->computeStats(VitalSignsHistory::Lane::HEART_RATE, 30);
+
+    EXPECT_EQ(stats.sampleCount, 30u);
+    EXPECT_FLOAT_EQ(stats.min, expected.min);
+    EXPECT_FLOAT_EQ(stats.max, expected.max);
+    EXPECT_NEAR(stats.mean, expected.mean, 1e-3f);
+    EXPECT_NEAR(stats.stddev, expected.stddev, 1e-3f);
+}
+
+// Test that windows spanning the ring wrap-around are handled
+TEST_F(VitalHistoryTest, WindowAcrossWrapAround) {
+    const size_t total = VitalSignsHistory::kCapacity + 300;
+    std::vector<float> pressures;
+    for (size_t i = 0; i < total; ++i) {
+        float base = static_cast<float>(i % 97);
+        history->push(makeVitals(base));
+        pressures.push_back(110.0f + base * 0.5f);
+    }
+
+    EXPECT_EQ(history->size(), VitalSignsHistory::kCapacity);
+
+    std::vector<float> window(pressures.end() - 500, pressures.end());
+    auto expected = naiveStats(window);
+    auto stats = history->computeStats(VitalSignsHistory::Lane::BLOOD_PRESSURE, 500);
+
+    EXPECT_FLOAT_EQ(stats.min, expected.min);
+    EXPECT_FLOAT_EQ(stats.max, expected.max);
+    EXPECT_NEAR(stats.mean, expected.mean, 1e-3f);
+    EXPECT_NEAR(stats.stddev, expected.stddev, 1e-3f);
+}
+
+// Test that oversize and zero windows cover the whole history
+TEST_F(VitalHistoryTest, WindowClampedToSize) {
+    for (int i = 0; i < 7; ++i) {
+        history->push(makeVitals(static_cast<float>(i)));
+    }
+
+    EXPECT_EQ(history->computeStats(VitalSignsHistory::Lane::TEMPERATURE, 0).sampleCount, 7u);
+    EXPECT_EQ(history->computeStats(VitalSignsHistory::Lane::TEMPERATURE, 5000).sampleCount, 7u);
+
+    auto stats = history->computeStats(VitalSignsHistory::Lane::RESPIRATION_RATE, 0);
+    EXPECT_FLOAT_EQ(stats.min, 12.0f);
+    EXPECT_FLOAT_EQ(stats.max, 12.6f);
+}
+
+// Test lane names used as GDScript dictionary keys
+TEST_F(VitalHistoryTest, LaneNames) {
+    EXPECT_STREQ(VitalSignsHistory::getLaneName(VitalSignsHistory::Lane::OXYGEN_LEVEL), "oxygen_level");
+    EXPECT_STREQ(VitalSignsHistory::getLaneName(VitalSignsHistory::Lane::RESPIRATION_RATE), "respiration_rate");
+}
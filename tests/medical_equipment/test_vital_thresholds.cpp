@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+// VitalThresholds is Godot-free, so the real implementation is tested directly
+#include "vital_thresholds.h"
+
+class VitalThresholdsTest : public ::testing::Test {
+protected:
+    // Builds SoA lanes from per-patient samples
+    void setPatients(const std::vector<VitalSigns>& patients) {
+        for (auto& lane : lanes) {
+            lane.clear();
+        }
+        for (const auto& vitals : patients) {
+            lanes[static_cast<size_t>(VitalLane::OXYGEN_LEVEL)].push_back(vitals.oxygenLevel);
+            lanes[static_cast<size_t>(VitalLane::HEART_RATE)].push_back(vitals.heartRate);
+            lanes[static_cast<size_t>(VitalLane::BLOOD_PRESSURE)].push_back(vitals.bloodPressure);
+            lanes[static_cast<size_t>(VitalLane::TEMPERATURE)].push_back(vitals.temperature);
+            lanes[static_cast<size_t>(VitalLane::RESPIRATION_RATE)].push_back(vitals.respirationRate);
+        }
+        for (size_t lane = 0; lane < kVitalLaneCount; ++lane) {
+            pointers[lane] = lanes[lane].data();
+        }
+    }
+
+    std::vector<float> lanes[kVitalLaneCount];
+    VitalThresholds::LanePointers pointers;
+    VitalThresholds thresholds = VitalThresholds::defaults();
+};
+
+// Test that normal vitals raise no alerts
+TEST_F(VitalThresholdsTest, NormalVitals) {
+    VitalSigns vitals;
+    EXPECT_EQ(thresholds.evaluate(vitals), 0);
+}
+
+// Test each default alert bit
+TEST_F(VitalThresholdsTest, DefaultAlerts) {
+    VitalSigns lowOxygen;
+    lowOxygen.oxygenLevel = 85.0f;
+    EXPECT_EQ(thresholds.evaluate(lowOxygen),
+              VitalThresholds::ALERT_LOW_OXYGEN | VitalThresholds::ALERT_PROCEDURE);
+
+    VitalSigns fastHeart;
+    fastHeart.heartRate = 130.0f;
+    EXPECT_EQ(thresholds.evaluate(fastHeart),
+              VitalThresholds::ALERT_ABNORMAL_HEART_RATE | VitalThresholds::ALERT_PROCEDURE);
+
+    VitalSigns fever;
+    fever.temperature = 39.0f;
+    EXPECT_EQ(thresholds.evaluate(fever), VitalThresholds::ALERT_TEMPERATURE_WARNING);
+
+    // Only the tighter procedure limit is exceeded
+    VitalSigns elevated;
+    elevated.heartRate = 115.0f;
+    EXPECT_EQ(thresholds.evaluate(elevated), VitalThresholds::ALERT_PROCEDURE);
+}
+
+// Test that band edges are inclusive
+TEST_F(VitalThresholdsTest, BandEdges) {
+    VitalSigns vitals;
+    vitals.oxygenLevel = 95.0f;
+    vitals.heartRate = 110.0f;
+    vitals.temperature = 38.5f;
+    EXPECT_EQ(thresholds.evaluate(vitals), 0);
+}
+
+// Test that the vectorized pass matches per-patient evaluation, including the tail
+TEST_F(VitalThresholdsTest, BatchMatchesSingle) {
+    std::vector<VitalSigns> patients;
+    for (int i = 0; i < 37; ++i) {
+        VitalSigns vitals;
+        vitals.oxygenLevel = 84.0f + static_cast<float>(i % 17);
+        vitals.heartRate = 40.0f + static_cast<float>(i * 3);
+        vitals.temperature = 35.5f + static_cast<float>(i % 7) * 0.5f;
+        patients.push_back(vitals);
+    }
+    setPatients(patients);
+
+    std::vector<int32_t> masks(patients.size(), -1);
+    thresholds.evaluate(pointers, patients.size(), masks.data());
+
+    for (size_t i = 0; i < patients.size(); ++i) {
+        EXPECT_EQ(masks[i], thresholds.evaluate(patients[i])) << "patient " << i;
+    }
+}
+
+// Test custom tables and the rule limit
+TEST_F(VitalThresholdsTest, CustomRules) {
+    VitalThresholds table;
+    EXPECT_TRUE(table.addRule({VitalLane::RESPIRATION_RATE, 10.0f, 25.0f, 1 << 4}));
+
+    VitalSigns vitals;
+    vitals.respirationRate = 30.0f;
+    EXPECT_EQ(table.evaluate(vitals), 1 << 4);
+
+    while (table.getRuleCount() < VitalThresholds::kMaxRules) {
+        EXPECT_TRUE(table.addRule({VitalLane::HEART_RATE, 0.0f, 1000.0f, 1}));
+    }
+    EXPECT_FALSE(table.addRule({VitalLane::HEART_RATE, 0.0f, 1000.0f, 1}));
+
+    table.clear();
+    EXPECT_EQ(table.evaluate(vitals), 0);
+}
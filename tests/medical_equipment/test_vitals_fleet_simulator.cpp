@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+// VitalsFleetSimulator is Godot-free, so the real implementation is tested directly
+#include "vitals_fleet_simulator.h"
+#include "worker_pool.h"
+
+class VitalsFleetSimulatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        simulator.resize(10000);
+    }
+
+    VitalsFleetSimulator simulator{1234u};
+};
+
+// Test that new patients start at default vitals
+TEST_F(VitalsFleetSimulatorTest, DefaultVitals) {
+    VitalSigns defaults;
+    VitalSigns vitals = simulator.getVitals(42);
+    EXPECT_FLOAT_EQ(vitals.heartRate, defaults.heartRate);
+    EXPECT_FLOAT_EQ(vitals.oxygenLevel, defaults.oxygenLevel);
+    EXPECT_EQ(simulator.size(), 10000u);
+}
+
+// Test that the random walk stays within the configured limits
+TEST_F(VitalsFleetSimulatorTest, StaysWithinLimits) {
+    for (int i = 0; i < 50; ++i) {
+        simulator.step();
+    }
+
+    const float* heartRates = simulator.getLane(VitalLane::HEART_RATE);
+    auto range = std::minmax_element(heartRates, heartRates + simulator.size());
+    EXPECT_GE(*range.first, 60.0f);
+    EXPECT_LE(*range.second, 100.0f);
+    EXPECT_LT(*range.first, *range.second); // values actually moved
+    EXPECT_EQ(simulator.getTick(), 50u);
+}
+
+// Test that results do not depend on how the fleet is split across threads
+TEST_F(VitalsFleetSimulatorTest, ParallelMatchesSerial) {
+    VitalsFleetSimulator serial(1234u);
+    serial.resize(10000);
+    WorkerPool pool(3);
+
+    for (int i = 0; i < 5; ++i) {
+        simulator.step(&pool);
+        serial.step(nullptr);
+    }
+
+    for (size_t lane = 0; lane < kVitalLaneCount; ++lane) {
+        const float* a = simulator.getLane(static_cast<VitalLane>(lane));
+        const float* b = serial.getLane(static_cast<VitalLane>(lane));
+        EXPECT_TRUE(std::equal(a, a + simulator.size(), b));
+    }
+}
+
+// Test that the counter-based generator covers [-1, 1) and is deterministic
+TEST_F(VitalsFleetSimulatorTest, RandomUnitRange) {
+    float low = 1.0f;
+    float high = -1.0f;
+    for (uint32_t patient = 0; patient < 100000; ++patient) {
+        float u = VitalsFleetSimulator::randomUnit(7u, 3u, 1u, patient);
+        low = std::min(low, u);
+        high = std::max(high, u);
+    }
+    EXPECT_GE(low, -1.0f);
+    EXPECT_LT(high, 1.0f);
+    EXPECT_LT(low, -0.99f);
+    EXPECT_GT(high, 0.99f);
+    EXPECT_EQ(VitalsFleetSimulator::randomUnit(7u, 3u, 1u, 5u),
+              VitalsFleetSimulator::randomUnit(7u, 3u, 1u, 5u));
+}
+
+// Test that only patients crossing an alert band are reported
+TEST_F(VitalsFleetSimulatorTest, ReportsThresholdCrossings) {
+    // Widen the heart rate walk so patients can leave the 50-120 band
+    simulator.setLimits(VitalLane::HEART_RATE, {30.0f, 150.0f, 40.0f});
+
+    VitalSigns critical;
+    critical.oxygenLevel = 80.0f;
+    simulator.setVitals(7, critical);
+    simulator.setLimits(VitalLane::OXYGEN_LEVEL, {0.0f, 100.0f, 0.0f});
+
+    size_t crossings = simulator.step();
+    const auto& crossed = simulator.getCrossedPatients();
+
+    EXPECT_EQ(crossings, crossed.size());
+    EXPECT_TRUE(std::is_sorted(crossed.begin(), crossed.end()));
+    EXPECT_TRUE(std::binary_search(crossed.begin(), crossed.end(), 7u));
+    EXPECT_NE(simulator.getAlertState(7) & VitalThresholds::ALERT_LOW_OXYGEN, 0);
+
+    // A patient that stays in the same alert state is not reported again
+    simulator.setLimits(VitalLane::HEART_RATE, {75.0f, 75.0f, 0.0f});
+    simulator.step();
+    simulator.step();
+    EXPECT_FALSE(std::binary_search(simulator.getCrossedPatients().begin(),
+                                    simulator.getCrossedPatients().end(), 7u));
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// VitalsRecorder is Godot-free, so the real implementation is tested directly
+#include "vitals_recorder.h"
+
+class VitalsRecorderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = ::testing::TempDir() + "vitals_recorder_test.vtlr";
+        std::remove(path.c_str());
+    }
+
+    void TearDown() override {
+        recorder.close();
+        reader.close();
+        std::remove(path.c_str());
+    }
+
+    static VitalSigns sampleAt(uint64_t i) {
+        VitalSigns vitals;
+        vitals.heartRate = 60.0f + static_cast<float>(i % 40);
+        vitals.oxygenLevel = 95.0f + static_cast<float>(i % 5);
+        vitals.bloodPressure = 110.0f + static_cast<float>(i % 30);
+        vitals.temperature = 36.5f + static_cast<float>(i % 10) * 0.1f;
+        vitals.respirationRate = 12.0f + static_cast<float>(i % 8);
+        return vitals;
+    }
+
+    // Irregular, occasionally backwards timestamps exercise the zigzag deltas
+    static int64_t timestampAt(uint64_t i) {
+        return 1700000000000000LL + static_cast<int64_t>(i) * 1000 + ((i % 7 == 3) ? -400 : 0);
+    }
+
+    std::string path;
+    VitalsRecorder recorder;
+    VitalsRecordingReader reader;
+};
+
+// Test that samples round-trip across several blocks
+TEST_F(VitalsRecorderTest, RoundTrip) {
+    ASSERT_TRUE(recorder.open(path));
+
+    const uint64_t count = VitalsRecordingFormat::kBlockCapacity * 2 + 123;
+    for (uint64_t i = 0; i < count; ++i) {
+        ASSERT_TRUE(recorder.record(timestampAt(i), sampleAt(i)));
+    }
+    recorder.close();
+
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.getSampleCount(), count);
+    EXPECT_EQ(reader.getBlockCount(), 3u);
+
+    for (uint64_t i : std::vector<uint64_t>{0, 1, 3, 4095, 4096, 8200, count - 1}) {
+        int64_t timestamp = 0;
+        VitalSigns vitals;
+        ASSERT_TRUE(reader.readSample(i, timestamp, vitals));
+        EXPECT_EQ(timestamp, timestampAt(i));
+        EXPECT_FLOAT_EQ(vitals.heartRate, sampleAt(i).heartRate);
+        EXPECT_FLOAT_EQ(vitals.temperature, sampleAt(i).temperature);
+    }
+
+    std::vector<int64_t> timestamps(VitalsRecordingFormat::kBlockCapacity);
+    ASSERT_EQ(reader.decodeTimestamps(2, timestamps.data()), 123u);
+    EXPECT_EQ(timestamps[122], timestampAt(count - 1));
+}
+
+// Test block min/max summaries for sealed and partial blocks
+TEST_F(VitalsRecorderTest, BlockSummaries) {
+    ASSERT_TRUE(recorder.open(path));
+    const uint64_t count = VitalsRecordingFormat::kBlockCapacity + 20;
+    for (uint64_t i = 0; i < count; ++i) {
+        recorder.record(timestampAt(i), sampleAt(i));
+    }
+    recorder.flush();
+
+    ASSERT_TRUE(reader.open(path));
+    auto sealed = reader.getBlockSummary(0);
+    EXPECT_EQ(sealed.sampleCount, VitalsRecordingFormat::kBlockCapacity);
+    EXPECT_FLOAT_EQ(sealed.min[static_cast<size_t>(VitalLane::HEART_RATE)], 60.0f);
+    EXPECT_FLOAT_EQ(sealed.max[static_cast<size_t>(VitalLane::HEART_RATE)], 99.0f);
+    EXPECT_EQ(sealed.firstTimestampUs, timestampAt(0));
+    EXPECT_EQ(sealed.lastTimestampUs, timestampAt(VitalsRecordingFormat::kBlockCapacity - 1));
+
+    auto partial = reader.getBlockSummary(1);
+    EXPECT_EQ(partial.sampleCount, 20u);
+    EXPECT_FLOAT_EQ(partial.max[static_cast<size_t>(VitalLane::RESPIRATION_RATE)], 19.0f);
+    EXPECT_EQ(partial.lastTimestampUs, timestampAt(count - 1));
+}
+
+// Test that a reader follows a file that is still being written
+TEST_F(VitalsRecorderTest, ReadWhileRecording) {
+    ASSERT_TRUE(recorder.open(path));
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.getSampleCount(), 0u);
+
+    uint64_t written = 0;
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 5000; ++i, ++written) {
+            recorder.record(timestampAt(written), sampleAt(written));
+        }
+        recorder.flush();
+
+        EXPECT_TRUE(reader.refresh());
+        EXPECT_EQ(reader.getSampleCount(), written);
+
+        int64_t timestamp = 0;
+        VitalSigns vitals;
+        ASSERT_TRUE(reader.readSample(written - 1, timestamp, vitals));
+        EXPECT_EQ(timestamp, timestampAt(written - 1));
+    }
+    EXPECT_EQ(recorder.getDroppedCount(), 0u);
+}
+
+// Test that a closed recorder ignores samples and bad files are rejected
+TEST_F(VitalsRecorderTest, ClosedAndInvalid) {
+    EXPECT_FALSE(recorder.record(VitalSigns()));
+    EXPECT_FALSE(reader.open(path));
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::vector<char> junk(256, 'x');
+    std::fwrite(junk.data(), 1, junk.size(), file);
+    std::fclose(file);
+    EXPECT_FALSE(reader.open(path));
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// VitalsReplay is Godot-free, so the real implementation is tested directly
+#include "vitals_replay.h"
+
+class VitalsReplayTest : public ::testing::Test {
+protected:
+    static constexpr int64_t kStartUs = 1700000000000000LL;
+    static constexpr int64_t kPeriodUs = 1000000; // one sample per second
+
+    void SetUp() override {
+        path = ::testing::TempDir() + "vitals_replay_test.vtlr";
+        std::remove(path.c_str());
+    }
+
+    void TearDown() override {
+        replay.close();
+        std::remove(path.c_str());
+    }
+
+    // Records `count` samples whose heart rate encodes their index
+    void recordSession(uint64_t count) {
+        VitalsRecorder recorder;
+        ASSERT_TRUE(recorder.open(path));
+        for (uint64_t i = 0; i < count; ++i) {
+            VitalSigns vitals;
+            vitals.heartRate = static_cast<float>(i);
+            recorder.record(kStartUs + static_cast<int64_t>(i) * kPeriodUs, vitals);
+            if (i % 10000 == 9999) {
+                recorder.flush();
+            }
+        }
+        recorder.close();
+    }
+
+    std::string path;
+    VitalsReplay replay;
+};
+
+// Test that max speed plays every sample in order
+TEST_F(VitalsReplayTest, MaxSpeedPlaysEverything) {
+    const uint64_t count = 3 * 3600; // three hours at 1 Hz
+    recordSession(count);
+    ASSERT_TRUE(replay.open(path));
+    replay.setSpeed(0.0);
+
+    uint64_t expected = 0;
+    bool ordered = true;
+    size_t played = replay.advance(0, [&](int64_t timestamp, const VitalSigns& vitals) {
+        ordered &= timestamp == kStartUs + static_cast<int64_t>(expected) * kPeriodUs;
+        ordered &= vitals.heartRate == static_cast<float>(expected);
+        ++expected;
+    });
+
+    EXPECT_EQ(played, count);
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(replay.isFinished());
+    EXPECT_EQ(replay.getPlayhead(), kStartUs + static_cast<int64_t>(count - 1) * kPeriodUs);
+}
+
+// Test paced playback at real time and N times faster
+TEST_F(VitalsReplayTest, PacedPlayback) {
+    recordSession(100);
+    ASSERT_TRUE(replay.open(path));
+    auto ignore = [](int64_t, const VitalSigns&) {};
+
+    // The first sample is due immediately
+    EXPECT_EQ(replay.advance(0, ignore), 1u);
+    EXPECT_EQ(replay.advance(kPeriodUs * 3, ignore), 3u);
+
+    replay.setSpeed(10.0);
+    EXPECT_EQ(replay.advance(kPeriodUs, ignore), 10u);
+    EXPECT_EQ(replay.getSampleIndex(), 14u);
+}
+
+// Test seeking by timestamp across block boundaries
+TEST_F(VitalsReplayTest, SeekByTimestamp) {
+    const uint64_t count = VitalsRecordingFormat::kBlockCapacity * 3 + 10;
+    recordSession(count);
+    ASSERT_TRUE(replay.open(path));
+
+    for (uint64_t target : std::vector<uint64_t>{0, 1, 4095, 4096, 9000, count - 1}) {
+        ASSERT_TRUE(replay.seek(kStartUs + static_cast<int64_t>(target) * kPeriodUs));
+        EXPECT_EQ(replay.getSampleIndex(), target);
+
+        float heartRate = -1.0f;
+        replay.playUntil(kStartUs + static_cast<int64_t>(target) * kPeriodUs,
+                         [&](int64_t, const VitalSigns& vitals) { heartRate = vitals.heartRate; });
+        EXPECT_FLOAT_EQ(heartRate, static_cast<float>(target));
+    }
+
+    // Between samples seeks to the next one; before the start rewinds
+    replay.seek(kStartUs + 10 * kPeriodUs + 1);
+    EXPECT_EQ(replay.getSampleIndex(), 11u);
+    replay.seek(0);
+    EXPECT_EQ(replay.getSampleIndex(), 0u);
+
+    // Past the end finishes the replay
+    replay.seek(kStartUs + static_cast<int64_t>(count) * kPeriodUs);
+    EXPECT_TRUE(replay.isFinished());
+}
+
+// Test following a recording that is still being written
+TEST_F(VitalsReplayTest, FollowsLiveRecording) {
+    VitalsRecorder recorder;
+    ASSERT_TRUE(recorder.open(path));
+    for (int64_t i = 0; i < 10; ++i) {
+        recorder.record(kStartUs + i * kPeriodUs, VitalSigns());
+    }
+    recorder.flush();
+
+    ASSERT_TRUE(replay.open(path));
+    replay.setSpeed(0.0);
+    auto ignore = [](int64_t, const VitalSigns&) {};
+    EXPECT_EQ(replay.advance(0, ignore), 10u);
+
+    for (int64_t i = 10; i < 5000; ++i) {
+        recorder.record(kStartUs + i * kPeriodUs, VitalSigns());
+    }
+    recorder.flush();
+
+    EXPECT_TRUE(replay.refresh());
+    EXPECT_EQ(replay.advance(0, ignore), 4990u);
+    EXPECT_TRUE(replay.isFinished());
+}
+
+// Test that a cursor mid-block survives the file being remapped as the recording grows
+TEST_F(VitalsReplayTest, FollowsRemappedRecordingMidBlock) {
+    VitalsRecorder recorder;
+    ASSERT_TRUE(recorder.open(path));
+    auto record = [&recorder](uint64_t i) {
+        VitalSigns vitals;
+        vitals.heartRate = static_cast<float>(i);
+        recorder.record(kStartUs + static_cast<int64_t>(i) * kPeriodUs, vitals);
+    };
+    for (uint64_t i = 0; i < 100; ++i) {
+        record(i);
+    }
+    recorder.flush();
+
+    ASSERT_TRUE(replay.open(path));
+    std::vector<float> rates;
+    auto collect = [&rates](int64_t, const VitalSigns& vitals) { rates.push_back(vitals.heartRate); };
+    EXPECT_EQ(replay.playUntil(kStartUs + 50 * kPeriodUs, collect), 51u);
+
+    // Well past the writer's growth step, so the reader has to map the file again
+    const uint64_t total = 200000;
+    for (uint64_t i = 100; i < total; ++i) {
+        record(i);
+        if (i % 10000 == 9999) {
+            recorder.flush();
+        }
+    }
+    recorder.flush();
+
+    EXPECT_TRUE(replay.refresh());
+    EXPECT_EQ(replay.getSampleIndex(), 51u);
+    replay.setSpeed(0.0);
+    EXPECT_EQ(replay.advance(0, collect), total - 51);
+    ASSERT_EQ(rates.size(), total);
+    for (uint64_t i = 0; i < total; ++i) {
+        ASSERT_EQ(rates[i], static_cast<float>(i)) << i;
+    }
+    EXPECT_TRUE(replay.isFinished());
+}